@@ -18,8 +18,14 @@
 #ifndef IGNITION_SENSORS_BROWNDISTORTIONMODEL_HH_
 #define IGNITION_SENSORS_BROWNDISTORTIONMODEL_HH_
 
+#include <cstdint>
+#include <memory>
+#include <vector>
+
 #include <sdf/sdf.hh>
 
+#include <ignition/math/Vector2.hh>
+
 #include "ignition/sensors/Distortion.hh"
 #include "ignition/sensors/Export.hh"
 #include "ignition/sensors/config.hh"
@@ -39,8 +45,52 @@ namespace ignition
     ignition/sensors/BrownDistortionModel.hh
     **/
     /// \brief Brown Distortion Model class
+    ///
+    /// Besides holding the coefficients, the model distorts and undistorts
+    /// images and points on the CPU. Image and point coordinates are in
+    /// pixels, with the center of the first pixel at 0. The distortion is
+    /// applied about the lens center, in image coordinates normalized by the
+    /// focal lengths.
     class IGNITION_SENSORS_VISIBLE BrownDistortionModel : public Distortion
     {
+      /// \brief Fractional bits of the fixed point remap tables.
+      public: static constexpr unsigned int kRemapFractionBits = 5u;
+
+      /// \brief Interpolation used when resampling images.
+      public: enum class Interpolation
+      {
+        /// \brief Bilinear interpolation, for color and intensity images.
+        BILINEAR,
+
+        /// \brief Nearest neighbour, for images whose values must not be
+        /// blended such as depth and labels.
+        NEAREST
+      };
+
+      /// \brief Table that maps every pixel of an output image to the
+      /// position in the input image it is sampled from.
+      public: struct RemapTable
+      {
+        /// \brief Image width in pixels.
+        unsigned int width = 0u;
+
+        /// \brief Image height in pixels.
+        unsigned int height = 0u;
+
+        /// \brief Source column and row of each output pixel, interleaved.
+        /// Both are -1 for output pixels without a source in the image.
+        std::vector<float> map;
+
+        /// \brief Source positions in fixed point: the integer column and
+        /// row of each output pixel, interleaved, -1 without a source.
+        std::vector<std::int16_t> fixedMap;
+
+        /// \brief Fraction of the fixed point source positions, in units of
+        /// 1 / 2^kRemapFractionBits pixels: column in the low bits, row in
+        /// the next kRemapFractionBits bits.
+        std::vector<std::uint16_t> fixedFraction;
+      };
+
       /// \brief Constructor.
       public: BrownDistortionModel();
 
@@ -74,6 +124,96 @@ namespace ignition
       /// \return Distortion center.
       public: math::Vector2d Center() const;
 
+      /// \brief Get the table that distorts images of a size, whose output
+      /// pixels sample an undistorted input image. Tables are built on first
+      /// use and cached.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _fx Horizontal focal length in pixels.
+      /// \param[in] _fy Vertical focal length in pixels.
+      /// \return The table, null for an empty image.
+      public: std::shared_ptr<const RemapTable> DistortionTable(
+                  unsigned int _width, unsigned int _height,
+                  double _fx, double _fy) const;
+
+      /// \brief Get the table that undistorts images of a size, whose output
+      /// pixels sample a distorted input image. Tables are built on first
+      /// use and cached.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _fx Horizontal focal length in pixels.
+      /// \param[in] _fy Vertical focal length in pixels.
+      /// \return The table, null for an empty image.
+      public: std::shared_ptr<const RemapTable> UndistortionTable(
+                  unsigned int _width, unsigned int _height,
+                  double _fx, double _fy) const;
+
+      /// \brief Distort an image rendered with an ideal pinhole camera.
+      /// Rows are processed in parallel. Output pixels without a source are
+      /// zero.
+      /// \param[in] _src Undistorted image.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _channels Number of channels. Bilinear interpolation
+      /// supports 1, 3 or 4.
+      /// \param[in] _bytesPerChannel Bytes per channel. Bilinear
+      /// interpolation supports 1 or 2.
+      /// \param[in] _fx Horizontal focal length in pixels.
+      /// \param[in] _fy Vertical focal length in pixels.
+      /// \param[out] _dst Distorted image, which must not overlap _src.
+      /// \param[in] _interpolation Interpolation.
+      /// \return False if the pixel layout is not supported.
+      public: bool Distort(const unsigned char *_src, unsigned int _width,
+                  unsigned int _height, unsigned int _channels,
+                  unsigned int _bytesPerChannel, double _fx, double _fy,
+                  unsigned char *_dst,
+                  Interpolation _interpolation = Interpolation::BILINEAR)
+                  const;
+
+      /// \brief Undistort an image. Rows are processed in parallel. Output
+      /// pixels without a source are zero.
+      /// \param[in] _src Distorted image.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _channels Number of channels. Bilinear interpolation
+      /// supports 1, 3 or 4.
+      /// \param[in] _bytesPerChannel Bytes per channel. Bilinear
+      /// interpolation supports 1 or 2.
+      /// \param[in] _fx Horizontal focal length in pixels.
+      /// \param[in] _fy Vertical focal length in pixels.
+      /// \param[out] _dst Undistorted image, which must not overlap _src.
+      /// \param[in] _interpolation Interpolation.
+      /// \return False if the pixel layout is not supported.
+      public: bool Undistort(const unsigned char *_src, unsigned int _width,
+                  unsigned int _height, unsigned int _channels,
+                  unsigned int _bytesPerChannel, double _fx, double _fy,
+                  unsigned char *_dst,
+                  Interpolation _interpolation = Interpolation::BILINEAR)
+                  const;
+
+      /// \brief Distort points, in place.
+      /// \param[in,out] _points Pixel positions.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _fx Horizontal focal length in pixels.
+      /// \param[in] _fy Vertical focal length in pixels.
+      public: void Distort(std::vector<math::Vector2d> &_points,
+                  unsigned int _width, unsigned int _height,
+                  double _fx, double _fy) const;
+
+      /// \brief Undistort points, in place, by fixed point iteration.
+      /// \param[in,out] _points Pixel positions. Points for which the
+      /// iteration does not converge, which happens far outside the image
+      /// with strong barrel distortion, are set to NaN.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _fx Horizontal focal length in pixels.
+      /// \param[in] _fy Vertical focal length in pixels.
+      /// \return False if any point did not converge.
+      public: bool Undistort(std::vector<math::Vector2d> &_points,
+                  unsigned int _width, unsigned int _height,
+                  double _fx, double _fy) const;
+
       /// Documentation inherited
       public: virtual void Print(std::ostream &_out) const override;
 
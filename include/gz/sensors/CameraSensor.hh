@@ -121,6 +121,36 @@ namespace ignition
       /// \return height of the image
       public: virtual unsigned int ImageHeight() const;
 
+      /// \brief Publish only a region of the rendered image, optionally
+      /// binned, to reduce the size of image messages. The camera_info
+      /// message describes the published image. The same can be set with
+      /// `<ignition:roi>x y width height</ignition:roi>` and
+      /// `<ignition:binning>` in the camera SDF.
+      /// \param[in] _x Left column of the region.
+      /// \param[in] _y Top row of the region.
+      /// \param[in] _width Width of the region, zero to extend it to the
+      /// right edge of the image.
+      /// \param[in] _height Height of the region, zero to extend it to the
+      /// bottom edge of the image.
+      /// \param[in] _binning Size of the square blocks of pixels averaged
+      /// into one published pixel: 1, 2 or 4. The region is shrunk to a whole
+      /// number of blocks.
+      /// \return False if the binning is not supported, or the region does
+      /// not fit the image, in which case the whole image is published.
+      public: bool SetImageRegion(unsigned int _x, unsigned int _y,
+                  unsigned int _width, unsigned int _height,
+                  unsigned int _binning = 1u);
+
+      /// \brief Get the width of published images, which is smaller than
+      /// ImageWidth() when a region or binning is set.
+      /// \return Width in pixels.
+      public: unsigned int PublishedImageWidth() const;
+
+      /// \brief Get the height of published images, which is smaller than
+      /// ImageHeight() when a region or binning is set.
+      /// \return Height in pixels.
+      public: unsigned int PublishedImageHeight() const;
+
       /// \brief Get pointer to rendering camera object.
       /// \return Camera in Gazebo Rendering.
       public: rendering::CameraPtr RenderingCamera() const;
@@ -138,6 +168,22 @@ namespace ignition
       /// \return The distance from the 1st camera, in meters.
       public: double Baseline() const;
 
+      /// \brief Set how often camera info is published. By default it is
+      /// published on every update while it has subscribers. Otherwise it is
+      /// published when it changes, when the topic goes from no subscribers
+      /// to some, and at the given rate. Subscribers that join while others
+      /// are connected receive it at the next publication, so rates below
+      /// 0.1 Hz are raised to 0.1 Hz. The same can be set with
+      /// `<ignition:camera_info_rate>` in the camera SDF.
+      /// \param[in] _rate Rate in Hz, negative to publish on every update.
+      public: void SetInfoRate(double _rate);
+
+      /// \brief Get how often camera info is published.
+      /// \return Rate in Hz, at least 0.1, or negative if it is published
+      /// on every update.
+      /// \sa SetInfoRate
+      public: double InfoRate() const;
+
       /// \brief Check if there are any subscribers
       /// \return True if there are subscribers, false otherwise
       /// \todo(iche033) Make this function virtual on Garden
@@ -153,6 +199,11 @@ namespace ignition
       /// \todo(iche033) Make this function virtual on Harmonic
       public: bool HasInfoConnections() const;
 
+      /// \brief Get the number of triggers dropped because more arrived
+      /// between updates than <ignition:trigger_queue_size> holds.
+      /// \return Number of dropped triggers.
+      public: std::uint64_t DroppedTriggerCount() const;
+
       /// \brief Advertise camera info topic.
       /// \return True if successful.
       protected: bool AdvertiseInfo();
@@ -169,6 +220,12 @@ namespace ignition
       /// information.
       protected: void PopulateInfo(const sdf::Camera *_cameraSdf);
 
+      /// \brief Read <ignition:camera_info_rate>, if present. Called once
+      /// from Load, so that a rate set later with SetInfoRate() is kept.
+      /// \param[in] _cameraSdf Pointer to SDF object containing camera
+      /// information.
+      protected: void LoadInfoRate(const sdf::Camera *_cameraSdf);
+
       /// \brief Publish camera info message.
       /// \param[in] _now The current time
       protected: void PublishInfo(
@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef IGNITION_SENSORS_FRAMECONTAINER_HH_
+#define IGNITION_SENSORS_FRAMECONTAINER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "ignition/sensors/Export.hh"
+#include "ignition/sensors/config.hh"
+#include "ignition/utils/ImplPtr.hh"
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Type of the data held by a container record.
+    enum class FrameContentType : std::uint32_t
+    {
+      /// \brief Unknown data.
+      UNKNOWN = 0,
+
+      /// \brief PNG image.
+      PNG = 1,
+
+      /// \brief Raw frame dump, see the ImageSaver documentation.
+      RAW = 2,
+
+      /// \brief QOI image.
+      QOI = 3,
+
+      /// \brief Raw frame dump in an LZ4 frame.
+      LZ4 = 4,
+
+      /// \brief Comma separated values, such as bounding boxes.
+      CSV = 5
+    };
+
+    /** \class FrameContainerWriter FrameContainer.hh \
+    ignition/sensors/FrameContainer.hh
+    **/
+    /// \brief Appends the frames, label maps and boxes a sensor saves to a
+    /// single file, instead of one file each.
+    ///
+    /// A container starts with a 16 byte file header, "IGNC" and a version,
+    /// followed by records. Each record is a 32 byte record header, the
+    /// record name and the data, with the data starting on a 64 byte
+    /// boundary so that a memory mapped container can be read in place.
+    /// Record names are the relative paths the data would have had as
+    /// separate files, such as "images/image_0000001.qoi".
+    ///
+    /// Close() writes an index of all records after the last one, followed
+    /// by a 16 byte trailer pointing at the index. A container that was not
+    /// closed, for example because the simulation crashed, is still
+    /// readable: readers fall back to walking the records.
+    ///
+    /// Appending is thread safe.
+    class IGNITION_SENSORS_VISIBLE FrameContainerWriter
+    {
+      /// \brief Constructor
+      public: FrameContainerWriter();
+
+      /// \brief Destructor. Closes the container.
+      public: ~FrameContainerWriter();
+
+      /// \brief Open a container. An existing container is appended to,
+      /// anything else at _path is replaced.
+      /// \param[in] _path File path.
+      /// \return True if the container is open.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Write the index and close the container.
+      public: void Close();
+
+      /// \brief Check whether the container is open.
+      /// \return True if open.
+      public: bool IsOpen() const;
+
+      /// \brief Get the container path.
+      /// \return Path, empty if not open.
+      public: std::string Path() const;
+
+      /// \brief Get the number of records, including those already in the
+      /// container when it was opened.
+      /// \return Number of records.
+      public: std::size_t RecordCount() const;
+
+      /// \brief Append a record.
+      /// \param[in] _name Record name.
+      /// \param[in] _type Type of the data.
+      /// \param[in] _data Record data.
+      /// \param[in] _size Size of _data in bytes.
+      /// \return True if the record was written.
+      public: bool Append(const std::string &_name, FrameContentType _type,
+                  const void *_data, std::size_t _size);
+
+      /// \brief Private data pointer.
+      IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+
+    /** \class FrameContainerReader FrameContainer.hh \
+    ignition/sensors/FrameContainer.hh
+    **/
+    /// \brief Random access to the records of a container written by a
+    /// FrameContainerWriter. The container is memory mapped, record data is
+    /// returned in place without copying. On Windows the container is read
+    /// into memory instead.
+    class IGNITION_SENSORS_VISIBLE FrameContainerReader
+    {
+      /// \brief Constructor
+      public: FrameContainerReader();
+
+      /// \brief Destructor. Closes the container.
+      public: ~FrameContainerReader();
+
+      /// \brief Open a container.
+      /// \param[in] _path File path.
+      /// \return False if the file can not be read or is not a container.
+      public: bool Open(const std::string &_path);
+
+      /// \brief Close the container. Pointers returned by Data() become
+      /// invalid.
+      public: void Close();
+
+      /// \brief Check whether a container is open.
+      /// \return True if open.
+      public: bool IsOpen() const;
+
+      /// \brief Check whether the index was rebuilt from the records,
+      /// because the container was not closed.
+      /// \return True if the index was rebuilt.
+      public: bool Recovered() const;
+
+      /// \brief Get the number of records.
+      /// \return Number of records.
+      public: std::size_t RecordCount() const;
+
+      /// \brief Get the name of a record.
+      /// \param[in] _index Record index, in the order records were written.
+      /// \return Record name, empty if _index is out of range.
+      public: std::string Name(std::size_t _index) const;
+
+      /// \brief Get the data type of a record.
+      /// \param[in] _index Record index.
+      /// \return Data type, UNKNOWN if _index is out of range.
+      public: FrameContentType Type(std::size_t _index) const;
+
+      /// \brief Get the data of a record.
+      /// \param[in] _index Record index.
+      /// \param[out] _size Size of the data in bytes.
+      /// \return Data, aligned to 64 bytes, or nullptr if _index is out of
+      /// range.
+      public: const unsigned char *Data(std::size_t _index,
+                  std::size_t &_size) const;
+
+      /// \brief Find a record by name. If a name was written more than once
+      /// the last record wins.
+      /// \param[in] _name Record name.
+      /// \param[out] _index Record index.
+      /// \return True if found.
+      public: bool Find(const std::string &_name, std::size_t &_index) const;
+
+      /// \brief Private data pointer.
+      IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+
+#endif
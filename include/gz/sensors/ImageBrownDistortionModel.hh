@@ -63,6 +63,29 @@ namespace ignition
       // Documentation inherited.
       public: virtual void SetCamera(rendering::CameraPtr _camera);
 
+      /// \brief Check whether images are distorted on the CPU, which is the
+      /// case when the render engine of the camera passed to SetCamera() has
+      /// no distortion render pass.
+      /// \return True if rendered images need to go through ApplyToImage().
+      public: bool CpuFallback() const;
+
+      /// \brief Distort a rendered image on the CPU, with bilinear
+      /// interpolation through the cached DistortionTable(). Unlike the
+      /// render pass, the image is not scaled to hide the black border left
+      /// by barrel distortion.
+      /// \param[in] _src Rendered image.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _channels Number of channels, 1, 3 or 4.
+      /// \param[in] _bytesPerChannel Bytes per channel, 1 or 2.
+      /// \param[out] _dst Distorted image, which must not overlap _src.
+      /// \return False if there is no camera or the pixel layout is not
+      /// supported.
+      public: bool ApplyToImage(const unsigned char *_src,
+                  unsigned int _width, unsigned int _height,
+                  unsigned int _channels, unsigned int _bytesPerChannel,
+                  unsigned char *_dst);
+
       /// Documentation inherited
       public: virtual void Print(std::ostream &_out) const override;
 
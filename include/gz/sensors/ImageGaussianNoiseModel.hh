@@ -63,6 +63,24 @@ namespace ignition
       // Documentation inherited.
       public: virtual void SetCamera(rendering::CameraPtr _camera);
 
+      /// \brief Check whether noise is added on the CPU, which is the case
+      /// when the render engine of the camera passed to SetCamera() has no
+      /// Gaussian noise render pass.
+      /// \return True if rendered images need to go through ApplyToImage().
+      public: bool CpuFallback() const;
+
+      /// \brief Add noise to a rendered image on the CPU, in place. Every
+      /// call adds a new noise frame.
+      /// \param[in,out] _data Image data.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _bytesPerChannel Bytes per channel, 1 or 2.
+      /// \return False if the channel type is not supported.
+      public: bool ApplyToImage(unsigned char *_data, unsigned int _width,
+                  unsigned int _height, unsigned int _channels,
+                  unsigned int _bytesPerChannel);
+
       /// Documentation inherited
       public: virtual void Print(std::ostream &_out) const override;
 
@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <sdf/sdf.hh>
 
@@ -40,6 +41,7 @@
 #include "gz/sensors/config.hh"
 #include "gz/sensors/Export.hh"
 #include "gz/sensors/logical_camera/Export.hh"
+#include "gz/sensors/ModelPoseSnapshot.hh"
 #include "gz/sensors/Sensor.hh"
 
 namespace ignition
@@ -95,6 +97,26 @@ namespace ignition
       /// \param[in] _models A map of model names to their world pose.
       public: void SetModelPoses(std::map<std::string, math::Pose3d> &&_models);
 
+      /// \brief Set the models currently in the world from a snapshot
+      /// shared with other logical cameras, which is not copied. It
+      /// replaces the models of the other SetModelPoses() until that is
+      /// called again.
+      /// \param[in] _snapshot Model poses, null for no models.
+      public: void SetModelPoses(
+          std::shared_ptr<const ModelPoseSnapshot> _snapshot);
+
+      /// \brief Share one snapshot of the model poses between logical
+      /// cameras and update them in parallel, each at its own update rate
+      /// as with Sensor::Update(_now, false). The snapshot is built once per
+      /// step, the cameras only query it.
+      /// \param[in] _sensors Logical cameras.
+      /// \param[in] _snapshot Model poses.
+      /// \param[in] _now The current time.
+      public: static void UpdateAll(
+          const std::vector<LogicalCameraSensor *> &_sensors,
+          const std::shared_ptr<const ModelPoseSnapshot> &_snapshot,
+          const std::chrono::steady_clock::duration &_now);
+
       /// \brief Get the horizontal field of view. The field of view is the
       /// angle between the frustum's vertex and the edges of the near or far
       /// plane. This value represents the horizontal angle.
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+#ifndef GZ_SENSORS_MODELPOSESNAPSHOT_HH_
+#define GZ_SENSORS_MODELPOSESNAPSHOT_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <gz/math/Pose3.hh>
+#include <gz/math/Vector3.hh>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+#include "ignition/utils/ImplPtr.hh"
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /** \class ModelPoseSnapshot ModelPoseSnapshot.hh \
+    gz/sensors/ModelPoseSnapshot.hh
+    **/
+    /// \brief The poses of the models in the world at one simulation step,
+    /// built once and shared by any number of logical cameras through a
+    /// std::shared_ptr, instead of each camera keeping its own copy.
+    ///
+    /// A snapshot does not change once built, so cameras can read it from
+    /// several threads at once. Models are numbered in name order. Their
+    /// positions are stored as separate x, y and z arrays and indexed by a
+    /// uniform grid, so that finding the models near a camera only visits
+    /// the grid cells around its frustum.
+    class IGNITION_SENSORS_VISIBLE ModelPoseSnapshot
+    {
+      /// \brief Constructor. Builds the snapshot.
+      /// \param[in] _models A map of model names to their world pose.
+      /// \param[in] _cellSize Edge length of the grid cells, in meters.
+      /// Cells about half the far distance of the cameras work well.
+      /// Values that are not positive and finite leave the default.
+      public: explicit ModelPoseSnapshot(
+                  const std::map<std::string, math::Pose3d> &_models,
+                  double _cellSize = 2.5);
+
+      /// \brief Destructor
+      public: ~ModelPoseSnapshot();
+
+      /// \brief Get the number of models.
+      /// \return Number of models.
+      public: std::size_t Count() const;
+
+      /// \brief Get the name of a model.
+      /// \param[in] _index Model index, less than Count().
+      /// \return Model name.
+      public: const std::string &Name(std::size_t _index) const;
+
+      /// \brief Get the position of a model.
+      /// \param[in] _index Model index, less than Count().
+      /// \return World position.
+      public: math::Vector3d Position(std::size_t _index) const;
+
+      /// \brief Get the pose of a model.
+      /// \param[in] _index Model index, less than Count().
+      /// \return World pose.
+      public: math::Pose3d Pose(std::size_t _index) const;
+
+      /// \brief Find the models in the grid cells overlapping a box. This
+      /// is a superset of the models within the box.
+      /// \param[in] _min Box minimum corner.
+      /// \param[in] _max Box maximum corner.
+      /// \param[out] _indices Model indices, in increasing order, which is
+      /// name order.
+      public: void Query(const math::Vector3d &_min,
+                  const math::Vector3d &_max,
+                  std::vector<std::uint32_t> &_indices) const;
+
+      /// \brief Private data pointer.
+      IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+
+#endif
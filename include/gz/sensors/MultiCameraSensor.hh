@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef GZ_SENSORS_MULTICAMERASENSOR_HH_
+#define GZ_SENSORS_MULTICAMERASENSOR_HH_
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sdf/sdf.hh>
+
+#include <gz/common/Event.hh>
+#include <gz/common/SuppressWarning.hh>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable: 4005)
+#pragma warning(disable: 4251)
+#endif
+#include <ignition/msgs.hh>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+// TODO(louise) Remove these pragmas once ign-rendering is disabling the
+// warnings
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+#include <gz/rendering/Camera.hh>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/multi_camera/Export.hh"
+#include "gz/sensors/Export.hh"
+#include "gz/sensors/RenderingSensor.hh"
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    // forward declarations
+    class MultiCameraSensorPrivate;
+
+    /// \brief Multi camera sensor class.
+    ///
+    /// This class creates a synchronized set of images from several cameras
+    /// rigidly attached to the same sensor, such as a stereo pair. It is
+    /// loaded from a `multicamera` sensor with one `<camera>` element per
+    /// camera, each with its own name and pose relative to the sensor.
+    ///
+    /// All cameras share one scene update and are rendered back to back by
+    /// a single Render() call. Every update publishes one image per camera
+    /// on `<topic>/<camera name>/image`, and its camera_info on
+    /// `<topic>/<camera name>/camera_info`, all with the same stamp. The
+    /// camera_info projection of each camera after the first carries the
+    /// stereo baseline to the first camera.
+    ///
+    /// With `<ignition:side_by_side>true</ignition:side_by_side>` in the
+    /// sensor element the images are also packed left to right, in SDF
+    /// order, into a single image published on `<topic>/side_by_side`. This
+    /// requires all cameras to have the same height and pixel format.
+    class IGNITION_SENSORS_MULTI_CAMERA_VISIBLE MultiCameraSensor
+      : public RenderingSensor
+    {
+      /// \brief constructor
+      public: MultiCameraSensor();
+
+      /// \brief destructor
+      public: virtual ~MultiCameraSensor();
+
+      /// \brief Load the sensor based on data from an sdf::Sensor object.
+      /// \param[in] _sdf SDF Sensor parameters.
+      /// \return true if loading was successful
+      public: virtual bool Load(const sdf::Sensor &_sdf) override;
+
+      /// \brief Load the sensor with SDF parameters.
+      /// \param[in] _sdf SDF Sensor parameters.
+      /// \return true if loading was successful
+      public: virtual bool Load(sdf::ElementPtr _sdf) override;
+
+      /// \brief Initialize values in the sensor
+      /// \return True on success
+      public: virtual bool Init() override;
+
+      /// \brief Force the sensor to generate data
+      /// \param[in] _now The current time
+      /// \return true if the update was successful
+      public: virtual bool Update(
+        const std::chrono::steady_clock::duration &_now) override;
+
+      /// \brief Set a callback to be called with each synchronized set of
+      /// images, one per camera in SDF order, all with the same stamp.
+      /// \param[in] _callback This callback will be called every time the
+      /// cameras generate images.
+      /// \return A connection pointer that must remain in scope. When the
+      /// connection pointer falls out of scope, the connection is broken.
+      public: gz::common::ConnectionPtr ConnectImagesCallback(
+                  std::function<
+                  void(const std::vector<msgs::Image> &)> _callback);
+
+      /// \brief Set the rendering scene.
+      /// \param[in] _scene Pointer to the scene
+      public: virtual void SetScene(
+                  gz::rendering::ScenePtr _scene) override;
+
+      /// \brief Get the number of cameras.
+      /// \return Number of cameras.
+      public: std::size_t CameraCount() const;
+
+      /// \brief Get the name of a camera.
+      /// \param[in] _index Camera index, in SDF order.
+      /// \return Camera name, empty if the index is out of range.
+      public: std::string CameraName(std::size_t _index) const;
+
+      /// \brief Get a rendering camera.
+      /// \param[in] _index Camera index, in SDF order.
+      /// \return Rendering camera, null if the index is out of range or the
+      /// cameras have not been created yet.
+      public: rendering::CameraPtr RenderingCamera(std::size_t _index) const;
+
+      /// \brief Get the image width of a camera.
+      /// \param[in] _index Camera index, in SDF order.
+      /// \return Width of the image, zero if the index is out of range.
+      public: unsigned int ImageWidth(std::size_t _index) const;
+
+      /// \brief Get the image height of a camera.
+      /// \param[in] _index Camera index, in SDF order.
+      /// \return Height of the image, zero if the index is out of range.
+      public: unsigned int ImageHeight(std::size_t _index) const;
+
+      /// \brief Get whether images are also packed into a single side by
+      /// side image.
+      /// \return True if side by side images are published.
+      public: bool SideBySide() const;
+
+      /// \brief Check if there are any subscribers
+      /// \return True if there are subscribers, false otherwise
+      public: bool HasConnections() const;
+
+      /// \brief Create the rendering cameras.
+      /// \return True on success.
+      private: bool CreateCameras();
+
+      IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
+      /// \brief Data pointer for private data
+      /// \internal
+      private: std::unique_ptr<MultiCameraSensorPrivate> dataPtr;
+      IGN_COMMON_WARN_RESUME__DLL_INTERFACE_MISSING
+    };
+    }
+  }
+}
+
+#endif
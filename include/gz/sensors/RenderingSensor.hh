@@ -86,6 +86,14 @@ namespace ignition
       /// \param[in] _sensor Sensor to add.
       protected: void AddSensor(rendering::SensorPtr _sensor);
 
+      /// \brief Enable or disable the render updates of a rendering::Sensor
+      /// added with AddSensor(), for sensors that only need some of their
+      /// cameras on some updates. Sensors are enabled when added.
+      /// \param[in] _sensor Sensor.
+      /// \param[in] _enabled False to skip the sensor in Render().
+      protected: void SetSensorEnabled(rendering::SensorPtr _sensor,
+          bool _enabled);
+
       IGN_COMMON_WARN_IGNORE__DLL_INTERFACE_MISSING
       /// \internal
       /// \brief Data pointer for private data
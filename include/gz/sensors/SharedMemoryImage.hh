@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_SENSORS_SHAREDMEMORYIMAGE_HH_
+#define IGNITION_SENSORS_SHAREDMEMORYIMAGE_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <ignition/msgs/image.pb.h>
+
+#include "ignition/sensors/Export.hh"
+#include "ignition/sensors/config.hh"
+#include "ignition/utils/ImplPtr.hh"
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Header key holding the shared memory segment name in an image
+    /// descriptor message.
+    static const char kSharedMemoryNameKey[] = "shm_name";
+
+    /// \brief Header key holding the generation of the shared memory
+    /// segment in an image descriptor message. It changes every time a
+    /// segment is created, even under the same name.
+    static const char kSharedMemoryGenerationKey[] = "shm_generation";
+
+    /// \brief Header key holding the ring slot index in an image descriptor
+    /// message.
+    static const char kSharedMemorySlotKey[] = "shm_slot";
+
+    /// \brief Header key holding the frame sequence number in an image
+    /// descriptor message.
+    static const char kSharedMemorySequenceKey[] = "shm_sequence";
+
+    /// \brief Header key holding the frame size in bytes in an image
+    /// descriptor message.
+    static const char kSharedMemorySizeKey[] = "shm_size";
+
+    /** \class SharedMemoryImageWriter SharedMemoryImage.hh \
+    ignition/sensors/SharedMemoryImage.hh
+    **/
+    /// \brief Writes image frames into a POSIX shared memory ring buffer.
+    ///
+    /// Frames are written into the ring slots in turn. Instead of the pixel
+    /// data, a descriptor message is published on the image topic: an
+    /// msgs::Image with the usual width, height, step, pixel format and
+    /// stamp, an empty data field and header entries naming the segment and
+    /// its generation, and the slot, sequence number and size of the frame.
+    /// Consumers on the same host read the frame back with a
+    /// SharedMemoryImageReader.
+    ///
+    /// A consumer has until the writer comes around the ring to the same
+    /// slot to read a frame. Reads that race with the writer are detected
+    /// and fail rather than returning a torn frame.
+    ///
+    /// Shared memory transport is not available on Windows, Open() always
+    /// fails there.
+    class IGNITION_SENSORS_VISIBLE SharedMemoryImageWriter
+    {
+      /// \brief Constructor
+      public: SharedMemoryImageWriter();
+
+      /// \brief Destructor. Removes the segment.
+      public: ~SharedMemoryImageWriter();
+
+      /// \brief Create the shared memory segment. A segment with the same
+      /// name left behind by a writer process that is no longer running is
+      /// replaced. Open fails if the name is taken by a running writer or
+      /// by a segment that is not an image ring.
+      /// \param[in] _name Segment name. A leading '/' is added if missing.
+      /// \param[in] _slotCount Number of frames in the ring.
+      /// \param[in] _slotSize Maximum size of a frame in bytes.
+      /// \return True if the segment was created.
+      public: bool Open(const std::string &_name, unsigned int _slotCount,
+                  std::size_t _slotSize);
+
+      /// \brief Remove the segment, unless its name now refers to a
+      /// segment created by someone else. Readers keep their mapping but
+      /// will not receive new frames.
+      public: void Close();
+
+      /// \brief Get whether the segment is open.
+      /// \return True if Open() succeeded and Close() was not called.
+      public: bool IsOpen() const;
+
+      /// \brief Get the segment name.
+      /// \return Segment name, empty if not open.
+      public: const std::string &Name() const;
+
+      /// \brief Get the number of slots in the ring.
+      /// \return Number of slots.
+      public: unsigned int SlotCount() const;
+
+      /// \brief Get the maximum size of a frame.
+      /// \return Size in bytes.
+      public: std::size_t SlotSize() const;
+
+      /// \brief Copy a frame into the next slot of the ring and fill in the
+      /// shared memory entries of its descriptor message.
+      /// \param[in] _data Frame data.
+      /// \param[in] _size Size of _data in bytes, at most SlotSize().
+      /// \param[in,out] _descriptor Message to add the header entries to.
+      /// Its data field is cleared.
+      /// \return True if the frame was written.
+      public: bool Write(const void *_data, std::size_t _size,
+                  msgs::Image &_descriptor);
+
+      /// \brief Private data pointer.
+      IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+
+    /** \class SharedMemoryImageReader SharedMemoryImage.hh \
+    ignition/sensors/SharedMemoryImage.hh
+    **/
+    /// \brief Reads image frames written by a SharedMemoryImageWriter, given
+    /// the descriptor messages published on the image topic.
+    class IGNITION_SENSORS_VISIBLE SharedMemoryImageReader
+    {
+      /// \brief Constructor
+      public: SharedMemoryImageReader();
+
+      /// \brief Destructor
+      public: ~SharedMemoryImageReader();
+
+      /// \brief Check if a message is a shared memory image descriptor.
+      /// \param[in] _msg Message received on an image topic.
+      /// \return True if the message holds shared memory entries.
+      public: static bool IsDescriptor(const msgs::Image &_msg);
+
+      /// \brief Map an existing segment read-only. Read() opens the segment
+      /// named in the descriptor itself, so calling this is only needed to
+      /// map the segment ahead of the first frame.
+      /// \param[in] _name Segment name.
+      /// \return True if the segment was mapped.
+      public: bool Open(const std::string &_name);
+
+      /// \brief Unmap the segment.
+      public: void Close();
+
+      /// \brief Copy the frame a descriptor refers to.
+      /// \param[in] _descriptor Descriptor message received on the topic.
+      /// \param[out] _image Copy of the descriptor with the frame in its
+      /// data field.
+      /// \return False if the message is not a descriptor, the segment is
+      /// missing or the frame was overwritten before it could be read.
+      public: bool Read(const msgs::Image &_descriptor, msgs::Image &_image);
+
+      /// \brief Copy the frame a descriptor refers to into a caller owned
+      /// buffer.
+      /// \param[in] _descriptor Descriptor message received on the topic.
+      /// \param[out] _data Destination buffer.
+      /// \param[in] _size Size of _data in bytes.
+      /// \return Number of bytes copied, 0 on failure or if _data is too
+      /// small.
+      public: std::size_t Read(const msgs::Image &_descriptor, void *_data,
+                  std::size_t _size);
+
+      /// \brief Private data pointer.
+      IGN_UTILS_UNIQUE_IMPL_PTR(dataPtr)
+    };
+    }
+  }
+}
+
+#endif
@@ -16,6 +16,8 @@
 */
 
 #include <mutex>
+#include <sstream>
+#include <utility>
 
 #include <ignition/msgs/image.pb.h>
 #include <ignition/msgs/annotated_axis_aligned_2d_box.pb.h>
@@ -33,6 +35,9 @@
 #include "ignition/sensors/RenderingEvents.hh"
 #include "ignition/sensors/SensorFactory.hh"
 
+#include "BoxDatasetWriter.hh"
+#include "ImageSaver.hh"
+
 using namespace ignition;
 using namespace sensors;
 
@@ -69,11 +74,15 @@ class ignition::sensors::BoundingBoxCameraSensorPrivate
   /// \brief Vector to receive boxes from the rendering camera
   public: std::vector<rendering::BoundingBox> boundingBoxes;
 
-  /// \brief RGB Image to draw boxes on it
+  /// \brief RGB Image of the rgb camera, without boxes. Boxes are drawn
+  /// on the copy in the image message.
   public: rendering::Image image;
 
-  /// \brief Buffer contains the image data to be saved
-  public: unsigned char *saveImageBuffer{nullptr};
+  /// \brief Image message with drawn boxes
+  public: msgs::Image imageMsg;
+
+  /// \brief Save policy and file format
+  public: ImageSaver::Options saveOptions;
 
   /// \brief Connection to the new BoundingBox frames data
   public: common::ConnectionPtr newBoundingBoxConnection;
@@ -102,6 +111,13 @@ class ignition::sensors::BoundingBoxCameraSensorPrivate
 
   /// \brief counter used to set the sample filename
   public: std::uint64_t saveCounter{0};
+
+  /// \brief Writer of the single boxes file, open if boxes are saved that
+  /// way instead of one CSV file per sample
+  public: BoxDatasetWriter boxesWriter;
+
+  /// \brief Boxes of the sample being saved, reused between samples
+  public: std::vector<BoxDatasetWriter::Box> saveBoxes;
 };
 
 //////////////////////////////////////////////////
@@ -113,6 +129,12 @@ BoundingBoxCameraSensor::BoundingBoxCameraSensor()
 /////////////////////////////////////////////////
 BoundingBoxCameraSensor::~BoundingBoxCameraSensor()
 {
+  // Make sure the last frames are on disk before the sensor goes away
+  if (this->dataPtr->saveSample)
+  {
+    ImageSaver::Instance().Finish(this->dataPtr->saveOptions);
+    this->dataPtr->boxesWriter.Close();
+  }
 }
 
 /////////////////////////////////////////////////
@@ -218,6 +240,7 @@ bool BoundingBoxCameraSensor::Load(const sdf::Sensor &_sdf)
 
   if (!this->AdvertiseInfo())
     return false;
+  this->LoadInfoRate(_sdf.CameraSensor());
 
   if (this->Scene())
   {
@@ -324,16 +347,43 @@ bool BoundingBoxCameraSensor::CreateCamera()
     this->dataPtr->saveBoxesFolder =
       this->dataPtr->savePath + this->dataPtr->saveBoxesFolder;
     this->dataPtr->saveSample = true;
+    this->dataPtr->saveOptions = ImageSaver::OptionsFromSdf(*sdfCamera,
+        this->Name());
 
     // Set the save counter to be equal number of images in the folder + 1
     // to continue adding to the images in the folder (multi scene datasets)
-    if (common::isDirectory(this->dataPtr->saveImageFolder))
+    this->dataPtr->saveCounter = ImageSaver::SavedCount(
+        this->dataPtr->saveImageFolder, this->dataPtr->saveOptions);
+
+    // Boxes are saved to one CSV file per sample by default, or appended
+    // to a single binary file, see BoxDatasetWriter
+    auto elem = sdfCamera->Element();
+    if (elem && elem->HasElement("ignition:save_boxes_format"))
     {
-      common::DirIter endIter;
-      for (common::DirIter dirIter(this->dataPtr->saveImageFolder);
-        dirIter != endIter; ++dirIter)
+      std::string format =
+          elem->Get<std::string>("ignition:save_boxes_format");
+      if (format == "binary")
+      {
+        auto type = this->dataPtr->type ==
+            rendering::BoundingBoxType::BBT_BOX3D ?
+            BoxDatasetWriter::Type::BOX3D : BoxDatasetWriter::Type::BOX2D;
+        if (ImageSaver::Instance().EnsureDirectory(
+            this->dataPtr->saveBoxesFolder))
+        {
+          this->dataPtr->boxesWriter.Open(
+              this->dataPtr->saveBoxesFolder + "/boxes.ignb", type);
+        }
+        if (!this->dataPtr->boxesWriter.IsOpen())
+        {
+          ignerr << "Failed to open the boxes file in ["
+                 << this->dataPtr->saveBoxesFolder
+                 << "], saving CSV files instead" << std::endl;
+        }
+      }
+      else if (format != "csv")
       {
-        this->dataPtr->saveCounter++;
+        ignerr << "Unknown <ignition:save_boxes_format> [" << format
+               << "], using csv" << std::endl;
       }
     }
   }
@@ -397,126 +447,138 @@ bool BoundingBoxCameraSensor::Update(
     return false;
   }
 
+  // Each topic only costs work while it has subscribers. The rgb camera
+  // is rendered for the image topic and for saving, the bounding box
+  // camera is always needed.
+  const bool imageConnections = this->dataPtr->imagePublisher.HasConnections();
+  const bool boxesConnections = this->dataPtr->boxesPublisher.HasConnections();
+  const bool needImage = imageConnections || this->dataPtr->saveSample;
+  this->SetSensorEnabled(this->dataPtr->rgbCamera, needImage);
+
   // The sensor updates only the bounding box camera with its pose
   // as it has the same name, so make rgb camera with the same pose
-  this->dataPtr->rgbCamera->SetWorldPose(
-    this->dataPtr->boundingboxCamera->WorldPose());
+  if (needImage)
+  {
+    this->dataPtr->rgbCamera->SetWorldPose(
+      this->dataPtr->boundingboxCamera->WorldPose());
+  }
 
-  // Render the bounding box camera
+  // Render the bounding box camera, and the rgb camera if needed
   this->Render();
 
-  // Render the rgb camera
-  this->dataPtr->rgbCamera->Copy(this->dataPtr->image);
+  if (needImage)
+    this->dataPtr->rgbCamera->Copy(this->dataPtr->image);
 
-  auto imageBuffer = this->dataPtr->image.Data<unsigned char>();
-
-  if (this->dataPtr->saveSample)
+  if (imageConnections)
   {
-    auto bufferSize = this->dataPtr->image.MemorySize();
-    if (!this->dataPtr->saveImageBuffer)
-      this->dataPtr->saveImageBuffer = new uint8_t[bufferSize];
-
-    memcpy(this->dataPtr->saveImageBuffer, imageBuffer,
-      bufferSize);
-  }
+    auto width = this->dataPtr->rgbCamera->ImageWidth();
+    auto height = this->dataPtr->rgbCamera->ImageHeight();
+    auto bufferSize = rendering::PixelUtil::MemorySize(rendering::PF_R8G8B8,
+        width, height);
+
+    // Create Image message
+    msgs::Image &imageMsg = this->dataPtr->imageMsg;
+    imageMsg.set_width(width);
+    imageMsg.set_height(height);
+    // Format
+    imageMsg.set_step(
+      width * rendering::PixelUtil::BytesPerPixel(rendering::PF_R8G8B8));
+    imageMsg.set_pixel_format_type(
+      msgs::PixelFormatType::RGB_INT8);
+    // Time stamp
+    imageMsg.mutable_header()->Clear();
+    auto stamp = imageMsg.mutable_header()->mutable_stamp();
+    *stamp = msgs::Convert(_now);
+    auto frame = imageMsg.mutable_header()->add_data();
+    frame->set_key("frame_id");
+    frame->add_value(this->Name());
+
+    // Image data, with the boxes drawn on the message's copy so that the
+    // image stays clean for saving
+    imageMsg.set_data(this->dataPtr->image.Data<unsigned char>(),
+        bufferSize);
+    auto imageBuffer =
+        reinterpret_cast<unsigned char *>(&(*imageMsg.mutable_data())[0]);
+    for (const auto &box : this->dataPtr->boundingBoxes)
+    {
+      this->dataPtr->boundingboxCamera->DrawBoundingBox(
+        imageBuffer, math::Color::Green, box);
+    }
 
-  // Draw bounding boxes
-  for (const auto &box : this->dataPtr->boundingBoxes)
-  {
-    this->dataPtr->boundingboxCamera->DrawBoundingBox(
-      imageBuffer, math::Color::Green, box);
+    // Publish
+    this->AddSequence(imageMsg.mutable_header(), "rgbImage");
+    this->dataPtr->imagePublisher.Publish(imageMsg);
   }
 
-  auto width = this->dataPtr->rgbCamera->ImageWidth();
-  auto height = this->dataPtr->rgbCamera->ImageHeight();
-
-  // Create Image message
-  msgs::Image imageMsg;
-  imageMsg.set_width(width);
-  imageMsg.set_height(height);
-  // Format
-  imageMsg.set_step(
-    width * rendering::PixelUtil::BytesPerPixel(rendering::PF_R8G8B8));
-  imageMsg.set_pixel_format_type(
-    msgs::PixelFormatType::RGB_INT8);
-  // Time stamp
-  auto stamp = imageMsg.mutable_header()->mutable_stamp();
-  *stamp = msgs::Convert(_now);
-  auto frame = imageMsg.mutable_header()->add_data();
-  frame->set_key("frame_id");
-  frame->add_value(this->Name());
-  // Image data
-  imageMsg.set_data(imageBuffer,
-      rendering::PixelUtil::MemorySize(rendering::PF_R8G8B8,
-      width, height));
-
-  // Publish
-  this->AddSequence(imageMsg.mutable_header(), "rgbImage");
-  this->dataPtr->imagePublisher.Publish(imageMsg);
-
   msgs::AnnotatedAxisAligned2DBox_V boxes2DMsg;
   msgs::AnnotatedOriented3DBox_V boxes3DMsg;
 
-  if (this->dataPtr->type == rendering::BoundingBoxType::BBT_BOX3D)
+  if (boxesConnections)
   {
-    // Create 3D boxes message
-    for (const auto &box : this->dataPtr->boundingBoxes)
+    if (this->dataPtr->type == rendering::BoundingBoxType::BBT_BOX3D)
     {
-      // box data
-      auto annotatedBox = boxes3DMsg.add_annotated_box();
-      annotatedBox->set_label(box.Label());
-
-      auto oriented3DBox = annotatedBox->mutable_box();
-      msgs::Set(oriented3DBox->mutable_center(), box.Center());
-      msgs::Set(oriented3DBox->mutable_boxsize(), box.Size());
-      msgs::Set(oriented3DBox->mutable_orientation(), box.Orientation());
+      // Create 3D boxes message
+      for (const auto &box : this->dataPtr->boundingBoxes)
+      {
+        // box data
+        auto annotatedBox = boxes3DMsg.add_annotated_box();
+        annotatedBox->set_label(box.Label());
+
+        auto oriented3DBox = annotatedBox->mutable_box();
+        msgs::Set(oriented3DBox->mutable_center(), box.Center());
+        msgs::Set(oriented3DBox->mutable_boxsize(), box.Size());
+        msgs::Set(oriented3DBox->mutable_orientation(), box.Orientation());
+      }
+      // time stamp
+      auto stampBoxes =
+        boxes3DMsg.mutable_header()->mutable_stamp();
+      *stampBoxes = msgs::Convert(_now);
+      auto frameBoxes = boxes3DMsg.mutable_header()->add_data();
+      frameBoxes->set_key("frame_id");
+      frameBoxes->add_value(this->Name());
     }
-    // time stamp
-    auto stampBoxes =
-      boxes3DMsg.mutable_header()->mutable_stamp();
-    *stampBoxes = msgs::Convert(_now);
-    auto frameBoxes = boxes3DMsg.mutable_header()->add_data();
-    frameBoxes->set_key("frame_id");
-    frameBoxes->add_value(this->Name());
-  }
-  else
-  {
-    // Create 2D boxes message
-    for (const auto &box : this->dataPtr->boundingBoxes)
+    else
     {
-      // box data
-      auto annotatedBox = boxes2DMsg.add_annotated_box();
-      annotatedBox->set_label(box.Label());
-
-      auto minCorner = box.Center() - box.Size() * 0.5;
-      auto maxCorner = box.Center() + box.Size() * 0.5;
-
-      auto axisAlignedBox = annotatedBox->mutable_box();
-      msgs::Set(axisAlignedBox->mutable_min_corner(),
-          {minCorner.X(), minCorner.Y()});
-      msgs::Set(axisAlignedBox->mutable_max_corner(),
-          {maxCorner.X(), maxCorner.Y()});
+      // Create 2D boxes message
+      for (const auto &box : this->dataPtr->boundingBoxes)
+      {
+        // box data
+        auto annotatedBox = boxes2DMsg.add_annotated_box();
+        annotatedBox->set_label(box.Label());
+
+        auto minCorner = box.Center() - box.Size() * 0.5;
+        auto maxCorner = box.Center() + box.Size() * 0.5;
+
+        auto axisAlignedBox = annotatedBox->mutable_box();
+        msgs::Set(axisAlignedBox->mutable_min_corner(),
+            {minCorner.X(), minCorner.Y()});
+        msgs::Set(axisAlignedBox->mutable_max_corner(),
+            {maxCorner.X(), maxCorner.Y()});
+      }
+      // time stamp
+      auto stampBoxes = boxes2DMsg.mutable_header()->mutable_stamp();
+      *stampBoxes = msgs::Convert(_now);
+      auto frameBoxes = boxes2DMsg.mutable_header()->add_data();
+      frameBoxes->set_key("frame_id");
+      frameBoxes->add_value(this->Name());
     }
-    // time stamp
-    auto stampBoxes = boxes2DMsg.mutable_header()->mutable_stamp();
-    *stampBoxes = msgs::Convert(_now);
-    auto frameBoxes = boxes2DMsg.mutable_header()->add_data();
-    frameBoxes->set_key("frame_id");
-    frameBoxes->add_value(this->Name());
   }
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
   // Publish
-  if (this->dataPtr->type == rendering::BoundingBoxType::BBT_BOX3D)
+  if (boxesConnections)
   {
-    this->AddSequence(boxes3DMsg.mutable_header(), "boundingboxes");
-    this->dataPtr->boxesPublisher.Publish(boxes3DMsg);
-  }
-  else
-  {
-    this->AddSequence(boxes2DMsg.mutable_header(), "boundingboxes");
-    this->dataPtr->boxesPublisher.Publish(boxes2DMsg);
+    if (this->dataPtr->type == rendering::BoundingBoxType::BBT_BOX3D)
+    {
+      this->AddSequence(boxes3DMsg.mutable_header(), "boundingboxes");
+      this->dataPtr->boxesPublisher.Publish(boxes3DMsg);
+    }
+    else
+    {
+      this->AddSequence(boxes2DMsg.mutable_header(), "boundingboxes");
+      this->dataPtr->boxesPublisher.Publish(boxes2DMsg);
+    }
   }
 
   // Save a sample (image & its bounding boxes)
@@ -545,25 +607,15 @@ unsigned int BoundingBoxCameraSensor::ImageWidth() const
 //////////////////////////////////////////////////
 void BoundingBoxCameraSensorPrivate::SaveImage()
 {
-  // Attempt to create the save directory if it doesn't exist
-  if (!common::isDirectory(this->savePath))
-  {
-    if (!common::createDirectories(this->savePath))
-    {
-      ignerr << "Failed to create directory [" << this->savePath << "]"
-             << std::endl;
-      return;
-    }
-  }
-  // Attempt to create the image directory if it doesn't exist
-  if (!common::isDirectory(this->saveImageFolder))
+  // Attempt to create the image directory if it doesn't exist, the saver
+  // only touches the filesystem the first time. A container only needs the
+  // directory it is in, which the saver creates.
+  if (this->saveOptions.container.empty() &&
+      !ImageSaver::Instance().EnsureDirectory(this->saveImageFolder))
   {
-    if (!common::createDirectories(this->saveImageFolder))
-    {
-      ignerr << "Failed to create directory [" << this->saveImageFolder << "]"
-             << std::endl;
-      return;
-    }
+    ignerr << "Failed to create directory [" << this->saveImageFolder << "]"
+           << std::endl;
+    return;
   }
 
   auto width = this->rgbCamera->ImageWidth();
@@ -571,44 +623,61 @@ void BoundingBoxCameraSensorPrivate::SaveImage()
   if (width == 0 || height == 0)
     return;
 
-  common::Image localImage;
-
   // Save the images in format of 0000001, 0000002 .. etc
   // Useful in sorting them in python
   std::stringstream ss;
   ss << std::setw(7) << std::setfill('0') << this->saveCounter;
   std::string saveCounterString = ss.str();
 
-  std::string filename = "image_" + saveCounterString + ".png";
+  std::string filename = "image_" + saveCounterString;
 
-  localImage.SetFromData(this->saveImageBuffer, width, height,
-      common::Image::RGB_INT8);
-  localImage.SavePNG(
-      common::joinPaths(this->saveImageFolder, filename));
+  // The saver copies the image, which the next frame overwrites
+  ImageSaver::Instance().Save(this->saveImageFolder, filename,
+      this->image.Data<unsigned char>(), this->image.MemorySize(), width,
+      height, common::Image::RGB_INT8, this->saveOptions);
 }
 
 //////////////////////////////////////////////////
 void BoundingBoxCameraSensorPrivate::SaveBoxes()
 {
-  // Attempt to create the save directory if it doesn't exist
-  if (!common::isDirectory(this->savePath))
+  const auto type = this->type == rendering::BoundingBoxType::BBT_BOX3D ?
+      BoxDatasetWriter::Type::BOX3D : BoxDatasetWriter::Type::BOX2D;
+  this->saveBoxes.resize(this->boundingBoxes.size());
+  for (std::size_t i = 0; i < this->boundingBoxes.size(); ++i)
   {
-    if (!common::createDirectories(this->savePath))
+    const auto &box = this->boundingBoxes[i];
+    auto &saveBox = this->saveBoxes[i];
+    saveBox.label = box.Label();
+    saveBox.values[0] = box.Center().X();
+    saveBox.values[1] = box.Center().Y();
+    if (type == BoxDatasetWriter::Type::BOX3D)
+    {
+      // x y z w h l roll pitch yaw
+      saveBox.values[2] = box.Center().Z();
+      saveBox.values[3] = box.Size().X();
+      saveBox.values[4] = box.Size().Y();
+      saveBox.values[5] = box.Size().Z();
+      saveBox.values[6] = box.Orientation().Roll();
+      saveBox.values[7] = box.Orientation().Pitch();
+      saveBox.values[8] = box.Orientation().Yaw();
+    }
+    else
     {
-      ignerr << "Failed to create directory [" << this->savePath << "]"
-             << std::endl;
-      return;
+      // x y width height
+      saveBox.values[2] = box.Size().X();
+      saveBox.values[3] = box.Size().Y();
     }
   }
-  // Attempt to create the boxes directory if it doesn't exist
-  if (!common::isDirectory(this->saveBoxesFolder))
+
+  if (this->boxesWriter.IsOpen())
   {
-    if (!common::createDirectories(this->saveBoxesFolder))
+    if (!this->boxesWriter.Append(this->saveCounter, this->saveBoxes.data(),
+        this->saveBoxes.size()))
     {
-      ignerr << "Failed to create directory [" << this->saveBoxesFolder << "]"
-             << std::endl;
-      return;
+      ignerr << "Failed to save the boxes of sample [" << this->saveCounter
+             << "] to [" << this->saveBoxesFolder << "]" << std::endl;
     }
+    return;
   }
 
   // Save the images in format of 0000001, 0000002 .. etc
@@ -617,58 +686,21 @@ void BoundingBoxCameraSensorPrivate::SaveBoxes()
   ss << std::setw(7) << std::setfill('0') << this->saveCounter;
   std::string saveCounterString = ss.str();
 
-  std::string filename = this->saveBoxesFolder + "/boxes_" +
-    saveCounterString + ".csv";
-  std::ofstream file(filename);
-
-  if (this->type == rendering::BoundingBoxType::BBT_BOX3D)
-  {
-    file << "label,x,y,z,w,h,l,roll,pitch,yaw\n";
-    for (const auto &box : this->boundingBoxes)
-    {
-      auto label = std::to_string(box.Label());
-
-      auto x = std::to_string(box.Center().X());
-      auto y = std::to_string(box.Center().Y());
-      auto z = std::to_string(box.Center().Z());
-
-      auto w = std::to_string(box.Size().X());
-      auto h = std::to_string(box.Size().Y());
-      auto l = std::to_string(box.Size().Z());
-
-      auto roll = std::to_string(box.Orientation().Roll());
-      auto pitch = std::to_string(box.Orientation().Pitch());
-      auto yaw = std::to_string(box.Orientation().Yaw());
-
-      // label x y z w h l roll pitch yaw
-      std::string sep = ",";
-      std::string boxString = label + sep + x + sep + y + sep + z + sep +
-        w + sep + h + sep + l + sep + roll + sep + pitch + sep + yaw;
-
-      file << boxString + '\n';
-    }
-  }
-  else
+  // The boxes are written by the saver, with the images
+  std::string filename = "boxes_" + saveCounterString + ".csv";
+  std::string file;
+  file.reserve(64u + this->saveBoxes.size() *
+      (type == BoxDatasetWriter::Type::BOX3D ? 128u : 64u));
+  BoxDatasetWriter::AppendCsvHeader(type, false, file);
+  BoxDatasetWriter::AppendCsv(type, this->saveBoxes.data(),
+      this->saveBoxes.size(), -1, file);
+
+  if (!ImageSaver::Instance().SaveData(this->saveBoxesFolder, filename,
+      FrameContentType::CSV, std::move(file), this->saveOptions))
   {
-    file << "label,x_center,y_center,width,height\n";
-    for (const auto &box : this->boundingBoxes)
-    {
-      auto label = std::to_string(box.Label());
-
-      auto x = std::to_string(box.Center().X());
-      auto y = std::to_string(box.Center().Y());
-      auto width = std::to_string(box.Size().X());
-      auto height = std::to_string(box.Size().Y());
-
-      // label x y width height
-      std::string sep = ",";
-      std::string boxString = label + sep +
-        x + sep + y + sep + width + sep + height;
-
-      file << boxString + '\n';
-    }
+    ignerr << "Failed to save [" << filename << "] to ["
+           << this->saveBoxesFolder << "]" << std::endl;
   }
-  file.close();
 }
 
 //////////////////////////////////////////////////
@@ -0,0 +1,394 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+#include <gz/common/Console.hh>
+
+#include "BoxDatasetWriter.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief File header magic.
+  const unsigned char kMagic[4] = {'I', 'G', 'N', 'B'};
+
+  /// \brief File layout version.
+  const std::uint32_t kVersion = 1u;
+
+  /// \brief Size of the file header: magic, version, type, reserved.
+  const std::size_t kHeaderSize = 16u;
+
+  /// \brief Size of the fixed part of a record: frame, label, reserved.
+  const std::size_t kRecordPrefixSize = 16u;
+
+  /// \brief Number of records exported at a time.
+  const std::size_t kExportRecords = 4096u;
+
+  /// \brief Append a little endian integer.
+  template <typename T>
+  void putLE(unsigned char *_out, T _value)
+  {
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      _out[i] = static_cast<unsigned char>(_value >> (8u * i));
+  }
+
+  /// \brief Read a little endian integer.
+  template <typename T>
+  T getLE(const unsigned char *_data)
+  {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(static_cast<T>(_data[i]) << (8u * i));
+    return value;
+  }
+
+  /// \brief Check a file header.
+  /// \param[in] _header kHeaderSize bytes.
+  /// \param[out] _type Box type.
+  /// \return False if this is not a dataset file.
+  bool readHeader(const unsigned char *_header,
+      BoxDatasetWriter::Type &_type)
+  {
+    if (std::memcmp(_header, kMagic, 4) != 0 ||
+        getLE<std::uint32_t>(_header + 4) != kVersion)
+    {
+      return false;
+    }
+    const std::uint32_t type = getLE<std::uint32_t>(_header + 8);
+    if (type != static_cast<std::uint32_t>(BoxDatasetWriter::Type::BOX2D) &&
+        type != static_cast<std::uint32_t>(BoxDatasetWriter::Type::BOX3D))
+    {
+      return false;
+    }
+    _type = static_cast<BoxDatasetWriter::Type>(type);
+    return true;
+  }
+
+  /// \brief Append an unsigned integer in decimal.
+  /// \param[in] _value Value.
+  /// \param[in,out] _out Text to append to.
+  void appendUnsigned(std::uint64_t _value, std::string &_out)
+  {
+    char digits[20];
+    std::size_t count = 0u;
+    do
+    {
+      digits[count++] = static_cast<char>('0' + _value % 10u);
+      _value /= 10u;
+    }
+    while (_value > 0u);
+    while (count > 0u)
+      _out.push_back(digits[--count]);
+  }
+
+  /// \brief Append a value with six decimals, the std::to_string format.
+  /// \param[in] _value Value.
+  /// \param[in,out] _out Text to append to.
+  void appendFixed(double _value, std::string &_out)
+  {
+    const double magnitude = std::fabs(_value);
+    if (!(magnitude < 1e15))
+    {
+      // Huge, infinite and NaN values are rare, printf handles them. Large
+      // enough for any double in %f, which has up to 309 integer digits.
+      char text[328];
+      const int length = std::snprintf(text, sizeof(text), "%f", _value);
+      if (length > 0)
+        _out.append(text, static_cast<std::size_t>(length));
+      return;
+    }
+
+    // The integer part and the fraction are exact. The fraction is scaled
+    // to millionths, with the rounding error of the product recovered by
+    // fma, so that rounding to the nearest millionth, ties to even, matches
+    // printf exactly.
+    const double integer = std::floor(magnitude);
+    const double fraction = magnitude - integer;
+    const double scaled = fraction * 1e6;
+    const double error = std::fma(fraction, 1e6, -scaled);
+    const double below = std::floor(scaled);
+    std::uint64_t millionths = static_cast<std::uint64_t>(below);
+    // excess is finite, so being neither above nor below zero is a tie
+    const double excess = (scaled - below - 0.5) + error;
+    if (excess > 0.0 || (!(excess < 0.0) && (millionths & 1u)))
+      ++millionths;
+    std::uint64_t units = static_cast<std::uint64_t>(integer);
+    if (millionths == 1000000u)
+    {
+      millionths = 0u;
+      ++units;
+    }
+
+    if (std::signbit(_value))
+      _out.push_back('-');
+    appendUnsigned(units, _out);
+    char digits[7] = {'.', '0', '0', '0', '0', '0', '0'};
+    for (std::size_t i = 6u; i > 0u; --i)
+    {
+      digits[i] = static_cast<char>('0' + millionths % 10u);
+      millionths /= 10u;
+    }
+    _out.append(digits, sizeof(digits));
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t BoxDatasetWriter::ValueCount(Type _type)
+{
+  return _type == Type::BOX3D ? 9u : 4u;
+}
+
+//////////////////////////////////////////////////
+std::size_t BoxDatasetWriter::RecordSize(Type _type)
+{
+  return kRecordPrefixSize + ValueCount(_type) * sizeof(double);
+}
+
+//////////////////////////////////////////////////
+void BoxDatasetWriter::AppendCsvHeader(Type _type, bool _frame,
+    std::string &_out)
+{
+  if (_frame)
+    _out += "frame,";
+  if (_type == Type::BOX3D)
+    _out += "label,x,y,z,w,h,l,roll,pitch,yaw\n";
+  else
+    _out += "label,x_center,y_center,width,height\n";
+}
+
+//////////////////////////////////////////////////
+void BoxDatasetWriter::AppendCsv(Type _type, const Box *_boxes,
+    std::size_t _count, std::int64_t _frame, std::string &_out)
+{
+  const std::size_t values = ValueCount(_type);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    if (_frame >= 0)
+    {
+      appendUnsigned(static_cast<std::uint64_t>(_frame), _out);
+      _out.push_back(',');
+    }
+    appendUnsigned(_boxes[i].label, _out);
+    for (std::size_t v = 0; v < values; ++v)
+    {
+      _out.push_back(',');
+      appendFixed(_boxes[i].values[v], _out);
+    }
+    _out.push_back('\n');
+  }
+}
+
+//////////////////////////////////////////////////
+bool BoxDatasetWriter::ExportCsv(const std::string &_path,
+    const std::string &_csvPath)
+{
+  std::ifstream in(_path, std::ios::binary);
+  unsigned char header[kHeaderSize];
+  Type type;
+  if (!in.read(reinterpret_cast<char *>(header), kHeaderSize) ||
+      !readHeader(header, type))
+  {
+    ignerr << "Not a bounding box dataset [" << _path << "]" << std::endl;
+    return false;
+  }
+
+  std::ofstream out(_csvPath, std::ios::binary | std::ios::trunc);
+  if (!out)
+  {
+    ignerr << "Failed to open [" << _csvPath << "]" << std::endl;
+    return false;
+  }
+
+  // Records are read and formatted in blocks, through one text buffer
+  const std::size_t recordSize = RecordSize(type);
+  const std::size_t values = ValueCount(type);
+  std::vector<unsigned char> records(recordSize * kExportRecords);
+  std::vector<Box> boxes(kExportRecords);
+  std::string text;
+  AppendCsvHeader(type, true, text);
+  while (in)
+  {
+    in.read(reinterpret_cast<char *>(records.data()),
+        static_cast<std::streamsize>(records.size()));
+    // A trailing incomplete record, from a crash, is skipped
+    const std::size_t count =
+        static_cast<std::size_t>(in.gcount()) / recordSize;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const unsigned char *record = records.data() + i * recordSize;
+      const std::uint64_t frame = getLE<std::uint64_t>(record);
+      boxes[i].label = getLE<std::uint32_t>(record + 8);
+      for (std::size_t v = 0; v < values; ++v)
+      {
+        const std::uint64_t bits = getLE<std::uint64_t>(
+            record + kRecordPrefixSize + v * sizeof(double));
+        std::memcpy(&boxes[i].values[v], &bits, sizeof(double));
+      }
+      AppendCsv(type, &boxes[i], 1u, static_cast<std::int64_t>(frame),
+          text);
+    }
+    out.write(text.data(), static_cast<std::streamsize>(text.size()));
+    text.clear();
+  }
+
+  if (!out)
+  {
+    ignerr << "Failed to write [" << _csvPath << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+BoxDatasetWriter::~BoxDatasetWriter()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool BoxDatasetWriter::Open(const std::string &_path, Type _type)
+{
+  this->Close();
+  this->type = _type;
+
+  // Append to a dataset of the same type, after its last complete record.
+  // Any other file is left alone rather than replaced.
+  std::uint64_t end = 0u;
+  {
+    std::ifstream existing(_path, std::ios::binary | std::ios::ate);
+    unsigned char header[kHeaderSize];
+    Type existingType;
+    const std::streamoff size =
+        existing ? static_cast<std::streamoff>(existing.tellg()) : 0;
+    if (size > 0)
+    {
+      existing.seekg(0);
+      if (size < static_cast<std::streamoff>(kHeaderSize) ||
+          !existing.read(reinterpret_cast<char *>(header), kHeaderSize) ||
+          !readHeader(header, existingType))
+      {
+        ignerr << "[" << _path << "] exists and is not a bounding box "
+               << "dataset, not overwriting it." << std::endl;
+        return false;
+      }
+      if (existingType != _type)
+      {
+        ignerr << "Bounding box dataset [" << _path << "] holds "
+               << static_cast<int>(existingType) << "D boxes, not "
+               << static_cast<int>(_type) << "D boxes." << std::endl;
+        return false;
+      }
+      const std::uint64_t records =
+          (static_cast<std::uint64_t>(size) - kHeaderSize) /
+          RecordSize(_type);
+      end = kHeaderSize + records * RecordSize(_type);
+    }
+  }
+
+  if (end > 0u)
+  {
+    this->file.open(_path,
+        std::ios::binary | std::ios::in | std::ios::out);
+    this->file.seekp(static_cast<std::streamoff>(end));
+  }
+  else
+  {
+    this->file.open(_path,
+        std::ios::binary | std::ios::out | std::ios::trunc);
+    unsigned char header[kHeaderSize] = {};
+    std::memcpy(header, kMagic, 4);
+    putLE<std::uint32_t>(header + 4, kVersion);
+    putLE<std::uint32_t>(header + 8, static_cast<std::uint32_t>(_type));
+    this->file.write(reinterpret_cast<const char *>(header), kHeaderSize);
+  }
+
+  if (!this->file)
+  {
+    ignerr << "Failed to open bounding box dataset [" << _path << "]"
+           << std::endl;
+    this->file.close();
+    return false;
+  }
+  this->buffer.reserve(kBufferSize + RecordSize(_type));
+  return true;
+}
+
+//////////////////////////////////////////////////
+void BoxDatasetWriter::Close()
+{
+  if (!this->file.is_open())
+    return;
+  this->Flush();
+  this->file.close();
+}
+
+//////////////////////////////////////////////////
+bool BoxDatasetWriter::IsOpen() const
+{
+  return this->file.is_open();
+}
+
+//////////////////////////////////////////////////
+bool BoxDatasetWriter::Append(std::uint64_t _frame, const Box *_boxes,
+    std::size_t _count)
+{
+  if (!this->file.is_open())
+    return false;
+
+  const std::size_t recordSize = RecordSize(this->type);
+  const std::size_t values = ValueCount(this->type);
+  for (std::size_t i = 0; i < _count; ++i)
+  {
+    const std::size_t offset = this->buffer.size();
+    this->buffer.resize(offset + recordSize);
+    unsigned char *record = this->buffer.data() + offset;
+    putLE<std::uint64_t>(record, _frame);
+    putLE<std::uint32_t>(record + 8, _boxes[i].label);
+    putLE<std::uint32_t>(record + 12, 0u);
+    for (std::size_t v = 0; v < values; ++v)
+    {
+      std::uint64_t bits;
+      std::memcpy(&bits, &_boxes[i].values[v], sizeof(double));
+      putLE<std::uint64_t>(record + kRecordPrefixSize + v * sizeof(double),
+          bits);
+    }
+
+    if (this->buffer.size() >= kBufferSize && !this->Flush())
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool BoxDatasetWriter::Flush()
+{
+  if (!this->file.is_open())
+    return false;
+  if (!this->buffer.empty())
+  {
+    this->file.write(reinterpret_cast<const char *>(this->buffer.data()),
+        static_cast<std::streamsize>(this->buffer.size()));
+    this->buffer.clear();
+  }
+  this->file.flush();
+  return static_cast<bool>(this->file);
+}
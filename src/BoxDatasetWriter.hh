@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_BOXDATASETWRITER_HH_
+#define GZ_SENSORS_BOXDATASETWRITER_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define BoxDatasetWriter_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define BoxDatasetWriter_EXPORTS_API __declspec(dllexport)
+#  else
+#    define BoxDatasetWriter_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Appends the bounding boxes a BoundingBoxCameraSensor saves to
+    /// one file, instead of one CSV file per frame, and formats boxes as
+    /// CSV for the sensor's CSV files and for exporting such a file.
+    ///
+    /// The file starts with a 16 byte header, "IGNB", a version, the box
+    /// type and a reserved word, followed by fixed size records: the frame
+    /// number (8 bytes), the label (4 bytes), 4 reserved bytes and
+    /// ValueCount() doubles. Integers and doubles are little endian. Records
+    /// are buffered in memory and written in large blocks.
+    class BoxDatasetWriter_EXPORTS_API BoxDatasetWriter
+    {
+      /// \brief Box types.
+      public: enum class Type : std::uint32_t
+      {
+        /// \brief 2D boxes: x_center, y_center, width, height.
+        BOX2D = 2,
+
+        /// \brief 3D boxes: x, y, z, w, h, l, roll, pitch, yaw.
+        BOX3D = 3
+      };
+
+      /// \brief A box, with its values in the order of the CSV columns.
+      public: struct Box
+      {
+        /// \brief Label.
+        std::uint32_t label = 0u;
+
+        /// \brief Values, ValueCount() of them are used.
+        double values[9] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+      };
+
+      /// \brief Size of the buffer, records are written once it holds
+      /// this many bytes.
+      public: static constexpr std::size_t kBufferSize = 1u << 18u;
+
+      /// \brief Get the number of values of a box type.
+      /// \param[in] _type Box type.
+      /// \return 4 or 9.
+      public: static std::size_t ValueCount(Type _type);
+
+      /// \brief Get the size of the records of a box type.
+      /// \param[in] _type Box type.
+      /// \return Record size in bytes.
+      public: static std::size_t RecordSize(Type _type);
+
+      /// \brief Append the CSV header line of a box type.
+      /// \param[in] _type Box type.
+      /// \param[in] _frame True to start with a frame column.
+      /// \param[in,out] _out Text to append to.
+      public: static void AppendCsvHeader(Type _type, bool _frame,
+          std::string &_out);
+
+      /// \brief Append boxes as CSV lines. Labels are integers and values
+      /// have six decimals, as with std::to_string, but are formatted in
+      /// place without a temporary string per value.
+      /// \param[in] _type Box type.
+      /// \param[in] _boxes Boxes.
+      /// \param[in] _count Number of boxes.
+      /// \param[in] _frame Frame number to start each line with, negative
+      /// for none.
+      /// \param[in,out] _out Text to append to.
+      public: static void AppendCsv(Type _type, const Box *_boxes,
+          std::size_t _count, std::int64_t _frame, std::string &_out);
+
+      /// \brief Convert a file written by a BoxDatasetWriter to a single
+      /// CSV file, with a frame column in front of the box columns.
+      /// \param[in] _path Dataset file path.
+      /// \param[in] _csvPath CSV file path, replaced if it exists.
+      /// \return False if the dataset can not be read or the CSV file can
+      /// not be written.
+      public: static bool ExportCsv(const std::string &_path,
+          const std::string &_csvPath);
+
+      /// \brief Destructor. Closes the file.
+      public: ~BoxDatasetWriter();
+
+      /// \brief Open a dataset file. An existing dataset of the same box
+      /// type is appended to, after its last complete record. Other
+      /// non empty files at _path are not modified and Open fails.
+      /// \param[in] _path File path.
+      /// \param[in] _type Box type.
+      /// \return True if the file is open.
+      public: bool Open(const std::string &_path, Type _type);
+
+      /// \brief Write the buffered records and close the file.
+      public: void Close();
+
+      /// \brief Check whether a file is open.
+      /// \return True if open.
+      public: bool IsOpen() const;
+
+      /// \brief Append the boxes of a frame. The records are written once
+      /// the buffer is full, or by Flush() and Close().
+      /// \param[in] _frame Frame number.
+      /// \param[in] _boxes Boxes.
+      /// \param[in] _count Number of boxes.
+      /// \return False if the file is not open or a write failed.
+      public: bool Append(std::uint64_t _frame, const Box *_boxes,
+          std::size_t _count);
+
+      /// \brief Write the buffered records.
+      /// \return False if the write failed.
+      public: bool Flush();
+
+      /// \brief Box type.
+      private: Type type = Type::BOX2D;
+
+      /// \brief Output file.
+      private: std::fstream file;
+
+      /// \brief Records not written yet.
+      private: std::vector<unsigned char> buffer;
+    };
+    }
+  }
+}
+
+#endif
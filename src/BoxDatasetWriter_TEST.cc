@@ -0,0 +1,252 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "BoxDatasetWriter.hh"
+#include "test_config.h"  // NOLINT(build/include)
+
+using namespace gz;
+using namespace sensors;
+
+using Box = BoxDatasetWriter::Box;
+using Type = BoxDatasetWriter::Type;
+
+/// \brief Get the path of a file in the build directory.
+/// \param[in] _name File name.
+/// \return Path, with any previous file removed.
+static std::string filePath(const std::string &_name)
+{
+  std::string path = std::string(PROJECT_BUILD_PATH) + "/" + _name;
+  std::remove(path.c_str());
+  return path;
+}
+
+/// \brief Read a whole file.
+/// \param[in] _path File path.
+/// \return Contents.
+static std::string readFile(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+}
+
+/// \brief Make a 2D box.
+static Box box2d(std::uint32_t _label, double _x, double _y, double _w,
+    double _h)
+{
+  Box box;
+  box.label = _label;
+  box.values[0] = _x;
+  box.values[1] = _y;
+  box.values[2] = _w;
+  box.values[3] = _h;
+  return box;
+}
+
+//////////////////////////////////////////////////
+TEST(BoxDatasetWriter_TEST, Csv)
+{
+  // Values are formatted as std::to_string formats them
+  Box box;
+  box.label = 42u;
+  const double values[9] = {1.5, -0.25, 1e-7, 123456.789, 0.0, -3.0000005,
+      2.5e10, 1.0 / 3.0, -1e-9};
+  std::string expected = "42";
+  for (unsigned int i = 0; i < 9u; ++i)
+  {
+    box.values[i] = values[i];
+    expected += "," + std::to_string(values[i]);
+  }
+  expected += "\n";
+
+  std::string text;
+  BoxDatasetWriter::AppendCsv(Type::BOX3D, &box, 1u, -1, text);
+  EXPECT_EQ(expected, text);
+
+  text.clear();
+  BoxDatasetWriter::AppendCsvHeader(Type::BOX2D, false, text);
+  const Box boxes[2] = {box2d(0u, 1.0, 2.0, 3.0, 4.0),
+      box2d(7u, 0.5, 0.25, 10.0, 20.0)};
+  BoxDatasetWriter::AppendCsv(Type::BOX2D, boxes, 2u, 12, text);
+  EXPECT_EQ("label,x_center,y_center,width,height\n"
+      "12,0,1.000000,2.000000,3.000000,4.000000\n"
+      "12,7,0.500000,0.250000,10.000000,20.000000\n", text);
+
+  // Rounding matches on values of every magnitude, halfway values and
+  // values outside the fast path
+  std::vector<double> tricky = {0.0078125, 0.0234375, -0.0078125,
+      0.0000005, 0.9999995, 0.99999949999999, 999999.9999995, -0.0, 1e15,
+      -2.5e300, 4503599627370495.5, 1e-320};
+  std::uint64_t state = 12345u;
+  for (int i = 0; i < 20000; ++i)
+  {
+    state = state * 6364136223846793005u + 1442695040888963407u;
+    const double mantissa =
+        static_cast<double>(state >> 11u) / 9007199254740992.0;
+    tricky.push_back((i % 2 ? -1.0 : 1.0) * mantissa *
+        std::pow(10.0, i % 20 - 8));
+    tricky.push_back((state >> 40u) / 128.0);
+  }
+  for (double value : tricky)
+  {
+    box.values[0] = value;
+    text.clear();
+    BoxDatasetWriter::AppendCsv(Type::BOX2D, &box, 1u, -1, text);
+    EXPECT_EQ("42," + std::to_string(value) + ",", text.substr(0,
+        text.find(',', 3u) + 1u)) << value;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(BoxDatasetWriter_TEST, RoundingBoundaries)
+{
+  // Values next to a half millionth, on both sides, and exact ties, which
+  // are the odd multiples of 1/128 and round to even
+  std::vector<double> values;
+  for (double value : {0.0000005, 2.5e-7, 7.5e-7, 0.0000015, 0.0000025,
+      0.0000035, 0.9999995, 1.0000005, 123.4567895, 0.0078125, 0.0234375,
+      0.0390625, 0.9921875, 1.0078125, 99.5078125})
+  {
+    values.push_back(value);
+    values.push_back(std::nextafter(value, 0.0));
+    values.push_back(std::nextafter(value, 1e300));
+    values.push_back(-value);
+  }
+
+  Box box;
+  box.label = 1u;
+  std::string text;
+  for (double value : values)
+  {
+    box.values[0] = value;
+    text.clear();
+    BoxDatasetWriter::AppendCsv(Type::BOX2D, &box, 1u, -1, text);
+    EXPECT_EQ("1," + std::to_string(value) + ",", text.substr(0,
+        text.find(',', 2u) + 1u)) << value;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(BoxDatasetWriter_TEST, WriteExport)
+{
+  const std::string path = filePath("box_dataset.ignb");
+  const std::string csvPath = filePath("box_dataset.csv");
+
+  BoxDatasetWriter writer;
+  const Box first = box2d(1u, 10.0, 20.0, 4.0, 8.0);
+  EXPECT_FALSE(writer.Append(0u, &first, 1u));
+  ASSERT_TRUE(writer.Open(path, Type::BOX2D));
+  EXPECT_TRUE(writer.IsOpen());
+  EXPECT_TRUE(writer.Append(0u, &first, 1u));
+
+  // Enough frames to fill the buffer more than once
+  const std::size_t frames = 2u * BoxDatasetWriter::kBufferSize /
+      BoxDatasetWriter::RecordSize(Type::BOX2D);
+  for (std::size_t f = 1u; f <= frames; ++f)
+  {
+    const Box boxes[2] = {box2d(2u, f, 0.5, 1.0, 1.0),
+        box2d(3u, 0.0, f, 2.0, 2.0)};
+    ASSERT_TRUE(writer.Append(f, boxes, 2u));
+  }
+  writer.Close();
+  EXPECT_FALSE(writer.IsOpen());
+
+  EXPECT_EQ(16u + (1u + 2u * frames) *
+      BoxDatasetWriter::RecordSize(Type::BOX2D), readFile(path).size());
+
+  // Reopening appends
+  ASSERT_TRUE(writer.Open(path, Type::BOX2D));
+  const Box last = box2d(9u, 1.0, 1.0, 1.0, 1.0);
+  EXPECT_TRUE(writer.Append(frames + 1u, &last, 1u));
+  writer.Close();
+
+  ASSERT_TRUE(BoxDatasetWriter::ExportCsv(path, csvPath));
+  std::string expected;
+  BoxDatasetWriter::AppendCsvHeader(Type::BOX2D, true, expected);
+  BoxDatasetWriter::AppendCsv(Type::BOX2D, &first, 1u, 0, expected);
+  for (std::size_t f = 1u; f <= frames; ++f)
+  {
+    const Box boxes[2] = {box2d(2u, f, 0.5, 1.0, 1.0),
+        box2d(3u, 0.0, f, 2.0, 2.0)};
+    BoxDatasetWriter::AppendCsv(Type::BOX2D, boxes, 2u,
+        static_cast<std::int64_t>(f), expected);
+  }
+  BoxDatasetWriter::AppendCsv(Type::BOX2D, &last, 1u,
+      static_cast<std::int64_t>(frames + 1u), expected);
+  EXPECT_EQ(expected, readFile(csvPath));
+
+  // A dataset of another type, or a file that is not a dataset, is not
+  // replaced
+  const std::string dataset = readFile(path);
+  EXPECT_FALSE(writer.Open(path, Type::BOX3D));
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_EQ(dataset, readFile(path));
+
+  const std::string csv = readFile(csvPath);
+  EXPECT_FALSE(writer.Open(csvPath, Type::BOX2D));
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_EQ(csv, readFile(csvPath));
+
+  EXPECT_FALSE(BoxDatasetWriter::ExportCsv(csvPath, path));
+}
+
+//////////////////////////////////////////////////
+TEST(BoxDatasetWriter_TEST, IncompleteRecord)
+{
+  const std::string path = filePath("box_dataset_crash.ignb");
+  const std::string csvPath = filePath("box_dataset_crash.csv");
+
+  BoxDatasetWriter writer;
+  ASSERT_TRUE(writer.Open(path, Type::BOX3D));
+  Box box;
+  box.label = 5u;
+  box.values[8] = 0.5;
+  EXPECT_TRUE(writer.Append(3u, &box, 1u));
+  writer.Close();
+
+  // Half a record, as left by a crash, is ignored and then overwritten
+  {
+    std::ofstream file(path, std::ios::binary | std::ios::app);
+    file.write("abcdefghijklmnopqrstuvwxyz", 26);
+  }
+  ASSERT_TRUE(BoxDatasetWriter::ExportCsv(path, csvPath));
+  EXPECT_EQ("frame,label,x,y,z,w,h,l,roll,pitch,yaw\n"
+      "3,5,0.000000,0.000000,0.000000,0.000000,0.000000,0.000000,"
+      "0.000000,0.000000,0.500000\n", readFile(csvPath));
+
+  ASSERT_TRUE(writer.Open(path, Type::BOX3D));
+  EXPECT_TRUE(writer.Append(4u, &box, 1u));
+  writer.Close();
+  EXPECT_EQ(16u + 2u * BoxDatasetWriter::RecordSize(Type::BOX3D),
+      readFile(path).size());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
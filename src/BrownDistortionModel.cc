@@ -22,10 +22,19 @@
 
 #include "ignition/sensors/BrownDistortionModel.hh"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <mutex>
+
 #include <ignition/common/Console.hh>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Rand.hh>
 
+#include "ImageRemap.hh"
+#include "ParallelRows.hh"
+
 using namespace ignition;
 using namespace sensors;
 
@@ -48,8 +57,154 @@ class ignition::sensors::BrownDistortionModel::Implementation
 
   /// \brief The distortion center.
   public: math::Vector2d lensCenter = {0.5, 0.5};
+
+  /// \brief Cached remap tables.
+  public: struct TableCache
+  {
+    /// \brief A table and what it was built for.
+    struct Entry
+    {
+      /// \brief True for an undistortion table.
+      bool undistort;
+
+      /// \brief Horizontal focal length.
+      double fx;
+
+      /// \brief Vertical focal length.
+      double fy;
+
+      /// \brief The table, which also holds the image size.
+      std::shared_ptr<const RemapTable> table;
+    };
+
+    /// \brief Protects entries.
+    std::mutex mutex;
+
+    /// \brief Tables, most recently built last.
+    std::vector<Entry> entries;
+  };
+
+  /// \brief Maximum number of cached tables.
+  public: static constexpr std::size_t kMaxTables = 4u;
+
+  /// \brief Cached remap tables. Not copied with the model, a copy that
+  /// is loaded again gets its own cache.
+  public: std::shared_ptr<TableCache> cache = std::make_shared<TableCache>();
+
+  /// \brief Get a table, building it if it is not cached.
+  /// \param[in] _undistort True for an undistortion table.
+  /// \param[in] _width Image width.
+  /// \param[in] _height Image height.
+  /// \param[in] _fx Horizontal focal length.
+  /// \param[in] _fy Vertical focal length.
+  /// \return The table, null for an empty image.
+  public: std::shared_ptr<const RemapTable> Table(bool _undistort,
+      unsigned int _width, unsigned int _height, double _fx, double _fy)
+      const;
+
+  /// \brief Distort a point in normalized coordinates.
+  /// \param[in,out] _x X coordinate.
+  /// \param[in,out] _y Y coordinate.
+  public: void Distort(double &_x, double &_y) const;
+
+  /// \brief Undistort a point in normalized coordinates.
+  /// \param[in,out] _x X coordinate.
+  /// \param[in,out] _y Y coordinate.
+  /// \param[in] _tolerance Largest error of the result.
+  /// \return False if the iteration does not converge, in which case the
+  /// point is left unchanged.
+  public: bool Undistort(double &_x, double &_y, double _tolerance) const;
 };
 
+//////////////////////////////////////////////////
+void BrownDistortionModel::Implementation::Distort(double &_x, double &_y)
+    const
+{
+  const double x = _x;
+  const double y = _y;
+  const double r2 = x * x + y * y;
+  const double radial = 1.0 + r2 * (this->k1 + r2 * (this->k2 + r2 * this->k3));
+  _x = x * radial + 2.0 * this->p1 * x * y + this->p2 * (r2 + 2.0 * x * x);
+  _y = y * radial + this->p1 * (r2 + 2.0 * y * y) + 2.0 * this->p2 * x * y;
+}
+
+//////////////////////////////////////////////////
+bool BrownDistortionModel::Implementation::Undistort(double &_x, double &_y,
+    double _tolerance) const
+{
+  // A fixed number of iterations and no early exit, so that loops over
+  // points vectorize
+  double x = _x;
+  double y = _y;
+  for (int i = 0; i < 20; ++i)
+  {
+    const double r2 = x * x + y * y;
+    const double radial =
+        1.0 + r2 * (this->k1 + r2 * (this->k2 + r2 * this->k3));
+    const double dx = 2.0 * this->p1 * x * y + this->p2 * (r2 + 2.0 * x * x);
+    const double dy = this->p1 * (r2 + 2.0 * y * y) + 2.0 * this->p2 * x * y;
+    x = (_x - dx) / radial;
+    y = (_y - dy) / radial;
+  }
+
+  // Check the result by distorting it again
+  double xd = x;
+  double yd = y;
+  this->Distort(xd, yd);
+  if (!(std::abs(xd - _x) < _tolerance && std::abs(yd - _y) < _tolerance))
+    return false;
+
+  _x = x;
+  _y = y;
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const BrownDistortionModel::RemapTable>
+BrownDistortionModel::Implementation::Table(bool _undistort,
+    unsigned int _width, unsigned int _height, double _fx, double _fy) const
+{
+  if (_width == 0u || _height == 0u)
+    return nullptr;
+
+  std::lock_guard<std::mutex> lock(this->cache->mutex);
+  auto &entries = this->cache->entries;
+  for (const auto &entry : entries)
+  {
+    if (entry.undistort == _undistort && entry.fx == _fx &&
+        entry.fy == _fy && entry.table->width == _width &&
+        entry.table->height == _height)
+    {
+      return entry.table;
+    }
+  }
+
+  // Distortion tables sample the undistorted image where the lens maps
+  // each distorted pixel from, undistortion tables the other way around
+  const double cu = this->lensCenter.X() * _width - 0.5;
+  const double cv = this->lensCenter.Y() * _height - 0.5;
+  const double tolerance = 0.01 / std::max(_fx, _fy);
+  auto table = std::make_shared<RemapTable>();
+  ImageRemap::Build(_width, _height,
+      [&](double _u, double _v, double &_srcU, double &_srcV)
+      {
+        double x = (_u - cu) / _fx;
+        double y = (_v - cv) / _fy;
+        if (_undistort)
+          this->Distort(x, y);
+        else if (!this->Undistort(x, y, tolerance))
+          return false;
+        _srcU = x * _fx + cu;
+        _srcV = y * _fy + cv;
+        return true;
+      }, *table);
+
+  if (entries.size() >= kMaxTables)
+    entries.erase(entries.begin());
+  entries.push_back({_undistort, _fx, _fy, table});
+  return table;
+}
+
 //////////////////////////////////////////////////
 BrownDistortionModel::BrownDistortionModel()
   : Distortion(DistortionType::BROWN),
@@ -73,6 +228,7 @@ void BrownDistortionModel::Load(const sdf::Camera &_sdf)
   this->dataPtr->p1 = _sdf.DistortionP1();
   this->dataPtr->p2 = _sdf.DistortionP2();
   this->dataPtr->lensCenter = _sdf.DistortionCenter();
+  this->dataPtr->cache = std::make_shared<Implementation::TableCache>();
 }
 
 //////////////////////////////////////////////////
@@ -111,6 +267,120 @@ math::Vector2d BrownDistortionModel::Center() const
   return this->dataPtr->lensCenter;
 }
 
+//////////////////////////////////////////////////
+std::shared_ptr<const BrownDistortionModel::RemapTable>
+BrownDistortionModel::DistortionTable(unsigned int _width,
+    unsigned int _height, double _fx, double _fy) const
+{
+  return this->dataPtr->Table(false, _width, _height, _fx, _fy);
+}
+
+//////////////////////////////////////////////////
+std::shared_ptr<const BrownDistortionModel::RemapTable>
+BrownDistortionModel::UndistortionTable(unsigned int _width,
+    unsigned int _height, double _fx, double _fy) const
+{
+  return this->dataPtr->Table(true, _width, _height, _fx, _fy);
+}
+
+//////////////////////////////////////////////////
+bool BrownDistortionModel::Distort(const unsigned char *_src,
+    unsigned int _width, unsigned int _height, unsigned int _channels,
+    unsigned int _bytesPerChannel, double _fx, double _fy,
+    unsigned char *_dst, Interpolation _interpolation) const
+{
+  auto table = this->DistortionTable(_width, _height, _fx, _fy);
+  if (!table)
+    return false;
+  if (_interpolation == Interpolation::NEAREST)
+  {
+    return ImageRemap::ApplyNearest(*table, _src,
+        _channels * _bytesPerChannel, _dst);
+  }
+  return ImageRemap::Apply(*table, _src, _channels, _bytesPerChannel, _dst);
+}
+
+//////////////////////////////////////////////////
+bool BrownDistortionModel::Undistort(const unsigned char *_src,
+    unsigned int _width, unsigned int _height, unsigned int _channels,
+    unsigned int _bytesPerChannel, double _fx, double _fy,
+    unsigned char *_dst, Interpolation _interpolation) const
+{
+  auto table = this->UndistortionTable(_width, _height, _fx, _fy);
+  if (!table)
+    return false;
+  if (_interpolation == Interpolation::NEAREST)
+  {
+    return ImageRemap::ApplyNearest(*table, _src,
+        _channels * _bytesPerChannel, _dst);
+  }
+  return ImageRemap::Apply(*table, _src, _channels, _bytesPerChannel, _dst);
+}
+
+//////////////////////////////////////////////////
+void BrownDistortionModel::Distort(std::vector<math::Vector2d> &_points,
+    unsigned int _width, unsigned int _height, double _fx, double _fy) const
+{
+  const double cu = this->dataPtr->lensCenter.X() * _width - 0.5;
+  const double cv = this->dataPtr->lensCenter.Y() * _height - 0.5;
+  const Implementation &d = *this->dataPtr;
+
+  // Chunks of points stand in for rows
+  const unsigned int chunk = 1024u;
+  const unsigned int chunks =
+      static_cast<unsigned int>((_points.size() + chunk - 1u) / chunk);
+  ParallelRows::Instance().Run(chunks,
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        const std::size_t last =
+            std::min<std::size_t>(_points.size(), _end * std::size_t(chunk));
+        for (std::size_t i = _begin * std::size_t(chunk); i < last; ++i)
+        {
+          double x = (_points[i].X() - cu) / _fx;
+          double y = (_points[i].Y() - cv) / _fy;
+          d.Distort(x, y);
+          _points[i].Set(x * _fx + cu, y * _fy + cv);
+        }
+      }, 4u);
+}
+
+//////////////////////////////////////////////////
+bool BrownDistortionModel::Undistort(std::vector<math::Vector2d> &_points,
+    unsigned int _width, unsigned int _height, double _fx, double _fy) const
+{
+  const double cu = this->dataPtr->lensCenter.X() * _width - 0.5;
+  const double cv = this->dataPtr->lensCenter.Y() * _height - 0.5;
+  const double tolerance = 0.01 / std::max(_fx, _fy);
+  const Implementation &d = *this->dataPtr;
+  std::atomic<bool> converged{true};
+
+  const unsigned int chunk = 1024u;
+  const unsigned int chunks =
+      static_cast<unsigned int>((_points.size() + chunk - 1u) / chunk);
+  ParallelRows::Instance().Run(chunks,
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        const std::size_t last =
+            std::min<std::size_t>(_points.size(), _end * std::size_t(chunk));
+        for (std::size_t i = _begin * std::size_t(chunk); i < last; ++i)
+        {
+          double x = (_points[i].X() - cu) / _fx;
+          double y = (_points[i].Y() - cv) / _fy;
+          if (d.Undistort(x, y, tolerance))
+          {
+            _points[i].Set(x * _fx + cu, y * _fy + cv);
+          }
+          else
+          {
+            _points[i].Set(std::numeric_limits<double>::quiet_NaN(),
+                std::numeric_limits<double>::quiet_NaN());
+            converged = false;
+          }
+        }
+      }, 4u);
+  return converged;
+}
+
 //////////////////////////////////////////////////
 void BrownDistortionModel::Print(std::ostream &_out) const
 {
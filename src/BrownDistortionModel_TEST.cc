@@ -0,0 +1,186 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+
+#include <sdf/sdf.hh>
+
+#include "gz/sensors/BrownDistortionModel.hh"
+
+using namespace gz;
+using namespace sensors;
+
+/// \brief Image width used by the tests.
+static const unsigned int kWidth = 160u;
+
+/// \brief Image height used by the tests.
+static const unsigned int kHeight = 120u;
+
+/// \brief Focal length used by the tests, about a 90 degree field of view.
+static const double kFocal = 80.0;
+
+//////////////////////////////////////////////////
+/// \brief Camera with barrel distortion.
+sdf::Camera barrelCamera()
+{
+  sdf::Camera camera;
+  camera.SetDistortionK1(-0.1);
+  camera.SetDistortionK2(0.01);
+  camera.SetDistortionK3(0.0);
+  camera.SetDistortionP1(0.001);
+  camera.SetDistortionP2(-0.002);
+  camera.SetDistortionCenter(math::Vector2d(0.5, 0.5));
+  return camera;
+}
+
+//////////////////////////////////////////////////
+TEST(BrownDistortionModel_TEST, Points)
+{
+  BrownDistortionModel model;
+  model.Load(barrelCamera());
+
+  std::vector<math::Vector2d> points;
+  for (unsigned int v = 0; v < kHeight; v += 7u)
+  {
+    for (unsigned int u = 0; u < kWidth; u += 5u)
+      points.push_back(math::Vector2d(u, v));
+  }
+  const std::vector<math::Vector2d> original = points;
+
+  // Barrel distortion pulls the corners toward the center
+  model.Distort(points, kWidth, kHeight, kFocal, kFocal);
+  EXPECT_GT(points.front().X(), original.front().X());
+  EXPECT_GT(points.front().Y(), original.front().Y());
+
+  EXPECT_TRUE(model.Undistort(points, kWidth, kHeight, kFocal, kFocal));
+  ASSERT_EQ(original.size(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_NEAR(original[i].X(), points[i].X(), 0.01);
+    EXPECT_NEAR(original[i].Y(), points[i].Y(), 0.01);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(BrownDistortionModel_TEST, NoDistortion)
+{
+  // Without coefficients the tables sample each pixel itself
+  BrownDistortionModel model;
+  model.Load(sdf::Camera());
+
+  std::vector<unsigned char> image(kWidth * kHeight * 3u);
+  for (std::size_t i = 0; i < image.size(); ++i)
+    image[i] = static_cast<unsigned char>(i * 13u);
+  std::vector<unsigned char> out(image.size());
+
+  ASSERT_TRUE(model.Distort(image.data(), kWidth, kHeight, 3u, 1u,
+      kFocal, kFocal, out.data()));
+  EXPECT_EQ(image, out);
+  ASSERT_TRUE(model.Undistort(image.data(), kWidth, kHeight, 3u, 1u,
+      kFocal, kFocal, out.data(),
+      BrownDistortionModel::Interpolation::NEAREST));
+  EXPECT_EQ(image, out);
+}
+
+//////////////////////////////////////////////////
+TEST(BrownDistortionModel_TEST, Images)
+{
+  BrownDistortionModel model;
+  model.Load(barrelCamera());
+
+  // Smooth 16 bit gradient, so that resampling errors stay small
+  std::vector<std::uint16_t> image(kWidth * kHeight);
+  for (unsigned int v = 0; v < kHeight; ++v)
+  {
+    for (unsigned int u = 0; u < kWidth; ++u)
+      image[v * kWidth + u] = static_cast<std::uint16_t>(200u * u + 100u * v);
+  }
+
+  std::vector<std::uint16_t> distorted(image.size());
+  std::vector<std::uint16_t> restored(image.size());
+  ASSERT_TRUE(model.Distort(
+      reinterpret_cast<const unsigned char *>(image.data()), kWidth, kHeight,
+      1u, 2u, kFocal, kFocal,
+      reinterpret_cast<unsigned char *>(distorted.data())));
+  EXPECT_NE(image, distorted);
+  ASSERT_TRUE(model.Undistort(
+      reinterpret_cast<const unsigned char *>(distorted.data()), kWidth,
+      kHeight, 1u, 2u, kFocal, kFocal,
+      reinterpret_cast<unsigned char *>(restored.data())));
+
+  // Away from the border the round trip is close to the original, within
+  // a pixel of the gradient
+  for (unsigned int v = kHeight / 4u; v < kHeight * 3u / 4u; ++v)
+  {
+    for (unsigned int u = kWidth / 4u; u < kWidth * 3u / 4u; ++u)
+    {
+      const int expected = image[v * kWidth + u];
+      const int actual = restored[v * kWidth + u];
+      EXPECT_LE(std::abs(expected - actual), 300) << u << " " << v;
+    }
+  }
+
+  // Unsupported layouts
+  EXPECT_FALSE(model.Distort(
+      reinterpret_cast<const unsigned char *>(image.data()), kWidth, kHeight,
+      2u, 1u, kFocal, kFocal,
+      reinterpret_cast<unsigned char *>(distorted.data())));
+  EXPECT_FALSE(model.Distort(
+      reinterpret_cast<const unsigned char *>(image.data()), 0u, kHeight,
+      1u, 2u, kFocal, kFocal,
+      reinterpret_cast<unsigned char *>(distorted.data())));
+}
+
+//////////////////////////////////////////////////
+TEST(BrownDistortionModel_TEST, TableCache)
+{
+  BrownDistortionModel model;
+  model.Load(barrelCamera());
+
+  auto table = model.DistortionTable(kWidth, kHeight, kFocal, kFocal);
+  ASSERT_NE(nullptr, table);
+  EXPECT_EQ(kWidth, table->width);
+  EXPECT_EQ(kHeight, table->height);
+  EXPECT_EQ(table, model.DistortionTable(kWidth, kHeight, kFocal, kFocal));
+  EXPECT_EQ(nullptr, model.DistortionTable(0u, kHeight, kFocal, kFocal));
+
+  // Other sizes, focal lengths and directions get their own tables
+  auto undistortion = model.UndistortionTable(kWidth, kHeight, kFocal,
+      kFocal);
+  ASSERT_NE(nullptr, undistortion);
+  EXPECT_NE(table, undistortion);
+  EXPECT_NE(table, model.DistortionTable(kWidth / 2u, kHeight / 2u,
+      kFocal / 2.0, kFocal / 2.0));
+  EXPECT_NE(table, model.DistortionTable(kWidth, kHeight, kFocal * 2.0,
+      kFocal * 2.0));
+
+  // Loading new coefficients drops the cached tables
+  model.Load(barrelCamera());
+  EXPECT_NE(table, model.DistortionTable(kWidth, kHeight, kFocal, kFocal));
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
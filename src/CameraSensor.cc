@@ -24,7 +24,12 @@
   #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <mutex>
+#include <sstream>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Event.hh>
@@ -44,9 +49,16 @@
 #include "gz/sensors/RenderingEvents.hh"
 #include "gz/sensors/SensorFactory.hh"
 #include "gz/sensors/SensorTypes.hh"
+#include "gz/sensors/SharedMemoryImage.hh"
 
 #include <gz/rendering/Utils.hh>
 
+#include "FrameBufferPool.hh"
+#include "ImageRegion.hh"
+#include "ImageSaver.hh"
+#include "PixelFormatConversion.hh"
+#include "TriggerQueue.hh"
+
 using namespace gz;
 using namespace sensors;
 
@@ -62,12 +74,25 @@ class gz::sensors::CameraSensorPrivate
   /// \param[in] _width width of image in pixels
   /// \param[in] _height height of image in pixels
   /// \param[in] _format The format the data is in
-  /// \return True if the image was saved successfully. False can mean
+  /// \param[in] _size Size of _data in bytes
+  /// \return True if the image was queued for saving. False can mean
   /// that the path provided to the constructor does exist and creation
-  /// of the path was not possible.
+  /// of the path was not possible, or that the frame was dropped.
   /// \sa ImageSaver
   public: bool SaveImage(const unsigned char *_data, unsigned int _width,
-    unsigned int _height, common::Image::PixelFormatType _format);
+    unsigned int _height, common::Image::PixelFormatType _format,
+    std::size_t _size);
+
+  /// \brief Write an image into the shared memory ring, creating or
+  /// growing the segment as needed.
+  /// \param[in] _data Image data.
+  /// \param[in] _size Size of _data in bytes.
+  /// \param[in] _topic Image topic, used to name the segment.
+  /// \param[in,out] _msg Image message to turn into a descriptor.
+  /// \return True if the image was written. On failure shared memory
+  /// transport is disabled and images are published inline.
+  public: bool WriteSharedMemory(const unsigned char *_data,
+    std::size_t _size, const std::string &_topic, msgs::Image &_msg);
 
   /// \brief Computes the OpenGL NDC matrix
   /// \param[in] _left Left vertical clipping plane
@@ -156,6 +181,17 @@ class gz::sensors::CameraSensorPrivate
   /// \brief Distortion added to sensor data
   public: DistortionPtr distortion;
 
+  /// \brief Noise added on the CPU, set when the render engine has no
+  /// Gaussian noise pass.
+  public: std::shared_ptr<ImageGaussianNoiseModel> cpuNoise;
+
+  /// \brief Distortion applied on the CPU, set when the render engine has
+  /// no distortion pass.
+  public: std::shared_ptr<ImageBrownDistortionModel> cpuDistortion;
+
+  /// \brief Image distorted on the CPU.
+  public: FrameBuffer distortedBuffer;
+
   /// \brief Event that is used to trigger callbacks when a new image
   /// is generated
   public: common::EventT<
@@ -170,8 +206,20 @@ class gz::sensors::CameraSensorPrivate
   /// \brief True if camera is triggered by a topic
   public: bool isTriggeredCamera = false;
 
-  /// \brief True if camera has been triggered by a topic
-  public: bool isTriggered = false;
+  /// \brief Triggers received since the last update, with their times.
+  /// Trigger callbacks never wait for the mutex held while rendering.
+  public: TriggerQueue triggers;
+
+  /// \brief Maximum number of triggered frames published per update.
+  public: unsigned int maxTriggeredFrames = 4u;
+
+  /// \brief Time of the last update in nanoseconds, used as the time of
+  /// triggers that carry no stamp.
+  public: std::atomic<std::int64_t> lastUpdateTime{0};
+
+  /// \brief Stamps of the frames published by the current update, kept
+  /// between updates to avoid reallocating.
+  public: std::vector<std::chrono::steady_clock::duration> frameStamps;
 
   /// \brief Topic for camera trigger
   public: std::string triggerTopic = "";
@@ -188,12 +236,47 @@ class gz::sensors::CameraSensorPrivate
   /// \brief counter used to set the image filename
   public: std::uint64_t saveImageCounter = 0;
 
+  /// \brief Save policy and file format
+  public: ImageSaver::Options saveOptions;
+
   /// \brief SDF Sensor DOM object.
   public: sdf::Sensor sdfSensor;
 
   /// \brief Camera information message.
   public: msgs::CameraInfo infoMsg;
 
+  /// \brief Rate at which an unchanged camera info message is republished,
+  /// in Hz. Negative republishes it on every update.
+  public: double infoRate{-1.0};
+
+  /// \brief Lowest info rate. Transport only tells whether a topic has
+  /// subscribers, not when another one joins, so a subscriber that joins
+  /// while others are connected gets camera info from the periodic
+  /// republication.
+  public: static constexpr double kMinInfoRate = 0.1;
+
+  /// \brief True if infoMsg changed since it was last serialized.
+  public: bool infoChanged{true};
+
+  /// \brief Cleared while the info topic has no subscribers, so that the
+  /// first subscriber gets the message on the next update. Later
+  /// subscribers wait for the next republication at the info rate.
+  public: std::atomic<bool> infoSubscribed{false};
+
+  /// \brief Time camera info was last published.
+  public: std::chrono::steady_clock::duration lastInfoTime{0};
+
+  /// \brief infoMsg serialized without a stamp.
+  public: std::string infoData;
+
+  /// \brief Message holding only the stamp. Protobuf merges concatenated
+  /// messages, so appending it to infoData stamps the serialized message.
+  public: msgs::CameraInfo infoStamp;
+
+  /// \brief Serialized message being published, kept between updates to
+  /// avoid reallocating.
+  public: std::string infoBuffer;
+
   /// \brief The frame this camera uses in its camera_info topic.
   public: std::string opticalFrameId{""};
 
@@ -205,6 +288,29 @@ class gz::sensors::CameraSensorPrivate
 
   /// \brief Flag to indicate if sensor is generating data
   public: bool generatingData = false;
+
+  /// \brief Number of frames in the shared memory ring. Zero publishes
+  /// images inline on the topic.
+  public: unsigned int sharedMemorySlots = 0u;
+
+  /// \brief Writer for the shared memory image transport.
+  public: SharedMemoryImageWriter sharedMemoryWriter;
+
+  /// \brief Conversion from the rendered image to the published pixel
+  /// format.
+  public: PixelFormatConversion conversion;
+
+  /// \brief Converted image, used when it is not written straight into the
+  /// image message.
+  public: FrameBuffer convertedBuffer;
+
+  /// \brief Region of the rendered image that is published, and its
+  /// binning.
+  public: ImageRegion region;
+
+  /// \brief Cropped and binned image, used when it is not written straight
+  /// into the image message.
+  public: FrameBuffer regionBuffer;
 };
 
 //////////////////////////////////////////////////
@@ -220,6 +326,9 @@ bool CameraSensor::CreateCamera()
   unsigned int width = cameraSdf->ImageWidth();
   unsigned int height = cameraSdf->ImageHeight();
 
+  this->dataPtr->cpuNoise.reset();
+  this->dataPtr->cpuDistortion.reset();
+
   this->dataPtr->camera = this->Scene()->CreateCamera(this->Name());
   this->dataPtr->camera->SetImageWidth(width);
   this->dataPtr->camera->SetImageHeight(height);
@@ -240,9 +349,14 @@ bool CameraSensor::CreateCamera()
       this->dataPtr->noises[noiseType] =
         ImageNoiseFactory::NewNoiseModel(noiseSdf, "camera");
 
-      std::dynamic_pointer_cast<ImageGaussianNoiseModel>(
-           this->dataPtr->noises[noiseType])->SetCamera(
-             this->dataPtr->camera);
+      auto noise = std::dynamic_pointer_cast<ImageGaussianNoiseModel>(
+           this->dataPtr->noises[noiseType]);
+      noise->SetCamera(this->dataPtr->camera);
+      if (noise->CpuFallback())
+      {
+        igndbg << "Camera noise is added on the CPU." << std::endl;
+        this->dataPtr->cpuNoise = noise;
+      }
     }
     else if (noiseSdf.Type() != sdf::NoiseType::NONE)
     {
@@ -270,16 +384,40 @@ bool CameraSensor::CreateCamera()
         ImageDistortionFactory::NewDistortionModel(*cameraSdf, "camera");
     this->dataPtr->distortion->Load(*cameraSdf);
 
-    std::dynamic_pointer_cast<ImageBrownDistortionModel>(
-        this->dataPtr->distortion)->SetCamera(this->dataPtr->camera);
+    auto distortion = std::dynamic_pointer_cast<ImageBrownDistortionModel>(
+        this->dataPtr->distortion);
+    distortion->SetCamera(this->dataPtr->camera);
+    if (distortion->CpuFallback())
+    {
+      igndbg << "Camera images are distorted on the CPU." << std::endl;
+      this->dataPtr->cpuDistortion = distortion;
+    }
   }
 
+  // Formats the render engine does not produce are rendered as RGB and
+  // converted in Update
+  this->dataPtr->conversion.SetFormat(PixelFormatConversion::Format::NONE);
   sdf::PixelFormatType pixelFormat = cameraSdf->PixelFormat();
   switch (pixelFormat)
   {
     case sdf::PixelFormatType::RGB_INT8:
       this->dataPtr->camera->SetImageFormat(rendering::PF_R8G8B8);
       break;
+    case sdf::PixelFormatType::BGR_INT8:
+      this->dataPtr->camera->SetImageFormat(rendering::PF_R8G8B8);
+      this->dataPtr->conversion.SetFormat(
+          PixelFormatConversion::Format::BGR8);
+      break;
+    case sdf::PixelFormatType::RGBA_INT8:
+      this->dataPtr->camera->SetImageFormat(rendering::PF_R8G8B8);
+      this->dataPtr->conversion.SetFormat(
+          PixelFormatConversion::Format::RGBA8);
+      break;
+    case sdf::PixelFormatType::BAYER_RGGB8:
+      this->dataPtr->camera->SetImageFormat(rendering::PF_R8G8B8);
+      this->dataPtr->conversion.SetFormat(
+          PixelFormatConversion::Format::BAYER_RGGB8);
+      break;
     case sdf::PixelFormatType::L_INT8:
       this->dataPtr->camera->SetImageFormat(rendering::PF_L8);
       break;
@@ -292,6 +430,26 @@ bool CameraSensor::CreateCamera()
       break;
   }
 
+  // Output formats SDF has no name for, such as YUV, are set with
+  // <ignition:output_format>
+  sdf::ElementPtr cameraElem = cameraSdf->Element();
+  if (cameraElem && cameraElem->HasElement("ignition:output_format"))
+  {
+    std::string outputFormat =
+        cameraElem->Get<std::string>("ignition:output_format");
+    if (this->dataPtr->camera->ImageFormat() != rendering::PF_R8G8B8)
+    {
+      ignwarn << "<ignition:output_format> requires an R8G8B8 image format, "
+              << "ignoring [" << outputFormat << "]." << std::endl;
+    }
+    else if (!this->dataPtr->conversion.SetFormat(outputFormat))
+    {
+      ignerr << "Unsupported output format [" << outputFormat << "]. "
+             << "Supported formats are BGR8, RGBA8, YUYV, NV12, "
+             << "BAYER_RGGB8 and BAYER_BGGR8." << std::endl;
+    }
+  }
+
   // Update the DOM object intrinsics to have consistent
   // intrinsics between ogre camera and camera_info msg
   if(!cameraSdf->HasLensIntrinsics())
@@ -327,6 +485,13 @@ bool CameraSensor::CreateCamera()
 
   this->dataPtr->image = this->dataPtr->camera->CreateImage();
 
+  if (!this->dataPtr->region.SetImageSize(width, height))
+  {
+    ignwarn << "The image region of camera [" << this->Name() << "] does "
+            << "not fit its " << width << "x" << height << " image, the "
+            << "whole image is published." << std::endl;
+  }
+
   this->Scene()->RootVisual()->AddChild(this->dataPtr->camera);
 
   // Create the directory to store frames
@@ -335,6 +500,8 @@ bool CameraSensor::CreateCamera()
     this->dataPtr->saveImagePath = cameraSdf->SaveFramesPath();
     this->dataPtr->saveImagePrefix = this->Name() + "_";
     this->dataPtr->saveImage = true;
+    this->dataPtr->saveOptions = ImageSaver::OptionsFromSdf(*cameraSdf,
+        this->Name());
   }
 
   // Update the DOM object intrinsics to have consistent
@@ -394,6 +561,9 @@ CameraSensor::CameraSensor()
 //////////////////////////////////////////////////
 CameraSensor::~CameraSensor()
 {
+  // Make sure the last frames are on disk before the sensor goes away
+  if (this->dataPtr->saveImage)
+    ImageSaver::Instance().Finish(this->dataPtr->saveOptions);
 }
 
 //////////////////////////////////////////////////
@@ -467,16 +637,97 @@ bool CameraSensor::Load(const sdf::Sensor &_sdf)
       }
     }
 
+    // Triggers that arrive faster than the sensor updates wait in a queue,
+    // each update publishes up to <ignition:max_triggered_frames> of them.
+    // The queue is sized before subscribing, OnTrigger may run right away.
+    sdf::ElementPtr cameraElem = _sdf.CameraSensor()->Element();
+    if (cameraElem && cameraElem->HasElement("ignition:trigger_queue_size"))
+    {
+      int size = cameraElem->Get<int>("ignition:trigger_queue_size");
+      if (size > 0)
+      {
+        this->dataPtr->triggers.Reset(static_cast<std::size_t>(size));
+      }
+      else
+      {
+        ignerr << "<ignition:trigger_queue_size> must be positive."
+               << std::endl;
+      }
+    }
+    if (cameraElem && cameraElem->HasElement("ignition:max_triggered_frames"))
+    {
+      int frames = cameraElem->Get<int>("ignition:max_triggered_frames");
+      if (frames > 0)
+      {
+        this->dataPtr->maxTriggeredFrames = static_cast<unsigned int>(frames);
+      }
+      else
+      {
+        ignerr << "<ignition:max_triggered_frames> must be positive."
+               << std::endl;
+      }
+    }
+
+    this->dataPtr->isTriggeredCamera = true;
     this->dataPtr->node.Subscribe(this->dataPtr->triggerTopic,
         &CameraSensorPrivate::OnTrigger, this->dataPtr.get());
 
     igndbg << "Camera trigger messages for [" << this->Name() << "] subscribed"
            << " on [" << this->dataPtr->triggerTopic << "]" << std::endl;
-    this->dataPtr->isTriggeredCamera = true;
   }
 
   if (!this->AdvertiseInfo())
     return false;
+  this->LoadInfoRate(_sdf.CameraSensor());
+
+  // Same host consumers can opt into reading frames from shared memory, in
+  // which case only a descriptor is published on the image topic
+  sdf::ElementPtr cameraElem = _sdf.CameraSensor()->Element();
+  if (cameraElem && cameraElem->HasElement("ignition:shared_memory_slots"))
+  {
+#ifdef _WIN32
+    ignwarn << "Shared memory image transport is not supported on Windows, "
+            << "camera [" << this->Name() << "] publishes images inline."
+            << std::endl;
+#else
+    int slots = cameraElem->Get<int>("ignition:shared_memory_slots");
+    if (slots > 0)
+      this->dataPtr->sharedMemorySlots = static_cast<unsigned int>(slots);
+    else
+      ignerr << "<ignition:shared_memory_slots> must be positive." << std::endl;
+#endif
+  }
+
+  // Consumers that only need part of the image, or a lower resolution, can
+  // have it cropped and binned before it is published
+  if (cameraElem && cameraElem->HasElement("ignition:roi"))
+  {
+    std::istringstream roi(cameraElem->Get<std::string>("ignition:roi"));
+    int x = -1;
+    int y = -1;
+    int w = -1;
+    int h = -1;
+    if ((roi >> x >> y >> w >> h) && x >= 0 && y >= 0 && w >= 0 && h >= 0)
+    {
+      this->dataPtr->region.SetRoi(static_cast<unsigned int>(x),
+          static_cast<unsigned int>(y), static_cast<unsigned int>(w),
+          static_cast<unsigned int>(h));
+    }
+    else
+    {
+      ignerr << "<ignition:roi> must be four non-negative integers: "
+             << "x y width height." << std::endl;
+    }
+  }
+  if (cameraElem && cameraElem->HasElement("ignition:binning"))
+  {
+    int binning = cameraElem->Get<int>("ignition:binning");
+    if (binning < 1 ||
+        !this->dataPtr->region.SetBinning(static_cast<unsigned int>(binning)))
+    {
+      ignerr << "<ignition:binning> must be 1, 2 or 4." << std::endl;
+    }
+  }
 
   if (this->Scene())
     this->CreateCamera();
@@ -536,6 +787,8 @@ bool CameraSensor::Update(const std::chrono::steady_clock::duration &_now)
   }
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->lastUpdateTime = std::chrono::duration_cast<
+      std::chrono::nanoseconds>(_now).count();
 
   // move the camera to the current pose
   this->dataPtr->camera->SetLocalPose(this->Pose());
@@ -548,7 +801,7 @@ bool CameraSensor::Update(const std::chrono::steady_clock::duration &_now)
 
   // render only if necessary
   if (this->dataPtr->isTriggeredCamera &&
-      !this->dataPtr->isTriggered)
+      this->dataPtr->triggers.Empty())
   {
     return true;
   }
@@ -564,6 +817,12 @@ bool CameraSensor::Update(const std::chrono::steady_clock::duration &_now)
       this->dataPtr->generatingData = false;
     }
 
+    // Nobody is listening, pending triggers are handled as if rendered
+    std::chrono::steady_clock::duration stamp;
+    while (this->dataPtr->triggers.Pop(stamp))
+    {
+    }
+
     return true;
   }
   else
@@ -576,9 +835,28 @@ bool CameraSensor::Update(const std::chrono::steady_clock::duration &_now)
     }
   }
 
+  // One frame per pending trigger, stamped with the trigger time, or one
+  // frame stamped with the current time
+  auto &stamps = this->dataPtr->frameStamps;
+  stamps.clear();
+  if (this->dataPtr->isTriggeredCamera)
+  {
+    std::chrono::steady_clock::duration stamp;
+    while (stamps.size() < this->dataPtr->maxTriggeredFrames &&
+        this->dataPtr->triggers.Pop(stamp))
+    {
+      stamps.push_back(stamp);
+    }
+  }
+  else
+  {
+    stamps.push_back(_now);
+  }
+
   if (this->HasImageConnections() || this->dataPtr->saveImage)
   {
-    // generate sensor data
+    // generate sensor data. Triggers handled by the same update all see the
+    // same scene, so the image is rendered once and published for each.
     this->Render();
     {
       IGN_PROFILE("CameraSensor::Update Copy image");
@@ -588,6 +866,7 @@ bool CameraSensor::Update(const std::chrono::steady_clock::duration &_now)
     unsigned int width = this->dataPtr->camera->ImageWidth();
     unsigned int height = this->dataPtr->camera->ImageHeight();
     unsigned char *data = this->dataPtr->image.Data<unsigned char>();
+    std::size_t imageSize = this->dataPtr->camera->ImageMemorySize();
 
     common::Image::PixelFormatType
         format{common::Image::UNKNOWN_PIXEL_FORMAT};
@@ -614,86 +893,232 @@ bool CameraSensor::Update(const std::chrono::steady_clock::duration &_now)
         break;
     }
 
-    // create message
     msgs::Image msg;
+    const PixelFormatConversion &conversion = this->dataPtr->conversion;
+    bool sharedMemory = this->dataPtr->sharedMemorySlots > 0u;
+    bool dataInMsg = false;
+
+    const rendering::PixelFormat renderFormat =
+        this->dataPtr->camera->ImageFormat();
+    const unsigned int bytesPerPixel =
+        rendering::PixelUtil::BytesPerPixel(renderFormat);
+    const unsigned int channels =
+        rendering::PixelUtil::ChannelCount(renderFormat);
+
+    // Noise and distortion the render engine could not apply, in the same
+    // order as the render passes
+    if (this->dataPtr->cpuNoise)
+    {
+      IGN_PROFILE("CameraSensor::Update Noise");
+      this->dataPtr->cpuNoise->ApplyToImage(data, width, height, channels,
+          bytesPerPixel / channels);
+    }
+    if (this->dataPtr->cpuDistortion)
+    {
+      IGN_PROFILE("CameraSensor::Update Distortion");
+      this->dataPtr->distortedBuffer.Resize(imageSize);
+      unsigned char *dst = this->dataPtr->distortedBuffer.Data<unsigned char>();
+      if (this->dataPtr->cpuDistortion->ApplyToImage(data, width, height,
+          channels, bytesPerPixel / channels, dst))
+      {
+        data = dst;
+      }
+    }
+
+    // Crop and bin before anything else touches the image. The result goes
+    // straight into the message when it is published as is.
+    const ImageRegion &region = this->dataPtr->region;
+    if (region.Active())
+    {
+      IGN_PROFILE("CameraSensor::Update Region");
+      imageSize = region.OutputSize(bytesPerPixel);
+      unsigned char *dst = nullptr;
+      if (!sharedMemory &&
+          conversion.OutputFormat() == PixelFormatConversion::Format::NONE)
+      {
+        std::string *msgData = msg.mutable_data();
+        msgData->resize(imageSize);
+        dst = reinterpret_cast<unsigned char *>(&(*msgData)[0]);
+        dataInMsg = true;
+      }
+      else
+      {
+        this->dataPtr->regionBuffer.Resize(imageSize);
+        dst = this->dataPtr->regionBuffer.Data<unsigned char>();
+      }
+      region.Apply(data, channels, bytesPerPixel / channels, dst);
+      data = dst;
+      width = region.Width();
+      height = region.Height();
+    }
+
+    // create message
     {
       IGN_PROFILE("CameraSensor::Update Message");
       msg.set_width(width);
       msg.set_height(height);
-      msg.set_step(width * rendering::PixelUtil::BytesPerPixel(
-                   this->dataPtr->camera->ImageFormat()));
+      msg.set_step(width * bytesPerPixel);
       msg.set_pixel_format_type(msgsPixelFormat);
-      *msg.mutable_header()->mutable_stamp() = msgs::Convert(_now);
       auto frame = msg.mutable_header()->add_data();
       frame->set_key("frame_id");
       frame->add_value(this->dataPtr->opticalFrameId);
-      msg.set_data(data, this->dataPtr->camera->ImageMemorySize());
     }
 
-    // publish the image message
-    {
-      this->AddSequence(msg.mutable_header());
-      IGN_PROFILE("CameraSensor::Update Publish");
-      this->dataPtr->pub.Publish(msg);
-    }
+    const unsigned char *outData = data;
+    std::size_t dataSize = imageSize;
 
-    // Trigger callbacks.
-    if (this->dataPtr->imageEvent.ConnectionCount() > 0)
+    // Convert to the published pixel format. The result goes straight into
+    // the message unless the message only carries a shared memory
+    // descriptor.
+    if (conversion.OutputFormat() != PixelFormatConversion::Format::NONE)
     {
-      try
+      IGN_PROFILE("CameraSensor::Update Convert");
+      dataSize = conversion.OutputSize(width, height);
+      unsigned char *dst = nullptr;
+      if (sharedMemory)
       {
-        this->dataPtr->imageEvent(msg);
+        this->dataPtr->convertedBuffer.Resize(dataSize);
+        dst = this->dataPtr->convertedBuffer.Data<unsigned char>();
       }
-      catch(...)
+      else
       {
-        ignerr << "Exception thrown in an image callback.\n";
+        std::string *msgData = msg.mutable_data();
+        msgData->resize(dataSize);
+        dst = reinterpret_cast<unsigned char *>(&(*msgData)[0]);
+        dataInMsg = true;
       }
+      conversion.Convert(data, width, height, dst);
+      outData = dst;
+
+      msg.set_step(conversion.Step(width));
+      msg.set_pixel_format_type(conversion.MsgsFormat());
+      auto pixelFormatData = msg.mutable_header()->add_data();
+      pixelFormatData->set_key("pixel_format");
+      pixelFormatData->add_value(conversion.Name());
     }
 
-    // Save image
-    if (this->dataPtr->saveImage)
+    for (const auto &stamp : stamps)
     {
-      this->dataPtr->SaveImage(data, width, height, format);
+      *msg.mutable_header()->mutable_stamp() = msgs::Convert(stamp);
+
+      sharedMemory = sharedMemory && this->dataPtr->WriteSharedMemory(
+          outData, dataSize, this->Topic(), msg);
+      if (!sharedMemory && !dataInMsg)
+      {
+        msg.set_data(outData, dataSize);
+        dataInMsg = true;
+      }
+
+      // publish the image message
+      {
+        this->AddSequence(msg.mutable_header());
+        IGN_PROFILE("CameraSensor::Update Publish");
+        this->dataPtr->pub.Publish(msg);
+      }
+
+      // Trigger callbacks.
+      if (this->dataPtr->imageEvent.ConnectionCount() > 0)
+      {
+        // Callbacks run in process and always get the image data
+        if (sharedMemory)
+          msg.set_data(outData, dataSize);
+
+        try
+        {
+          this->dataPtr->imageEvent(msg);
+        }
+        catch(...)
+        {
+          ignerr << "Exception thrown in an image callback.\n";
+        }
+      }
+
+      // Save image
+      if (this->dataPtr->saveImage)
+      {
+        this->dataPtr->SaveImage(data, width, height, format, imageSize);
+      }
     }
   }
 
   if (this->dataPtr->isTriggeredCamera)
   {
-    return this->dataPtr->isTriggered = false;
+    return false;
   }
 
   return true;
 }
 
 //////////////////////////////////////////////////
-void CameraSensorPrivate::OnTrigger(const msgs::Boolean &/*_msg*/)
+std::uint64_t CameraSensor::DroppedTriggerCount() const
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-  this->isTriggered = true;
+  return this->dataPtr->triggers.DroppedCount();
 }
 
 //////////////////////////////////////////////////
-bool CameraSensorPrivate::SaveImage(const unsigned char *_data,
-    unsigned int _width, unsigned int _height,
-    common::Image::PixelFormatType _format)
+bool CameraSensorPrivate::WriteSharedMemory(const unsigned char *_data,
+    std::size_t _size, const std::string &_topic, msgs::Image &_msg)
 {
-  // Attempt to create the directory if it doesn't exist
-  if (!common::isDirectory(this->saveImagePath))
+  IGN_PROFILE("CameraSensor::Update Shared memory");
+  if (!this->sharedMemoryWriter.IsOpen() ||
+      this->sharedMemoryWriter.SlotSize() < _size)
   {
-    if (!common::createDirectories(this->saveImagePath))
+    // Segment names are shared by the whole host, so they include the
+    // transport partition, and may not contain '/' after the leading one
+    std::string name = "ign_sensors_" + this->node.Options().Partition() +
+        _topic;
+    std::replace_if(name.begin(), name.end(), [](char _c)
+        {
+          return !std::isalnum(static_cast<unsigned char>(_c)) &&
+              _c != '-' && _c != '.';
+        }, '_');
+    if (!this->sharedMemoryWriter.Open(name, this->sharedMemorySlots, _size))
+    {
+      ignerr << "Unable to create shared memory image ring for topic ["
+             << _topic << "], publishing images inline." << std::endl;
+      this->sharedMemorySlots = 0u;
       return false;
+    }
   }
+  return this->sharedMemoryWriter.Write(_data, _size, _msg);
+}
 
+//////////////////////////////////////////////////
+void CameraSensorPrivate::OnTrigger(const msgs::Boolean &_msg)
+{
+  // Frames are stamped with the sim time the trigger was sent at when the
+  // sender sets it, otherwise with the time of the last update
+  std::chrono::steady_clock::duration time;
+  if (_msg.has_header() && _msg.header().has_stamp() &&
+      (_msg.header().stamp().sec() != 0 || _msg.header().stamp().nsec() != 0))
+  {
+    time = msgs::Convert(_msg.header().stamp());
+  }
+  else
+  {
+    time = std::chrono::nanoseconds(this->lastUpdateTime.load());
+  }
+
+  if (!this->triggers.Push(time) && this->triggers.DroppedCount() == 1u)
+  {
+    ignwarn << "Camera trigger queue on [" << this->triggerTopic
+            << "] is full, dropping triggers. Increase "
+            << "<ignition:trigger_queue_size> or "
+            << "<ignition:max_triggered_frames>." << std::endl;
+  }
+}
+
+//////////////////////////////////////////////////
+bool CameraSensorPrivate::SaveImage(const unsigned char *_data,
+    unsigned int _width, unsigned int _height,
+    common::Image::PixelFormatType _format, std::size_t _size)
+{
   std::string filename = this->saveImagePrefix +
-                         std::to_string(this->saveImageCounter) + ".png";
+                         std::to_string(this->saveImageCounter);
   ++this->saveImageCounter;
 
-  common::Image localImage;
-  localImage.SetFromData(_data, _width, _height, _format);
-
-  localImage.SavePNG(
-      common::joinPaths(this->saveImagePath, filename));
-  return true;
+  return ImageSaver::Instance().Save(this->saveImagePath, filename, _data,
+      _size, _width, _height, _format, this->saveOptions);
 }
 
 //////////////////////////////////////////////////
@@ -712,6 +1137,52 @@ unsigned int CameraSensor::ImageHeight() const
   return 0;
 }
 
+//////////////////////////////////////////////////
+bool CameraSensor::SetImageRegion(unsigned int _x, unsigned int _y,
+    unsigned int _width, unsigned int _height, unsigned int _binning)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->region.SetBinning(_binning))
+  {
+    ignerr << "Unsupported binning [" << _binning << "], it must be 1, 2 "
+           << "or 4." << std::endl;
+    return false;
+  }
+  this->dataPtr->region.SetRoi(_x, _y, _width, _height);
+
+  if (!this->dataPtr->camera)
+    return true;
+
+  bool result = this->dataPtr->region.SetImageSize(
+      this->dataPtr->camera->ImageWidth(),
+      this->dataPtr->camera->ImageHeight());
+  if (!result)
+  {
+    ignerr << "The image region of camera [" << this->Name() << "] does not "
+           << "fit its image, the whole image is published." << std::endl;
+  }
+
+  // camera_info describes the published image
+  this->PopulateInfo(this->dataPtr->sdfSensor.CameraSensor());
+  return result;
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraSensor::PublishedImageWidth() const
+{
+  if (this->dataPtr->region.Active())
+    return this->dataPtr->region.Width();
+  return this->ImageWidth();
+}
+
+//////////////////////////////////////////////////
+unsigned int CameraSensor::PublishedImageHeight() const
+{
+  if (this->dataPtr->region.Active())
+    return this->dataPtr->region.Height();
+  return this->ImageHeight();
+}
+
 //////////////////////////////////////////////////
 rendering::CameraPtr CameraSensor::RenderingCamera() const
 {
@@ -768,9 +1239,55 @@ bool CameraSensor::AdvertiseInfo(const std::string &_topic)
 void CameraSensor::PublishInfo(
   const std::chrono::steady_clock::duration &_now)
 {
-  *this->dataPtr->infoMsg.mutable_header()->mutable_stamp() =
+  // Publish when the message changes, when it gains subscribers and at the
+  // info rate. Time going backwards means the simulation was reset.
+  bool publish = this->dataPtr->infoRate < 0.0 ||
+      this->dataPtr->infoChanged || !this->dataPtr->infoSubscribed ||
+      _now < this->dataPtr->lastInfoTime;
+  if (!publish && this->dataPtr->infoRate > 0.0)
+  {
+    publish = _now - this->dataPtr->lastInfoTime >=
+        std::chrono::duration<double>(1.0 / this->dataPtr->infoRate);
+  }
+  if (!publish)
+    return;
+
+  // Only the stamp changes between publications, the rest of the message is
+  // serialized once
+  if (this->dataPtr->infoChanged)
+  {
+    this->dataPtr->infoMsg.mutable_header()->clear_stamp();
+    this->dataPtr->infoMsg.SerializeToString(&this->dataPtr->infoData);
+    this->dataPtr->infoChanged = false;
+  }
+  *this->dataPtr->infoStamp.mutable_header()->mutable_stamp() =
     msgs::Convert(_now);
-  this->dataPtr->infoPub.Publish(this->dataPtr->infoMsg);
+  this->dataPtr->infoBuffer = this->dataPtr->infoData;
+  this->dataPtr->infoStamp.AppendToString(&this->dataPtr->infoBuffer);
+  this->dataPtr->infoPub.PublishRaw(this->dataPtr->infoBuffer,
+      this->dataPtr->infoMsg.GetTypeName());
+
+  this->dataPtr->lastInfoTime = _now;
+  this->dataPtr->infoSubscribed = true;
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::SetInfoRate(double _rate)
+{
+  if (_rate >= 0.0 && _rate < CameraSensorPrivate::kMinInfoRate)
+  {
+    ignwarn << "Camera info rate [" << _rate << "] is raised to ["
+            << CameraSensorPrivate::kMinInfoRate << "] Hz, so that late "
+            << "subscribers receive camera info." << std::endl;
+    _rate = CameraSensorPrivate::kMinInfoRate;
+  }
+  this->dataPtr->infoRate = _rate;
+}
+
+//////////////////////////////////////////////////
+double CameraSensor::InfoRate() const
+{
+  return this->dataPtr->infoRate;
 }
 
 //////////////////////////////////////////////////
@@ -779,6 +1296,32 @@ void CameraSensor::PopulateInfo(const sdf::Camera *_cameraSdf)
   unsigned int width = _cameraSdf->ImageWidth();
   unsigned int height = _cameraSdf->ImageHeight();
 
+  // Intrinsics and projection of the published image, which may be a
+  // cropped and binned part of the rendered image
+  double fx = _cameraSdf->LensIntrinsicsFx();
+  double fy = _cameraSdf->LensIntrinsicsFy();
+  double cx = _cameraSdf->LensIntrinsicsCx();
+  double cy = _cameraSdf->LensIntrinsicsCy();
+  double pfx = _cameraSdf->LensProjectionFx();
+  double pfy = _cameraSdf->LensProjectionFy();
+  double pcx = _cameraSdf->LensProjectionCx();
+  double pcy = _cameraSdf->LensProjectionCy();
+  double tx = _cameraSdf->LensProjectionTx();
+  double ty = _cameraSdf->LensProjectionTy();
+  const ImageRegion &region = this->dataPtr->region;
+  if (region.Active())
+  {
+    region.AdjustIntrinsics(fx, fy, cx, cy);
+    region.AdjustIntrinsics(pfx, pfy, pcx, pcy);
+    tx /= region.Binning();
+    ty /= region.Binning();
+    width = region.Width();
+    height = region.Height();
+  }
+
+  // Start over when called again after the region changed
+  this->dataPtr->infoMsg.Clear();
+
   msgs::CameraInfo::Distortion *distortion =
     this->dataPtr->infoMsg.mutable_distortion();
 
@@ -792,13 +1335,13 @@ void CameraSensor::PopulateInfo(const sdf::Camera *_cameraSdf)
   msgs::CameraInfo::Intrinsics *intrinsics =
     this->dataPtr->infoMsg.mutable_intrinsics();
 
-  intrinsics->add_k(_cameraSdf->LensIntrinsicsFx());
+  intrinsics->add_k(fx);
   intrinsics->add_k(0.0);
-  intrinsics->add_k(_cameraSdf->LensIntrinsicsCx());
+  intrinsics->add_k(cx);
 
   intrinsics->add_k(0.0);
-  intrinsics->add_k(_cameraSdf->LensIntrinsicsFy());
-  intrinsics->add_k(_cameraSdf->LensIntrinsicsCy());
+  intrinsics->add_k(fy);
+  intrinsics->add_k(cy);
 
   intrinsics->add_k(0.0);
   intrinsics->add_k(0.0);
@@ -807,15 +1350,15 @@ void CameraSensor::PopulateInfo(const sdf::Camera *_cameraSdf)
   msgs::CameraInfo::Projection *proj =
     this->dataPtr->infoMsg.mutable_projection();
 
-  proj->add_p(_cameraSdf->LensProjectionFx());
+  proj->add_p(pfx);
   proj->add_p(0.0);
-  proj->add_p(_cameraSdf->LensProjectionCx());
-  proj->add_p(_cameraSdf->LensProjectionTx());
+  proj->add_p(pcx);
+  proj->add_p(tx);
 
   proj->add_p(0.0);
-  proj->add_p(_cameraSdf->LensProjectionFy());
-  proj->add_p(_cameraSdf->LensProjectionCy());
-  proj->add_p(_cameraSdf->LensProjectionTy());
+  proj->add_p(pfy);
+  proj->add_p(pcy);
+  proj->add_p(ty);
 
   proj->add_p(0.0);
   proj->add_p(0.0);
@@ -854,6 +1397,33 @@ void CameraSensor::PopulateInfo(const sdf::Camera *_cameraSdf)
 
   this->dataPtr->infoMsg.set_width(width);
   this->dataPtr->infoMsg.set_height(height);
+
+  if (!math::equal(this->dataPtr->baseline, 0.0))
+    this->SetBaseline(this->dataPtr->baseline);
+
+  this->dataPtr->infoChanged = true;
+}
+
+//////////////////////////////////////////////////
+void CameraSensor::LoadInfoRate(const sdf::Camera *_cameraSdf)
+{
+  // camera_info rarely changes, consumers that only need it once or at a low
+  // rate can have it published when it changes and at
+  // <ignition:camera_info_rate>
+  sdf::ElementPtr cameraElem = _cameraSdf ? _cameraSdf->Element() : nullptr;
+  if (!cameraElem || !cameraElem->HasElement("ignition:camera_info_rate"))
+    return;
+
+  double rate = cameraElem->Get<double>("ignition:camera_info_rate");
+  if (rate >= CameraSensorPrivate::kMinInfoRate)
+  {
+    this->dataPtr->infoRate = rate;
+  }
+  else
+  {
+    ignerr << "<ignition:camera_info_rate> must be at least ["
+           << CameraSensorPrivate::kMinInfoRate << "] Hz." << std::endl;
+  }
 }
 
 //////////////////////////////////////////////////
@@ -867,6 +1437,7 @@ void CameraSensor::SetBaseline(double _baseline)
   {
     auto fx = this->dataPtr->infoMsg.projection().p(0);
     this->dataPtr->infoMsg.mutable_projection()->set_p(3, -fx * _baseline);
+    this->dataPtr->infoChanged = true;
   }
 }
 
@@ -892,7 +1463,11 @@ bool CameraSensor::HasImageConnections() const
 //////////////////////////////////////////////////
 bool CameraSensor::HasInfoConnections() const
 {
-  return this->dataPtr->infoPub && this->dataPtr->infoPub.HasConnections();
+  bool connected =
+      this->dataPtr->infoPub && this->dataPtr->infoPub.HasConnections();
+  if (!connected)
+    this->dataPtr->infoSubscribed = false;
+  return connected;
 }
 
 //////////////////////////////////////////////////
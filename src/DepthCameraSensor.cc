@@ -24,6 +24,7 @@
   #pragma warning(pop)
 #endif
 
+#include <limits>
 #include <mutex>
 
 #include <gz/common/Console.hh>
@@ -34,8 +35,11 @@
 #include <gz/math/Angle.hh>
 #include <gz/math/Helpers.hh>
 
+#include <gz/rendering/Utils.hh>
+
 #include <gz/transport/Node.hh>
 
+#include "gz/sensors/BrownDistortionModel.hh"
 #include "gz/sensors/DepthCameraSensor.hh"
 #include "gz/sensors/Manager.hh"
 #include "gz/sensors/SensorFactory.hh"
@@ -43,7 +47,11 @@
 #include "gz/sensors/ImageNoise.hh"
 #include "gz/sensors/RenderingEvents.hh"
 
+#include "FrameBufferPool.hh"
+#include "ImageRemap.hh"
+#include "ImageSaver.hh"
 #include "PointCloudUtil.hh"
+#include "TripleBuffer.hh"
 
 // undefine near and far macros from windows.h
 #ifdef _WIN32
@@ -59,9 +67,9 @@ class gz::sensors::DepthCameraSensorPrivate
   /// \param[in] _width width of image in pixels
   /// \param[in] _height height of image in pixels
   /// \param[in] _format The format the data is in
-  /// \return True if the image was saved successfully. False can mean
+  /// \return True if the image was queued for saving. False can mean
   /// that the path provided to the constructor does exist and creation
-  /// of the path was not possible.
+  /// of the path was not possible, or that the frame was dropped.
   /// \sa ImageSaver
   public: bool SaveImage(const float *_data, unsigned int _width,
     unsigned int _height, gz::common::Image::PixelFormatType _format);
@@ -74,6 +82,13 @@ class gz::sensors::DepthCameraSensorPrivate
   public: bool ConvertDepthToImage(const float *_data,
     unsigned char *_imageBuffer, unsigned int _width, unsigned int _height);
 
+  /// \brief Get the table that distorts frames of the depth camera.
+  /// \param[in] _width Frame width.
+  /// \param[in] _height Frame height.
+  /// \return The table, or null if frames are not distorted.
+  public: std::shared_ptr<const BrownDistortionModel::RemapTable>
+      DistortionTable(unsigned int _width, unsigned int _height);
+
   /// \brief node to create publisher
   public: transport::Node node;
 
@@ -86,14 +101,19 @@ class gz::sensors::DepthCameraSensorPrivate
     /// \brief Rendering camera
   public: gz::rendering::DepthCameraPtr depthCamera;
 
-  /// \brief Depth data buffer.
-  public: float *depthBuffer = nullptr;
+  /// \brief Depth frames handed over from the depth camera callback.
+  public: TripleBuffer<float> depthFrames;
+
+  /// \brief Point cloud frames handed over from the depth camera callback.
+  public: TripleBuffer<float> pointCloudFrames;
 
-  /// \brief point cloud data buffer.
-  public: float *pointCloudBuffer = nullptr;
+  /// \brief Lens distortion applied to depth and point cloud frames, null
+  /// if the camera has none. Both go through the same nearest neighbour
+  /// table, so that points stay where their depth is.
+  public: std::shared_ptr<BrownDistortionModel> distortion;
 
-  /// \brief xyz data buffer.
-  public: float *xyzBuffer = nullptr;
+  /// \brief xyz data buffer, resized to follow the image size.
+  public: FrameBuffer xyzBuffer;
 
   /// \brief Near clip distance.
   public: float near = 0.0;
@@ -133,6 +153,9 @@ class gz::sensors::DepthCameraSensorPrivate
   /// \brief counter used to set the image filename
   public: std::uint64_t saveImageCounter = 0;
 
+  /// \brief Save policy and file format
+  public: ImageSaver::Options saveOptions;
+
   /// \brief SDF Sensor DOM object.
   public: sdf::Sensor sdfSensor;
 
@@ -167,7 +190,9 @@ bool DepthCameraSensorPrivate::ConvertDepthToImage(
   double factor = 255 / maxDepth;
   for (unsigned int j = 0; j < _height * _width; ++j)
   {
-    unsigned char d = static_cast<unsigned char>(255 - (_data[j] * factor));
+    // NaN is left by lens distortion outside the rendered image
+    unsigned char d = std::isnan(_data[j]) ? 0 :
+        static_cast<unsigned char>(255 - (_data[j] * factor));
     _imageBuffer[j * 3] = d;
     _imageBuffer[j * 3 + 1] = d;
     _imageBuffer[j * 3 + 2] = d;
@@ -175,41 +200,56 @@ bool DepthCameraSensorPrivate::ConvertDepthToImage(
   return true;
 }
 
+//////////////////////////////////////////////////
+std::shared_ptr<const BrownDistortionModel::RemapTable>
+DepthCameraSensorPrivate::DistortionTable(unsigned int _width,
+    unsigned int _height)
+{
+  if (!this->distortion || !this->depthCamera)
+    return nullptr;
+
+  // The model caches the table, this is a lookup after the first frame
+  auto intrinsics = rendering::projectionToCameraIntrinsic(
+      this->depthCamera->ProjectionMatrix(), _width, _height);
+  return this->distortion->DistortionTable(_width, _height,
+      intrinsics(0, 0), intrinsics(1, 1));
+}
+
 //////////////////////////////////////////////////
 bool DepthCameraSensorPrivate::SaveImage(const float *_data,
     unsigned int _width, unsigned int _height,
     common::Image::PixelFormatType /*_format*/)
 {
-  // Attempt to create the directory if it doesn't exist
-  if (!common::isDirectory(this->saveImagePath))
-  {
-    if (!common::createDirectories(this->saveImagePath))
-      return false;
-  }
-
   if (_width == 0 || _height == 0)
     return false;
 
-  common::Image localImage;
-
   unsigned int depthSamples = _width * _height;
-  unsigned int depthBufferSize = depthSamples * 3;
-
-  unsigned char * imgDepthBuffer = new unsigned char[depthBufferSize];
-
-  this->ConvertDepthToImage(_data, imgDepthBuffer, _width, _height);
+  ImageSaver &saver = ImageSaver::Instance();
 
   std::string filename = this->saveImagePrefix +
-                         std::to_string(this->saveImageCounter) + ".png";
+                         std::to_string(this->saveImageCounter);
   ++this->saveImageCounter;
 
-  localImage.SetFromData(imgDepthBuffer, _width, _height,
-      common::Image::RGB_INT8);
-  localImage.SavePNG(
-      common::joinPaths(this->saveImagePath, filename));
+  // Formats that store floats get the depth as it is
+  if (ImageSaver::Supports(this->saveOptions.format,
+      common::Image::R_FLOAT32))
+  {
+    return saver.Save(this->saveImagePath, filename,
+        reinterpret_cast<const unsigned char *>(_data),
+        depthSamples * sizeof(float), _width, _height,
+        common::Image::R_FLOAT32, this->saveOptions);
+  }
 
-  delete[] imgDepthBuffer;
-  return true;
+  // Others get an 8 bit image, converted straight into the buffer handed
+  // to the saver
+  unsigned int depthBufferSize = depthSamples * 3;
+  FrameBuffer imgDepthBuffer = saver.Buffer(depthBufferSize);
+
+  this->ConvertDepthToImage(_data, imgDepthBuffer.Data<unsigned char>(),
+      _width, _height);
+
+  return saver.Save(this->saveImagePath, filename, std::move(imgDepthBuffer),
+      _width, _height, common::Image::RGB_INT8, this->saveOptions);
 }
 
 //////////////////////////////////////////////////
@@ -223,12 +263,10 @@ DepthCameraSensor::~DepthCameraSensor()
 {
   this->dataPtr->depthConnection.reset();
   this->dataPtr->pointCloudConnection.reset();
-  if (this->dataPtr->depthBuffer)
-    delete [] this->dataPtr->depthBuffer;
-  if (this->dataPtr->pointCloudBuffer)
-    delete [] this->dataPtr->pointCloudBuffer;
-  if (this->dataPtr->xyzBuffer)
-    delete [] this->dataPtr->xyzBuffer;
+
+  // Make sure the last frames are on disk before the sensor goes away
+  if (this->dataPtr->saveImage)
+    ImageSaver::Instance().Finish(this->dataPtr->saveOptions);
 }
 
 //////////////////////////////////////////////////
@@ -289,6 +327,7 @@ bool DepthCameraSensor::Load(const sdf::Sensor &_sdf)
 
   if (!this->AdvertiseInfo())
     return false;
+  this->LoadInfoRate(_sdf.CameraSensor());
 
   // Create the point cloud publisher
   this->dataPtr->pointPub =
@@ -401,9 +440,19 @@ bool DepthCameraSensor::CreateCamera()
   // Create depth texture when the camera is reconfigured from default values
   this->dataPtr->depthCamera->CreateDepthTexture();
 
-  // \todo(nkoenig) Port Distortion class
-  // This->dataPtr->distortion.reset(new Distortion());
-  // This->dataPtr->distortion->Load(this->sdf->GetElement("distortion"));
+  // Depth is distorted on the CPU, render passes would blend depth across
+  // edges. Without coefficients there is nothing to do.
+  this->dataPtr->distortion.reset();
+  if (cameraSdf->Element() && cameraSdf->Element()->HasElement("distortion")
+      && (!math::equal(cameraSdf->DistortionK1(), 0.0) ||
+          !math::equal(cameraSdf->DistortionK2(), 0.0) ||
+          !math::equal(cameraSdf->DistortionK3(), 0.0) ||
+          !math::equal(cameraSdf->DistortionP1(), 0.0) ||
+          !math::equal(cameraSdf->DistortionP2(), 0.0)))
+  {
+    this->dataPtr->distortion = std::make_shared<BrownDistortionModel>();
+    this->dataPtr->distortion->Load(*cameraSdf);
+  }
 
   this->Scene()->RootVisual()->AddChild(this->dataPtr->depthCamera);
 
@@ -413,6 +462,8 @@ bool DepthCameraSensor::CreateCamera()
     this->dataPtr->saveImagePath = cameraSdf->SaveFramesPath();
     this->dataPtr->saveImagePrefix = this->Name() + "_";
     this->dataPtr->saveImage = true;
+    this->dataPtr->saveOptions = ImageSaver::OptionsFromSdf(*cameraSdf,
+        this->Name());
   }
 
   this->dataPtr->depthConnection =
@@ -442,25 +493,37 @@ void DepthCameraSensor::OnNewDepthFrame(const float *_scan,
                     unsigned int /*_channels*/,
                     const std::string &_format)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  unsigned int depthSamples = _width * _height;
-  unsigned int depthBufferSize = depthSamples * sizeof(float);
-
   common::Image::PixelFormatType format =
     common::Image::ConvertPixelFormat(_format);
 
-  if (!this->dataPtr->depthBuffer)
-    this->dataPtr->depthBuffer = new float[depthSamples];
-
-  memcpy(this->dataPtr->depthBuffer, _scan, depthBufferSize);
+  // No lock needed, the frame is written into a slot Update never reads.
+  // Distorted frames are remapped straight into that slot.
+  const float *depth = _scan;
+  auto table = this->dataPtr->DistortionTable(_width, _height);
+  if (table)
+  {
+    const float noDepth = std::numeric_limits<float>::quiet_NaN();
+    float *slot = this->dataPtr->depthFrames.BeginWrite(_width * _height);
+    ImageRemap::ApplyNearest(*table,
+        reinterpret_cast<const unsigned char *>(_scan), sizeof(float),
+        reinterpret_cast<unsigned char *>(slot),
+        reinterpret_cast<const unsigned char *>(&noDepth));
+    depth = slot;
+  }
+  else
+  {
+    this->dataPtr->depthFrames.Write(_scan, _width * _height);
+  }
 
   // Save image
   if (this->dataPtr->saveImage)
   {
-    this->dataPtr->SaveImage(_scan, _width, _height,
+    this->dataPtr->SaveImage(depth, _width, _height,
         format);
   }
+
+  if (table)
+    this->dataPtr->depthFrames.EndWrite();
 }
 
 /////////////////////////////////////////////////
@@ -469,16 +532,26 @@ void DepthCameraSensor::OnNewRgbPointCloud(const float *_scan,
                     unsigned int _channels,
                     const std::string &/*_format*/)
 {
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-  unsigned int pointCloudSamples = _width * _height;
-  unsigned int pointCloudBufferSize = pointCloudSamples * _channels *
-      sizeof(float);
-
-  if (!this->dataPtr->pointCloudBuffer)
-    this->dataPtr->pointCloudBuffer = new float[pointCloudSamples * _channels];
+  // No lock needed, the frame is written into a slot Update never reads
+  auto table = this->dataPtr->DistortionTable(_width, _height);
+  if (!table || _channels != PointCloudUtil::kPointStride)
+  {
+    this->dataPtr->pointCloudFrames.Write(_scan,
+        _width * _height * _channels);
+    return;
+  }
 
-  memcpy(this->dataPtr->pointCloudBuffer, _scan, pointCloudBufferSize);
+  // Points without a source are NaN, with the color left black
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  const float noPoint[PointCloudUtil::kPointStride] = {nan, nan, nan, 0.0f};
+  float *slot = this->dataPtr->pointCloudFrames.BeginWrite(
+      _width * _height * _channels);
+  ImageRemap::ApplyNearest(*table,
+      reinterpret_cast<const unsigned char *>(_scan),
+      PointCloudUtil::kPointStride * sizeof(float),
+      reinterpret_cast<unsigned char *>(slot),
+      reinterpret_cast<const unsigned char *>(noPoint));
+  this->dataPtr->pointCloudFrames.EndWrite();
 }
 
 /////////////////////////////////////////////////
@@ -544,6 +617,20 @@ bool DepthCameraSensor::Update(
   unsigned int width = this->dataPtr->depthCamera->ImageWidth();
   unsigned int height = this->dataPtr->depthCamera->ImageHeight();
 
+  // Take the latest frames. They stay valid until the next Acquire, so they
+  // are published without holding the mutex or copying them first.
+  this->dataPtr->depthFrames.Acquire();
+  this->dataPtr->pointCloudFrames.Acquire();
+
+  if (this->dataPtr->depthFrames.FrontSize() != width * height)
+    return false;
+  const float *depthBuffer = this->dataPtr->depthFrames.Front();
+
+  const float *pointCloudBuffer = nullptr;
+  if (this->dataPtr->pointCloudFrames.FrontSize() ==
+      width * height * PointCloudUtil::kPointStride)
+    pointCloudBuffer = this->dataPtr->pointCloudFrames.Front();
+
   auto msgsFormat = msgs::PixelFormatType::R_FLOAT32;
 
   // create message
@@ -558,8 +645,7 @@ bool DepthCameraSensor::Update(
   frame->set_key("frame_id");
   frame->add_value(this->FrameId());
 
-  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-  msg.set_data(this->dataPtr->depthBuffer,
+  msg.set_data(depthBuffer,
       rendering::PixelUtil::MemorySize(rendering::PF_FLOAT32_R,
       width, height));
 
@@ -580,16 +666,15 @@ bool DepthCameraSensor::Update(
     }
   }
 
-  if (this->HasPointConnections() &&
-      this->dataPtr->pointCloudBuffer)
+  if (this->HasPointConnections() && pointCloudBuffer)
   {
     // Set the time stamp
     *this->dataPtr->pointMsg.mutable_header()->mutable_stamp() =
       msgs::Convert(_now);
-    this->dataPtr->pointMsg.set_is_dense(true);
+    this->dataPtr->pointMsg.set_is_dense(!this->dataPtr->distortion);
 
-    if (!this->dataPtr->xyzBuffer)
-      this->dataPtr->xyzBuffer = new float[width*height*3];
+    this->dataPtr->xyzBuffer.Resize(width * height * 3u * sizeof(float));
+    float *xyzBuffer = this->dataPtr->xyzBuffer.Data<float>();
 
     if (this->dataPtr->image.Width() != width
         || this->dataPtr->image.Height() != height)
@@ -600,17 +685,15 @@ bool DepthCameraSensor::Update(
 
     // extract image data from point cloud data
     this->dataPtr->pointsUtil.XYZFromPointCloud(
-        this->dataPtr->xyzBuffer,
-        this->dataPtr->pointCloudBuffer,
-        width, height);
+        xyzBuffer, pointCloudBuffer, width, height);
 
     // convert depth to grayscale rgb image
-    this->dataPtr->ConvertDepthToImage(this->dataPtr->depthBuffer,
+    this->dataPtr->ConvertDepthToImage(depthBuffer,
         this->dataPtr->image.Data<unsigned char>(), width, height);
 
     // fill the point cloud msg with data from xyz and rgb buffer
     this->dataPtr->pointsUtil.FillMsg(this->dataPtr->pointMsg,
-        this->dataPtr->xyzBuffer,
+        xyzBuffer,
         this->dataPtr->image.Data<unsigned char>());
 
     this->AddSequence(this->dataPtr->pointMsg.mutable_header(), "pointMsg");
@@ -0,0 +1,170 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "FrameBufferPool.hh"
+
+#include <cstdint>
+
+using namespace gz;
+using namespace sensors;
+
+constexpr std::size_t FrameBufferPool::kAlignment;
+constexpr std::size_t FrameBufferPool::kMaxFreeBlocksPerSize;
+
+//////////////////////////////////////////////////
+FrameBuffer::FrameBuffer(FrameBuffer &&_other) noexcept
+  : raw(_other.raw), data(_other.data), size(_other.size)
+{
+  _other.raw = nullptr;
+  _other.data = nullptr;
+  _other.size = 0u;
+}
+
+//////////////////////////////////////////////////
+FrameBuffer &FrameBuffer::operator=(FrameBuffer &&_other) noexcept
+{
+  if (this != &_other)
+  {
+    this->Release();
+    this->raw = _other.raw;
+    this->data = _other.data;
+    this->size = _other.size;
+    _other.raw = nullptr;
+    _other.data = nullptr;
+    _other.size = 0u;
+  }
+  return *this;
+}
+
+//////////////////////////////////////////////////
+FrameBuffer::~FrameBuffer()
+{
+  this->Release();
+}
+
+//////////////////////////////////////////////////
+void FrameBuffer::Resize(std::size_t _size)
+{
+  if (_size == this->size)
+    return;
+
+  this->Release();
+  if (_size > 0u)
+    *this = FrameBufferPool::Instance().Acquire(_size);
+}
+
+//////////////////////////////////////////////////
+void FrameBuffer::Release()
+{
+  if (this->raw)
+    FrameBufferPool::Instance().Recycle(*this);
+}
+
+//////////////////////////////////////////////////
+std::size_t FrameBuffer::Size() const
+{
+  return this->size;
+}
+
+//////////////////////////////////////////////////
+FrameBufferPool &FrameBufferPool::Instance()
+{
+  // Intentionally leaked so that buffers owned by static objects can still
+  // be released during static destruction.
+  static FrameBufferPool *pool = new FrameBufferPool();
+  return *pool;
+}
+
+//////////////////////////////////////////////////
+FrameBuffer FrameBufferPool::Acquire(std::size_t _size)
+{
+  FrameBuffer buffer;
+  if (_size == 0u)
+    return buffer;
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto it = this->freeBlocks.find(_size);
+    if (it != this->freeBlocks.end() && !it->second.empty())
+    {
+      buffer.raw = it->second.back().first;
+      buffer.data = it->second.back().second;
+      buffer.size = _size;
+      it->second.pop_back();
+      return buffer;
+    }
+  }
+
+  // Over allocate and align the start of the data by hand, aligned
+  // operator new is not available in C++14.
+  buffer.raw = new unsigned char[_size + kAlignment - 1u];
+  std::uintptr_t address = reinterpret_cast<std::uintptr_t>(buffer.raw);
+  address = (address + kAlignment - 1u) & ~(kAlignment - 1u);
+  buffer.data = reinterpret_cast<unsigned char *>(address);
+  buffer.size = _size;
+  return buffer;
+}
+
+//////////////////////////////////////////////////
+void FrameBufferPool::Recycle(FrameBuffer &_buffer)
+{
+  unsigned char *raw = _buffer.raw;
+  unsigned char *data = _buffer.data;
+  std::size_t size = _buffer.size;
+  _buffer.raw = nullptr;
+  _buffer.data = nullptr;
+  _buffer.size = 0u;
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto &blocks = this->freeBlocks[size];
+    if (blocks.size() < kMaxFreeBlocksPerSize)
+    {
+      blocks.emplace_back(raw, data);
+      return;
+    }
+  }
+  delete [] raw;
+}
+
+//////////////////////////////////////////////////
+std::size_t FrameBufferPool::FreeBlockCount() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  std::size_t count = 0u;
+  for (const auto &blocks : this->freeBlocks)
+    count += blocks.second.size();
+  return count;
+}
+
+//////////////////////////////////////////////////
+void FrameBufferPool::Clear()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto &blocks : this->freeBlocks)
+  {
+    for (auto &block : blocks.second)
+      delete [] block.first;
+  }
+  this->freeBlocks.clear();
+}
+
+//////////////////////////////////////////////////
+FrameBufferPool::~FrameBufferPool()
+{
+  this->Clear();
+}
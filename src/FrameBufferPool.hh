@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_FRAMEBUFFERPOOL_HH_
+#define GZ_SENSORS_FRAMEBUFFERPOOL_HH_
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define FrameBufferPool_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define FrameBufferPool_EXPORTS_API __declspec(dllexport)
+#  else
+#    define FrameBufferPool_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    class FrameBufferPool;
+
+    /// \brief A block of aligned memory borrowed from the FrameBufferPool.
+    /// The block goes back to the pool when the buffer is destroyed or
+    /// resized, where another buffer of the same size can pick it up.
+    /// Sensors use this instead of raw arrays so that image buffers follow
+    /// resolution changes and large allocations are shared between sensors
+    /// of the same shape.
+    class FrameBufferPool_EXPORTS_API FrameBuffer
+    {
+      /// \brief Constructor. The buffer is empty.
+      public: FrameBuffer() = default;
+
+      /// \brief Move constructor.
+      /// \param[in] _other Buffer to take the memory from.
+      public: FrameBuffer(FrameBuffer &&_other) noexcept;
+
+      /// \brief Move assignment operator.
+      /// \param[in] _other Buffer to take the memory from.
+      /// \return Reference to this buffer.
+      public: FrameBuffer &operator=(FrameBuffer &&_other) noexcept;
+
+      /// \brief Destructor. Returns the memory to the pool.
+      public: ~FrameBuffer();
+
+      /// \brief Make sure the buffer holds exactly _size bytes. The memory
+      /// block is only exchanged if the size changes, in which case the
+      /// previous contents are not preserved.
+      /// \param[in] _size Size in bytes. Zero releases the buffer.
+      public: void Resize(std::size_t _size);
+
+      /// \brief Return the memory to the pool, leaving the buffer empty.
+      public: void Release();
+
+      /// \brief Get the buffer size.
+      /// \return Size in bytes.
+      public: std::size_t Size() const;
+
+      /// \brief Get the buffer data.
+      /// \return Pointer to the data or nullptr if the buffer is empty.
+      public: template <typename T>
+              T *Data() const
+      {
+        return reinterpret_cast<T *>(this->data);
+      }
+
+      /// \brief Copying would alias the pooled memory.
+      public: FrameBuffer(const FrameBuffer &) = delete;
+
+      /// \brief Copying would alias the pooled memory.
+      public: FrameBuffer &operator=(const FrameBuffer &) = delete;
+
+      /// \brief Start of the allocation, used to free it.
+      private: unsigned char *raw = nullptr;
+
+      /// \brief Aligned start of the data.
+      private: unsigned char *data = nullptr;
+
+      /// \brief Size of the data in bytes.
+      private: std::size_t size = 0u;
+
+      friend class FrameBufferPool;
+    };
+
+    /// \brief Process wide pool of aligned image buffers, keyed by size.
+    /// All buffers are aligned to FrameBufferPool::kAlignment bytes so that
+    /// vectorized kernels can use aligned loads on them.
+    class FrameBufferPool_EXPORTS_API FrameBufferPool
+    {
+      /// \brief Alignment of every buffer, in bytes.
+      public: static constexpr std::size_t kAlignment = 64u;
+
+      /// \brief Maximum number of unused blocks kept for a single size.
+      public: static constexpr std::size_t kMaxFreeBlocksPerSize = 4u;
+
+      /// \brief Get the pool shared by all sensors.
+      /// \return The pool.
+      public: static FrameBufferPool &Instance();
+
+      /// \brief Get a buffer of _size bytes, reusing an unused block of the
+      /// same size if there is one.
+      /// \param[in] _size Size in bytes.
+      /// \return The buffer.
+      public: FrameBuffer Acquire(std::size_t _size);
+
+      /// \brief Get the number of unused blocks held by the pool.
+      /// \return Number of blocks.
+      public: std::size_t FreeBlockCount() const;
+
+      /// \brief Free all unused blocks.
+      public: void Clear();
+
+      /// \brief Destructor. Frees all unused blocks.
+      public: ~FrameBufferPool();
+
+      /// \brief Give a buffer's memory back to the pool.
+      /// \param[in,out] _buffer Buffer to empty.
+      private: void Recycle(FrameBuffer &_buffer);
+
+      /// \brief Mutex protecting the free lists.
+      private: mutable std::mutex mutex;
+
+      /// \brief Unused blocks, keyed by size. Each entry holds the raw and
+      /// aligned pointers of a block.
+      private: std::map<std::size_t,
+          std::vector<std::pair<unsigned char *, unsigned char *>>> freeBlocks;
+
+      friend class FrameBuffer;
+    };
+    }
+  }
+}
+#endif
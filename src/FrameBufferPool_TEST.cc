@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <utility>
+
+#include "FrameBufferPool.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(FrameBufferPool_TEST, Alignment)
+{
+  for (std::size_t size : {1u, 3u, 100u, 640u * 480u * 3u})
+  {
+    FrameBuffer buffer = FrameBufferPool::Instance().Acquire(size);
+    EXPECT_EQ(size, buffer.Size());
+    ASSERT_NE(nullptr, buffer.Data<unsigned char>());
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(
+        buffer.Data<unsigned char>()) % FrameBufferPool::kAlignment);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(FrameBufferPool_TEST, Resize)
+{
+  FrameBuffer buffer;
+  EXPECT_EQ(0u, buffer.Size());
+  EXPECT_EQ(nullptr, buffer.Data<float>());
+
+  buffer.Resize(16u * sizeof(float));
+  EXPECT_EQ(16u * sizeof(float), buffer.Size());
+  float *data = buffer.Data<float>();
+  ASSERT_NE(nullptr, data);
+  data[15] = 1.0f;
+
+  // Same size keeps the memory and its contents
+  buffer.Resize(16u * sizeof(float));
+  EXPECT_EQ(data, buffer.Data<float>());
+  EXPECT_FLOAT_EQ(1.0f, buffer.Data<float>()[15]);
+
+  // A new size gets a block large enough to write all of it
+  buffer.Resize(1024u * sizeof(float));
+  EXPECT_EQ(1024u * sizeof(float), buffer.Size());
+  for (unsigned int i = 0u; i < 1024u; ++i)
+    buffer.Data<float>()[i] = static_cast<float>(i);
+
+  buffer.Resize(0u);
+  EXPECT_EQ(0u, buffer.Size());
+  EXPECT_EQ(nullptr, buffer.Data<float>());
+}
+
+//////////////////////////////////////////////////
+TEST(FrameBufferPool_TEST, Reuse)
+{
+  FrameBufferPool &pool = FrameBufferPool::Instance();
+  pool.Clear();
+  EXPECT_EQ(0u, pool.FreeBlockCount());
+
+  const std::size_t size = 320u * 240u;
+  unsigned char *data = nullptr;
+  {
+    FrameBuffer buffer = pool.Acquire(size);
+    data = buffer.Data<unsigned char>();
+  }
+  EXPECT_EQ(1u, pool.FreeBlockCount());
+
+  // A buffer of the same size picks up the released block
+  FrameBuffer buffer = pool.Acquire(size);
+  EXPECT_EQ(data, buffer.Data<unsigned char>());
+  EXPECT_EQ(0u, pool.FreeBlockCount());
+
+  // Moving transfers ownership without touching the pool
+  FrameBuffer moved(std::move(buffer));
+  EXPECT_EQ(0u, buffer.Size());
+  EXPECT_EQ(data, moved.Data<unsigned char>());
+  EXPECT_EQ(0u, pool.FreeBlockCount());
+
+  moved.Release();
+  EXPECT_EQ(1u, pool.FreeBlockCount());
+
+  // The number of unused blocks kept per size is bounded
+  {
+    FrameBuffer buffers[FrameBufferPool::kMaxFreeBlocksPerSize + 2u];
+    for (auto &b : buffers)
+      b.Resize(size);
+  }
+  EXPECT_EQ(FrameBufferPool::kMaxFreeBlocksPerSize, pool.FreeBlockCount());
+
+  pool.Clear();
+  EXPECT_EQ(0u, pool.FreeBlockCount());
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
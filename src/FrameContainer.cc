@@ -0,0 +1,656 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/sensors/FrameContainer.hh"
+
+#ifdef _WIN32
+  #include <fcntl.h>
+  #include <io.h>
+  #include <share.h>
+  #include <sys/stat.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace sensors;
+
+namespace
+{
+  /// \brief File header magic.
+  const unsigned char kFileMagic[4] = {'I', 'G', 'N', 'C'};
+
+  /// \brief Record header magic.
+  const unsigned char kRecordMagic[4] = {'I', 'G', 'N', 'R'};
+
+  /// \brief Index magic.
+  const unsigned char kIndexMagic[4] = {'I', 'G', 'N', 'X'};
+
+  /// \brief Trailer magic.
+  const unsigned char kTrailerMagic[4] = {'I', 'G', 'N', 'E'};
+
+  /// \brief Container layout version.
+  const std::uint32_t kVersion = 1u;
+
+  /// \brief Size of the file header: magic, version, reserved.
+  const std::size_t kFileHeaderSize = 16u;
+
+  /// \brief Size of a record header: magic, name length, data size,
+  /// reserved, type, reserved.
+  const std::size_t kRecordHeaderSize = 32u;
+
+  /// \brief Size of the trailer: index offset, reserved, magic.
+  const std::size_t kTrailerSize = 16u;
+
+  /// \brief Size of the fixed part of an index entry: record offset, data
+  /// offset, data size, type, name length.
+  const std::size_t kIndexEntrySize = 32u;
+
+  /// \brief Alignment of records and record data.
+  const std::size_t kAlignment = 64u;
+
+  /// \brief A record in the index.
+  struct Record
+  {
+    /// \brief Record name.
+    std::string name;
+
+    /// \brief Data type.
+    FrameContentType type = FrameContentType::UNKNOWN;
+
+    /// \brief Offset of the record header in the file.
+    std::uint64_t recordOffset = 0u;
+
+    /// \brief Offset of the data in the file.
+    std::uint64_t dataOffset = 0u;
+
+    /// \brief Size of the data in bytes.
+    std::uint64_t dataSize = 0u;
+  };
+
+  /// \brief Round up to kAlignment.
+  std::uint64_t align(std::uint64_t _offset)
+  {
+    return (_offset + kAlignment - 1u) & ~static_cast<std::uint64_t>(
+        kAlignment - 1u);
+  }
+
+  /// \brief Append a little endian integer.
+  template <typename T>
+  void putLE(std::vector<unsigned char> &_out, T _value)
+  {
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      _out.push_back(static_cast<unsigned char>(_value >> (8u * i)));
+  }
+
+  /// \brief Read a little endian integer.
+  template <typename T>
+  T getLE(const unsigned char *_data)
+  {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(static_cast<T>(_data[i]) << (8u * i));
+    return value;
+  }
+
+  /// \brief Read the index a closed container ends with.
+  /// \return False if the container has no valid index.
+  bool readIndex(const unsigned char *_data, std::uint64_t _size,
+      std::vector<Record> &_records)
+  {
+    _records.clear();
+    if (_size < kFileHeaderSize + kTrailerSize)
+      return false;
+
+    const unsigned char *trailer = _data + _size - kTrailerSize;
+    if (std::memcmp(trailer + 12, kTrailerMagic, 4) != 0)
+      return false;
+    const std::uint64_t indexOffset = getLE<std::uint64_t>(trailer);
+    if (indexOffset < kFileHeaderSize ||
+        indexOffset + 16u > _size - kTrailerSize)
+    {
+      return false;
+    }
+
+    const unsigned char *p = _data + indexOffset;
+    const unsigned char *end = _data + _size - kTrailerSize;
+    if (std::memcmp(p, kIndexMagic, 4) != 0)
+      return false;
+    const std::uint64_t count = getLE<std::uint64_t>(p + 8);
+    p += 16;
+
+    for (std::uint64_t i = 0u; i < count; ++i)
+    {
+      if (static_cast<std::size_t>(end - p) < kIndexEntrySize)
+        return false;
+      Record record;
+      record.recordOffset = getLE<std::uint64_t>(p);
+      record.dataOffset = getLE<std::uint64_t>(p + 8);
+      record.dataSize = getLE<std::uint64_t>(p + 16);
+      record.type = static_cast<FrameContentType>(
+          getLE<std::uint32_t>(p + 24));
+      const std::uint32_t nameLength = getLE<std::uint32_t>(p + 28);
+      p += kIndexEntrySize;
+      if (static_cast<std::size_t>(end - p) < nameLength ||
+          record.dataOffset > indexOffset ||
+          record.dataSize > indexOffset - record.dataOffset)
+      {
+        return false;
+      }
+      record.name.assign(reinterpret_cast<const char *>(p), nameLength);
+      p += nameLength;
+      _records.push_back(std::move(record));
+    }
+    return true;
+  }
+
+  /// \brief Rebuild the index of a container that was not closed by
+  /// walking its records. Stops at the first incomplete record.
+  void scanRecords(const unsigned char *_data, std::uint64_t _size,
+      std::vector<Record> &_records)
+  {
+    _records.clear();
+    std::uint64_t offset = kFileHeaderSize;
+    while (true)
+    {
+      offset = align(offset);
+      if (offset + kRecordHeaderSize > _size)
+        break;
+      const unsigned char *header = _data + offset;
+      if (std::memcmp(header, kRecordMagic, 4) != 0)
+        break;
+
+      Record record;
+      const std::uint32_t nameLength = getLE<std::uint32_t>(header + 4);
+      record.dataSize = getLE<std::uint64_t>(header + 8);
+      record.type = static_cast<FrameContentType>(
+          getLE<std::uint32_t>(header + 24));
+      record.recordOffset = offset;
+      record.dataOffset = align(offset + kRecordHeaderSize + nameLength);
+      if (record.dataOffset > _size ||
+          record.dataSize > _size - record.dataOffset)
+      {
+        break;
+      }
+      record.name.assign(
+          reinterpret_cast<const char *>(header + kRecordHeaderSize),
+          nameLength);
+
+      offset = record.dataOffset + record.dataSize;
+      _records.push_back(std::move(record));
+    }
+  }
+
+  /// \brief A container mapped into memory, or read into memory where
+  /// memory mapping is not available.
+  class MappedFile
+  {
+    /// \brief Destructor. Unmaps the file.
+    public: ~MappedFile()
+    {
+      this->Close();
+    }
+
+    /// \brief Map a file.
+    /// \param[in] _path File path.
+    /// \return False if the file can not be read or is not a container.
+    public: bool Open(const std::string &_path)
+    {
+      this->Close();
+#ifdef _WIN32
+      std::ifstream file(_path, std::ios::binary);
+      if (!file)
+        return false;
+      this->contents.assign(std::istreambuf_iterator<char>(file),
+          std::istreambuf_iterator<char>());
+      this->data = this->contents.data();
+      this->size = this->contents.size();
+#else
+      int fd = open(_path.c_str(), O_RDONLY);
+      if (fd < 0)
+        return false;
+      struct stat info;
+      if (fstat(fd, &info) != 0 || info.st_size <= 0)
+      {
+        close(fd);
+        return false;
+      }
+      void *map = mmap(nullptr, static_cast<std::size_t>(info.st_size),
+          PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (map == MAP_FAILED)
+        return false;
+      this->data = static_cast<const unsigned char *>(map);
+      this->size = static_cast<std::uint64_t>(info.st_size);
+      this->mapped = true;
+#endif
+
+      if (this->size < kFileHeaderSize ||
+          std::memcmp(this->data, kFileMagic, 4) != 0 ||
+          getLE<std::uint32_t>(this->data + 4) != kVersion)
+      {
+        this->Close();
+        return false;
+      }
+      return true;
+    }
+
+    /// \brief Unmap the file.
+    public: void Close()
+    {
+#ifndef _WIN32
+      if (this->mapped)
+      {
+        munmap(const_cast<unsigned char *>(this->data),
+            static_cast<std::size_t>(this->size));
+      }
+#endif
+      this->data = nullptr;
+      this->size = 0u;
+      this->mapped = false;
+      this->contents.clear();
+      this->contents.shrink_to_fit();
+    }
+
+    /// \brief Read the records, from the index if there is one.
+    /// \param[out] _records Records.
+    /// \return False if the index was rebuilt from the records.
+    public: bool Records(std::vector<Record> &_records) const
+    {
+      if (readIndex(this->data, this->size, _records))
+        return true;
+      scanRecords(this->data, this->size, _records);
+      return false;
+    }
+
+    /// \brief Start of the file in memory.
+    public: const unsigned char *data = nullptr;
+
+    /// \brief Size of the file in bytes.
+    public: std::uint64_t size = 0u;
+
+    /// \brief True if data is a memory mapping.
+    public: bool mapped = false;
+
+    /// \brief File contents when it is not memory mapped.
+    public: std::vector<unsigned char> contents;
+  };
+}
+
+/// \brief Private data for FrameContainerWriter
+class ignition::sensors::FrameContainerWriter::Implementation
+{
+  /// \brief Write bytes at the end of the file.
+  /// \return True on success.
+  public: bool Write(const void *_data, std::size_t _size);
+
+  /// \brief Write zeros up to the next aligned offset.
+  /// \return True on success.
+  public: bool Pad();
+
+  /// \brief Container path.
+  public: std::string path;
+
+  /// \brief Open file.
+  public: std::FILE *file = nullptr;
+
+  /// \brief Current file size.
+  public: std::uint64_t offset = 0u;
+
+  /// \brief Records written so far.
+  public: std::vector<Record> records;
+
+  /// \brief Header scratch space.
+  public: std::vector<unsigned char> scratch;
+
+  /// \brief Protects everything above.
+  public: mutable std::mutex mutex;
+};
+
+/// \brief Private data for FrameContainerReader
+class ignition::sensors::FrameContainerReader::Implementation
+{
+  /// \brief Container file.
+  public: MappedFile file;
+
+  /// \brief Records.
+  public: std::vector<Record> records;
+
+  /// \brief Record index by name.
+  public: std::unordered_map<std::string, std::size_t> names;
+
+  /// \brief True if the index was rebuilt from the records.
+  public: bool recovered = false;
+};
+
+//////////////////////////////////////////////////
+bool FrameContainerWriter::Implementation::Write(const void *_data,
+    std::size_t _size)
+{
+  if (_size > 0u && std::fwrite(_data, 1u, _size, this->file) != _size)
+    return false;
+  this->offset += _size;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerWriter::Implementation::Pad()
+{
+  static const unsigned char zeros[kAlignment] = {};
+  return this->Write(zeros,
+      static_cast<std::size_t>(align(this->offset) - this->offset));
+}
+
+//////////////////////////////////////////////////
+FrameContainerWriter::FrameContainerWriter()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+FrameContainerWriter::~FrameContainerWriter()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerWriter::Open(const std::string &_path)
+{
+  this->Close();
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  std::vector<Record> records;
+  std::uint64_t end = 0u;
+
+  // Pick up the records of an existing container, dropping its index so
+  // that new records go after the last one
+  {
+    MappedFile existing;
+    if (existing.Open(_path))
+    {
+      existing.Records(records);
+      end = kFileHeaderSize;
+      if (!records.empty())
+        end = records.back().dataOffset + records.back().dataSize;
+    }
+  }
+
+  if (end > 0u)
+  {
+#ifdef _WIN32
+    int fd = -1;
+    bool truncated = _sopen_s(&fd, _path.c_str(), _O_RDWR | _O_BINARY,
+        _SH_DENYNO, _S_IREAD | _S_IWRITE) == 0 &&
+        _chsize_s(fd, static_cast<__int64>(end)) == 0;
+    if (fd >= 0)
+      _close(fd);
+#else
+    bool truncated = truncate(_path.c_str(), static_cast<off_t>(end)) == 0;
+#endif
+    if (!truncated)
+    {
+      ignerr << "Unable to append to frame container [" << _path << "]"
+             << std::endl;
+      return false;
+    }
+    this->dataPtr->file = std::fopen(_path.c_str(), "ab");
+  }
+  else
+  {
+    this->dataPtr->file = std::fopen(_path.c_str(), "wb");
+  }
+
+  if (!this->dataPtr->file)
+  {
+    ignerr << "Unable to open frame container [" << _path << "]: "
+           << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  this->dataPtr->path = _path;
+  this->dataPtr->records = std::move(records);
+  this->dataPtr->offset = end;
+
+  if (end == 0u)
+  {
+    std::vector<unsigned char> &header = this->dataPtr->scratch;
+    header.clear();
+    header.insert(header.end(), kFileMagic, kFileMagic + 4);
+    putLE<std::uint32_t>(header, kVersion);
+    putLE<std::uint64_t>(header, 0u);
+    if (!this->dataPtr->Write(header.data(), header.size()))
+    {
+      std::fclose(this->dataPtr->file);
+      this->dataPtr->file = nullptr;
+      return false;
+    }
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void FrameContainerWriter::Close()
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file)
+    return;
+
+  // Index
+  bool written = this->dataPtr->Pad();
+  const std::uint64_t indexOffset = this->dataPtr->offset;
+  std::vector<unsigned char> &index = this->dataPtr->scratch;
+  index.clear();
+  index.insert(index.end(), kIndexMagic, kIndexMagic + 4);
+  putLE<std::uint32_t>(index, 0u);
+  putLE<std::uint64_t>(index, this->dataPtr->records.size());
+  for (const auto &record : this->dataPtr->records)
+  {
+    putLE<std::uint64_t>(index, record.recordOffset);
+    putLE<std::uint64_t>(index, record.dataOffset);
+    putLE<std::uint64_t>(index, record.dataSize);
+    putLE<std::uint32_t>(index, static_cast<std::uint32_t>(record.type));
+    putLE<std::uint32_t>(index,
+        static_cast<std::uint32_t>(record.name.size()));
+    index.insert(index.end(), record.name.begin(), record.name.end());
+  }
+
+  // Trailer
+  putLE<std::uint64_t>(index, indexOffset);
+  putLE<std::uint32_t>(index, 0u);
+  index.insert(index.end(), kTrailerMagic, kTrailerMagic + 4);
+
+  written = written && this->dataPtr->Write(index.data(), index.size());
+  written = std::fclose(this->dataPtr->file) == 0 && written;
+  if (!written)
+  {
+    ignerr << "Failed to write the index of frame container ["
+           << this->dataPtr->path << "]" << std::endl;
+  }
+
+  this->dataPtr->file = nullptr;
+  this->dataPtr->path.clear();
+  this->dataPtr->records.clear();
+  this->dataPtr->offset = 0u;
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerWriter::IsOpen() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->file != nullptr;
+}
+
+//////////////////////////////////////////////////
+std::string FrameContainerWriter::Path() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->path;
+}
+
+//////////////////////////////////////////////////
+std::size_t FrameContainerWriter::RecordCount() const
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  return this->dataPtr->records.size();
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerWriter::Append(const std::string &_name,
+    FrameContentType _type, const void *_data, std::size_t _size)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  if (!this->dataPtr->file)
+    return false;
+
+  Record record;
+  record.name = _name;
+  record.type = _type;
+  record.dataSize = _size;
+
+  bool written = this->dataPtr->Pad();
+  record.recordOffset = this->dataPtr->offset;
+
+  std::vector<unsigned char> &header = this->dataPtr->scratch;
+  header.clear();
+  header.insert(header.end(), kRecordMagic, kRecordMagic + 4);
+  putLE<std::uint32_t>(header, static_cast<std::uint32_t>(_name.size()));
+  putLE<std::uint64_t>(header, _size);
+  putLE<std::uint64_t>(header, 0u);
+  putLE<std::uint32_t>(header, static_cast<std::uint32_t>(_type));
+  putLE<std::uint32_t>(header, 0u);
+  header.insert(header.end(), _name.begin(), _name.end());
+
+  written = written && this->dataPtr->Write(header.data(), header.size()) &&
+      this->dataPtr->Pad();
+  record.dataOffset = this->dataPtr->offset;
+  written = written && this->dataPtr->Write(_data, _size);
+  if (!written)
+  {
+    ignerr << "Failed to append [" << _name << "] to frame container ["
+           << this->dataPtr->path << "]" << std::endl;
+    return false;
+  }
+
+  this->dataPtr->records.push_back(std::move(record));
+  return true;
+}
+
+//////////////////////////////////////////////////
+FrameContainerReader::FrameContainerReader()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+FrameContainerReader::~FrameContainerReader()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerReader::Open(const std::string &_path)
+{
+  this->Close();
+  if (!this->dataPtr->file.Open(_path))
+    return false;
+
+  this->dataPtr->recovered = !this->dataPtr->file.Records(
+      this->dataPtr->records);
+  for (std::size_t i = 0u; i < this->dataPtr->records.size(); ++i)
+    this->dataPtr->names[this->dataPtr->records[i].name] = i;
+  return true;
+}
+
+//////////////////////////////////////////////////
+void FrameContainerReader::Close()
+{
+  this->dataPtr->file.Close();
+  this->dataPtr->records.clear();
+  this->dataPtr->names.clear();
+  this->dataPtr->recovered = false;
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerReader::IsOpen() const
+{
+  return this->dataPtr->file.data != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerReader::Recovered() const
+{
+  return this->dataPtr->recovered;
+}
+
+//////////////////////////////////////////////////
+std::size_t FrameContainerReader::RecordCount() const
+{
+  return this->dataPtr->records.size();
+}
+
+//////////////////////////////////////////////////
+std::string FrameContainerReader::Name(std::size_t _index) const
+{
+  if (_index >= this->dataPtr->records.size())
+    return std::string();
+  return this->dataPtr->records[_index].name;
+}
+
+//////////////////////////////////////////////////
+FrameContentType FrameContainerReader::Type(std::size_t _index) const
+{
+  if (_index >= this->dataPtr->records.size())
+    return FrameContentType::UNKNOWN;
+  return this->dataPtr->records[_index].type;
+}
+
+//////////////////////////////////////////////////
+const unsigned char *FrameContainerReader::Data(std::size_t _index,
+    std::size_t &_size) const
+{
+  _size = 0u;
+  if (_index >= this->dataPtr->records.size())
+    return nullptr;
+  const Record &record = this->dataPtr->records[_index];
+  _size = static_cast<std::size_t>(record.dataSize);
+  return this->dataPtr->file.data + record.dataOffset;
+}
+
+//////////////////////////////////////////////////
+bool FrameContainerReader::Find(const std::string &_name,
+    std::size_t &_index) const
+{
+  auto it = this->dataPtr->names.find(_name);
+  if (it == this->dataPtr->names.end())
+    return false;
+  _index = it->second;
+  return true;
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "ignition/sensors/FrameContainer.hh"
+#include "test_config.h"  // NOLINT(build/include)
+
+using namespace ignition;
+using namespace sensors;
+
+/// \brief Get the path of a container in the build directory.
+/// \param[in] _name File name.
+/// \return Path, with any previous file removed.
+static std::string containerPath(const std::string &_name)
+{
+  std::string path = std::string(PROJECT_BUILD_PATH) + "/" + _name;
+  std::remove(path.c_str());
+  return path;
+}
+
+/// \brief Check a record.
+/// \param[in] _reader Open container.
+/// \param[in] _index Record index.
+/// \param[in] _name Expected name.
+/// \param[in] _data Expected data.
+static void expectRecord(const FrameContainerReader &_reader,
+    std::size_t _index, const std::string &_name, const std::string &_data)
+{
+  EXPECT_EQ(_name, _reader.Name(_index));
+  std::size_t size = 0u;
+  const unsigned char *data = _reader.Data(_index, size);
+  ASSERT_NE(nullptr, data);
+  EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(data) % 64u);
+  EXPECT_EQ(_data, std::string(reinterpret_cast<const char *>(data), size));
+}
+
+//////////////////////////////////////////////////
+TEST(FrameContainer_TEST, WriteRead)
+{
+  const std::string path = containerPath("frame_container_rw.ignc");
+
+  FrameContainerWriter writer;
+  EXPECT_FALSE(writer.IsOpen());
+  EXPECT_FALSE(writer.Append("a", FrameContentType::RAW, "x", 1u));
+  ASSERT_TRUE(writer.Open(path));
+  EXPECT_TRUE(writer.IsOpen());
+  EXPECT_EQ(path, writer.Path());
+
+  const std::string large(1000u, 'l');
+  EXPECT_TRUE(writer.Append("images/image_0000000.qoi", FrameContentType::QOI,
+      "first", 5u));
+  EXPECT_TRUE(writer.Append("images/image_0000001.qoi", FrameContentType::QOI,
+      large.data(), large.size()));
+  EXPECT_TRUE(writer.Append("empty", FrameContentType::UNKNOWN, nullptr, 0u));
+  EXPECT_TRUE(writer.Append("boxes/0000000.csv", FrameContentType::CSV,
+      "1,2,3\n", 6u));
+  EXPECT_EQ(4u, writer.RecordCount());
+  writer.Close();
+  EXPECT_FALSE(writer.IsOpen());
+
+  FrameContainerReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_FALSE(reader.Recovered());
+  ASSERT_EQ(4u, reader.RecordCount());
+  expectRecord(reader, 0u, "images/image_0000000.qoi", "first");
+  expectRecord(reader, 1u, "images/image_0000001.qoi", large);
+  expectRecord(reader, 3u, "boxes/0000000.csv", "1,2,3\n");
+  EXPECT_EQ(FrameContentType::QOI, reader.Type(0u));
+  EXPECT_EQ(FrameContentType::CSV, reader.Type(3u));
+
+  std::size_t size = 1u;
+  EXPECT_NE(nullptr, reader.Data(2u, size));
+  EXPECT_EQ(0u, size);
+  EXPECT_EQ(nullptr, reader.Data(4u, size));
+  EXPECT_TRUE(reader.Name(4u).empty());
+  EXPECT_EQ(FrameContentType::UNKNOWN, reader.Type(4u));
+
+  std::size_t index = 0u;
+  EXPECT_TRUE(reader.Find("boxes/0000000.csv", index));
+  EXPECT_EQ(3u, index);
+  EXPECT_FALSE(reader.Find("boxes/0000001.csv", index));
+
+  reader.Close();
+  EXPECT_FALSE(reader.IsOpen());
+  EXPECT_EQ(0u, reader.RecordCount());
+
+  // Not a container
+  const std::string other = containerPath("frame_container_other.txt");
+  std::ofstream(other) << "not a container";
+  EXPECT_FALSE(reader.Open(other));
+  EXPECT_FALSE(reader.Open(containerPath("frame_container_missing.ignc")));
+}
+
+//////////////////////////////////////////////////
+TEST(FrameContainer_TEST, Append)
+{
+  const std::string path = containerPath("frame_container_append.ignc");
+
+  {
+    FrameContainerWriter writer;
+    ASSERT_TRUE(writer.Open(path));
+    EXPECT_TRUE(writer.Append("a", FrameContentType::RAW, "1", 1u));
+    EXPECT_TRUE(writer.Append("b", FrameContentType::RAW, "2", 1u));
+  }
+
+  FrameContainerWriter writer;
+  ASSERT_TRUE(writer.Open(path));
+  EXPECT_EQ(2u, writer.RecordCount());
+  EXPECT_TRUE(writer.Append("a", FrameContentType::RAW, "3", 1u));
+  writer.Close();
+
+  FrameContainerReader reader;
+  ASSERT_TRUE(reader.Open(path));
+  EXPECT_FALSE(reader.Recovered());
+  ASSERT_EQ(3u, reader.RecordCount());
+  expectRecord(reader, 0u, "a", "1");
+  expectRecord(reader, 1u, "b", "2");
+  expectRecord(reader, 2u, "a", "3");
+
+  // The last record with a name wins
+  std::size_t index = 0u;
+  EXPECT_TRUE(reader.Find("a", index));
+  EXPECT_EQ(2u, index);
+
+  // Anything other than a container is replaced
+  const std::string other = containerPath("frame_container_replace.ignc");
+  std::ofstream(other) << "not a container";
+  ASSERT_TRUE(writer.Open(other));
+  EXPECT_EQ(0u, writer.RecordCount());
+  writer.Close();
+  ASSERT_TRUE(reader.Open(other));
+  EXPECT_EQ(0u, reader.RecordCount());
+}
+
+//////////////////////////////////////////////////
+TEST(FrameContainer_TEST, Recover)
+{
+  const std::string path = containerPath("frame_container_recover.ignc");
+  const std::string copy = containerPath("frame_container_recover2.ignc");
+
+  // Copy a container before it is closed, as if the writer had crashed,
+  // with the last record cut short
+  {
+    FrameContainerWriter writer;
+    ASSERT_TRUE(writer.Open(path));
+    EXPECT_TRUE(writer.Append("a", FrameContentType::RAW, "first", 5u));
+    EXPECT_TRUE(writer.Append("b", FrameContentType::RAW, "second", 6u));
+    EXPECT_TRUE(writer.Append("c", FrameContentType::RAW, "third", 5u));
+
+    std::FILE *file = std::fopen(path.c_str(), "rb");
+    ASSERT_NE(nullptr, file);
+    std::fflush(nullptr);
+    std::vector<char> contents(4096u);
+    contents.resize(std::fread(contents.data(), 1u, contents.size(), file));
+    std::fclose(file);
+    ASSERT_GT(contents.size(), 2u);
+    contents.resize(contents.size() - 2u);
+    std::ofstream(copy, std::ios::binary).write(contents.data(),
+        static_cast<std::streamsize>(contents.size()));
+  }
+
+  FrameContainerReader reader;
+  ASSERT_TRUE(reader.Open(copy));
+  EXPECT_TRUE(reader.Recovered());
+  ASSERT_EQ(2u, reader.RecordCount());
+  expectRecord(reader, 0u, "a", "first");
+  expectRecord(reader, 1u, "b", "second");
+  reader.Close();
+
+  // Appending to a recovered container drops the incomplete record
+  FrameContainerWriter writer;
+  ASSERT_TRUE(writer.Open(copy));
+  EXPECT_EQ(2u, writer.RecordCount());
+  EXPECT_TRUE(writer.Append("c", FrameContentType::RAW, "again", 5u));
+  writer.Close();
+
+  ASSERT_TRUE(reader.Open(copy));
+  EXPECT_FALSE(reader.Recovered());
+  ASSERT_EQ(3u, reader.RecordCount());
+  expectRecord(reader, 2u, "c", "again");
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
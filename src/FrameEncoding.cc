@@ -0,0 +1,688 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "FrameEncoding.hh"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace gz;
+using namespace sensors;
+
+constexpr std::size_t FrameEncoding::kRawHeaderSize;
+
+namespace
+{
+  /// \brief Raw dump magic.
+  const unsigned char kRawMagic[4] = {'I', 'G', 'N', 'F'};
+
+  /// \brief Raw dump version.
+  const std::uint16_t kRawVersion = 1u;
+
+  /// \brief QOI magic.
+  const unsigned char kQoiMagic[4] = {'q', 'o', 'i', 'f'};
+
+  /// \brief QOI header size.
+  const std::size_t kQoiHeaderSize = 14u;
+
+  /// \brief QOI end marker.
+  const unsigned char kQoiPadding[8] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+  /// \brief QOI chunk tags.
+  const unsigned char kQoiOpIndex = 0x00;
+  const unsigned char kQoiOpDiff = 0x40;
+  const unsigned char kQoiOpLuma = 0x80;
+  const unsigned char kQoiOpRun = 0xc0;
+  const unsigned char kQoiOpRgb = 0xfe;
+  const unsigned char kQoiOpRgba = 0xff;
+  const unsigned char kQoiMask = 0xc0;
+
+  /// \brief LZ4 frame magic.
+  const std::uint32_t kLz4Magic = 0x184D2204u;
+
+  /// \brief LZ4 block size written, 4 MiB.
+  const std::size_t kLz4BlockSize = 4u * 1024u * 1024u;
+
+  /// \brief LZ4 block format limits.
+  const std::size_t kLz4MinMatch = 4u;
+  const std::size_t kLz4LastLiterals = 5u;
+  const std::size_t kLz4MatchFindLimit = 12u;
+  const std::size_t kLz4MaxOffset = 65535u;
+  const unsigned int kLz4HashBits = 16u;
+
+  /// \brief xxHash32 primes.
+  const std::uint32_t kPrime1 = 2654435761u;
+  const std::uint32_t kPrime2 = 2246822519u;
+  const std::uint32_t kPrime3 = 3266489917u;
+  const std::uint32_t kPrime4 = 668265263u;
+  const std::uint32_t kPrime5 = 374761393u;
+
+  /// \brief True if the host is little endian.
+  bool isLittleEndian()
+  {
+    const std::uint16_t one = 1u;
+    unsigned char first;
+    std::memcpy(&first, &one, 1u);
+    return first == 1u;
+  }
+
+  /// \brief Append a little endian integer.
+  template <typename T>
+  void putLE(std::vector<unsigned char> &_out, T _value)
+  {
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      _out.push_back(static_cast<unsigned char>(_value >> (8u * i)));
+  }
+
+  /// \brief Read a little endian integer.
+  template <typename T>
+  T getLE(const unsigned char *_data)
+  {
+    T value = 0;
+    for (std::size_t i = 0; i < sizeof(T); ++i)
+      value |= static_cast<T>(static_cast<T>(_data[i]) << (8u * i));
+    return value;
+  }
+
+  /// \brief Append a big endian 32 bit integer.
+  void putBE32(std::vector<unsigned char> &_out, std::uint32_t _value)
+  {
+    _out.push_back(static_cast<unsigned char>(_value >> 24u));
+    _out.push_back(static_cast<unsigned char>(_value >> 16u));
+    _out.push_back(static_cast<unsigned char>(_value >> 8u));
+    _out.push_back(static_cast<unsigned char>(_value));
+  }
+
+  /// \brief Read a big endian 32 bit integer.
+  std::uint32_t getBE32(const unsigned char *_data)
+  {
+    return (static_cast<std::uint32_t>(_data[0]) << 24u) |
+        (static_cast<std::uint32_t>(_data[1]) << 16u) |
+        (static_cast<std::uint32_t>(_data[2]) << 8u) |
+        static_cast<std::uint32_t>(_data[3]);
+  }
+
+  /// \brief Read 4 bytes in host order, for comparing and hashing.
+  std::uint32_t read32(const unsigned char *_data)
+  {
+    std::uint32_t value;
+    std::memcpy(&value, _data, sizeof(value));
+    return value;
+  }
+
+  /// \brief Rotate left.
+  std::uint32_t rotl(std::uint32_t _value, unsigned int _bits)
+  {
+    return (_value << _bits) | (_value >> (32u - _bits));
+  }
+
+  /// \brief xxHash32, used for the LZ4 frame header checksum.
+  std::uint32_t xxh32(const unsigned char *_data, std::size_t _size,
+      std::uint32_t _seed)
+  {
+    const unsigned char *p = _data;
+    const unsigned char *end = _data + _size;
+    std::uint32_t h;
+
+    if (_size >= 16u)
+    {
+      std::uint32_t v1 = _seed + kPrime1 + kPrime2;
+      std::uint32_t v2 = _seed + kPrime2;
+      std::uint32_t v3 = _seed;
+      std::uint32_t v4 = _seed - kPrime1;
+      for (; p + 16 <= end; p += 16)
+      {
+        v1 = rotl(v1 + getLE<std::uint32_t>(p) * kPrime2, 13u) * kPrime1;
+        v2 = rotl(v2 + getLE<std::uint32_t>(p + 4) * kPrime2, 13u) * kPrime1;
+        v3 = rotl(v3 + getLE<std::uint32_t>(p + 8) * kPrime2, 13u) * kPrime1;
+        v4 = rotl(v4 + getLE<std::uint32_t>(p + 12) * kPrime2, 13u) *
+            kPrime1;
+      }
+      h = rotl(v1, 1u) + rotl(v2, 7u) + rotl(v3, 12u) + rotl(v4, 18u);
+    }
+    else
+    {
+      h = _seed + kPrime5;
+    }
+
+    h += static_cast<std::uint32_t>(_size);
+    for (; p + 4 <= end; p += 4)
+      h = rotl(h + getLE<std::uint32_t>(p) * kPrime3, 17u) * kPrime4;
+    for (; p < end; ++p)
+      h = rotl(h + *p * kPrime5, 11u) * kPrime1;
+
+    h ^= h >> 15u;
+    h *= kPrime2;
+    h ^= h >> 13u;
+    h *= kPrime3;
+    h ^= h >> 16u;
+    return h;
+  }
+
+  /// \brief Read 8 bytes in host order, for comparing.
+  std::uint64_t read64(const unsigned char *_data)
+  {
+    std::uint64_t value;
+    std::memcpy(&value, _data, sizeof(value));
+    return value;
+  }
+
+  /// \brief Worst case size of a compressed LZ4 block.
+  std::size_t lz4Bound(std::size_t _size)
+  {
+    return _size + _size / 255u + 16u;
+  }
+
+  /// \brief Write an LZ4 length continuation.
+  unsigned char *putLz4Length(unsigned char *_dst, std::size_t _length)
+  {
+    for (; _length >= 255u; _length -= 255u)
+      *_dst++ = 255u;
+    *_dst++ = static_cast<unsigned char>(_length);
+    return _dst;
+  }
+
+  /// \brief Write an LZ4 token and its literals. The match part of the
+  /// token is filled in by the caller when there is one.
+  unsigned char *putLz4Literals(unsigned char *_dst,
+      const unsigned char *_literals, std::size_t _literalCount)
+  {
+    *_dst++ = static_cast<unsigned char>(
+        std::min<std::size_t>(_literalCount, 15u) << 4u);
+    if (_literalCount >= 15u)
+      _dst = putLz4Length(_dst, _literalCount - 15u);
+    std::memcpy(_dst, _literals, _literalCount);
+    return _dst + _literalCount;
+  }
+
+  /// \brief Compress one independent LZ4 block.
+  /// \param[in] _src Block data.
+  /// \param[in] _size Size of _src in bytes.
+  /// \param[in,out] _table Hash table scratch space.
+  /// \param[out] _dst Destination with room for lz4Bound(_size) bytes.
+  /// \return Compressed size in bytes.
+  std::size_t compressLz4Block(const unsigned char *_src, std::size_t _size,
+      std::vector<std::int32_t> &_table, unsigned char *_dst)
+  {
+    unsigned char *out = _dst;
+    std::size_t anchor = 0u;
+    if (_size > kLz4MatchFindLimit)
+    {
+      std::fill(_table.begin(), _table.end(), -1);
+      const std::size_t matchLimit = _size - kLz4LastLiterals;
+      const std::size_t inputLimit = _size - kLz4MatchFindLimit;
+
+      std::size_t ip = 0u;
+      unsigned int misses = 0u;
+      while (ip < inputLimit)
+      {
+        const std::uint32_t sequence = read32(_src + ip);
+        const std::uint32_t hash =
+            (sequence * kPrime1) >> (32u - kLz4HashBits);
+        const std::int32_t ref = _table[hash];
+        _table[hash] = static_cast<std::int32_t>(ip);
+
+        if (ref < 0 || ip - static_cast<std::size_t>(ref) > kLz4MaxOffset ||
+            read32(_src + ref) != sequence)
+        {
+          // Skip faster through data that does not compress
+          ip += 1u + (misses++ >> 6u);
+          continue;
+        }
+        misses = 0u;
+
+        // Extend the match a word at a time, then byte by byte
+        std::size_t length = kLz4MinMatch;
+        while (ip + length + 8u <= matchLimit &&
+            read64(_src + ref + length) == read64(_src + ip + length))
+        {
+          length += 8u;
+        }
+        while (ip + length < matchLimit &&
+            _src[ref + length] == _src[ip + length])
+        {
+          ++length;
+        }
+
+        unsigned char *token = out;
+        out = putLz4Literals(out, _src + anchor, ip - anchor);
+        const std::size_t offset = ip - static_cast<std::size_t>(ref);
+        *out++ = static_cast<unsigned char>(offset);
+        *out++ = static_cast<unsigned char>(offset >> 8u);
+        const std::size_t matchCode = length - kLz4MinMatch;
+        *token = static_cast<unsigned char>(*token |
+            std::min<std::size_t>(matchCode, 15u));
+        if (matchCode >= 15u)
+          out = putLz4Length(out, matchCode - 15u);
+
+        ip += length;
+        anchor = ip;
+      }
+    }
+
+    // Last literals
+    out = putLz4Literals(out, _src + anchor, _size - anchor);
+    return static_cast<std::size_t>(out - _dst);
+  }
+
+  /// \brief Read an LZ4 length continuation.
+  bool getLz4Length(const unsigned char *&_p, const unsigned char *_end,
+      std::size_t &_length)
+  {
+    unsigned char byte;
+    do
+    {
+      if (_p >= _end)
+        return false;
+      byte = *_p++;
+      _length += byte;
+    } while (byte == 255u);
+    return true;
+  }
+
+  /// \brief Decompress one LZ4 block, appending to _out. Matches may
+  /// reach back into earlier output for dependent blocks.
+  bool decompressLz4Block(const unsigned char *_src, std::size_t _size,
+      std::vector<unsigned char> &_out)
+  {
+    const unsigned char *p = _src;
+    const unsigned char *end = _src + _size;
+    while (p < end)
+    {
+      const unsigned char token = *p++;
+      std::size_t literalCount = token >> 4u;
+      if (literalCount == 15u && !getLz4Length(p, end, literalCount))
+        return false;
+      if (static_cast<std::size_t>(end - p) < literalCount)
+        return false;
+      _out.insert(_out.end(), p, p + literalCount);
+      p += literalCount;
+
+      // The last sequence has no match
+      if (p == end)
+        break;
+
+      if (end - p < 2)
+        return false;
+      const std::size_t offset = getLE<std::uint16_t>(p);
+      p += 2;
+      std::size_t length = token & 0x0fu;
+      if (length == 15u && !getLz4Length(p, end, length))
+        return false;
+      length += kLz4MinMatch;
+
+      if (offset == 0u || offset > _out.size())
+        return false;
+
+      // Copy byte by byte, matches may overlap their own output
+      std::size_t from = _out.size() - offset;
+      _out.resize(_out.size() + length);
+      unsigned char *dst = _out.data() + _out.size() - length;
+      const unsigned char *ref = _out.data() + from;
+      for (std::size_t i = 0u; i < length; ++i)
+        dst[i] = ref[i];
+    }
+    return true;
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t FrameEncoding::DataTypeSize(DataType _type)
+{
+  switch (_type)
+  {
+    case DataType::UINT16:
+      return 2u;
+    case DataType::FLOAT32:
+      return 4u;
+    default:
+      return 1u;
+  }
+}
+
+//////////////////////////////////////////////////
+void FrameEncoding::EncodeRaw(const RawHeader &_header,
+    const unsigned char *_data, std::vector<unsigned char> &_out)
+{
+  _out.clear();
+  _out.reserve(kRawHeaderSize + _header.dataSize);
+  _out.insert(_out.end(), kRawMagic, kRawMagic + 4);
+  putLE<std::uint16_t>(_out, kRawVersion);
+  _out.push_back(static_cast<unsigned char>(_header.dataType));
+  _out.push_back(_header.channels);
+  putLE<std::uint32_t>(_out, _header.width);
+  putLE<std::uint32_t>(_out, _header.height);
+  putLE<std::uint32_t>(_out, _header.step);
+  putLE<std::uint32_t>(_out, 0u);
+  putLE<std::uint64_t>(_out, _header.dataSize);
+
+  const std::size_t size = static_cast<std::size_t>(_header.dataSize);
+  _out.insert(_out.end(), _data, _data + size);
+
+  // Samples are stored little endian
+  const std::size_t sampleSize = DataTypeSize(_header.dataType);
+  if (sampleSize > 1u && !isLittleEndian())
+  {
+    unsigned char *samples = _out.data() + kRawHeaderSize;
+    for (std::size_t i = 0u; i + sampleSize <= size; i += sampleSize)
+      std::reverse(samples + i, samples + i + sampleSize);
+  }
+}
+
+//////////////////////////////////////////////////
+bool FrameEncoding::DecodeRawHeader(const unsigned char *_data,
+    std::size_t _size, RawHeader &_header)
+{
+  if (_size < kRawHeaderSize || std::memcmp(_data, kRawMagic, 4) != 0 ||
+      getLE<std::uint16_t>(_data + 4) != kRawVersion)
+  {
+    return false;
+  }
+
+  _header.dataType = static_cast<DataType>(_data[6]);
+  _header.channels = _data[7];
+  _header.width = getLE<std::uint32_t>(_data + 8);
+  _header.height = getLE<std::uint32_t>(_data + 12);
+  _header.step = getLE<std::uint32_t>(_data + 16);
+  _header.dataSize = getLE<std::uint64_t>(_data + 24);
+  return _header.dataSize <= _size - kRawHeaderSize;
+}
+
+//////////////////////////////////////////////////
+bool FrameEncoding::EncodeQoi(const unsigned char *_data,
+    unsigned int _width, unsigned int _height, unsigned int _channels,
+    std::vector<unsigned char> &_out)
+{
+  if (_channels != 3u && _channels != 4u)
+    return false;
+
+  const std::size_t pixels = static_cast<std::size_t>(_width) * _height;
+  _out.clear();
+  _out.reserve(kQoiHeaderSize + pixels * (_channels + 1u) +
+      sizeof(kQoiPadding));
+  _out.insert(_out.end(), kQoiMagic, kQoiMagic + 4);
+  putBE32(_out, _width);
+  putBE32(_out, _height);
+  _out.push_back(static_cast<unsigned char>(_channels));
+  // sRGB with linear alpha
+  _out.push_back(0u);
+
+  unsigned char index[64][4] = {};
+  unsigned char prev[4] = {0u, 0u, 0u, 255u};
+  unsigned char px[4] = {0u, 0u, 0u, 255u};
+  unsigned int run = 0u;
+
+  for (std::size_t i = 0u; i < pixels; ++i)
+  {
+    const unsigned char *src = _data + i * _channels;
+    px[0] = src[0];
+    px[1] = src[1];
+    px[2] = src[2];
+    if (_channels == 4u)
+      px[3] = src[3];
+
+    if (std::memcmp(px, prev, 4) == 0)
+    {
+      ++run;
+      if (run == 62u || i + 1u == pixels)
+      {
+        _out.push_back(static_cast<unsigned char>(kQoiOpRun | (run - 1u)));
+        run = 0u;
+      }
+      continue;
+    }
+
+    if (run > 0u)
+    {
+      _out.push_back(static_cast<unsigned char>(kQoiOpRun | (run - 1u)));
+      run = 0u;
+    }
+
+    const unsigned int hash =
+        (px[0] * 3u + px[1] * 5u + px[2] * 7u + px[3] * 11u) % 64u;
+    if (std::memcmp(index[hash], px, 4) == 0)
+    {
+      _out.push_back(static_cast<unsigned char>(kQoiOpIndex | hash));
+    }
+    else
+    {
+      std::memcpy(index[hash], px, 4);
+      if (px[3] == prev[3])
+      {
+        const int vr = static_cast<signed char>(px[0] - prev[0]);
+        const int vg = static_cast<signed char>(px[1] - prev[1]);
+        const int vb = static_cast<signed char>(px[2] - prev[2]);
+        const int vgr = vr - vg;
+        const int vgb = vb - vg;
+        if (vr > -3 && vr < 2 && vg > -3 && vg < 2 && vb > -3 && vb < 2)
+        {
+          _out.push_back(static_cast<unsigned char>(kQoiOpDiff |
+              (vr + 2) << 4 | (vg + 2) << 2 | (vb + 2)));
+        }
+        else if (vgr > -9 && vgr < 8 && vg > -33 && vg < 32 &&
+            vgb > -9 && vgb < 8)
+        {
+          _out.push_back(static_cast<unsigned char>(kQoiOpLuma | (vg + 32)));
+          _out.push_back(static_cast<unsigned char>((vgr + 8) << 4 |
+              (vgb + 8)));
+        }
+        else
+        {
+          _out.push_back(kQoiOpRgb);
+          _out.insert(_out.end(), px, px + 3);
+        }
+      }
+      else
+      {
+        _out.push_back(kQoiOpRgba);
+        _out.insert(_out.end(), px, px + 4);
+      }
+    }
+    std::memcpy(prev, px, 4);
+  }
+
+  _out.insert(_out.end(), kQoiPadding, kQoiPadding + sizeof(kQoiPadding));
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool FrameEncoding::DecodeQoi(const unsigned char *_data, std::size_t _size,
+    unsigned int &_width, unsigned int &_height, unsigned int &_channels,
+    std::vector<unsigned char> &_out)
+{
+  if (_size < kQoiHeaderSize + sizeof(kQoiPadding) ||
+      std::memcmp(_data, kQoiMagic, 4) != 0)
+  {
+    return false;
+  }
+
+  _width = getBE32(_data + 4);
+  _height = getBE32(_data + 8);
+  _channels = _data[12];
+  if (_channels != 3u && _channels != 4u)
+    return false;
+
+  const std::size_t pixels = static_cast<std::size_t>(_width) * _height;
+  _out.resize(pixels * _channels);
+
+  unsigned char index[64][4] = {};
+  unsigned char px[4] = {0u, 0u, 0u, 255u};
+  const unsigned char *p = _data + kQoiHeaderSize;
+  const unsigned char *end = _data + _size - sizeof(kQoiPadding);
+  unsigned int run = 0u;
+
+  for (std::size_t i = 0u; i < pixels; ++i)
+  {
+    if (run > 0u)
+    {
+      --run;
+    }
+    else
+    {
+      if (p >= end)
+        return false;
+      const unsigned char b1 = *p++;
+      if (b1 == kQoiOpRgb)
+      {
+        if (end - p < 3)
+          return false;
+        px[0] = p[0];
+        px[1] = p[1];
+        px[2] = p[2];
+        p += 3;
+      }
+      else if (b1 == kQoiOpRgba)
+      {
+        if (end - p < 4)
+          return false;
+        std::memcpy(px, p, 4);
+        p += 4;
+      }
+      else if ((b1 & kQoiMask) == kQoiOpIndex)
+      {
+        std::memcpy(px, index[b1], 4);
+      }
+      else if ((b1 & kQoiMask) == kQoiOpDiff)
+      {
+        px[0] = static_cast<unsigned char>(px[0] + ((b1 >> 4) & 0x03) - 2);
+        px[1] = static_cast<unsigned char>(px[1] + ((b1 >> 2) & 0x03) - 2);
+        px[2] = static_cast<unsigned char>(px[2] + (b1 & 0x03) - 2);
+      }
+      else if ((b1 & kQoiMask) == kQoiOpLuma)
+      {
+        if (p >= end)
+          return false;
+        const unsigned char b2 = *p++;
+        const int vg = (b1 & 0x3f) - 32;
+        px[0] = static_cast<unsigned char>(px[0] + vg - 8 + ((b2 >> 4) & 0x0f));
+        px[1] = static_cast<unsigned char>(px[1] + vg);
+        px[2] = static_cast<unsigned char>(px[2] + vg - 8 + (b2 & 0x0f));
+      }
+      else
+      {
+        run = b1 & 0x3fu;
+      }
+
+      const unsigned int hash =
+          (px[0] * 3u + px[1] * 5u + px[2] * 7u + px[3] * 11u) % 64u;
+      std::memcpy(index[hash], px, 4);
+    }
+
+    std::memcpy(_out.data() + i * _channels, px, _channels);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void FrameEncoding::CompressLz4(const unsigned char *_data, std::size_t _size,
+    std::vector<unsigned char> &_out)
+{
+  _out.clear();
+  // Room for the compressor's worst case, incompressible blocks are then
+  // stored as they are
+  _out.reserve(lz4Bound(_size) + (_size / kLz4BlockSize + 1u) * 20u + 19u);
+
+  putLE<std::uint32_t>(_out, kLz4Magic);
+  const std::size_t descriptor = _out.size();
+  // Version 01, independent blocks, content size present
+  _out.push_back(0x68u);
+  // 4 MiB maximum block size
+  _out.push_back(0x70u);
+  putLE<std::uint64_t>(_out, static_cast<std::uint64_t>(_size));
+  _out.push_back(static_cast<unsigned char>(
+      xxh32(_out.data() + descriptor, _out.size() - descriptor, 0u) >> 8u));
+
+  std::vector<std::int32_t> table(1u << kLz4HashBits);
+  for (std::size_t offset = 0u; offset < _size; offset += kLz4BlockSize)
+  {
+    const std::size_t blockSize = std::min(kLz4BlockSize, _size - offset);
+    const std::size_t sizePos = _out.size();
+    _out.resize(sizePos + 4u + lz4Bound(blockSize));
+    std::size_t compressed = compressLz4Block(_data + offset, blockSize,
+        table, _out.data() + sizePos + 4u);
+    _out.resize(sizePos + 4u + compressed);
+
+    std::uint32_t blockHeader = static_cast<std::uint32_t>(compressed);
+    if (compressed >= blockSize)
+    {
+      // Store the block uncompressed, flagged by the high bit
+      _out.resize(sizePos + 4u);
+      _out.insert(_out.end(), _data + offset, _data + offset + blockSize);
+      blockHeader = static_cast<std::uint32_t>(blockSize) | 0x80000000u;
+    }
+    for (std::size_t i = 0u; i < 4u; ++i)
+      _out[sizePos + i] = static_cast<unsigned char>(blockHeader >> (8u * i));
+  }
+
+  // End mark
+  putLE<std::uint32_t>(_out, 0u);
+}
+
+//////////////////////////////////////////////////
+bool FrameEncoding::DecompressLz4(const unsigned char *_data,
+    std::size_t _size, std::vector<unsigned char> &_out)
+{
+  _out.clear();
+  if (_size < 7u || getLE<std::uint32_t>(_data) != kLz4Magic)
+    return false;
+
+  const unsigned char *p = _data + 4;
+  const unsigned char *end = _data + _size;
+  const unsigned char flags = p[0];
+  if ((flags >> 6u) != 1u || (flags & 0x01u))
+    return false;
+  const bool blockChecksum = (flags & 0x10u) != 0u;
+  const bool contentSizeSet = (flags & 0x08u) != 0u;
+  const bool contentChecksum = (flags & 0x04u) != 0u;
+
+  const std::size_t descriptorSize = contentSizeSet ? 10u : 2u;
+  if (static_cast<std::size_t>(end - p) < descriptorSize + 1u)
+    return false;
+  const unsigned char checksum = static_cast<unsigned char>(
+      xxh32(p, descriptorSize, 0u) >> 8u);
+  if (checksum != p[descriptorSize])
+    return false;
+  if (contentSizeSet)
+    _out.reserve(static_cast<std::size_t>(getLE<std::uint64_t>(p + 2)));
+  p += descriptorSize + 1u;
+
+  while (true)
+  {
+    if (end - p < 4)
+      return false;
+    const std::uint32_t blockHeader = getLE<std::uint32_t>(p);
+    p += 4;
+    if (blockHeader == 0u)
+      break;
+
+    const std::size_t blockSize = blockHeader & 0x7fffffffu;
+    if (static_cast<std::size_t>(end - p) < blockSize)
+      return false;
+    if (blockHeader & 0x80000000u)
+      _out.insert(_out.end(), p, p + blockSize);
+    else if (!decompressLz4Block(p, blockSize, _out))
+      return false;
+    p += blockSize;
+    if (blockChecksum)
+      p += 4;
+  }
+
+  if (contentChecksum && end - p < 4)
+    return false;
+  return !contentSizeSet ||
+      _out.size() == getLE<std::uint64_t>(_data + 6);
+}
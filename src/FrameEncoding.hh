@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_FRAMEENCODING_HH_
+#define GZ_SENSORS_FRAMEENCODING_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define FrameEncoding_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define FrameEncoding_EXPORTS_API __declspec(dllexport)
+#  else
+#    define FrameEncoding_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Encoders for the fast frame dump formats the ImageSaver class
+    /// writes, and matching decoders for tools that read the dumps back.
+    ///
+    /// Raw dumps are a 32 byte header followed by the samples, all little
+    /// endian:
+    ///
+    ///     offset  size  field
+    ///          0     4  magic "IGNF"
+    ///          4     2  version, 1
+    ///          6     1  data type, see DataType
+    ///          7     1  channels per pixel
+    ///          8     4  width in pixels
+    ///         12     4  height in pixels
+    ///         16     4  row step in bytes
+    ///         20     4  reserved, 0
+    ///         24     8  data size in bytes
+    ///
+    /// QOI follows https://qoiformat.org/qoi-specification.pdf for RGB and
+    /// RGBA images. LZ4 output is a standard LZ4 frame with independent
+    /// blocks of up to 4 MiB and the content size set, so `lz4 -d` can
+    /// unpack it.
+    class FrameEncoding_EXPORTS_API FrameEncoding
+    {
+      /// \brief Sample types of a raw dump.
+      public: enum class DataType : std::uint8_t
+      {
+        /// \brief Unsigned 8 bit integer.
+        UINT8 = 1,
+
+        /// \brief Unsigned 16 bit integer.
+        UINT16 = 2,
+
+        /// \brief 32 bit float.
+        FLOAT32 = 3
+      };
+
+      /// \brief Description of the image in a raw dump.
+      public: struct RawHeader
+      {
+        /// \brief Sample type.
+        DataType dataType = DataType::UINT8;
+
+        /// \brief Channels per pixel.
+        std::uint8_t channels = 0u;
+
+        /// \brief Width in pixels.
+        std::uint32_t width = 0u;
+
+        /// \brief Height in pixels.
+        std::uint32_t height = 0u;
+
+        /// \brief Row step in bytes.
+        std::uint32_t step = 0u;
+
+        /// \brief Size of the samples in bytes.
+        std::uint64_t dataSize = 0u;
+      };
+
+      /// \brief Size of an encoded raw header.
+      public: static constexpr std::size_t kRawHeaderSize = 32u;
+
+      /// \brief Get the size of a sample type.
+      /// \param[in] _type Sample type.
+      /// \return Size in bytes.
+      public: static std::size_t DataTypeSize(DataType _type);
+
+      /// \brief Encode a raw dump.
+      /// \param[in] _header Image description. dataSize is the number of
+      /// bytes read from _data.
+      /// \param[in] _data Samples in host byte order.
+      /// \param[out] _out Encoded dump, replaces the previous contents.
+      public: static void EncodeRaw(const RawHeader &_header,
+          const unsigned char *_data, std::vector<unsigned char> &_out);
+
+      /// \brief Decode the header of a raw dump.
+      /// \param[in] _data Encoded dump.
+      /// \param[in] _size Size of _data in bytes.
+      /// \param[out] _header Image description.
+      /// \return False if _data is not a raw dump or is truncated. The
+      /// samples start kRawHeaderSize bytes into _data, in little endian
+      /// byte order.
+      public: static bool DecodeRawHeader(const unsigned char *_data,
+          std::size_t _size, RawHeader &_header);
+
+      /// \brief Encode a QOI image.
+      /// \param[in] _data Pixels, tightly packed.
+      /// \param[in] _width Width in pixels.
+      /// \param[in] _height Height in pixels.
+      /// \param[in] _channels 3 for RGB or 4 for RGBA.
+      /// \param[out] _out Encoded image, replaces the previous contents.
+      /// \return False if the channel count is not supported.
+      public: static bool EncodeQoi(const unsigned char *_data,
+          unsigned int _width, unsigned int _height, unsigned int _channels,
+          std::vector<unsigned char> &_out);
+
+      /// \brief Decode a QOI image.
+      /// \param[in] _data Encoded image.
+      /// \param[in] _size Size of _data in bytes.
+      /// \param[out] _width Width in pixels.
+      /// \param[out] _height Height in pixels.
+      /// \param[out] _channels Channels per pixel.
+      /// \param[out] _out Pixels, tightly packed.
+      /// \return False if _data is not a valid QOI image.
+      public: static bool DecodeQoi(const unsigned char *_data,
+          std::size_t _size, unsigned int &_width, unsigned int &_height,
+          unsigned int &_channels, std::vector<unsigned char> &_out);
+
+      /// \brief Compress data into an LZ4 frame.
+      /// \param[in] _data Data to compress.
+      /// \param[in] _size Size of _data in bytes.
+      /// \param[out] _out LZ4 frame, replaces the previous contents.
+      public: static void CompressLz4(const unsigned char *_data,
+          std::size_t _size, std::vector<unsigned char> &_out);
+
+      /// \brief Decompress an LZ4 frame.
+      /// \param[in] _data LZ4 frame.
+      /// \param[in] _size Size of _data in bytes.
+      /// \param[out] _out Decompressed data, replaces the previous contents.
+      /// \return False if _data is not a valid LZ4 frame or uses features
+      /// other than those CompressLz4() writes, except that dependent
+      /// blocks, block checksums and content checksums are accepted.
+      public: static bool DecompressLz4(const unsigned char *_data,
+          std::size_t _size, std::vector<unsigned char> &_out);
+    };
+    }
+  }
+}
+
+#endif
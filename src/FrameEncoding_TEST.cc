@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "FrameEncoding.hh"
+
+using namespace ignition;
+using namespace sensors;
+
+/// \brief Fill a buffer with a mix of runs, gradients and noise, so that
+/// every encoder path is used.
+/// \param[in] _size Size in bytes.
+/// \return The data.
+static std::vector<unsigned char> testData(std::size_t _size)
+{
+  std::vector<unsigned char> data(_size);
+  std::uint32_t seed = 1u;
+  for (std::size_t i = 0u; i < _size; ++i)
+  {
+    seed = seed * 1103515245u + 12345u;
+    switch ((i / 251u) % 3u)
+    {
+      case 0:
+        data[i] = 10u;
+        break;
+      case 1:
+        data[i] = static_cast<unsigned char>(i / 3u);
+        break;
+      default:
+        data[i] = static_cast<unsigned char>(seed >> 16u);
+        break;
+    }
+  }
+  return data;
+}
+
+//////////////////////////////////////////////////
+TEST(FrameEncoding_TEST, Raw)
+{
+  const float depth[6] = {0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f};
+  FrameEncoding::RawHeader header;
+  header.dataType = FrameEncoding::DataType::FLOAT32;
+  header.channels = 1u;
+  header.width = 3u;
+  header.height = 2u;
+  header.step = 3u * sizeof(float);
+  header.dataSize = sizeof(depth);
+
+  std::vector<unsigned char> raw;
+  FrameEncoding::EncodeRaw(header,
+      reinterpret_cast<const unsigned char *>(depth), raw);
+  ASSERT_EQ(FrameEncoding::kRawHeaderSize + sizeof(depth), raw.size());
+  EXPECT_EQ(0, std::memcmp(raw.data(), "IGNF", 4));
+
+  FrameEncoding::RawHeader decoded;
+  ASSERT_TRUE(FrameEncoding::DecodeRawHeader(raw.data(), raw.size(),
+      decoded));
+  EXPECT_EQ(FrameEncoding::DataType::FLOAT32, decoded.dataType);
+  EXPECT_EQ(1u, decoded.channels);
+  EXPECT_EQ(3u, decoded.width);
+  EXPECT_EQ(2u, decoded.height);
+  EXPECT_EQ(12u, decoded.step);
+  EXPECT_EQ(sizeof(depth), decoded.dataSize);
+  EXPECT_EQ(0, std::memcmp(depth, raw.data() + FrameEncoding::kRawHeaderSize,
+      sizeof(depth)));
+
+  // Truncated and foreign data
+  EXPECT_FALSE(FrameEncoding::DecodeRawHeader(raw.data(), raw.size() - 1u,
+      decoded));
+  raw[0] = 'X';
+  EXPECT_FALSE(FrameEncoding::DecodeRawHeader(raw.data(), raw.size(),
+      decoded));
+}
+
+//////////////////////////////////////////////////
+TEST(FrameEncoding_TEST, Qoi)
+{
+  const unsigned int width = 67u;
+  const unsigned int height = 33u;
+  for (unsigned int channels : {3u, 4u})
+  {
+    std::vector<unsigned char> image = testData(width * height * channels);
+
+    std::vector<unsigned char> encoded;
+    ASSERT_TRUE(FrameEncoding::EncodeQoi(image.data(), width, height,
+        channels, encoded));
+    EXPECT_EQ(0, std::memcmp(encoded.data(), "qoif", 4));
+    EXPECT_LT(encoded.size(), image.size());
+
+    std::vector<unsigned char> decoded;
+    unsigned int w = 0u;
+    unsigned int h = 0u;
+    unsigned int c = 0u;
+    ASSERT_TRUE(FrameEncoding::DecodeQoi(encoded.data(), encoded.size(), w,
+        h, c, decoded));
+    EXPECT_EQ(width, w);
+    EXPECT_EQ(height, h);
+    EXPECT_EQ(channels, c);
+    EXPECT_EQ(image, decoded);
+  }
+
+  std::vector<unsigned char> encoded;
+  unsigned char gray[4] = {0u, 0u, 0u, 0u};
+  EXPECT_FALSE(FrameEncoding::EncodeQoi(gray, 2u, 2u, 1u, encoded));
+}
+
+//////////////////////////////////////////////////
+TEST(FrameEncoding_TEST, Lz4)
+{
+  // Sizes around the block format limits, and more than one 4 MiB block
+  for (std::size_t size : {0u, 1u, 5u, 12u, 13u, 1000u, 9u * 1024u * 1024u})
+  {
+    std::vector<unsigned char> data = testData(size);
+
+    std::vector<unsigned char> compressed;
+    FrameEncoding::CompressLz4(data.data(), data.size(), compressed);
+    // Frame magic
+    ASSERT_GE(compressed.size(), 4u);
+    EXPECT_EQ(0x04u, compressed[0]);
+    EXPECT_EQ(0x22u, compressed[1]);
+    EXPECT_EQ(0x4Du, compressed[2]);
+    EXPECT_EQ(0x18u, compressed[3]);
+    if (size >= 1000u)
+    {
+      EXPECT_LT(compressed.size(), data.size()) << size;
+    }
+
+    std::vector<unsigned char> decompressed;
+    ASSERT_TRUE(FrameEncoding::DecompressLz4(compressed.data(),
+        compressed.size(), decompressed)) << size;
+    EXPECT_EQ(data, decompressed) << size;
+
+    // A corrupt header checksum is detected
+    if (size > 0u)
+    {
+      compressed[6] ^= 0xffu;
+      EXPECT_FALSE(FrameEncoding::DecompressLz4(compressed.data(),
+          compressed.size(), decompressed)) << size;
+    }
+  }
+
+  // Data that does not compress is stored as it is
+  std::vector<unsigned char> noise(4096u);
+  std::uint32_t seed = 7u;
+  for (auto &byte : noise)
+  {
+    seed = seed * 1103515245u + 12345u;
+    byte = static_cast<unsigned char>(seed >> 16u);
+  }
+  std::vector<unsigned char> compressed;
+  FrameEncoding::CompressLz4(noise.data(), noise.size(), compressed);
+  EXPECT_EQ(noise.size() + 23u, compressed.size());
+  std::vector<unsigned char> decompressed;
+  ASSERT_TRUE(FrameEncoding::DecompressLz4(compressed.data(),
+      compressed.size(), decompressed));
+  EXPECT_EQ(noise, decompressed);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstddef>
+
+#include "GaussianImageNoise.hh"
+#include "ParallelRows.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Bits of the noise table index.
+  constexpr unsigned int kTableBits = 12u;
+
+  /// \brief Number of entries of the noise table.
+  constexpr std::size_t kTableSize = std::size_t(1u) << kTableBits;
+
+  /// \brief Mask of a noise table index.
+  constexpr std::uint64_t kTableMask = kTableSize - 1u;
+
+  /// \brief Standard normal quantiles at the centers of kTableSize equal
+  /// probability bins.
+  const std::vector<double> &quantiles()
+  {
+    static const std::vector<double> values = []
+    {
+      std::vector<double> q(kTableSize);
+      for (std::size_t i = 0; i < kTableSize; ++i)
+      {
+        // Bisect the normal CDF, 0.5 * erfc(-z / sqrt(2))
+        const double p = (static_cast<double>(i) + 0.5) / kTableSize;
+        double low = -10.0;
+        double high = 10.0;
+        for (int iteration = 0; iteration < 64; ++iteration)
+        {
+          const double z = 0.5 * (low + high);
+          if (0.5 * std::erfc(-z / std::sqrt(2.0)) < p)
+            low = z;
+          else
+            high = z;
+        }
+        q[i] = 0.5 * (low + high);
+      }
+      return q;
+    }();
+    return values;
+  }
+
+  /// \brief SplitMix64, a fast generator that passes BigCrush.
+  /// \param[in,out] _state Generator state.
+  /// \return Next random number.
+  inline std::uint64_t splitMix64(std::uint64_t &_state)
+  {
+    std::uint64_t z = (_state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+  }
+
+  /// \brief Add noise to a row.
+  /// \param[in,out] _row Row data.
+  /// \param[in] _count Number of channels in the row.
+  /// \param[in] _table Noise table.
+  /// \param[in] _state Generator state of the row.
+  /// \param[in] _maxValue Full intensity.
+  /// \param[out] _noise Scratch space for _count samples.
+  template <typename T>
+  void addNoise(T *_row, std::size_t _count, const std::int32_t *_table,
+      std::uint64_t _state, std::int32_t _maxValue, std::int32_t *_noise)
+  {
+    // Four table indices from each random number
+    std::size_t i = 0;
+    for (; i + 4u <= _count; i += 4u)
+    {
+      const std::uint64_t r = splitMix64(_state);
+      _noise[i] = _table[r & kTableMask];
+      _noise[i + 1u] = _table[(r >> 16) & kTableMask];
+      _noise[i + 2u] = _table[(r >> 32) & kTableMask];
+      _noise[i + 3u] = _table[(r >> 48) & kTableMask];
+    }
+    if (i < _count)
+    {
+      const std::uint64_t r = splitMix64(_state);
+      for (unsigned int shift = 0u; i < _count; ++i, shift += 16u)
+        _noise[i] = _table[(r >> shift) & kTableMask];
+    }
+
+    // Branch free so that the compiler vectorizes it
+    for (i = 0; i < _count; ++i)
+    {
+      std::int32_t value = static_cast<std::int32_t>(_row[i]) + _noise[i];
+      value = value < 0 ? 0 : value;
+      value = value > _maxValue ? _maxValue : value;
+      _row[i] = static_cast<T>(value);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+GaussianImageNoise::GaussianImageNoise()
+  : table(kTableSize, 0)
+{
+}
+
+//////////////////////////////////////////////////
+void GaussianImageNoise::SetParameters(double _mean, double _stdDev)
+{
+  this->mean = _mean;
+  this->stdDev = _stdDev;
+  this->tableMaxValue = 0;
+}
+
+//////////////////////////////////////////////////
+void GaussianImageNoise::SetSeed(std::uint64_t _seed)
+{
+  this->seed = _seed;
+  this->frame = 0u;
+}
+
+//////////////////////////////////////////////////
+void GaussianImageNoise::BuildTable(std::int32_t _maxValue)
+{
+  const std::vector<double> &q = quantiles();
+  for (std::size_t i = 0; i < kTableSize; ++i)
+  {
+    this->table[i] = static_cast<std::int32_t>(
+        std::lround((this->mean + this->stdDev * q[i]) * _maxValue));
+  }
+  this->tableMaxValue = _maxValue;
+}
+
+//////////////////////////////////////////////////
+bool GaussianImageNoise::Apply(unsigned char *_data, unsigned int _width,
+    unsigned int _height, unsigned int _channels,
+    unsigned int _bytesPerChannel)
+{
+  if (_bytesPerChannel != 1u && _bytesPerChannel != 2u)
+    return false;
+
+  const std::int32_t maxValue = _bytesPerChannel == 1u ? 255 : 65535;
+  if (this->tableMaxValue != maxValue)
+    this->BuildTable(maxValue);
+
+  // Every row has its own generator, derived from the seed and frame number
+  std::uint64_t frameState =
+      this->seed ^ (this->frame++ * 0xD1B54A32D192ED03ull);
+  const std::uint64_t frameSeed = splitMix64(frameState);
+  const std::size_t count = static_cast<std::size_t>(_width) * _channels;
+  const std::int32_t *noiseTable = this->table.data();
+
+  ParallelRows::Instance().Run(_height,
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        thread_local std::vector<std::int32_t> noise;
+        noise.resize(count);
+        for (unsigned int row = _begin; row < _end; ++row)
+        {
+          std::uint64_t rowState =
+              frameSeed ^ (row * 0xA0761D6478BD642Full);
+          const std::uint64_t state = splitMix64(rowState);
+          if (_bytesPerChannel == 1u)
+          {
+            addNoise(_data + row * count, count, noiseTable, state,
+                maxValue, noise.data());
+          }
+          else
+          {
+            addNoise(reinterpret_cast<std::uint16_t *>(_data) + row * count,
+                count, noiseTable, state, maxValue, noise.data());
+          }
+        }
+      });
+  return true;
+}
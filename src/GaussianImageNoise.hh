@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_GAUSSIANIMAGENOISE_HH_
+#define GZ_SENSORS_GAUSSIANIMAGENOISE_HH_
+
+#include <cstdint>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define GaussianImageNoise_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define GaussianImageNoise_EXPORTS_API __declspec(dllexport)
+#  else
+#    define GaussianImageNoise_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Adds Gaussian noise to images on the CPU, for render engines
+    /// without a Gaussian noise render pass. The ImageGaussianNoiseModel
+    /// class uses this.
+    ///
+    /// Like the render pass, mean and standard deviation are fractions of
+    /// the full intensity range. Samples come from a table of normal
+    /// quantiles indexed by a counter based generator, which makes the
+    /// noise of a frame depend only on the seed and the frame number, not on
+    /// the number of threads. The table truncates the distribution at about
+    /// 3.5 standard deviations.
+    class GaussianImageNoise_EXPORTS_API GaussianImageNoise
+    {
+      /// \brief Constructor.
+      public: GaussianImageNoise();
+
+      /// \brief Set the distribution.
+      /// \param[in] _mean Mean, as a fraction of the full intensity.
+      /// \param[in] _stdDev Standard deviation, as a fraction of the full
+      /// intensity.
+      public: void SetParameters(double _mean, double _stdDev);
+
+      /// \brief Set the seed and restart the frame count.
+      /// \param[in] _seed Seed.
+      public: void SetSeed(std::uint64_t _seed);
+
+      /// \brief Add noise to every channel of an image, in place, clamping
+      /// to the range of the channel type. Each call uses the next frame of
+      /// the noise sequence.
+      /// \param[in,out] _data Image data.
+      /// \param[in] _width Width in pixels.
+      /// \param[in] _height Height in pixels.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _bytesPerChannel Bytes per channel, 1 or 2.
+      /// \return False if the channel type is not supported.
+      public: bool Apply(unsigned char *_data, unsigned int _width,
+          unsigned int _height, unsigned int _channels,
+          unsigned int _bytesPerChannel);
+
+      /// \brief Fill the noise table for a channel type.
+      /// \param[in] _maxValue Full intensity of the channel type.
+      private: void BuildTable(std::int32_t _maxValue);
+
+      /// \brief Mean.
+      private: double mean = 0.0;
+
+      /// \brief Standard deviation.
+      private: double stdDev = 0.0;
+
+      /// \brief Seed.
+      private: std::uint64_t seed = 0u;
+
+      /// \brief Number of frames noise was added to since the seed was set.
+      private: std::uint64_t frame = 0u;
+
+      /// \brief Noise in intensity units, one entry per quantile.
+      private: std::vector<std::int32_t> table;
+
+      /// \brief Full intensity the table was built for, zero if it needs
+      /// to be built.
+      private: std::int32_t tableMaxValue = 0;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "GaussianImageNoise.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(GaussianImageNoise_TEST, Distribution)
+{
+  // Mid grey RGB image
+  const unsigned int width = 320u;
+  const unsigned int height = 240u;
+  std::vector<unsigned char> image(width * height * 3u, 128u);
+
+  GaussianImageNoise noise;
+  noise.SetParameters(0.02, 0.04);
+  noise.SetSeed(1u);
+  ASSERT_TRUE(noise.Apply(image.data(), width, height, 3u, 1u));
+
+  double sum = 0.0;
+  double sumSq = 0.0;
+  for (unsigned char value : image)
+  {
+    const double d = value - 128.0;
+    sum += d;
+    sumSq += d * d;
+  }
+  const double mean = sum / image.size();
+  const double stdDev = std::sqrt(sumSq / image.size() - mean * mean);
+  EXPECT_NEAR(0.02 * 255.0, mean, 0.1);
+  EXPECT_NEAR(0.04 * 255.0, stdDev, 0.1);
+
+  EXPECT_FALSE(noise.Apply(image.data(), width, height, 3u, 4u));
+}
+
+//////////////////////////////////////////////////
+TEST(GaussianImageNoise_TEST, Sequence)
+{
+  const std::vector<unsigned char> clean(64u * 48u, 100u);
+
+  GaussianImageNoise noise;
+  noise.SetParameters(0.0, 0.1);
+  noise.SetSeed(7u);
+  std::vector<unsigned char> first = clean;
+  std::vector<unsigned char> second = clean;
+  ASSERT_TRUE(noise.Apply(first.data(), 64u, 48u, 1u, 1u));
+  ASSERT_TRUE(noise.Apply(second.data(), 64u, 48u, 1u, 1u));
+  EXPECT_NE(clean, first);
+  EXPECT_NE(first, second);
+
+  // The same seed gives the same frames
+  noise.SetSeed(7u);
+  std::vector<unsigned char> again = clean;
+  ASSERT_TRUE(noise.Apply(again.data(), 64u, 48u, 1u, 1u));
+  EXPECT_EQ(first, again);
+
+  // A different seed does not
+  noise.SetSeed(8u);
+  again = clean;
+  ASSERT_TRUE(noise.Apply(again.data(), 64u, 48u, 1u, 1u));
+  EXPECT_NE(first, again);
+}
+
+//////////////////////////////////////////////////
+TEST(GaussianImageNoise_TEST, Clamp)
+{
+  GaussianImageNoise noise;
+  noise.SetParameters(0.0, 0.5);
+  noise.SetSeed(3u);
+
+  std::vector<unsigned char> black(1000u, 0u);
+  ASSERT_TRUE(noise.Apply(black.data(), 1000u, 1u, 1u, 1u));
+  unsigned int zeros = 0u;
+  for (unsigned char value : black)
+    zeros += value == 0u;
+  // Negative noise clamps to zero
+  EXPECT_GT(zeros, 400u);
+  EXPECT_LT(zeros, 600u);
+
+  // 16 bit channels clamp at 65535
+  std::vector<std::uint16_t> white(999u, 65535u);
+  ASSERT_TRUE(noise.Apply(reinterpret_cast<unsigned char *>(white.data()),
+      333u, 1u, 3u, 2u));
+  unsigned int saturated = 0u;
+  for (std::uint16_t value : white)
+    saturated += value == 65535u;
+  EXPECT_GT(saturated, 400u);
+  EXPECT_LT(saturated, 600u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
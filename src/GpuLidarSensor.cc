@@ -70,6 +70,9 @@ class gz::sensors::GpuLidarSensorPrivate
 
   /// \brief Publisher for the publish point cloud message.
   public: transport::Node::Publisher pointPub;
+
+  /// \brief Number of floats allocated in Lidar::laserBuffer.
+  public: unsigned int laserBufferSamples = 0u;
 };
 
 //////////////////////////////////////////////////
@@ -248,8 +251,14 @@ void GpuLidarSensor::OnNewLidarFrame(const float *_data,
   unsigned int samples = _width * _height * _channels;
   unsigned int lidarBufferSize = samples * sizeof(float);
 
-  if (!this->laserBuffer)
+  // Lidar owns laserBuffer and frees it with delete [], so it is
+  // reallocated here rather than taken from the frame buffer pool
+  if (!this->laserBuffer || this->dataPtr->laserBufferSamples != samples)
+  {
+    delete [] this->laserBuffer;
     this->laserBuffer = new float[samples];
+    this->dataPtr->laserBufferSamples = samples;
+  }
 
   memcpy(this->laserBuffer, _data, lidarBufferSize);
 
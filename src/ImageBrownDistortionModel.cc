@@ -32,6 +32,7 @@
 #include <ignition/rendering/RenderEngine.hh>
 #include <ignition/rendering/RenderPass.hh>
 #include <ignition/rendering/RenderPassSystem.hh>
+#include <ignition/rendering/Utils.hh>
 #ifdef _WIN32
 #pragma warning(pop)
 #endif
@@ -63,6 +64,13 @@ class ignition::sensors::ImageBrownDistortionModelPrivate
 
   /// \brief The distortion pass.
   public: rendering::DistortionPassPtr distortionPass;
+
+  /// \brief Camera, used for its intrinsics when distorting on the CPU.
+  public: rendering::CameraPtr camera;
+
+  /// \brief True if images are distorted on the CPU because the render
+  /// engine has no distortion pass.
+  public: bool cpuFallback = false;
 };
 
 //////////////////////////////////////////////////
@@ -81,7 +89,7 @@ ImageBrownDistortionModel::~ImageBrownDistortionModel()
 //////////////////////////////////////////////////
 void ImageBrownDistortionModel::Load(const sdf::Camera &_sdf)
 {
-  Distortion::Load(_sdf);
+  BrownDistortionModel::Load(_sdf);
 
   this->dataPtr->k1 = _sdf.DistortionK1();
   this->dataPtr->k2 = _sdf.DistortionK2();
@@ -102,28 +110,52 @@ void ImageBrownDistortionModel::SetCamera(rendering::CameraPtr _camera)
 
   rendering::RenderEngine *engine = _camera->Scene()->Engine();
   rendering::RenderPassSystemPtr rpSystem = engine->RenderPassSystem();
+  rendering::RenderPassPtr distortionPass;
   if (rpSystem)
+    distortionPass = rpSystem->Create<rendering::DistortionPass>();
+  if (!distortionPass)
   {
-    // add distortion pass
-    rendering::RenderPassPtr distortionPass =
-      rpSystem->Create<rendering::DistortionPass>();
-    if (!distortionPass)
-    {
-      ignwarn << "ImageBrownDistortionModel is not supported in "
-              << engine->Name() << std::endl;
-      return;
-    }
-    this->dataPtr->distortionPass =
-        std::dynamic_pointer_cast<rendering::DistortionPass>(distortionPass);
-    this->dataPtr->distortionPass->SetK1(this->dataPtr->k1);
-    this->dataPtr->distortionPass->SetK2(this->dataPtr->k2);
-    this->dataPtr->distortionPass->SetK3(this->dataPtr->k3);
-    this->dataPtr->distortionPass->SetP1(this->dataPtr->p1);
-    this->dataPtr->distortionPass->SetP2(this->dataPtr->p2);
-    this->dataPtr->distortionPass->SetCenter(this->dataPtr->lensCenter);
-    this->dataPtr->distortionPass->SetEnabled(true);
-    _camera->AddRenderPass(this->dataPtr->distortionPass);
+    // Sensors that call ApplyToImage() still get distorted images. The
+    // distortion table is built on the first image, once the camera
+    // projection is final
+    ignwarn << "ImageBrownDistortionModel is not supported in "
+            << engine->Name() << std::endl;
+    this->dataPtr->camera = _camera;
+    this->dataPtr->cpuFallback = true;
+    return;
   }
+
+  this->dataPtr->distortionPass =
+      std::dynamic_pointer_cast<rendering::DistortionPass>(distortionPass);
+  this->dataPtr->distortionPass->SetK1(this->dataPtr->k1);
+  this->dataPtr->distortionPass->SetK2(this->dataPtr->k2);
+  this->dataPtr->distortionPass->SetK3(this->dataPtr->k3);
+  this->dataPtr->distortionPass->SetP1(this->dataPtr->p1);
+  this->dataPtr->distortionPass->SetP2(this->dataPtr->p2);
+  this->dataPtr->distortionPass->SetCenter(this->dataPtr->lensCenter);
+  this->dataPtr->distortionPass->SetEnabled(true);
+  _camera->AddRenderPass(this->dataPtr->distortionPass);
+}
+
+//////////////////////////////////////////////////
+bool ImageBrownDistortionModel::CpuFallback() const
+{
+  return this->dataPtr->cpuFallback;
+}
+
+//////////////////////////////////////////////////
+bool ImageBrownDistortionModel::ApplyToImage(const unsigned char *_src,
+    unsigned int _width, unsigned int _height, unsigned int _channels,
+    unsigned int _bytesPerChannel, unsigned char *_dst)
+{
+  if (!this->dataPtr->camera)
+    return false;
+
+  // The table is cached by the base model for this size and focal length
+  auto intrinsics = rendering::projectionToCameraIntrinsic(
+      this->dataPtr->camera->ProjectionMatrix(), _width, _height);
+  return this->Distort(_src, _width, _height, _channels, _bytesPerChannel,
+      intrinsics(0, 0), intrinsics(1, 1), _dst);
 }
 
 //////////////////////////////////////////////////
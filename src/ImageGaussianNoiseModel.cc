@@ -20,7 +20,12 @@
   #include <Winsock2.h>
 #endif
 
+#include <cstdint>
+#include <functional>
+#include <string>
+
 #include <gz/common/Console.hh>
+#include <gz/math/Rand.hh>
 
 #include <gz/rendering/GaussianNoisePass.hh>
 #include <gz/rendering/RenderPass.hh>
@@ -29,6 +34,8 @@
 
 #include "gz/sensors/ImageGaussianNoiseModel.hh"
 
+#include "GaussianImageNoise.hh"
+
 using namespace gz;
 using namespace sensors;
 
@@ -44,6 +51,13 @@ class gz::sensors::ImageGaussianNoiseModelPrivate
 
   /// \brief Gaussian noise pass.
   public: rendering::GaussianNoisePassPtr gaussianNoisePass;
+
+  /// \brief True if noise is added on the CPU because the render engine
+  /// has no Gaussian noise pass.
+  public: bool cpuFallback = false;
+
+  /// \brief Noise added on the CPU.
+  public: GaussianImageNoise cpuNoise;
 };
 
 //////////////////////////////////////////////////
@@ -79,24 +93,45 @@ void ImageGaussianNoiseModel::SetCamera(rendering::CameraPtr _camera)
 
   rendering::RenderEngine *engine = _camera->Scene()->Engine();
   rendering::RenderPassSystemPtr rpSystem = engine->RenderPassSystem();
+  rendering::RenderPassPtr noisePass;
   if (rpSystem)
+    noisePass = rpSystem->Create<rendering::GaussianNoisePass>();
+  if (!noisePass)
   {
-    // add gaussian noise pass
-    rendering::RenderPassPtr noisePass =
-      rpSystem->Create<rendering::GaussianNoisePass>();
-    if (!noisePass)
-    {
-      ignwarn << "ImageGaussianNoiseModel is not supported in "
-             << engine->Name() << std::endl;
-      return;
-    }
-    this->dataPtr->gaussianNoisePass =
-        std::dynamic_pointer_cast<rendering::GaussianNoisePass>(noisePass);
-    this->dataPtr->gaussianNoisePass->SetMean(this->dataPtr->mean);
-    this->dataPtr->gaussianNoisePass->SetStdDev(this->dataPtr->stdDev);
-    this->dataPtr->gaussianNoisePass->SetEnabled(true);
-    _camera->AddRenderPass(this->dataPtr->gaussianNoisePass);
+    // Sensors that call ApplyToImage() still get noisy images. The seed
+    // follows the global seed, and differs between cameras.
+    ignwarn << "ImageGaussianNoiseModel is not supported in "
+            << engine->Name() << std::endl;
+    this->dataPtr->cpuNoise.SetParameters(this->dataPtr->mean,
+        this->dataPtr->stdDev);
+    this->dataPtr->cpuNoise.SetSeed(
+        (static_cast<std::uint64_t>(math::Rand::Seed()) << 32) ^
+        std::hash<std::string>()(_camera->Name()));
+    this->dataPtr->cpuFallback = true;
+    return;
   }
+
+  this->dataPtr->gaussianNoisePass =
+      std::dynamic_pointer_cast<rendering::GaussianNoisePass>(noisePass);
+  this->dataPtr->gaussianNoisePass->SetMean(this->dataPtr->mean);
+  this->dataPtr->gaussianNoisePass->SetStdDev(this->dataPtr->stdDev);
+  this->dataPtr->gaussianNoisePass->SetEnabled(true);
+  _camera->AddRenderPass(this->dataPtr->gaussianNoisePass);
+}
+
+//////////////////////////////////////////////////
+bool ImageGaussianNoiseModel::CpuFallback() const
+{
+  return this->dataPtr->cpuFallback;
+}
+
+//////////////////////////////////////////////////
+bool ImageGaussianNoiseModel::ApplyToImage(unsigned char *_data,
+    unsigned int _width, unsigned int _height, unsigned int _channels,
+    unsigned int _bytesPerChannel)
+{
+  return this->dataPtr->cpuNoise.Apply(_data, _width, _height, _channels,
+      _bytesPerChannel);
 }
 
 //////////////////////////////////////////////////
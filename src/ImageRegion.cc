@@ -0,0 +1,233 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cstdint>
+#include <cstring>
+
+#include "ImageRegion.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  // The block size and channel count are template parameters so that the
+  // inner loops have fixed trip counts and no branches, and the compiler
+  // can unroll and vectorize them.
+
+  /// \brief Average _Block x _Block blocks of pixels.
+  /// \param[in] _src First pixel of the region.
+  /// \param[in] _srcStride Row stride of the source, in channels.
+  /// \param[in] _width Output width.
+  /// \param[in] _height Output height.
+  /// \param[out] _dst Output image.
+  template <typename T, unsigned int _Block, unsigned int _Channels>
+  void bin(const T *_src, std::size_t _srcStride, unsigned int _width,
+      unsigned int _height, T *_dst)
+  {
+    const std::uint32_t shift = _Block == 2u ? 2u : 4u;
+    const std::uint32_t round = 1u << (shift - 1u);
+    for (unsigned int oy = 0; oy < _height; ++oy)
+    {
+      const T *rows = _src + oy * _Block * _srcStride;
+      T *dst = _dst + static_cast<std::size_t>(oy) * _width * _Channels;
+      for (unsigned int ox = 0; ox < _width; ++ox)
+      {
+        for (unsigned int c = 0; c < _Channels; ++c)
+        {
+          std::uint32_t sum = 0u;
+          for (unsigned int dy = 0; dy < _Block; ++dy)
+          {
+            const T *row = rows + dy * _srcStride + ox * _Block * _Channels;
+            for (unsigned int dx = 0; dx < _Block; ++dx)
+              sum += row[dx * _Channels + c];
+          }
+          dst[ox * _Channels + c] = static_cast<T>((sum + round) >> shift);
+        }
+      }
+    }
+  }
+
+  /// \brief Pick the binning kernel for a pixel layout.
+  template <typename T>
+  bool binTyped(const unsigned char *_src, std::size_t _srcStride,
+      unsigned int _block, unsigned int _channels, unsigned int _width,
+      unsigned int _height, unsigned char *_dst)
+  {
+    const T *src = reinterpret_cast<const T *>(_src);
+    T *dst = reinterpret_cast<T *>(_dst);
+    if (_block == 2u && _channels == 1u)
+      bin<T, 2u, 1u>(src, _srcStride, _width, _height, dst);
+    else if (_block == 2u && _channels == 3u)
+      bin<T, 2u, 3u>(src, _srcStride, _width, _height, dst);
+    else if (_block == 4u && _channels == 1u)
+      bin<T, 4u, 1u>(src, _srcStride, _width, _height, dst);
+    else if (_block == 4u && _channels == 3u)
+      bin<T, 4u, 3u>(src, _srcStride, _width, _height, dst);
+    else
+      return false;
+    return true;
+  }
+}
+
+//////////////////////////////////////////////////
+void ImageRegion::SetRoi(unsigned int _x, unsigned int _y,
+    unsigned int _width, unsigned int _height)
+{
+  this->roiX = _x;
+  this->roiY = _y;
+  this->roiWidth = _width;
+  this->roiHeight = _height;
+}
+
+//////////////////////////////////////////////////
+bool ImageRegion::SetBinning(unsigned int _binning)
+{
+  if (_binning != 1u && _binning != 2u && _binning != 4u)
+    return false;
+  this->binning = _binning;
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImageRegion::Binning() const
+{
+  return this->binning;
+}
+
+//////////////////////////////////////////////////
+bool ImageRegion::SetImageSize(unsigned int _width, unsigned int _height)
+{
+  this->imageWidth = _width;
+  this->imageHeight = _height;
+
+  bool fits = this->roiX < _width && this->roiY < _height;
+  unsigned int w = 0u;
+  unsigned int h = 0u;
+  if (fits)
+  {
+    w = _width - this->roiX;
+    h = _height - this->roiY;
+    if (this->roiWidth > 0u && this->roiWidth < w)
+      w = this->roiWidth;
+    if (this->roiHeight > 0u && this->roiHeight < h)
+      h = this->roiHeight;
+    w -= w % this->binning;
+    h -= h % this->binning;
+    fits = w > 0u && h > 0u;
+  }
+
+  if (!fits)
+  {
+    this->x = 0u;
+    this->y = 0u;
+    this->width = _width;
+    this->height = _height;
+    this->block = 1u;
+    return false;
+  }
+
+  this->x = this->roiX;
+  this->y = this->roiY;
+  this->width = w;
+  this->height = h;
+  this->block = this->binning;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ImageRegion::Active() const
+{
+  return this->block > 1u || this->width != this->imageWidth ||
+      this->height != this->imageHeight;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImageRegion::X() const
+{
+  return this->x;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImageRegion::Y() const
+{
+  return this->y;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImageRegion::Width() const
+{
+  return this->width / this->block;
+}
+
+//////////////////////////////////////////////////
+unsigned int ImageRegion::Height() const
+{
+  return this->height / this->block;
+}
+
+//////////////////////////////////////////////////
+std::size_t ImageRegion::OutputSize(unsigned int _bytesPerPixel) const
+{
+  return static_cast<std::size_t>(this->Width()) * this->Height() *
+      _bytesPerPixel;
+}
+
+//////////////////////////////////////////////////
+bool ImageRegion::Apply(const unsigned char *_src, unsigned int _channels,
+    unsigned int _bytesPerChannel, unsigned char *_dst) const
+{
+  if ((_channels != 1u && _channels != 3u) ||
+      (_bytesPerChannel != 1u && _bytesPerChannel != 2u))
+  {
+    return false;
+  }
+
+  const std::size_t bytesPerPixel = _channels * _bytesPerChannel;
+  const std::size_t srcStep = this->imageWidth * bytesPerPixel;
+  const unsigned char *src = _src + this->y * srcStep + this->x * bytesPerPixel;
+
+  if (this->block == 1u)
+  {
+    const std::size_t step = this->width * bytesPerPixel;
+    for (unsigned int row = 0; row < this->height; ++row)
+      std::memcpy(_dst + row * step, src + row * srcStep, step);
+    return true;
+  }
+
+  // Strides in channels rather than bytes
+  const std::size_t srcStride = this->imageWidth * _channels;
+  if (_bytesPerChannel == 1u)
+  {
+    return binTyped<std::uint8_t>(src, srcStride, this->block, _channels,
+        this->Width(), this->Height(), _dst);
+  }
+  return binTyped<std::uint16_t>(src, srcStride, this->block, _channels,
+      this->Width(), this->Height(), _dst);
+}
+
+//////////////////////////////////////////////////
+void ImageRegion::AdjustIntrinsics(double &_fx, double &_fy,
+    double &_cx, double &_cy) const
+{
+  // Pixel centers of a block average to the center of the block
+  const double b = this->block;
+  _fx /= b;
+  _fy /= b;
+  _cx = (_cx - this->x + 0.5) / b - 0.5;
+  _cy = (_cy - this->y + 0.5) / b - 0.5;
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_IMAGEREGION_HH_
+#define GZ_SENSORS_IMAGEREGION_HH_
+
+#include <cstddef>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define ImageRegion_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define ImageRegion_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ImageRegion_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Crops a rendered image to a region of interest and bins it,
+    /// so that cameras whose consumers only need part of the image or a
+    /// lower resolution publish less data. The CameraSensor class uses this.
+    ///
+    /// Binning averages each square block of pixels, rounding to nearest.
+    /// The region is shrunk to a whole number of blocks. Images with one or
+    /// three channels of 8 or 16 bits are supported.
+    class ImageRegion_EXPORTS_API ImageRegion
+    {
+      /// \brief Set the region of interest.
+      /// \param[in] _x Left column of the region.
+      /// \param[in] _y Top row of the region.
+      /// \param[in] _width Width of the region, zero to extend it to the
+      /// right edge of the image.
+      /// \param[in] _height Height of the region, zero to extend it to the
+      /// bottom edge of the image.
+      public: void SetRoi(unsigned int _x, unsigned int _y,
+          unsigned int _width, unsigned int _height);
+
+      /// \brief Set the binning factor.
+      /// \param[in] _binning 1 for no binning, 2 or 4.
+      /// \return False if the factor is not supported, in which case it is
+      /// left unchanged.
+      public: bool SetBinning(unsigned int _binning);
+
+      /// \brief Get the requested binning factor.
+      /// \return Binning factor.
+      public: unsigned int Binning() const;
+
+      /// \brief Fit the region to the size of the rendered image. Call after
+      /// changing the region, binning or image size.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \return False if the region does not overlap the image or is
+      /// smaller than one block, in which case the whole image is used.
+      public: bool SetImageSize(unsigned int _width, unsigned int _height);
+
+      /// \brief Check whether the output differs from the rendered image.
+      /// \return True if the image is cropped or binned.
+      public: bool Active() const;
+
+      /// \brief Get the left column of the fitted region.
+      /// \return Column in rendered image pixels.
+      public: unsigned int X() const;
+
+      /// \brief Get the top row of the fitted region.
+      /// \return Row in rendered image pixels.
+      public: unsigned int Y() const;
+
+      /// \brief Get the output width.
+      /// \return Width in pixels, after binning.
+      public: unsigned int Width() const;
+
+      /// \brief Get the output height.
+      /// \return Height in pixels, after binning.
+      public: unsigned int Height() const;
+
+      /// \brief Get the output size.
+      /// \param[in] _bytesPerPixel Bytes per pixel.
+      /// \return Size in bytes.
+      public: std::size_t OutputSize(unsigned int _bytesPerPixel) const;
+
+      /// \brief Crop and bin an image.
+      /// \param[in] _src Rendered image, with rows of the width passed to
+      /// SetImageSize().
+      /// \param[in] _channels Number of channels, 1 or 3.
+      /// \param[in] _bytesPerChannel Bytes per channel, 1 or 2.
+      /// \param[out] _dst Destination with room for OutputSize() bytes.
+      /// \return False if the pixel layout is not supported.
+      public: bool Apply(const unsigned char *_src, unsigned int _channels,
+          unsigned int _bytesPerChannel, unsigned char *_dst) const;
+
+      /// \brief Adjust pinhole camera parameters of the rendered image to
+      /// the output image.
+      /// \param[in,out] _fx Horizontal focal length in pixels.
+      /// \param[in,out] _fy Vertical focal length in pixels.
+      /// \param[in,out] _cx Principal point column.
+      /// \param[in,out] _cy Principal point row.
+      public: void AdjustIntrinsics(double &_fx, double &_fy,
+          double &_cx, double &_cy) const;
+
+      /// \brief Requested left column.
+      private: unsigned int roiX = 0u;
+
+      /// \brief Requested top row.
+      private: unsigned int roiY = 0u;
+
+      /// \brief Requested width, zero for the rest of the image.
+      private: unsigned int roiWidth = 0u;
+
+      /// \brief Requested height, zero for the rest of the image.
+      private: unsigned int roiHeight = 0u;
+
+      /// \brief Binning factor.
+      private: unsigned int binning = 1u;
+
+      /// \brief Rendered image width.
+      private: unsigned int imageWidth = 0u;
+
+      /// \brief Rendered image height.
+      private: unsigned int imageHeight = 0u;
+
+      /// \brief Fitted left column.
+      private: unsigned int x = 0u;
+
+      /// \brief Fitted top row.
+      private: unsigned int y = 0u;
+
+      /// \brief Fitted width, before binning.
+      private: unsigned int width = 0u;
+
+      /// \brief Fitted height, before binning.
+      private: unsigned int height = 0u;
+
+      /// \brief Fitted binning factor, 1 when the region does not fit.
+      private: unsigned int block = 1u;
+    };
+    }
+  }
+}
+
+#endif
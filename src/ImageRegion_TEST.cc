@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "ImageRegion.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(ImageRegion_TEST, Fit)
+{
+  ImageRegion region;
+  EXPECT_FALSE(region.Active());
+  EXPECT_FALSE(region.SetBinning(3u));
+  EXPECT_EQ(1u, region.Binning());
+
+  // The whole image
+  EXPECT_TRUE(region.SetImageSize(640u, 480u));
+  EXPECT_FALSE(region.Active());
+  EXPECT_EQ(640u, region.Width());
+  EXPECT_EQ(480u, region.Height());
+
+  // Crop to the edge of the image
+  region.SetRoi(600u, 100u, 100u, 0u);
+  EXPECT_TRUE(region.SetImageSize(640u, 480u));
+  EXPECT_TRUE(region.Active());
+  EXPECT_EQ(600u, region.X());
+  EXPECT_EQ(100u, region.Y());
+  EXPECT_EQ(40u, region.Width());
+  EXPECT_EQ(380u, region.Height());
+  EXPECT_EQ(40u * 380u * 3u, region.OutputSize(3u));
+
+  // Binning shrinks the region to whole blocks
+  region.SetRoi(1u, 2u, 11u, 9u);
+  EXPECT_TRUE(region.SetBinning(4u));
+  EXPECT_TRUE(region.SetImageSize(640u, 480u));
+  EXPECT_EQ(2u, region.Width());
+  EXPECT_EQ(2u, region.Height());
+
+  // Binning alone
+  region.SetRoi(0u, 0u, 0u, 0u);
+  EXPECT_TRUE(region.SetBinning(2u));
+  EXPECT_TRUE(region.SetImageSize(641u, 480u));
+  EXPECT_TRUE(region.Active());
+  EXPECT_EQ(320u, region.Width());
+  EXPECT_EQ(240u, region.Height());
+
+  // Outside the image, the whole image is used
+  region.SetRoi(700u, 0u, 10u, 10u);
+  EXPECT_FALSE(region.SetImageSize(640u, 480u));
+  EXPECT_FALSE(region.Active());
+  EXPECT_EQ(640u, region.Width());
+  EXPECT_EQ(2u, region.Binning());
+
+  // Smaller than a block
+  region.SetRoi(0u, 0u, 1u, 10u);
+  EXPECT_FALSE(region.SetImageSize(640u, 480u));
+  EXPECT_FALSE(region.Active());
+}
+
+//////////////////////////////////////////////////
+TEST(ImageRegion_TEST, Crop)
+{
+  // 4x3 RGB image with each channel holding its own index
+  std::vector<unsigned char> image(4u * 3u * 3u);
+  for (std::size_t i = 0; i < image.size(); ++i)
+    image[i] = static_cast<unsigned char>(i);
+
+  ImageRegion region;
+  region.SetRoi(1u, 1u, 2u, 2u);
+  ASSERT_TRUE(region.SetImageSize(4u, 3u));
+  std::vector<unsigned char> out(region.OutputSize(3u));
+  ASSERT_TRUE(region.Apply(image.data(), 3u, 1u, out.data()));
+  const std::vector<unsigned char> expected =
+  {
+    15, 16, 17, 18, 19, 20,
+    27, 28, 29, 30, 31, 32
+  };
+  EXPECT_EQ(expected, out);
+
+  EXPECT_FALSE(region.Apply(image.data(), 4u, 1u, out.data()));
+  EXPECT_FALSE(region.Apply(image.data(), 3u, 4u, out.data()));
+}
+
+//////////////////////////////////////////////////
+TEST(ImageRegion_TEST, Bin)
+{
+  ImageRegion region;
+
+  // 2x2 binning of a 4x2 grey image, rounding to nearest
+  const std::vector<unsigned char> grey =
+  {
+    0, 1, 10, 10,
+    1, 1, 20, 21
+  };
+  ASSERT_TRUE(region.SetBinning(2u));
+  ASSERT_TRUE(region.SetImageSize(4u, 2u));
+  std::vector<unsigned char> out(region.OutputSize(1u));
+  ASSERT_TRUE(region.Apply(grey.data(), 1u, 1u, out.data()));
+  EXPECT_EQ(std::vector<unsigned char>({1, 15}), out);
+
+  // Channels are averaged separately
+  const std::vector<unsigned char> rgb =
+  {
+    255, 0, 0,  255, 0, 0,
+    0, 255, 0,  0, 0, 255
+  };
+  ASSERT_TRUE(region.SetImageSize(2u, 2u));
+  out.resize(region.OutputSize(3u));
+  ASSERT_TRUE(region.Apply(rgb.data(), 3u, 1u, out.data()));
+  EXPECT_EQ(std::vector<unsigned char>({128, 64, 64}), out);
+
+  // 4x4 binning of a 16 bit region that does not start at the origin
+  std::vector<std::uint16_t> deep(6u * 5u, 60000u);
+  for (unsigned int y = 1; y < 5u; ++y)
+  {
+    for (unsigned int x = 2; x < 6u; ++x)
+      deep[y * 6u + x] = static_cast<std::uint16_t>(1000u * x + y);
+  }
+  region.SetRoi(2u, 1u, 0u, 0u);
+  ASSERT_TRUE(region.SetBinning(4u));
+  ASSERT_TRUE(region.SetImageSize(6u, 5u));
+  ASSERT_EQ(1u, region.Width());
+  ASSERT_EQ(1u, region.Height());
+  std::vector<std::uint16_t> deepOut(1u);
+  ASSERT_TRUE(region.Apply(reinterpret_cast<unsigned char *>(deep.data()),
+      1u, 2u, reinterpret_cast<unsigned char *>(deepOut.data())));
+  // Mean of 1000 * (2..5) and 1..4
+  EXPECT_EQ(3503u, deepOut[0]);
+}
+
+//////////////////////////////////////////////////
+TEST(ImageRegion_TEST, Intrinsics)
+{
+  double fx = 500.0;
+  double fy = 400.0;
+  double cx = 319.5;
+  double cy = 239.5;
+
+  // Cropping moves the principal point
+  ImageRegion region;
+  region.SetRoi(100u, 50u, 200u, 200u);
+  ASSERT_TRUE(region.SetImageSize(640u, 480u));
+  region.AdjustIntrinsics(fx, fy, cx, cy);
+  EXPECT_DOUBLE_EQ(500.0, fx);
+  EXPECT_DOUBLE_EQ(400.0, fy);
+  EXPECT_DOUBLE_EQ(219.5, cx);
+  EXPECT_DOUBLE_EQ(189.5, cy);
+
+  // Binning scales about pixel centers, the center of the image stays at
+  // the center
+  fx = 500.0;
+  fy = 400.0;
+  cx = 319.5;
+  cy = 239.5;
+  region.SetRoi(0u, 0u, 0u, 0u);
+  ASSERT_TRUE(region.SetBinning(2u));
+  ASSERT_TRUE(region.SetImageSize(640u, 480u));
+  region.AdjustIntrinsics(fx, fy, cx, cy);
+  EXPECT_DOUBLE_EQ(250.0, fx);
+  EXPECT_DOUBLE_EQ(200.0, fy);
+  EXPECT_DOUBLE_EQ(159.5, cx);
+  EXPECT_DOUBLE_EQ(119.5, cy);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include "ImageRemap.hh"
+#include "ParallelRows.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Fractional bits of the fixed point positions.
+  constexpr unsigned int kBits = BrownDistortionModel::kRemapFractionBits;
+
+  /// \brief One pixel in fixed point.
+  constexpr std::uint32_t kOne = 1u << kBits;
+
+  /// \brief Mask of the fraction of a fixed point position.
+  constexpr std::uint32_t kMask = kOne - 1u;
+
+  /// \brief Bilinear resampling of rows in fixed point, with the channel
+  /// count as a template parameter so that the channel loop is unrolled.
+  /// \param[in] _table Remap table.
+  /// \param[in] _src Source image.
+  /// \param[in] _begin First row.
+  /// \param[in] _end One past the last row.
+  /// \param[out] _dst Output image.
+  template <typename T, unsigned int _Channels>
+  void remapRows(const ImageRemap::Table &_table, const T *_src,
+      unsigned int _begin, unsigned int _end, T *_dst)
+  {
+    const unsigned int width = _table.width;
+    const unsigned int height = _table.height;
+    const std::size_t stride = static_cast<std::size_t>(width) * _Channels;
+    for (unsigned int v = _begin; v < _end; ++v)
+    {
+      const std::size_t first = static_cast<std::size_t>(v) * width;
+      const std::int16_t *map = _table.fixedMap.data() + first * 2u;
+      const std::uint16_t *fraction = _table.fixedFraction.data() + first;
+      T *dst = _dst + v * stride;
+      for (unsigned int u = 0; u < width; ++u, map += 2, dst += _Channels)
+      {
+        if (map[0] < 0)
+        {
+          for (unsigned int c = 0; c < _Channels; ++c)
+            dst[c] = 0;
+          continue;
+        }
+
+        // The last row and column interpolate with themselves, their
+        // fraction is zero
+        const unsigned int u0 = static_cast<unsigned int>(map[0]);
+        const unsigned int v0 = static_cast<unsigned int>(map[1]);
+        const std::uint32_t au = fraction[u] & kMask;
+        const std::uint32_t av = (fraction[u] >> kBits) & kMask;
+        const std::uint32_t w00 = (kOne - au) * (kOne - av);
+        const std::uint32_t w10 = au * (kOne - av);
+        const std::uint32_t w01 = (kOne - au) * av;
+        const std::uint32_t w11 = au * av;
+        const unsigned int du = u0 + 1u < width ? _Channels : 0u;
+        const std::size_t dv = v0 + 1u < height ? stride : 0u;
+        const T *p = _src + v0 * stride + u0 * _Channels;
+        for (unsigned int c = 0; c < _Channels; ++c)
+        {
+          const std::uint32_t sum = w00 * p[c] + w10 * p[c + du] +
+              w01 * p[c + dv] + w11 * p[c + dv + du];
+          dst[c] = static_cast<T>((sum + (1u << (2u * kBits - 1u))) >>
+              (2u * kBits));
+        }
+      }
+    }
+  }
+
+  /// \brief Pick the bilinear kernel for a pixel layout.
+  template <typename T>
+  bool remapTyped(const ImageRemap::Table &_table, const unsigned char *_src,
+      unsigned int _channels, unsigned char *_dst)
+  {
+    const T *src = reinterpret_cast<const T *>(_src);
+    T *dst = reinterpret_cast<T *>(_dst);
+    if (_channels != 1u && _channels != 3u && _channels != 4u)
+      return false;
+
+    ParallelRows::Instance().Run(_table.height,
+        [&](unsigned int _begin, unsigned int _end)
+        {
+          if (_channels == 1u)
+            remapRows<T, 1u>(_table, src, _begin, _end, dst);
+          else if (_channels == 3u)
+            remapRows<T, 3u>(_table, src, _begin, _end, dst);
+          else
+            remapRows<T, 4u>(_table, src, _begin, _end, dst);
+        });
+    return true;
+  }
+
+  /// \brief Nearest neighbour resampling of rows. Pixels are copied with
+  /// a fixed size memcpy, which compiles to plain loads and stores.
+  /// \param[in] _table Remap table.
+  /// \param[in] _src Source image.
+  /// \param[in] _begin First row.
+  /// \param[in] _end One past the last row.
+  /// \param[out] _dst Output image.
+  /// \param[in] _pixelSize Bytes per pixel, only used when _Size is zero.
+  /// \param[in] _fill Pixel written where there is no source, null for
+  /// zero.
+  template <unsigned int _Size>
+  void nearestRows(const ImageRemap::Table &_table, const unsigned char *_src,
+      unsigned int _begin, unsigned int _end, unsigned char *_dst,
+      unsigned int _pixelSize, const unsigned char *_fill)
+  {
+    const std::size_t size = _Size > 0u ? _Size : _pixelSize;
+    const unsigned int width = _table.width;
+    const unsigned int maxU = width - 1u;
+    const unsigned int maxV = _table.height - 1u;
+    const std::uint32_t half = kOne / 2u;
+    for (unsigned int v = _begin; v < _end; ++v)
+    {
+      const std::size_t first = static_cast<std::size_t>(v) * width;
+      const std::int16_t *map = _table.fixedMap.data() + first * 2u;
+      const std::uint16_t *fraction = _table.fixedFraction.data() + first;
+      unsigned char *dst = _dst + first * size;
+      for (unsigned int u = 0; u < width; ++u, map += 2, dst += size)
+      {
+        if (map[0] < 0)
+        {
+          if (_fill)
+            std::memcpy(dst, _fill, size);
+          else
+            std::memset(dst, 0, size);
+          continue;
+        }
+        unsigned int su = static_cast<unsigned int>(map[0]) +
+            ((fraction[u] & kMask) >= half ? 1u : 0u);
+        unsigned int sv = static_cast<unsigned int>(map[1]) +
+            (((fraction[u] >> kBits) & kMask) >= half ? 1u : 0u);
+        su = su > maxU ? maxU : su;
+        sv = sv > maxV ? maxV : sv;
+        std::memcpy(dst, _src + (static_cast<std::size_t>(sv) * width + su) *
+            size, size);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void ImageRemap::Build(unsigned int _width, unsigned int _height,
+    const Mapping &_mapping, Table &_table)
+{
+  const std::size_t count = static_cast<std::size_t>(_width) * _height;
+  _table.width = _width;
+  _table.height = _height;
+  _table.map.resize(count * 2u);
+  _table.fixedMap.resize(count * 2u);
+  _table.fixedFraction.resize(count);
+
+  const double maxU = _width - 1.0;
+  const double maxV = _height - 1.0;
+  ParallelRows::Instance().Run(_height,
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        for (unsigned int v = _begin; v < _end; ++v)
+        {
+          const std::size_t first = static_cast<std::size_t>(v) * _width;
+          float *map = _table.map.data() + first * 2u;
+          std::int16_t *fixedMap = _table.fixedMap.data() + first * 2u;
+          std::uint16_t *fraction = _table.fixedFraction.data() + first;
+          for (unsigned int u = 0; u < _width; ++u)
+          {
+            double su = -1.0;
+            double sv = -1.0;
+            if (!_mapping(u, v, su, sv) || !(su >= 0.0 && su <= maxU) ||
+                !(sv >= 0.0 && sv <= maxV))
+            {
+              map[2u * u] = -1.0f;
+              map[2u * u + 1u] = -1.0f;
+              fixedMap[2u * u] = -1;
+              fixedMap[2u * u + 1u] = -1;
+              fraction[u] = 0u;
+              continue;
+            }
+
+            map[2u * u] = static_cast<float>(su);
+            map[2u * u + 1u] = static_cast<float>(sv);
+            const long fu = std::lround(su * kOne);
+            const long fv = std::lround(sv * kOne);
+            fixedMap[2u * u] = static_cast<std::int16_t>(fu >> kBits);
+            fixedMap[2u * u + 1u] = static_cast<std::int16_t>(fv >> kBits);
+            fraction[u] = static_cast<std::uint16_t>(
+                (fu & kMask) | ((fv & kMask) << kBits));
+          }
+        }
+      });
+}
+
+//////////////////////////////////////////////////
+bool ImageRemap::Apply(const Table &_table, const unsigned char *_src,
+    unsigned int _channels, unsigned int _bytesPerChannel,
+    unsigned char *_dst)
+{
+  if (_bytesPerChannel == 1u)
+    return remapTyped<std::uint8_t>(_table, _src, _channels, _dst);
+  if (_bytesPerChannel == 2u)
+    return remapTyped<std::uint16_t>(_table, _src, _channels, _dst);
+  return false;
+}
+
+//////////////////////////////////////////////////
+bool ImageRemap::ApplyNearest(const Table &_table, const unsigned char *_src,
+    unsigned int _bytesPerPixel, unsigned char *_dst,
+    const unsigned char *_fill)
+{
+  if (_bytesPerPixel == 0u)
+    return false;
+
+  ParallelRows::Instance().Run(_table.height,
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        switch (_bytesPerPixel)
+        {
+          case 1u:
+            nearestRows<1u>(_table, _src, _begin, _end, _dst, 1u,
+                _fill);
+            break;
+          case 2u:
+            nearestRows<2u>(_table, _src, _begin, _end, _dst, 2u,
+                _fill);
+            break;
+          case 3u:
+            nearestRows<3u>(_table, _src, _begin, _end, _dst, 3u,
+                _fill);
+            break;
+          case 4u:
+            nearestRows<4u>(_table, _src, _begin, _end, _dst, 4u,
+                _fill);
+            break;
+          case 8u:
+            nearestRows<8u>(_table, _src, _begin, _end, _dst, 8u,
+                _fill);
+            break;
+          case 12u:
+            nearestRows<12u>(_table, _src, _begin, _end, _dst, 12u,
+                _fill);
+            break;
+          case 16u:
+            nearestRows<16u>(_table, _src, _begin, _end, _dst, 16u,
+                _fill);
+            break;
+          default:
+            nearestRows<0u>(_table, _src, _begin, _end, _dst,
+                _bytesPerPixel, _fill);
+            break;
+        }
+      });
+  return true;
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_IMAGEREMAP_HH_
+#define GZ_SENSORS_IMAGEREMAP_HH_
+
+#include <functional>
+
+#include "gz/sensors/BrownDistortionModel.hh"
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define ImageRemap_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define ImageRemap_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ImageRemap_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Builds remap tables, which hold for every output pixel the
+    /// position in the source image it is sampled from, and resamples images
+    /// through them. BrownDistortionModel uses this to distort and
+    /// undistort images.
+    ///
+    /// Positions are in pixels with the center of the first pixel at 0.
+    /// Source and output images have the same size. Output pixels that map
+    /// outside the source image are zero, unless a fill value is given. Resampling goes through the fixed
+    /// point table, with rows processed in parallel.
+    class ImageRemap_EXPORTS_API ImageRemap
+    {
+      /// \brief Remap table.
+      public: using Table = BrownDistortionModel::RemapTable;
+
+      /// \brief Map from an output pixel to a source position.
+      /// \param[in] _u Output column.
+      /// \param[in] _v Output row.
+      /// \param[out] _srcU Source column.
+      /// \param[out] _srcV Source row.
+      /// \return False if the output pixel has no source.
+      public: using Mapping = std::function<bool(double _u, double _v,
+          double &_srcU, double &_srcV)>;
+
+      /// \brief Build a table. Rows are computed in parallel, so the
+      /// mapping must be safe to call concurrently.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _mapping Mapping from output pixels to source positions.
+      /// \param[out] _table Table with its floating and fixed point maps.
+      public: static void Build(unsigned int _width, unsigned int _height,
+          const Mapping &_mapping, Table &_table);
+
+      /// \brief Resample an image with bilinear interpolation.
+      /// \param[in] _table Table.
+      /// \param[in] _src Source image.
+      /// \param[in] _channels Number of channels, 1, 3 or 4.
+      /// \param[in] _bytesPerChannel Bytes per channel, 1 or 2.
+      /// \param[out] _dst Output image, which must not overlap _src.
+      /// \return False if the pixel layout is not supported.
+      public: static bool Apply(const Table &_table,
+          const unsigned char *_src, unsigned int _channels,
+          unsigned int _bytesPerChannel, unsigned char *_dst);
+
+      /// \brief Resample an image with nearest neighbour interpolation,
+      /// which never blends pixels and works with any pixel type.
+      /// \param[in] _table Table.
+      /// \param[in] _src Source image.
+      /// \param[in] _bytesPerPixel Bytes per pixel.
+      /// \param[out] _dst Output image, which must not overlap _src.
+      /// \param[in] _fill Pixel of _bytesPerPixel bytes written where the
+      /// output has no source, for example NaN depth. Null for zero.
+      /// \return False if _bytesPerPixel is zero.
+      public: static bool ApplyNearest(const Table &_table,
+          const unsigned char *_src, unsigned int _bytesPerPixel,
+          unsigned char *_dst, const unsigned char *_fill = nullptr);
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ImageRemap.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(ImageRemap_TEST, Identity)
+{
+  std::vector<unsigned char> image(37u * 29u * 3u);
+  for (std::size_t i = 0; i < image.size(); ++i)
+    image[i] = static_cast<unsigned char>(i * 7u);
+  std::vector<unsigned char> out(image.size());
+
+  ImageRemap::Table table;
+  ImageRemap::Build(37u, 29u,
+      [](double _u, double _v, double &_su, double &_sv)
+      {
+        _su = _u;
+        _sv = _v;
+        return true;
+      }, table);
+  EXPECT_EQ(37u, table.width);
+  EXPECT_EQ(29u, table.height);
+  EXPECT_EQ(37u * 29u * 2u, table.map.size());
+  EXPECT_EQ(37u * 29u * 2u, table.fixedMap.size());
+  EXPECT_EQ(37u * 29u, table.fixedFraction.size());
+  ASSERT_TRUE(ImageRemap::Apply(table, image.data(), 3u, 1u, out.data()));
+  EXPECT_EQ(image, out);
+
+  std::fill(out.begin(), out.end(), 0u);
+  ASSERT_TRUE(ImageRemap::ApplyNearest(table, image.data(), 3u, out.data()));
+  EXPECT_EQ(image, out);
+
+  EXPECT_FALSE(ImageRemap::Apply(table, image.data(), 2u, 1u, out.data()));
+  EXPECT_FALSE(ImageRemap::Apply(table, image.data(), 3u, 4u, out.data()));
+  EXPECT_FALSE(ImageRemap::ApplyNearest(table, image.data(), 0u,
+      out.data()));
+}
+
+//////////////////////////////////////////////////
+TEST(ImageRemap_TEST, Bilinear)
+{
+  // 16 bit grey ramp along the columns
+  std::vector<std::uint16_t> ramp(4u * 2u);
+  for (unsigned int v = 0; v < 2u; ++v)
+  {
+    for (unsigned int u = 0; u < 4u; ++u)
+      ramp[v * 4u + u] = static_cast<std::uint16_t>(1000u * u + 100u * v);
+  }
+
+  // Half a pixel to the right and down, nothing beyond the image
+  ImageRemap::Table table;
+  ImageRemap::Build(4u, 2u,
+      [](double _u, double _v, double &_su, double &_sv)
+      {
+        _su = _u + 0.5;
+        _sv = _v + 0.5;
+        return _u > 0.0;
+      }, table);
+  EXPECT_FLOAT_EQ(1.5f, table.map[2]);
+  EXPECT_FLOAT_EQ(0.5f, table.map[3]);
+  EXPECT_FLOAT_EQ(-1.0f, table.map[0]);
+
+  std::vector<std::uint16_t> out(ramp.size(), 1u);
+  ASSERT_TRUE(ImageRemap::Apply(table,
+      reinterpret_cast<unsigned char *>(ramp.data()), 1u, 2u,
+      reinterpret_cast<unsigned char *>(out.data())));
+
+  // The first column has no source, the last column and row map outside
+  EXPECT_EQ(0u, out[0]);
+  EXPECT_EQ(1550u, out[1]);
+  EXPECT_EQ(2550u, out[2]);
+  EXPECT_EQ(0u, out[3]);
+  EXPECT_EQ(0u, out[5]);
+}
+
+//////////////////////////////////////////////////
+TEST(ImageRemap_TEST, Nearest)
+{
+  // Float values are copied bit for bit, never blended
+  std::vector<float> depth(5u * 3u);
+  for (std::size_t i = 0; i < depth.size(); ++i)
+    depth[i] = 0.25f + static_cast<float>(i);
+
+  // A third of a pixel right rounds down, two thirds down rounds up
+  ImageRemap::Table table;
+  ImageRemap::Build(5u, 3u,
+      [](double _u, double _v, double &_su, double &_sv)
+      {
+        _su = _u + 1.0 / 3.0;
+        _sv = _v + 2.0 / 3.0;
+        return true;
+      }, table);
+
+  std::vector<float> out(depth.size(), -1.0f);
+  ASSERT_TRUE(ImageRemap::ApplyNearest(table,
+      reinterpret_cast<unsigned char *>(depth.data()), sizeof(float),
+      reinterpret_cast<unsigned char *>(out.data())));
+  for (unsigned int v = 0; v < 3u; ++v)
+  {
+    for (unsigned int u = 0; u < 5u; ++u)
+    {
+      const float expected = (v < 2u && u < 4u) ?
+          depth[(v + 1u) * 5u + u] : 0.0f;
+      EXPECT_FLOAT_EQ(expected, out[v * 5u + u]) << u << " " << v;
+    }
+  }
+
+  // Pixels without a source take the fill value
+  const float fill = -2.0f;
+  ASSERT_TRUE(ImageRemap::ApplyNearest(table,
+      reinterpret_cast<unsigned char *>(depth.data()), sizeof(float),
+      reinterpret_cast<unsigned char *>(out.data()),
+      reinterpret_cast<const unsigned char *>(&fill)));
+  EXPECT_FLOAT_EQ(depth[5u], out[0]);
+  EXPECT_FLOAT_EQ(fill, out[4]);
+  EXPECT_FLOAT_EQ(fill, out[10]);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
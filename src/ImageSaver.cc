@@ -0,0 +1,574 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ImageSaver.hh"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <utility>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Profiler.hh>
+
+#include "FrameEncoding.hh"
+
+using namespace gz;
+using namespace sensors;
+
+constexpr std::size_t ImageSaver::kDefaultQueueSize;
+
+namespace
+{
+  /// \brief Get the raw dump layout of a pixel format.
+  /// \param[in] _format Pixel format.
+  /// \param[out] _header Data type and channels are set.
+  /// \return False if raw dumps can not store the format.
+  bool rawLayout(common::Image::PixelFormatType _format,
+      FrameEncoding::RawHeader &_header)
+  {
+    using DataType = FrameEncoding::DataType;
+    switch (_format)
+    {
+      case common::Image::L_INT8:
+        _header.dataType = DataType::UINT8;
+        _header.channels = 1u;
+        return true;
+      case common::Image::L_INT16:
+        _header.dataType = DataType::UINT16;
+        _header.channels = 1u;
+        return true;
+      case common::Image::RGB_INT8:
+        _header.dataType = DataType::UINT8;
+        _header.channels = 3u;
+        return true;
+      case common::Image::RGBA_INT8:
+        _header.dataType = DataType::UINT8;
+        _header.channels = 4u;
+        return true;
+      case common::Image::RGB_INT16:
+        _header.dataType = DataType::UINT16;
+        _header.channels = 3u;
+        return true;
+      case common::Image::R_FLOAT32:
+        _header.dataType = DataType::FLOAT32;
+        _header.channels = 1u;
+        return true;
+      case common::Image::RGB_FLOAT32:
+        _header.dataType = DataType::FLOAT32;
+        _header.channels = 3u;
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  /// \brief Write a file in one go, or append it to a container.
+  bool writeFile(const std::string &_path, FrameContainerWriter *_container,
+      FrameContentType _type, const void *_data, std::size_t _size)
+  {
+    if (_container)
+      return _container->Append(_path, _type, _data, _size);
+
+    std::ofstream file(_path, std::ios::out | std::ios::binary);
+    file.write(static_cast<const char *>(_data),
+        static_cast<std::streamsize>(_size));
+    return file.good();
+  }
+
+  /// \brief Get the path of a directory relative to the directory of a
+  /// container, which prefixes the names of the records saved to it.
+  /// \param[in] _container Container path.
+  /// \param[in] _directory Directory path.
+  /// \return Relative path followed by '/', or empty for the container
+  /// directory itself.
+  std::string recordPrefix(const std::string &_container,
+      const std::string &_directory)
+  {
+    // Collapse the doubled separators of paths built with +
+    auto normalize = [](const std::string &_path)
+    {
+      std::string result;
+      for (char c : _path)
+      {
+        if (c == '\\')
+          c = '/';
+        if (c != '/' || result.empty() || result.back() != '/')
+          result += c;
+      }
+      while (result.size() > 1u && result.back() == '/')
+        result.pop_back();
+      return result;
+    };
+
+    std::string base = normalize(common::parentPath(_container));
+    std::string directory = normalize(_directory);
+    if (directory == base || directory == ".")
+      return std::string();
+    if (base == ".")
+      base.clear();
+    if (!base.empty() && directory.compare(0u, base.size() + 1u,
+        base + "/") == 0)
+    {
+      directory = directory.substr(base.size() + 1u);
+    }
+    if (directory.compare(0u, 2u, "./") == 0)
+      directory = directory.substr(2u);
+    return directory + "/";
+  }
+}
+
+//////////////////////////////////////////////////
+ImageSaver &ImageSaver::Instance()
+{
+  // Intentionally leaked, joining threads during static destruction is not
+  // safe on all platforms. Sensors flush the saver when they are destroyed.
+  static ImageSaver *saver = new ImageSaver();
+  return *saver;
+}
+
+//////////////////////////////////////////////////
+ImageSaver::Options ImageSaver::OptionsFromSdf(const sdf::Camera &_camera,
+    const std::string &_sensorName)
+{
+  Options options;
+  sdf::ElementPtr elem = _camera.Element();
+  if (!elem)
+    return options;
+
+  if (elem->HasElement("ignition:save_policy"))
+  {
+    std::string policy = elem->Get<std::string>("ignition:save_policy");
+    if (policy == "drop")
+    {
+      options.policy = Policy::DROP;
+    }
+    else if (policy != "block")
+    {
+      ignerr << "Unknown <ignition:save_policy> [" << policy << "], "
+             << "expected [block] or [drop]. Using [block]." << std::endl;
+    }
+  }
+
+  if (elem->HasElement("ignition:save_format"))
+  {
+    std::string format = elem->Get<std::string>("ignition:save_format");
+    if (format == "raw")
+    {
+      options.format = FileFormat::RAW;
+    }
+    else if (format == "qoi")
+    {
+      options.format = FileFormat::QOI;
+    }
+    else if (format == "lz4")
+    {
+      options.format = FileFormat::LZ4;
+    }
+    else if (format != "png")
+    {
+      ignerr << "Unknown <ignition:save_format> [" << format << "], "
+             << "expected [png], [raw], [qoi] or [lz4]. Using [png]."
+             << std::endl;
+    }
+  }
+
+  if (elem->HasElement("ignition:save_container") &&
+      elem->Get<bool>("ignition:save_container"))
+  {
+    options.container = common::joinPaths(_camera.SaveFramesPath(),
+        _sensorName + ".ignc");
+  }
+  return options;
+}
+
+//////////////////////////////////////////////////
+std::uint64_t ImageSaver::SavedCount(const std::string &_directory,
+    const Options &_options)
+{
+  std::uint64_t count = 0u;
+  if (_options.container.empty())
+  {
+    if (!common::isDirectory(_directory))
+      return 0u;
+    common::DirIter endIter;
+    for (common::DirIter dirIter(_directory); dirIter != endIter; ++dirIter)
+      ++count;
+    return count;
+  }
+
+  FrameContainerReader reader;
+  if (!reader.Open(_options.container))
+    return 0u;
+  const std::string prefix = recordPrefix(_options.container, _directory);
+  for (std::size_t i = 0u; i < reader.RecordCount(); ++i)
+  {
+    const std::string name = reader.Name(i);
+    if (name.compare(0u, prefix.size(), prefix) == 0 &&
+        name.find('/', prefix.size()) == std::string::npos)
+    {
+      ++count;
+    }
+  }
+  return count;
+}
+
+//////////////////////////////////////////////////
+bool ImageSaver::Supports(FileFormat _fileFormat,
+    common::Image::PixelFormatType _pixelFormat)
+{
+  FrameEncoding::RawHeader header;
+  switch (_fileFormat)
+  {
+    case FileFormat::PNG:
+      return _pixelFormat != common::Image::UNKNOWN_PIXEL_FORMAT &&
+          _pixelFormat != common::Image::R_FLOAT16 &&
+          _pixelFormat != common::Image::R_FLOAT32 &&
+          _pixelFormat != common::Image::RGB_FLOAT16 &&
+          _pixelFormat != common::Image::RGB_FLOAT32;
+    case FileFormat::QOI:
+      return _pixelFormat == common::Image::RGB_INT8 ||
+          _pixelFormat == common::Image::RGBA_INT8;
+    default:
+      return rawLayout(_pixelFormat, header);
+  }
+}
+
+//////////////////////////////////////////////////
+std::string ImageSaver::Extension(FileFormat _format)
+{
+  switch (_format)
+  {
+    case FileFormat::RAW:
+      return "raw";
+    case FileFormat::QOI:
+      return "qoi";
+    case FileFormat::LZ4:
+      return "raw.lz4";
+    default:
+      return "png";
+  }
+}
+
+//////////////////////////////////////////////////
+ImageSaver::ImageSaver(unsigned int _workerCount, std::size_t _queueSize)
+  : workerCount(_workerCount),
+    queueSize(std::max<std::size_t>(_queueSize, 1u))
+{
+  if (this->workerCount == 0u)
+  {
+    // PNG encoding is CPU bound, leave most cores to the simulation
+    this->workerCount =
+        std::min(4u, std::max(1u, std::thread::hardware_concurrency() / 2u));
+  }
+}
+
+//////////////////////////////////////////////////
+ImageSaver::~ImageSaver()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->jobAvailable.notify_all();
+  for (auto &worker : this->workers)
+    worker.join();
+}
+
+//////////////////////////////////////////////////
+bool ImageSaver::EnsureDirectory(const std::string &_directory)
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->directories.count(_directory))
+      return true;
+  }
+
+  if (!common::isDirectory(_directory) &&
+      !common::createDirectories(_directory))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->directories.insert(_directory);
+  return true;
+}
+
+//////////////////////////////////////////////////
+FrameBuffer ImageSaver::Buffer(std::size_t _size) const
+{
+  return FrameBufferPool::Instance().Acquire(_size);
+}
+
+//////////////////////////////////////////////////
+bool ImageSaver::Save(const std::string &_directory,
+    const std::string &_name, FrameBuffer &&_buffer,
+    unsigned int _width, unsigned int _height,
+    common::Image::PixelFormatType _format, const Options &_options)
+{
+  // Anything PNG or QOI can not store is dumped raw. Containers can not
+  // hold PNG images, the closest format is used instead.
+  FileFormat fileFormat = _options.format;
+  if (!_options.container.empty() && fileFormat == FileFormat::PNG)
+    fileFormat = FileFormat::QOI;
+  if (!Supports(fileFormat, _format))
+  {
+    if (!Supports(FileFormat::RAW, _format))
+    {
+      ignerr << "Unable to save frames with pixel format [" << _format
+             << "]" << std::endl;
+      return false;
+    }
+    if (_options.format != FileFormat::PNG || _options.container.empty())
+    {
+      std::lock_guard<std::mutex> lock(this->mutex);
+      if (!this->warnedFallback)
+      {
+        ignwarn << "Pixel format [" << _format << "] can not be saved as ["
+                << Extension(_options.format) << "], saving ["
+                << Extension(FileFormat::RAW) << "] files instead."
+                << std::endl;
+        this->warnedFallback = true;
+      }
+    }
+    fileFormat = FileFormat::RAW;
+  }
+
+  Job job;
+  job.fileFormat = fileFormat;
+  job.buffer = std::move(_buffer);
+  job.width = _width;
+  job.height = _height;
+  job.format = _format;
+  return this->Enqueue(_directory, _name + "." + Extension(fileFormat),
+      std::move(job), _options);
+}
+
+//////////////////////////////////////////////////
+bool ImageSaver::Save(const std::string &_directory,
+    const std::string &_name, const unsigned char *_data,
+    std::size_t _size, unsigned int _width, unsigned int _height,
+    common::Image::PixelFormatType _format, const Options &_options)
+{
+  FrameBuffer buffer = this->Buffer(_size);
+  std::memcpy(buffer.Data<unsigned char>(), _data, _size);
+  return this->Save(_directory, _name, std::move(buffer), _width,
+      _height, _format, _options);
+}
+
+//////////////////////////////////////////////////
+bool ImageSaver::SaveData(const std::string &_directory,
+    const std::string &_name, FrameContentType _type, std::string &&_data,
+    const Options &_options)
+{
+  Job job;
+  job.fileFormat = FileFormat::RAW;
+  job.data = std::move(_data);
+  job.type = _type;
+  job.width = 0u;
+  job.height = 0u;
+  job.format = common::Image::UNKNOWN_PIXEL_FORMAT;
+  return this->Enqueue(_directory, _name, std::move(job), _options);
+}
+
+//////////////////////////////////////////////////
+bool ImageSaver::Enqueue(const std::string &_directory,
+    const std::string &_name, Job &&_job, const Options &_options)
+{
+  // Only the directory holding the container is created in container mode
+  if (_options.container.empty())
+  {
+    if (!this->EnsureDirectory(_directory))
+      return false;
+    _job.path = common::joinPaths(_directory, _name);
+  }
+  else
+  {
+    if (!this->EnsureDirectory(common::parentPath(_options.container)))
+      return false;
+    _job.path = recordPrefix(_options.container, _directory) + _name;
+  }
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  if (!_options.container.empty())
+  {
+    auto &container = this->containers[_options.container];
+    if (!container)
+    {
+      container.reset(new FrameContainerWriter());
+      if (!container->Open(_options.container))
+      {
+        this->containers.erase(_options.container);
+        return false;
+      }
+    }
+    _job.container = container.get();
+  }
+
+  if (this->queue.size() >= this->queueSize)
+  {
+    if (_options.policy == Policy::DROP)
+    {
+      ++this->dropped;
+      return false;
+    }
+    IGN_PROFILE("ImageSaver::Save Wait");
+    this->jobDone.wait(lock, [this]
+    {
+      return this->queue.size() < this->queueSize;
+    });
+  }
+
+  if (this->workers.empty())
+  {
+    for (unsigned int i = 0u; i < this->workerCount; ++i)
+      this->workers.emplace_back(&ImageSaver::Run, this);
+  }
+
+  this->queue.push_back(std::move(_job));
+  lock.unlock();
+
+  this->jobAvailable.notify_one();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ImageSaver::Flush()
+{
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->jobDone.wait(lock, [this]
+  {
+    return this->queue.empty() && this->active == 0u;
+  });
+}
+
+//////////////////////////////////////////////////
+void ImageSaver::Finish(const Options &_options)
+{
+  this->Flush();
+  if (_options.container.empty())
+    return;
+
+  // The writer writes its index when it is destroyed
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->containers.erase(_options.container);
+}
+
+//////////////////////////////////////////////////
+std::uint64_t ImageSaver::DroppedCount() const
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  return this->dropped;
+}
+
+//////////////////////////////////////////////////
+void ImageSaver::Run()
+{
+  // Encoding buffers, kept between frames to avoid reallocating
+  std::vector<unsigned char> encoded;
+  std::vector<unsigned char> raw;
+
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->jobAvailable.wait(lock, [this]
+    {
+      return this->stop || !this->queue.empty();
+    });
+
+    // Queued frames are still written when stopping
+    if (this->queue.empty())
+      return;
+
+    Job job = std::move(this->queue.front());
+    this->queue.pop_front();
+    ++this->active;
+    lock.unlock();
+    this->jobDone.notify_all();
+
+    if (!Write(job, encoded, raw))
+      ignerr << "Failed to save [" << job.path << "]" << std::endl;
+    job.buffer.Release();
+
+    lock.lock();
+    --this->active;
+    this->jobDone.notify_all();
+  }
+}
+
+//////////////////////////////////////////////////
+bool ImageSaver::Write(const Job &_job,
+    std::vector<unsigned char> &_encoded, std::vector<unsigned char> &_raw)
+{
+  if (_job.type != FrameContentType::UNKNOWN)
+  {
+    return writeFile(_job.path, _job.container, _job.type, _job.data.data(),
+        _job.data.size());
+  }
+
+  const unsigned char *data = _job.buffer.Data<unsigned char>();
+  switch (_job.fileFormat)
+  {
+    case FileFormat::PNG:
+    {
+      IGN_PROFILE("ImageSaver::Write PNG");
+      common::Image image;
+      image.SetFromData(data, _job.width, _job.height, _job.format);
+      image.SavePNG(_job.path);
+      return true;
+    }
+    case FileFormat::QOI:
+    {
+      IGN_PROFILE("ImageSaver::Write QOI");
+      unsigned int channels = _job.format == common::Image::RGBA_INT8 ?
+          4u : 3u;
+      return FrameEncoding::EncodeQoi(data, _job.width, _job.height,
+          channels, _encoded) &&
+          writeFile(_job.path, _job.container, FrameContentType::QOI,
+              _encoded.data(), _encoded.size());
+    }
+    default:
+    {
+      IGN_PROFILE("ImageSaver::Write RAW");
+      FrameEncoding::RawHeader header;
+      rawLayout(_job.format, header);
+      header.width = _job.width;
+      header.height = _job.height;
+      header.step = static_cast<std::uint32_t>(_job.width * header.channels *
+          FrameEncoding::DataTypeSize(header.dataType));
+      header.dataSize = static_cast<std::uint64_t>(header.step) * _job.height;
+      if (header.dataSize > _job.buffer.Size())
+        return false;
+
+      if (_job.fileFormat == FileFormat::RAW)
+      {
+        FrameEncoding::EncodeRaw(header, data, _encoded);
+        return writeFile(_job.path, _job.container, FrameContentType::RAW,
+            _encoded.data(), _encoded.size());
+      }
+
+      // The raw dump is compressed as a whole, so a decompressed file is
+      // identical to a RAW one
+      FrameEncoding::EncodeRaw(header, data, _raw);
+      FrameEncoding::CompressLz4(_raw.data(), _raw.size(), _encoded);
+      return writeFile(_job.path, _job.container, FrameContentType::LZ4,
+          _encoded.data(), _encoded.size());
+    }
+  }
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_IMAGESAVER_HH_
+#define GZ_SENSORS_IMAGESAVER_HH_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gz/common/Image.hh>
+#include <sdf/Camera.hh>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+#include "gz/sensors/FrameContainer.hh"
+
+#include "FrameBufferPool.hh"
+
+#ifndef _WIN32
+#  define ImageSaver_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define ImageSaver_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ImageSaver_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Saves images to disk from a pool of worker threads, so that
+    /// sensors with <save> enabled do not encode and write files inside
+    /// their Update functions. Camera, depth, thermal, segmentation and
+    /// bounding box cameras share one saver.
+    ///
+    /// Frames wait in a bounded queue. When the queue is full, a save
+    /// either waits for room (Policy::BLOCK, no frame is lost) or drops the
+    /// frame (Policy::DROP, the sensor never waits). The policy is chosen per
+    /// camera with <ignition:save_policy> under <camera>.
+    ///
+    /// Frames are written as PNG by default. <ignition:save_format> under
+    /// <camera> selects one of the faster FileFormat values instead, see
+    /// FrameEncoding for their layout.
+    ///
+    /// With <ignition:save_container>true</ignition:save_container> under
+    /// <camera>, frames are appended to a single FrameContainerWriter file
+    /// per sensor, "<save path>/<sensor name>.ignc", instead of one file
+    /// each. Records are named after the paths the files would have had
+    /// relative to the save path. PNG can only be written to files, so
+    /// containers hold QOI, or RAW for formats QOI can not store.
+    class ImageSaver_EXPORTS_API ImageSaver
+    {
+      /// \brief What to do with a frame when the queue is full.
+      public: enum class Policy
+      {
+        /// \brief Wait until a worker takes a frame off the queue.
+        BLOCK,
+
+        /// \brief Discard the new frame.
+        DROP
+      };
+
+      /// \brief File formats frames can be written in.
+      public: enum class FileFormat
+      {
+        /// \brief PNG, 8 bit formats only. Slow to encode.
+        PNG,
+
+        /// \brief Uncompressed dump with a small header, ".raw". Keeps
+        /// 16 bit and float samples as they are.
+        RAW,
+
+        /// \brief QOI, lossless and much faster to encode than PNG, 8 bit
+        /// RGB and RGBA only, ".qoi".
+        QOI,
+
+        /// \brief A raw dump compressed into an LZ4 frame, ".raw.lz4".
+        LZ4
+      };
+
+      /// \brief How a sensor saves its frames.
+      public: struct Options
+      {
+        /// \brief What to do with a frame when the queue is full.
+        Policy policy = Policy::BLOCK;
+
+        /// \brief File format.
+        FileFormat format = FileFormat::PNG;
+
+        /// \brief Path of the container frames are appended to. Empty to
+        /// write separate files.
+        std::string container;
+      };
+
+      /// \brief Default number of frames the queue holds.
+      public: static constexpr std::size_t kDefaultQueueSize = 16u;
+
+      /// \brief Get the saver shared by all sensors.
+      /// \return The saver.
+      public: static ImageSaver &Instance();
+
+      /// \brief Read the save options of a camera from its
+      /// <ignition:save_policy> element, "block" or "drop", and its
+      /// <ignition:save_format> element, "png", "raw", "qoi" or "lz4", and
+      /// its <ignition:save_container> element.
+      /// \param[in] _camera Camera SDF.
+      /// \param[in] _sensorName Sensor name, which names the container.
+      /// \return The options. Missing or invalid elements leave the
+      /// defaults, BLOCK, PNG and separate files.
+      public: static Options OptionsFromSdf(const sdf::Camera &_camera,
+          const std::string &_sensorName);
+
+      /// \brief Count the files saved to a directory by an earlier run, so
+      /// that a sensor can continue numbering its frames.
+      /// \param[in] _directory Directory.
+      /// \param[in] _options Save options. With a container, the records
+      /// saved to _directory are counted instead.
+      /// \return Number of files or records.
+      public: static std::uint64_t SavedCount(const std::string &_directory,
+          const Options &_options);
+
+      /// \brief Check whether a file format can store a pixel format.
+      /// \param[in] _fileFormat File format.
+      /// \param[in] _pixelFormat Pixel format.
+      /// \return True if frames in _pixelFormat are saved as they are.
+      /// Otherwise Save() falls back to FileFormat::RAW.
+      public: static bool Supports(FileFormat _fileFormat,
+          common::Image::PixelFormatType _pixelFormat);
+
+      /// \brief Get the file name extension of a file format.
+      /// \param[in] _format File format.
+      /// \return Extension without the leading dot.
+      public: static std::string Extension(FileFormat _format);
+
+      /// \brief Constructor. Workers are started on the first save.
+      /// \param[in] _workerCount Number of worker threads. Zero picks a
+      /// number based on the hardware concurrency.
+      /// \param[in] _queueSize Maximum number of queued frames.
+      public: explicit ImageSaver(unsigned int _workerCount = 0u,
+          std::size_t _queueSize = kDefaultQueueSize);
+
+      /// \brief Destructor. Saves the queued frames, then stops the workers.
+      public: ~ImageSaver();
+
+      /// \brief Create a directory unless this saver already did. Only the
+      /// first call for a directory touches the filesystem.
+      /// \param[in] _directory Directory path.
+      /// \return True if the directory exists.
+      public: bool EnsureDirectory(const std::string &_directory);
+
+      /// \brief Get a buffer to fill with an image and pass to Save(),
+      /// which avoids copying the image.
+      /// \param[in] _size Size in bytes.
+      /// \return The buffer.
+      public: FrameBuffer Buffer(std::size_t _size) const;
+
+      /// \brief Queue an image to be saved.
+      /// \param[in] _directory Directory, created if needed.
+      /// \param[in] _name File name within _directory, without extension.
+      /// The extension of the file format is appended.
+      /// \param[in] _buffer Image data, tightly packed, taken over by the
+      /// saver.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _format Image pixel format.
+      /// \param[in] _options Policy and file format.
+      /// \return False if the directory could not be created or the frame
+      /// was dropped.
+      public: bool Save(const std::string &_directory,
+          const std::string &_name, FrameBuffer &&_buffer,
+          unsigned int _width, unsigned int _height,
+          common::Image::PixelFormatType _format, const Options &_options);
+
+      /// \brief Copy an image and queue it to be saved.
+      /// \param[in] _directory Directory, created if needed.
+      /// \param[in] _name File name within _directory, without extension.
+      /// The extension of the file format is appended.
+      /// \param[in] _data Image data, tightly packed.
+      /// \param[in] _size Size of _data in bytes.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _format Image pixel format.
+      /// \param[in] _options Policy and file format.
+      /// \return False if the directory could not be created or the frame
+      /// was dropped.
+      public: bool Save(const std::string &_directory,
+          const std::string &_name, const unsigned char *_data,
+          std::size_t _size, unsigned int _width, unsigned int _height,
+          common::Image::PixelFormatType _format, const Options &_options);
+
+      /// \brief Queue data that needs no encoding, such as a CSV file, to be
+      /// saved.
+      /// \param[in] _directory Directory, created if needed.
+      /// \param[in] _name File name within _directory, with extension.
+      /// \param[in] _type Type of the data, recorded in containers.
+      /// \param[in] _data Data, taken over by the saver.
+      /// \param[in] _options Policy and container. The file format is not
+      /// used.
+      /// \return False if the directory could not be created or the data
+      /// was dropped.
+      public: bool SaveData(const std::string &_directory,
+          const std::string &_name, FrameContentType _type,
+          std::string &&_data, const Options &_options);
+
+      /// \brief Wait until all queued frames are written.
+      public: void Flush();
+
+      /// \brief Wait until all queued frames are written, then close the
+      /// container of a sensor, if it uses one. Sensors call this when they
+      /// are destroyed.
+      /// \param[in] _options Save options of the sensor.
+      public: void Finish(const Options &_options);
+
+      /// \brief Get the number of frames dropped because the queue was full.
+      /// \return Number of dropped frames.
+      public: std::uint64_t DroppedCount() const;
+
+      /// \brief A queued image.
+      private: struct Job
+      {
+        /// \brief Output file path, or record name when saving to a
+        /// container, with extension.
+        std::string path;
+
+        /// \brief Container to append to, null to write a file.
+        FrameContainerWriter *container = nullptr;
+
+        /// \brief File format.
+        FileFormat fileFormat;
+
+        /// \brief Image data.
+        FrameBuffer buffer;
+
+        /// \brief Data written as it is, used instead of buffer when type
+        /// is set.
+        std::string data;
+
+        /// \brief Type of data, UNKNOWN for images.
+        FrameContentType type = FrameContentType::UNKNOWN;
+
+        /// \brief Image width in pixels.
+        unsigned int width;
+
+        /// \brief Image height in pixels.
+        unsigned int height;
+
+        /// \brief Image pixel format.
+        common::Image::PixelFormatType format;
+      };
+
+      /// \brief Resolve where a frame is saved and queue it.
+      /// \param[in] _directory Directory, created if needed.
+      /// \param[in] _name File name within _directory, with extension.
+      /// \param[in,out] _job The frame, path and container are set.
+      /// \param[in] _options Policy and container.
+      /// \return False if the directory could not be created or the frame
+      /// was dropped.
+      private: bool Enqueue(const std::string &_directory,
+          const std::string &_name, Job &&_job, const Options &_options);
+
+      /// \brief Worker thread loop.
+      private: void Run();
+
+      /// \brief Encode and write a frame to a file or a container.
+      /// \param[in] _job The frame.
+      /// \param[in,out] _encoded Encoding buffer, reused between frames.
+      /// \param[in,out] _raw Raw dump buffer for LZ4, reused between
+      /// frames.
+      /// \return True on success.
+      private: static bool Write(const Job &_job,
+          std::vector<unsigned char> &_encoded,
+          std::vector<unsigned char> &_raw);
+
+      /// \brief Number of worker threads.
+      private: unsigned int workerCount;
+
+      /// \brief Maximum number of queued frames.
+      private: std::size_t queueSize;
+
+      /// \brief Worker threads.
+      private: std::vector<std::thread> workers;
+
+      /// \brief Queued frames.
+      private: std::deque<Job> queue;
+
+      /// \brief Number of frames taken off the queue but not written yet.
+      private: unsigned int active = 0u;
+
+      /// \brief Number of dropped frames.
+      private: std::uint64_t dropped = 0u;
+
+      /// \brief True when the workers should exit.
+      private: bool stop = false;
+
+      /// \brief True once a fallback to another file format was reported.
+      private: bool warnedFallback = false;
+
+      /// \brief Directories already created.
+      private: std::set<std::string> directories;
+
+      /// \brief Open containers by path.
+      private: std::map<std::string,
+          std::unique_ptr<FrameContainerWriter>> containers;
+
+      /// \brief Protects all members above.
+      private: mutable std::mutex mutex;
+
+      /// \brief Signaled when a frame is queued or the saver stops.
+      private: std::condition_variable jobAvailable;
+
+      /// \brief Signaled when a frame is taken off the queue or written.
+      private: std::condition_variable jobDone;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,336 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ignition/common/Filesystem.hh>
+#include <ignition/common/Image.hh>
+#include <sdf/Camera.hh>
+#include <sdf/Link.hh>
+#include <sdf/Model.hh>
+#include <sdf/Root.hh>
+#include <sdf/Sensor.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "FrameEncoding.hh"
+#include "ImageSaver.hh"
+
+using namespace ignition;
+using namespace sensors;
+
+/// \brief Test the image saver
+class ImageSaver_TEST : public ::testing::Test
+{
+  // Documentation inherited
+  protected: void SetUp() override
+  {
+    this->path = common::joinPaths(PROJECT_BUILD_PATH, "test",
+        "image_saver");
+    common::removeAll(this->path);
+  }
+
+  // Documentation inherited
+  protected: void TearDown() override
+  {
+    common::removeAll(this->path);
+  }
+
+  /// \brief Directory the test saves to
+  protected: std::string path;
+};
+
+//////////////////////////////////////////////////
+TEST_F(ImageSaver_TEST, SaveAndFlush)
+{
+  const unsigned int width = 8u;
+  const unsigned int height = 4u;
+  const std::size_t size = width * height * 3u;
+
+  ImageSaver saver(2u, 2u);
+  ImageSaver::Options options;
+  for (int i = 0; i < 10; ++i)
+  {
+    FrameBuffer buffer = saver.Buffer(size);
+    std::memset(buffer.Data<unsigned char>(), i * 20, size);
+    EXPECT_TRUE(saver.Save(this->path, std::to_string(i),
+        std::move(buffer), width, height, common::Image::RGB_INT8,
+        options));
+  }
+
+  // Copying overload
+  unsigned char data[size];
+  std::memset(data, 255, size);
+  EXPECT_TRUE(saver.Save(this->path, "copy", data, size, width, height,
+      common::Image::RGB_INT8, options));
+
+  saver.Flush();
+  EXPECT_EQ(0u, saver.DroppedCount());
+
+  for (int i = 0; i < 10; ++i)
+  {
+    std::string file = common::joinPaths(this->path, std::to_string(i) +
+        ".png");
+    ASSERT_TRUE(common::isFile(file)) << file;
+
+    common::Image image(file);
+    EXPECT_EQ(width, image.Width());
+    EXPECT_EQ(height, image.Height());
+    EXPECT_NEAR(i * 20, image.Pixel(1, 1).R() * 255.0, 1.0);
+  }
+  EXPECT_TRUE(common::isFile(common::joinPaths(this->path, "copy.png")));
+}
+
+//////////////////////////////////////////////////
+/// \brief Read a whole file
+std::vector<unsigned char> readFile(const std::string &_path)
+{
+  std::ifstream file(_path, std::ios::binary);
+  return std::vector<unsigned char>(std::istreambuf_iterator<char>(file),
+      std::istreambuf_iterator<char>());
+}
+
+//////////////////////////////////////////////////
+TEST_F(ImageSaver_TEST, FileFormats)
+{
+  const unsigned int width = 16u;
+  const unsigned int height = 8u;
+
+  std::vector<unsigned char> rgb(width * height * 3u);
+  for (std::size_t i = 0u; i < rgb.size(); ++i)
+    rgb[i] = static_cast<unsigned char>(i * 7u);
+  std::vector<float> depth(width * height);
+  for (std::size_t i = 0u; i < depth.size(); ++i)
+    depth[i] = 0.25f * i;
+  const unsigned char *depthBytes =
+      reinterpret_cast<const unsigned char *>(depth.data());
+  const std::size_t depthSize = depth.size() * sizeof(float);
+
+  ImageSaver saver;
+  ImageSaver::Options options;
+
+  options.format = ImageSaver::FileFormat::QOI;
+  EXPECT_TRUE(saver.Save(this->path, "rgb", rgb.data(), rgb.size(), width,
+      height, common::Image::RGB_INT8, options));
+
+  // QOI can not store floats, the depth is dumped raw instead
+  EXPECT_FALSE(ImageSaver::Supports(options.format,
+      common::Image::R_FLOAT32));
+  EXPECT_TRUE(saver.Save(this->path, "depth_fallback", depthBytes,
+      depthSize, width, height, common::Image::R_FLOAT32, options));
+
+  options.format = ImageSaver::FileFormat::RAW;
+  EXPECT_TRUE(saver.Save(this->path, "depth", depthBytes, depthSize, width,
+      height, common::Image::R_FLOAT32, options));
+
+  options.format = ImageSaver::FileFormat::LZ4;
+  EXPECT_TRUE(saver.Save(this->path, "depth", depthBytes, depthSize, width,
+      height, common::Image::R_FLOAT32, options));
+  saver.Flush();
+
+  // QOI
+  std::vector<unsigned char> file =
+      readFile(common::joinPaths(this->path, "rgb.qoi"));
+  std::vector<unsigned char> decoded;
+  unsigned int w, h, channels;
+  ASSERT_TRUE(FrameEncoding::DecodeQoi(file.data(), file.size(), w, h,
+      channels, decoded));
+  EXPECT_EQ(width, w);
+  EXPECT_EQ(height, h);
+  EXPECT_EQ(3u, channels);
+  EXPECT_EQ(rgb, decoded);
+
+  // Raw, lossless float depth
+  std::vector<unsigned char> raw =
+      readFile(common::joinPaths(this->path, "depth.raw"));
+  FrameEncoding::RawHeader header;
+  ASSERT_TRUE(FrameEncoding::DecodeRawHeader(raw.data(), raw.size(),
+      header));
+  EXPECT_EQ(FrameEncoding::DataType::FLOAT32, header.dataType);
+  EXPECT_EQ(1u, header.channels);
+  EXPECT_EQ(width, header.width);
+  EXPECT_EQ(height, header.height);
+  EXPECT_EQ(width * sizeof(float), header.step);
+  ASSERT_EQ(depthSize, header.dataSize);
+  EXPECT_EQ(0, std::memcmp(depthBytes,
+      raw.data() + FrameEncoding::kRawHeaderSize, depthSize));
+
+  EXPECT_EQ(raw,
+      readFile(common::joinPaths(this->path, "depth_fallback.raw")));
+
+  // LZ4 holds the same raw dump
+  file = readFile(common::joinPaths(this->path, "depth.raw.lz4"));
+  ASSERT_TRUE(FrameEncoding::DecompressLz4(file.data(), file.size(),
+      decoded));
+  EXPECT_EQ(raw, decoded);
+}
+
+//////////////////////////////////////////////////
+TEST_F(ImageSaver_TEST, Container)
+{
+  const unsigned int width = 4u;
+  const unsigned int height = 2u;
+  std::vector<unsigned char> rgb(width * height * 3u, 100u);
+  std::vector<float> depth(width * height, 1.5f);
+
+  ImageSaver saver;
+  ImageSaver::Options options;
+  options.container = common::joinPaths(this->path, "sensor.ignc");
+  const std::string images = this->path + "/images";
+  const std::string boxes = this->path + "/boxes";
+
+  for (std::uint64_t run = 0u; run < 2u; ++run)
+  {
+    EXPECT_EQ(run, ImageSaver::SavedCount(images, options));
+
+    // PNG is saved as QOI, floats as RAW
+    const std::string counter = std::to_string(run);
+    EXPECT_TRUE(saver.Save(images, "image_" + counter, rgb.data(),
+        rgb.size(), width, height, common::Image::RGB_INT8, options));
+    EXPECT_TRUE(saver.Save(this->path, "depth_" + counter,
+        reinterpret_cast<const unsigned char *>(depth.data()),
+        depth.size() * sizeof(float), width, height,
+        common::Image::R_FLOAT32, options));
+    EXPECT_TRUE(saver.SaveData(boxes, "boxes_" + counter + ".csv",
+        FrameContentType::CSV, "label\n", options));
+    saver.Finish(options);
+  }
+
+  // Only the container is written
+  EXPECT_TRUE(common::isFile(options.container));
+  EXPECT_FALSE(common::exists(images));
+  EXPECT_FALSE(common::exists(boxes));
+  EXPECT_EQ(2u, ImageSaver::SavedCount(images, options));
+  EXPECT_EQ(2u, ImageSaver::SavedCount(boxes, options));
+
+  FrameContainerReader reader;
+  ASSERT_TRUE(reader.Open(options.container));
+  EXPECT_FALSE(reader.Recovered());
+  EXPECT_EQ(6u, reader.RecordCount());
+
+  std::size_t index = 0u;
+  std::size_t size = 0u;
+  ASSERT_TRUE(reader.Find("images/image_1.qoi", index));
+  EXPECT_EQ(FrameContentType::QOI, reader.Type(index));
+  const unsigned char *data = reader.Data(index, size);
+  std::vector<unsigned char> decoded;
+  unsigned int w, h, channels;
+  ASSERT_TRUE(FrameEncoding::DecodeQoi(data, size, w, h, channels,
+      decoded));
+  EXPECT_EQ(rgb, decoded);
+
+  ASSERT_TRUE(reader.Find("depth_0.raw", index));
+  EXPECT_EQ(FrameContentType::RAW, reader.Type(index));
+  data = reader.Data(index, size);
+  ASSERT_EQ(FrameEncoding::kRawHeaderSize + depth.size() * sizeof(float),
+      size);
+  EXPECT_EQ(0, std::memcmp(depth.data(),
+      data + FrameEncoding::kRawHeaderSize, depth.size() * sizeof(float)));
+
+  ASSERT_TRUE(reader.Find("boxes/boxes_1.csv", index));
+  EXPECT_EQ(FrameContentType::CSV, reader.Type(index));
+  data = reader.Data(index, size);
+  EXPECT_EQ("label\n",
+      std::string(reinterpret_cast<const char *>(data), size));
+}
+
+//////////////////////////////////////////////////
+TEST_F(ImageSaver_TEST, EnsureDirectory)
+{
+  ImageSaver saver;
+  std::string dir = common::joinPaths(this->path, "a", "b");
+  EXPECT_TRUE(saver.EnsureDirectory(dir));
+  EXPECT_TRUE(common::isDirectory(dir));
+
+  // A file in the way can not be turned into a directory
+  std::string file = common::joinPaths(this->path, "file");
+  std::ofstream(file) << "x";
+  EXPECT_FALSE(saver.EnsureDirectory(common::joinPaths(file, "c")));
+}
+
+//////////////////////////////////////////////////
+/// \brief Read the save options of a camera sensor
+/// \param[in] _element Extra elements of the <camera>
+/// \return The options
+ImageSaver::Options optionsFromString(const std::string &_element)
+{
+  std::string sdfString = std::string(
+      "<sdf version='1.6'><model name='m'><link name='l'>"
+      "<sensor name='c' type='camera'><camera>"
+      "<image><width>8</width><height>4</height></image>") +
+      _element + "</camera></sensor></link></model></sdf>";
+
+  sdf::Root root;
+  EXPECT_TRUE(root.LoadSdfString(sdfString).empty());
+  const sdf::Camera *camera =
+      root.Model()->LinkByIndex(0)->SensorByIndex(0)->CameraSensor();
+  EXPECT_NE(nullptr, camera);
+  return ImageSaver::OptionsFromSdf(*camera, "c");
+}
+
+//////////////////////////////////////////////////
+TEST(ImageSaverOptions_TEST, OptionsFromSdf)
+{
+  ImageSaver::Options options = optionsFromString("");
+  EXPECT_EQ(ImageSaver::Policy::BLOCK, options.policy);
+  EXPECT_EQ(ImageSaver::FileFormat::PNG, options.format);
+
+  EXPECT_EQ(ImageSaver::Policy::BLOCK, optionsFromString(
+      "<ignition:save_policy>block</ignition:save_policy>").policy);
+  EXPECT_EQ(ImageSaver::Policy::DROP, optionsFromString(
+      "<ignition:save_policy>drop</ignition:save_policy>").policy);
+  EXPECT_EQ(ImageSaver::Policy::BLOCK, optionsFromString(
+      "<ignition:save_policy>bogus</ignition:save_policy>").policy);
+
+  EXPECT_EQ(ImageSaver::FileFormat::RAW, optionsFromString(
+      "<ignition:save_format>raw</ignition:save_format>").format);
+  EXPECT_EQ(ImageSaver::FileFormat::QOI, optionsFromString(
+      "<ignition:save_format>qoi</ignition:save_format>").format);
+  EXPECT_EQ(ImageSaver::FileFormat::LZ4, optionsFromString(
+      "<ignition:save_format>lz4</ignition:save_format>").format);
+  EXPECT_EQ(ImageSaver::FileFormat::PNG, optionsFromString(
+      "<ignition:save_format>bogus</ignition:save_format>").format);
+
+  options = optionsFromString(
+      "<ignition:save_policy>drop</ignition:save_policy>"
+      "<ignition:save_format>qoi</ignition:save_format>");
+  EXPECT_EQ(ImageSaver::Policy::DROP, options.policy);
+  EXPECT_EQ(ImageSaver::FileFormat::QOI, options.format);
+  EXPECT_TRUE(options.container.empty());
+
+  // The container is named after the sensor
+  options = optionsFromString(
+      "<save enabled='true'><path>/tmp/frames</path></save>"
+      "<ignition:save_container>true</ignition:save_container>");
+  EXPECT_EQ(common::joinPaths("/tmp/frames", "c.ignc"), options.container);
+  EXPECT_TRUE(optionsFromString(
+      "<ignition:save_container>false</ignition:save_container>")
+      .container.empty());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
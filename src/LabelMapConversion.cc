@@ -0,0 +1,297 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "LabelMapConversion.hh"
+#include "ParallelRows.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Format names, in LabelMapConversion::Format order.
+  const char *const kFormatNames[] = {"R8G8B8", "L8", "L16"};
+
+  /// \brief Key of the instance of a pixel of a labels map.
+  /// \param[in] _pixel RGB8 pixel.
+  /// \param[in] _panoptic True for panoptic labels maps.
+  /// \return Label in the upper bits, instance count in the lower 16.
+  std::uint32_t instanceKey(const unsigned char *_pixel, bool _panoptic)
+  {
+    if (!_panoptic)
+      return static_cast<std::uint32_t>(_pixel[0]) << 16u;
+    return (static_cast<std::uint32_t>(_pixel[2]) << 16u) |
+        (static_cast<std::uint32_t>(_pixel[1]) << 8u) | _pixel[0];
+  }
+
+  /// \brief Running measurements of an instance.
+  struct Accumulator
+  {
+    /// \brief Number of pixels.
+    std::uint64_t pixels = 0u;
+
+    /// \brief Sum of the columns.
+    std::uint64_t sumU = 0u;
+
+    /// \brief Sum of the rows.
+    std::uint64_t sumV = 0u;
+
+    /// \brief Smallest column.
+    unsigned int minU = ~0u;
+
+    /// \brief Smallest row.
+    unsigned int minV = ~0u;
+
+    /// \brief Largest column.
+    unsigned int maxU = 0u;
+
+    /// \brief Largest row.
+    unsigned int maxV = 0u;
+
+    /// \brief Add a run of pixels of a row.
+    /// \param[in] _begin First column.
+    /// \param[in] _end One past the last column.
+    /// \param[in] _v Row.
+    void AddRun(unsigned int _begin, unsigned int _end, unsigned int _v)
+    {
+      const std::uint64_t length = _end - _begin;
+      this->pixels += length;
+      // The sum of the columns of the run, length * (first + last) is even
+      this->sumU += length * (_begin + _end - 1u) / 2u;
+      this->sumV += length * _v;
+      this->minU = std::min(this->minU, _begin);
+      this->maxU = std::max(this->maxU, _end - 1u);
+      this->minV = std::min(this->minV, _v);
+      this->maxV = std::max(this->maxV, _v);
+    }
+
+    /// \brief Merge another accumulator.
+    /// \param[in] _other Accumulator.
+    void Merge(const Accumulator &_other)
+    {
+      this->pixels += _other.pixels;
+      this->sumU += _other.sumU;
+      this->sumV += _other.sumV;
+      this->minU = std::min(this->minU, _other.minU);
+      this->maxU = std::max(this->maxU, _other.maxU);
+      this->minV = std::min(this->minV, _other.minV);
+      this->maxV = std::max(this->maxV, _other.maxV);
+    }
+  };
+}
+
+//////////////////////////////////////////////////
+bool LabelMapConversion::SetFormat(const std::string &_name)
+{
+  for (unsigned int i = 0; i < 3u; ++i)
+  {
+    if (_name == kFormatNames[i])
+    {
+      this->SetFormat(static_cast<Format>(i));
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void LabelMapConversion::SetFormat(Format _format)
+{
+  this->format = _format;
+}
+
+//////////////////////////////////////////////////
+LabelMapConversion::Format LabelMapConversion::OutputFormat() const
+{
+  return this->format;
+}
+
+//////////////////////////////////////////////////
+unsigned int LabelMapConversion::BytesPerPixel() const
+{
+  switch (this->format)
+  {
+    case Format::L8:
+      return 1u;
+    case Format::L16:
+      return 2u;
+    default:
+      return 3u;
+  }
+}
+
+//////////////////////////////////////////////////
+void LabelMapConversion::SetPanoptic(bool _panoptic)
+{
+  this->panoptic = _panoptic;
+}
+
+//////////////////////////////////////////////////
+bool LabelMapConversion::Convert(const unsigned char *_labels,
+    std::size_t _count, unsigned char *_dst) const
+{
+  if (this->format == Format::L8)
+  {
+    // The label is in every channel of semantic maps, in blue otherwise
+    const unsigned char *src = _labels + (this->panoptic ? 2u : 0u);
+    for (std::size_t i = 0; i < _count; ++i)
+      _dst[i] = src[3u * i];
+    return true;
+  }
+
+  if (this->format == Format::L16)
+  {
+    // Assembled in a local value and stored with memcpy, the destination
+    // is a message buffer with no alignment guarantee
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      const unsigned char *pixel = _labels + 3u * i;
+      const std::uint16_t value = this->panoptic ?
+          static_cast<std::uint16_t>((pixel[1] << 8u) | pixel[0]) :
+          pixel[0];
+      std::memcpy(_dst + 2u * i, &value, sizeof(value));
+    }
+    return true;
+  }
+
+  return false;
+}
+
+//////////////////////////////////////////////////
+void LabelMapConversion::EncodeInstances(const unsigned char *_labels,
+    unsigned int _width, unsigned int _height, int _background,
+    std::vector<std::int32_t> &_data)
+{
+  // Instances that were gone from the last image are dropped, the others
+  // keep their run storage
+  for (auto it = this->runs.begin(); it != this->runs.end();)
+  {
+    if (it->second.empty())
+    {
+      it = this->runs.erase(it);
+    }
+    else
+    {
+      it->second.clear();
+      ++it;
+    }
+  }
+
+  const std::size_t count = static_cast<std::size_t>(_width) * _height;
+  std::size_t start = 0u;
+  std::uint32_t key = count > 0u ? instanceKey(_labels, this->panoptic) : 0u;
+  for (std::size_t i = 1u; i <= count; ++i)
+  {
+    std::uint32_t next = key;
+    if (i < count)
+    {
+      next = instanceKey(_labels + 3u * i, this->panoptic);
+      if (next == key)
+        continue;
+    }
+
+    if (static_cast<int>(key >> 16u) != _background)
+    {
+      std::vector<std::int32_t> &spans = this->runs[key];
+      spans.push_back(static_cast<std::int32_t>(start));
+      spans.push_back(static_cast<std::int32_t>(i - start));
+    }
+    start = i;
+    key = next;
+  }
+
+  _data.clear();
+  _data.push_back(static_cast<std::int32_t>(_width));
+  _data.push_back(static_cast<std::int32_t>(_height));
+  _data.push_back(0);
+  std::int32_t instances = 0;
+  for (const auto &entry : this->runs)
+  {
+    if (entry.second.empty())
+      continue;
+    _data.push_back(static_cast<std::int32_t>(entry.first >> 16u));
+    _data.push_back(static_cast<std::int32_t>(entry.first & 0xFFFFu));
+    _data.push_back(static_cast<std::int32_t>(entry.second.size() / 2u));
+    _data.insert(_data.end(), entry.second.begin(), entry.second.end());
+    ++instances;
+  }
+  _data[2] = instances;
+}
+
+//////////////////////////////////////////////////
+void LabelMapConversion::Measure(const unsigned char *_labels,
+    unsigned int _width, unsigned int _height, int _background,
+    std::vector<Instance> &_instances) const
+{
+  std::map<std::uint32_t, Accumulator> total;
+  std::mutex mutex;
+  const bool panopticMap = this->panoptic;
+
+  ParallelRows::Instance().Run(_height,
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        // Runs of equal pixels are looked up once, which keeps the map out
+        // of the per pixel loop
+        std::map<std::uint32_t, Accumulator> part;
+        for (unsigned int v = _begin; v < _end; ++v)
+        {
+          const unsigned char *row =
+              _labels + static_cast<std::size_t>(v) * _width * 3u;
+          unsigned int start = 0u;
+          while (start < _width)
+          {
+            const std::uint32_t key = instanceKey(row + 3u * start,
+                panopticMap);
+            unsigned int end = start + 1u;
+            while (end < _width &&
+                instanceKey(row + 3u * end, panopticMap) == key)
+            {
+              ++end;
+            }
+            if (static_cast<int>(key >> 16u) != _background)
+              part[key].AddRun(start, end, v);
+            start = end;
+          }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &entry : part)
+          total[entry.first].Merge(entry.second);
+      });
+
+  _instances.clear();
+  _instances.reserve(total.size());
+  for (const auto &entry : total)
+  {
+    const Accumulator &acc = entry.second;
+    Instance instance;
+    instance.label = static_cast<int>(entry.first >> 16u);
+    instance.instance = entry.first & 0xFFFFu;
+    instance.pixels = acc.pixels;
+    instance.minU = acc.minU;
+    instance.minV = acc.minV;
+    instance.maxU = acc.maxU;
+    instance.maxV = acc.maxV;
+    instance.centroidU = static_cast<double>(acc.sumU) / acc.pixels;
+    instance.centroidV = static_cast<double>(acc.sumV) / acc.pixels;
+    _instances.push_back(instance);
+  }
+}
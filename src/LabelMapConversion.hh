@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_LABELMAPCONVERSION_HH_
+#define GZ_SENSORS_LABELMAPCONVERSION_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define LabelMapConversion_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define LabelMapConversion_EXPORTS_API __declspec(dllexport)
+#  else
+#    define LabelMapConversion_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Converts the RGB8 labels maps of segmentation cameras to
+    /// compact formats. The SegmentationCameraSensor class uses this.
+    ///
+    /// Semantic labels maps hold the label in all three channels. Panoptic
+    /// labels maps hold the label in the blue channel and the instance
+    /// count in red (low byte) and green (high byte).
+    ///
+    /// Besides converting, it run length encodes instances and measures the
+    /// pixel count, bounding box and centroid of each of them.
+    class LabelMapConversion_EXPORTS_API LabelMapConversion
+    {
+      /// \brief Labels map formats.
+      public: enum class Format
+      {
+        /// \brief The RGB8 labels map as rendered.
+        R8G8B8,
+
+        /// \brief One byte per pixel, the label.
+        L8,
+
+        /// \brief Two bytes per pixel, the label for semantic segmentation
+        /// and the instance count for panoptic segmentation.
+        L16
+      };
+
+      /// \brief Measurements of one label or instance.
+      public: struct Instance
+      {
+        /// \brief Label.
+        int label = 0;
+
+        /// \brief Instance count, zero for semantic labels maps.
+        unsigned int instance = 0u;
+
+        /// \brief Number of pixels.
+        std::uint64_t pixels = 0u;
+
+        /// \brief Smallest column.
+        unsigned int minU = 0u;
+
+        /// \brief Smallest row.
+        unsigned int minV = 0u;
+
+        /// \brief Largest column.
+        unsigned int maxU = 0u;
+
+        /// \brief Largest row.
+        unsigned int maxV = 0u;
+
+        /// \brief Mean column.
+        double centroidU = 0.0;
+
+        /// \brief Mean row.
+        double centroidV = 0.0;
+      };
+
+      /// \brief Set the format from its name: "R8G8B8", "L8" or "L16".
+      /// \param[in] _name Format name.
+      /// \return False if the name is unknown, in which case the format is
+      /// left unchanged.
+      public: bool SetFormat(const std::string &_name);
+
+      /// \brief Set the format.
+      /// \param[in] _format Format.
+      public: void SetFormat(Format _format);
+
+      /// \brief Get the format.
+      /// \return Format.
+      public: Format OutputFormat() const;
+
+      /// \brief Get the number of bytes per pixel of the format.
+      /// \return 3, 1 or 2.
+      public: unsigned int BytesPerPixel() const;
+
+      /// \brief Set whether labels maps are panoptic, which holds instance
+      /// counts, or semantic. Defaults to semantic.
+      /// \param[in] _panoptic True for panoptic labels maps.
+      public: void SetPanoptic(bool _panoptic);
+
+      /// \brief Convert a labels map to the format.
+      /// \param[in] _labels RGB8 labels map.
+      /// \param[in] _count Number of pixels.
+      /// \param[out] _dst Destination with room for BytesPerPixel() *
+      /// _count bytes.
+      /// \return False if the format is R8G8B8, which needs no conversion.
+      public: bool Convert(const unsigned char *_labels, std::size_t _count,
+          unsigned char *_dst) const;
+
+      /// \brief Run length encode the instances of a labels map. Pixels are
+      /// numbered in row major order, and runs may span rows. The output is
+      /// the width, the height and the number of instances, followed for
+      /// each instance by its label, its instance count (zero for semantic
+      /// labels maps), its number of runs and the first pixel and length of
+      /// each run. Instances are sorted by label, then by instance count.
+      /// \param[in] _labels RGB8 labels map.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _background Label of the background, which is skipped.
+      /// \param[out] _data Encoded instances.
+      public: void EncodeInstances(const unsigned char *_labels,
+          unsigned int _width, unsigned int _height, int _background,
+          std::vector<std::int32_t> &_data);
+
+      /// \brief Measure every label, or every instance of panoptic labels
+      /// maps, in one pass. Rows are processed in parallel, one run of equal
+      /// pixels at a time.
+      /// \param[in] _labels RGB8 labels map.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[in] _background Label of the background, which is skipped.
+      /// \param[out] _instances Measurements, sorted by label, then by
+      /// instance count.
+      public: void Measure(const unsigned char *_labels, unsigned int _width,
+          unsigned int _height, int _background,
+          std::vector<Instance> &_instances) const;
+
+      /// \brief Format.
+      private: Format format = Format::R8G8B8;
+
+      /// \brief True for panoptic labels maps.
+      private: bool panoptic = false;
+
+      /// \brief Runs of each instance, keyed by label and instance count,
+      /// kept between images.
+      private: std::map<std::uint32_t, std::vector<std::int32_t>> runs;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "LabelMapConversion.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Append a panoptic pixel.
+  void panoptic(std::vector<unsigned char> &_map, unsigned char _label,
+      unsigned int _instance)
+  {
+    _map.push_back(static_cast<unsigned char>(_instance & 0xFFu));
+    _map.push_back(static_cast<unsigned char>(_instance >> 8u));
+    _map.push_back(_label);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(LabelMapConversion_TEST, Format)
+{
+  LabelMapConversion conversion;
+  EXPECT_EQ(LabelMapConversion::Format::R8G8B8, conversion.OutputFormat());
+  EXPECT_EQ(3u, conversion.BytesPerPixel());
+  EXPECT_TRUE(conversion.SetFormat("L16"));
+  EXPECT_EQ(2u, conversion.BytesPerPixel());
+  EXPECT_FALSE(conversion.SetFormat("L32"));
+  EXPECT_EQ(LabelMapConversion::Format::L16, conversion.OutputFormat());
+  EXPECT_TRUE(conversion.SetFormat("L8"));
+  EXPECT_EQ(1u, conversion.BytesPerPixel());
+
+  unsigned char out[4];
+  conversion.SetFormat(LabelMapConversion::Format::R8G8B8);
+  const unsigned char pixel[3] = {1u, 1u, 1u};
+  EXPECT_FALSE(conversion.Convert(pixel, 1u, out));
+}
+
+//////////////////////////////////////////////////
+TEST(LabelMapConversion_TEST, Convert)
+{
+  const std::vector<unsigned char> semantic = {0, 0, 0, 7, 7, 7, 255, 255,
+      255};
+  std::vector<unsigned char> out(6u);
+
+  LabelMapConversion conversion;
+  conversion.SetFormat(LabelMapConversion::Format::L8);
+  ASSERT_TRUE(conversion.Convert(semantic.data(), 3u, out.data()));
+  EXPECT_EQ(0u, out[0]);
+  EXPECT_EQ(7u, out[1]);
+  EXPECT_EQ(255u, out[2]);
+
+  conversion.SetFormat(LabelMapConversion::Format::L16);
+  ASSERT_TRUE(conversion.Convert(semantic.data(), 3u, out.data()));
+  std::uint16_t values[3];
+  std::memcpy(values, out.data(), sizeof(values));
+  EXPECT_EQ(0u, values[0]);
+  EXPECT_EQ(7u, values[1]);
+  EXPECT_EQ(255u, values[2]);
+
+  // Panoptic maps give the label in L8 and the instance in L16
+  std::vector<unsigned char> map;
+  panoptic(map, 4u, 2u);
+  panoptic(map, 9u, 700u);
+  conversion.SetPanoptic(true);
+  ASSERT_TRUE(conversion.Convert(map.data(), 2u, out.data()));
+  std::memcpy(values, out.data(), 2u * sizeof(std::uint16_t));
+  EXPECT_EQ(2u, values[0]);
+  EXPECT_EQ(700u, values[1]);
+
+  conversion.SetFormat(LabelMapConversion::Format::L8);
+  ASSERT_TRUE(conversion.Convert(map.data(), 2u, out.data()));
+  EXPECT_EQ(4u, out[0]);
+  EXPECT_EQ(9u, out[1]);
+}
+
+//////////////////////////////////////////////////
+TEST(LabelMapConversion_TEST, EncodeInstances)
+{
+  // 4x2 image, background 0:
+  //   0 A A B
+  //   B B 0 A
+  // A is label 3 instance 1, B is label 3 instance 2
+  std::vector<unsigned char> map;
+  panoptic(map, 0u, 0u);
+  panoptic(map, 3u, 1u);
+  panoptic(map, 3u, 1u);
+  panoptic(map, 3u, 2u);
+  panoptic(map, 3u, 2u);
+  panoptic(map, 3u, 2u);
+  panoptic(map, 0u, 0u);
+  panoptic(map, 3u, 1u);
+
+  LabelMapConversion conversion;
+  conversion.SetPanoptic(true);
+  std::vector<std::int32_t> data;
+  conversion.EncodeInstances(map.data(), 4u, 2u, 0, data);
+  const std::vector<std::int32_t> expected = {4, 2, 2,
+      3, 1, 2, 1, 2, 7, 1,
+      3, 2, 1, 3, 3};
+  EXPECT_EQ(expected, data);
+
+  // A background image has no instances, and stale instances are gone
+  std::vector<unsigned char> empty;
+  for (int i = 0; i < 8; ++i)
+    panoptic(empty, 0u, 0u);
+  conversion.EncodeInstances(empty.data(), 4u, 2u, 0, data);
+  EXPECT_EQ((std::vector<std::int32_t>{4, 2, 0}), data);
+
+  // Semantic maps have no instance counts
+  const std::vector<unsigned char> semantic = {5, 5, 5, 5, 5, 5, 1, 1, 1};
+  LabelMapConversion semanticConversion;
+  semanticConversion.EncodeInstances(semantic.data(), 3u, 1u, 1, data);
+  EXPECT_EQ((std::vector<std::int32_t>{3, 1, 1, 5, 0, 1, 0, 2}), data);
+}
+
+//////////////////////////////////////////////////
+TEST(LabelMapConversion_TEST, Measure)
+{
+  // 5x4 panoptic image, background 0, with instance 1 of label 3 split in
+  // two parts and instance 2 a single pixel
+  const unsigned int width = 5u;
+  const unsigned int height = 4u;
+  const unsigned int ids[] = {
+      0, 1, 1, 0, 0,
+      0, 1, 1, 0, 2,
+      0, 0, 0, 0, 0,
+      1, 0, 0, 0, 0};
+  std::vector<unsigned char> map;
+  for (unsigned int id : ids)
+    panoptic(map, id > 0u ? 3u : 0u, id);
+
+  LabelMapConversion conversion;
+  conversion.SetPanoptic(true);
+  std::vector<LabelMapConversion::Instance> instances;
+  conversion.Measure(map.data(), width, height, 0, instances);
+  ASSERT_EQ(2u, instances.size());
+
+  const auto &first = instances[0];
+  EXPECT_EQ(3, first.label);
+  EXPECT_EQ(1u, first.instance);
+  EXPECT_EQ(5u, first.pixels);
+  EXPECT_EQ(0u, first.minU);
+  EXPECT_EQ(0u, first.minV);
+  EXPECT_EQ(2u, first.maxU);
+  EXPECT_EQ(3u, first.maxV);
+  EXPECT_DOUBLE_EQ((1 + 2 + 1 + 2 + 0) / 5.0, first.centroidU);
+  EXPECT_DOUBLE_EQ((0 + 0 + 1 + 1 + 3) / 5.0, first.centroidV);
+
+  const auto &second = instances[1];
+  EXPECT_EQ(2u, second.instance);
+  EXPECT_EQ(1u, second.pixels);
+  EXPECT_EQ(4u, second.minU);
+  EXPECT_EQ(4u, second.maxU);
+  EXPECT_EQ(1u, second.minV);
+  EXPECT_DOUBLE_EQ(4.0, second.centroidU);
+
+  // Many rows, so that several chunks are merged: label 9 on the diagonal
+  const unsigned int size = 300u;
+  std::vector<unsigned char> diagonal(size * size * 3u, 0u);
+  for (unsigned int i = 0; i < size; ++i)
+    std::memset(&diagonal[(i * size + i) * 3u], 9, 3u);
+  LabelMapConversion semantic;
+  semantic.Measure(diagonal.data(), size, size, 0, instances);
+  ASSERT_EQ(1u, instances.size());
+  EXPECT_EQ(9, instances[0].label);
+  EXPECT_EQ(0u, instances[0].instance);
+  EXPECT_EQ(size, instances[0].pixels);
+  EXPECT_EQ(size - 1u, instances[0].maxU);
+  EXPECT_EQ(size - 1u, instances[0].maxV);
+  EXPECT_DOUBLE_EQ((size - 1) / 2.0, instances[0].centroidU);
+  EXPECT_DOUBLE_EQ((size - 1) / 2.0, instances[0].centroidV);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -24,7 +24,11 @@
   #pragma warning(pop)
 #endif
 
+#include <algorithm>
+#include <cmath>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Profiler.hh>
@@ -35,12 +39,40 @@
 #include "gz/sensors/SensorFactory.hh"
 #include "gz/sensors/LogicalCameraSensor.hh"
 
+#include "ParallelRows.hh"
+#include "SpatialGrid.hh"
+
 using namespace gz;
 using namespace sensors;
 
 /// \brief Private data for LogicalCameraSensor
 class gz::sensors::LogicalCameraSensorPrivate
 {
+  /// \brief A model in the world
+  public: struct Model
+  {
+    /// \brief Model name
+    std::string name;
+
+    /// \brief World pose
+    math::Pose3d pose;
+  };
+
+  /// \brief Rebuild the grid from the models
+  public: void Reindex();
+
+  /// \brief Add a model within the frustum to the message
+  /// \param[in] _name Model name
+  /// \param[in] _pose Model world pose
+  /// \param[in] _sensorPose Sensor world pose
+  public: void AddModel(const std::string &_name, const math::Pose3d &_pose,
+      const math::Pose3d &_sensorPose);
+
+  /// \brief Get the axis aligned box bounding the frustum
+  /// \param[out] _min Minimum corner
+  /// \param[out] _max Maximum corner
+  public: void FrustumBox(math::Vector3d &_min, math::Vector3d &_max) const;
+
   /// \brief node to create publisher
   public: transport::Node node;
 
@@ -59,8 +91,20 @@ class gz::sensors::LogicalCameraSensorPrivate
   /// \brief Set world pose.
   public: math::Pose3d worldPose;
 
-  /// \brief List of models in the world
-  public: std::map<std::string, math::Pose3d> models;
+  /// \brief Models in the world, sorted by name. Indices are the ones
+  /// in the grid.
+  public: std::vector<Model> models;
+
+  /// \brief Grid of model positions, so that Update() only tests the
+  /// models near the frustum
+  public: SpatialGrid grid;
+
+  /// \brief Models shared with other logical cameras, used instead of
+  /// models when set
+  public: std::shared_ptr<const ModelPoseSnapshot> snapshot;
+
+  /// \brief Models near the frustum, reused between updates
+  public: std::vector<std::uint32_t> candidates;
 
   /// \brief Msg containg info on models detected by logical camera
   msgs::LogicalCameraImage msg;
@@ -108,6 +152,10 @@ bool LogicalCameraSensor::Load(sdf::ElementPtr _sdf)
   this->dataPtr->frustum.SetAspectRatio(
       cameraSdf->Get<double>("aspect_ratio"));
 
+  // A frustum spans a few cells of half its range
+  this->dataPtr->grid.SetCellSize(this->dataPtr->frustum.Far() * 0.5);
+  this->dataPtr->Reindex();
+
   if (!Sensor::Load(_sdf))
     return false;
 
@@ -135,7 +183,115 @@ bool LogicalCameraSensor::Load(sdf::ElementPtr _sdf)
 void LogicalCameraSensor::SetModelPoses(
     std::map<std::string, math::Pose3d> &&_models)
 {
-  this->dataPtr->models = std::move(_models);
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->snapshot.reset();
+  auto &models = this->dataPtr->models;
+
+  // Usually the same models have moved, which only moves the grid entries
+  // of the models that changed cells. Both lists are sorted by name.
+  if (models.size() == _models.size())
+  {
+    std::uint32_t index = 0u;
+    auto it = _models.begin();
+    for (; it != _models.end(); ++it, ++index)
+    {
+      Model &model = models[index];
+      if (model.name != it->first)
+        break;
+      this->dataPtr->grid.Move(index, model.pose.Pos(), it->second.Pos());
+      model.pose = it->second;
+    }
+    if (it == _models.end())
+      return;
+  }
+
+  // Models were added or removed
+  models.clear();
+  models.reserve(_models.size());
+  for (const auto &it : _models)
+    models.push_back({it.first, it.second});
+  this->dataPtr->Reindex();
+}
+
+//////////////////////////////////////////////////
+void LogicalCameraSensor::SetModelPoses(
+    std::shared_ptr<const ModelPoseSnapshot> _snapshot)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  this->dataPtr->snapshot = std::move(_snapshot);
+  this->dataPtr->models.clear();
+  this->dataPtr->grid.Clear();
+}
+
+//////////////////////////////////////////////////
+void LogicalCameraSensor::UpdateAll(
+    const std::vector<LogicalCameraSensor *> &_sensors,
+    const std::shared_ptr<const ModelPoseSnapshot> &_snapshot,
+    const std::chrono::steady_clock::duration &_now)
+{
+  IGN_PROFILE("LogicalCameraSensor::UpdateAll");
+  for (auto *sensor : _sensors)
+    sensor->SetModelPoses(_snapshot);
+
+  // Each camera has its own data, so cameras update on separate threads
+  ParallelRows::Instance().Run(static_cast<unsigned int>(_sensors.size()),
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        for (unsigned int i = _begin; i < _end; ++i)
+          _sensors[i]->Sensor::Update(_now, false);
+      }, 1u);
+}
+
+//////////////////////////////////////////////////
+void LogicalCameraSensorPrivate::AddModel(const std::string &_name,
+    const math::Pose3d &_pose, const math::Pose3d &_sensorPose)
+{
+  msgs::LogicalCameraImage::Model *modelMsg = this->msg.add_model();
+  modelMsg->set_name(_name);
+  msgs::Set(modelMsg->mutable_pose(), _pose - _sensorPose);
+}
+
+//////////////////////////////////////////////////
+void LogicalCameraSensorPrivate::Reindex()
+{
+  this->grid.Clear();
+  for (std::size_t i = 0; i < this->models.size(); ++i)
+  {
+    this->grid.Insert(static_cast<std::uint32_t>(i),
+        this->models[i].pose.Pos());
+  }
+}
+
+//////////////////////////////////////////////////
+void LogicalCameraSensorPrivate::FrustumBox(math::Vector3d &_min,
+    math::Vector3d &_max) const
+{
+  // The frustum looks along +x, its corners are those of the near and far
+  // planes
+  const double tanHalfFov = std::tan(this->frustum.FOV().Radian() * 0.5);
+  const math::Pose3d &pose = this->frustum.Pose();
+  _min.Set(INF_D, INF_D, INF_D);
+  _max.Set(-INF_D, -INF_D, -INF_D);
+  for (double distance : {this->frustum.Near(), this->frustum.Far()})
+  {
+    const double y = distance * tanHalfFov;
+    const double z = y / this->frustum.AspectRatio();
+    for (double sy : {-y, y})
+    {
+      for (double sz : {-z, z})
+      {
+        const math::Vector3d corner =
+            pose.Pos() + pose.Rot().RotateVector({distance, sy, sz});
+        _min.Min(corner);
+        _max.Max(corner);
+      }
+    }
+  }
+
+  // Models on the frustum's faces must not be lost to rounding
+  const math::Vector3d margin(1e-6, 1e-6, 1e-6);
+  _min -= margin * (1.0 + this->frustum.Far());
+  _max += margin * (1.0 + this->frustum.Far());
 }
 
 //////////////////////////////////////////////////
@@ -156,15 +312,38 @@ bool LogicalCameraSensor::Update(
   // set frustum pose
   this->dataPtr->frustum.SetPose(this->Pose());
 
+  // Only the models in the grid cells around the frustum are tested.
+  // Sorting them keeps the models in name order.
+  math::Vector3d boxMin;
+  math::Vector3d boxMax;
+  this->dataPtr->FrustumBox(boxMin, boxMax);
+  auto &candidates = this->dataPtr->candidates;
+  const math::Pose3d sensorPose = this->Pose();
+
   this->dataPtr->msg.clear_model();
-  for (const auto &it : this->dataPtr->models)
+  if (this->dataPtr->snapshot)
+  {
+    const ModelPoseSnapshot &snapshot = *this->dataPtr->snapshot;
+    snapshot.Query(boxMin, boxMax, candidates);
+    for (std::uint32_t index : candidates)
+    {
+      // The pose is only assembled for the models in the frustum
+      if (this->dataPtr->frustum.Contains(snapshot.Position(index)))
+      {
+        this->dataPtr->AddModel(snapshot.Name(index), snapshot.Pose(index),
+            sensorPose);
+      }
+    }
+  }
+  else
   {
-    if (this->dataPtr->frustum.Contains(it.second.Pos()))
+    this->dataPtr->grid.Query(boxMin, boxMax, candidates);
+    std::sort(candidates.begin(), candidates.end());
+    for (std::uint32_t index : candidates)
     {
-      msgs::LogicalCameraImage::Model *modelMsg =
-          this->dataPtr->msg.add_model();
-      modelMsg->set_name(it.first);
-      msgs::Set(modelMsg->mutable_pose(), it.second - this->Pose());
+      const auto &model = this->dataPtr->models[index];
+      if (this->dataPtr->frustum.Contains(model.pose.Pos()))
+        this->dataPtr->AddModel(model.name, model.pose, sensorPose);
     }
   }
   *this->dataPtr->msg.mutable_header()->mutable_stamp() = msgs::Convert(_now);
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gz/sensors/ModelPoseSnapshot.hh"
+
+#include <algorithm>
+
+#include "SpatialGrid.hh"
+
+using namespace gz;
+using namespace sensors;
+
+/// \brief Private data for ModelPoseSnapshot
+class gz::sensors::ModelPoseSnapshot::Implementation
+{
+  /// \brief Model names, in name order
+  public: std::vector<std::string> names;
+
+  /// \brief Position along x of each model
+  public: std::vector<double> x;
+
+  /// \brief Position along y of each model
+  public: std::vector<double> y;
+
+  /// \brief Position along z of each model
+  public: std::vector<double> z;
+
+  /// \brief Orientation of each model
+  public: std::vector<math::Quaterniond> rotations;
+
+  /// \brief Grid of the model positions
+  public: SpatialGrid grid;
+};
+
+//////////////////////////////////////////////////
+ModelPoseSnapshot::ModelPoseSnapshot(
+    const std::map<std::string, math::Pose3d> &_models, double _cellSize)
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+  const std::size_t count = _models.size();
+  this->dataPtr->names.reserve(count);
+  this->dataPtr->x.reserve(count);
+  this->dataPtr->y.reserve(count);
+  this->dataPtr->z.reserve(count);
+  this->dataPtr->rotations.reserve(count);
+  this->dataPtr->grid.SetCellSize(_cellSize);
+
+  std::uint32_t index = 0u;
+  for (const auto &it : _models)
+  {
+    const math::Vector3d &pos = it.second.Pos();
+    this->dataPtr->names.push_back(it.first);
+    this->dataPtr->x.push_back(pos.X());
+    this->dataPtr->y.push_back(pos.Y());
+    this->dataPtr->z.push_back(pos.Z());
+    this->dataPtr->rotations.push_back(it.second.Rot());
+    this->dataPtr->grid.Insert(index++, pos);
+  }
+}
+
+//////////////////////////////////////////////////
+ModelPoseSnapshot::~ModelPoseSnapshot() = default;
+
+//////////////////////////////////////////////////
+std::size_t ModelPoseSnapshot::Count() const
+{
+  return this->dataPtr->names.size();
+}
+
+//////////////////////////////////////////////////
+const std::string &ModelPoseSnapshot::Name(std::size_t _index) const
+{
+  return this->dataPtr->names[_index];
+}
+
+//////////////////////////////////////////////////
+math::Vector3d ModelPoseSnapshot::Position(std::size_t _index) const
+{
+  return math::Vector3d(this->dataPtr->x[_index], this->dataPtr->y[_index],
+      this->dataPtr->z[_index]);
+}
+
+//////////////////////////////////////////////////
+math::Pose3d ModelPoseSnapshot::Pose(std::size_t _index) const
+{
+  return math::Pose3d(this->Position(_index),
+      this->dataPtr->rotations[_index]);
+}
+
+//////////////////////////////////////////////////
+void ModelPoseSnapshot::Query(const math::Vector3d &_min,
+    const math::Vector3d &_max, std::vector<std::uint32_t> &_indices) const
+{
+  this->dataPtr->grid.Query(_min, _max, _indices);
+  std::sort(_indices.begin(), _indices.end());
+}
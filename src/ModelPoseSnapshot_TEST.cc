@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "gz/sensors/ModelPoseSnapshot.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(ModelPoseSnapshot_TEST, Models)
+{
+  std::map<std::string, math::Pose3d> models;
+  models["b"] = math::Pose3d(1, 2, 3, 0, 0, 0.5);
+  models["a"] = math::Pose3d(-4, 0.5, 0, 0.1, 0, 0);
+  models["c"] = math::Pose3d(40, 0, 0, 0, 0, 0);
+
+  ModelPoseSnapshot snapshot(models, 2.0);
+  ASSERT_EQ(3u, snapshot.Count());
+
+  // Models are in name order
+  EXPECT_EQ("a", snapshot.Name(0u));
+  EXPECT_EQ("b", snapshot.Name(1u));
+  EXPECT_EQ("c", snapshot.Name(2u));
+  EXPECT_EQ(math::Vector3d(1, 2, 3), snapshot.Position(1u));
+  EXPECT_EQ(models["b"], snapshot.Pose(1u));
+  EXPECT_EQ(models["a"], snapshot.Pose(0u));
+
+  std::vector<std::uint32_t> indices;
+  snapshot.Query({-5, -1, -1}, {2, 3, 4}, indices);
+  EXPECT_EQ(std::vector<std::uint32_t>({0u, 1u}), indices);
+
+  snapshot.Query({-100, -100, -100}, {100, 100, 100}, indices);
+  EXPECT_EQ(std::vector<std::uint32_t>({0u, 1u, 2u}), indices);
+
+  snapshot.Query({10, 10, 10}, {11, 11, 11}, indices);
+  EXPECT_TRUE(indices.empty());
+
+  ModelPoseSnapshot empty(std::map<std::string, math::Pose3d>{});
+  EXPECT_EQ(0u, empty.Count());
+  empty.Query({-100, -100, -100}, {100, 100, 100}, indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
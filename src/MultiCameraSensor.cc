@@ -0,0 +1,717 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#if defined(_MSC_VER)
+  #pragma warning(push)
+  #pragma warning(disable: 4005)
+  #pragma warning(disable: 4251)
+#endif
+#include <gz/msgs/camera_info.pb.h>
+#include <gz/msgs/image.pb.h>
+#if defined(_MSC_VER)
+  #pragma warning(pop)
+#endif
+
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <gz/common/Console.hh>
+#include <gz/common/Profiler.hh>
+#include <gz/math/Angle.hh>
+#include <gz/math/Helpers.hh>
+#include <gz/math/Pose3.hh>
+
+#include <gz/rendering/Camera.hh>
+#include <gz/rendering/Utils.hh>
+
+#include <gz/transport/Node.hh>
+
+#include <sdf/Camera.hh>
+#include <sdf/Sensor.hh>
+
+#include "gz/sensors/ImageGaussianNoiseModel.hh"
+#include "gz/sensors/ImageNoise.hh"
+#include "gz/sensors/MultiCameraSensor.hh"
+#include "gz/sensors/RenderingEvents.hh"
+#include "gz/sensors/SensorFactory.hh"
+
+/// \brief Private data for MultiCameraSensor
+class gz::sensors::MultiCameraSensorPrivate
+{
+  /// \brief One camera of the sensor
+  public: class CameraEntry
+  {
+    /// \brief SDF of the camera.
+    public: sdf::Camera sdf;
+
+    /// \brief Pose of the camera relative to the sensor.
+    public: math::Pose3d pose;
+
+    /// \brief Rendering camera.
+    public: rendering::CameraPtr camera;
+
+    /// \brief Image the rendered frame is copied into.
+    public: rendering::Image image;
+
+    /// \brief Noise added to the image.
+    public: NoisePtr noise;
+
+    /// \brief Publisher of images.
+    public: transport::Node::Publisher imagePub;
+
+    /// \brief Publisher of camera information.
+    public: transport::Node::Publisher infoPub;
+
+    /// \brief Camera information message.
+    public: msgs::CameraInfo infoMsg;
+
+    /// \brief True if the camera image was copied by the current update.
+    public: bool copied = false;
+  };
+
+  /// \brief Fill the camera information message of a camera.
+  /// \param[in,out] _entry Camera, with its rendering camera created.
+  /// \param[in] _baseline Distance from the first camera along the image x
+  /// axis, in meters.
+  /// \param[in] _frameId Frame the message header is expressed in.
+  public: static void PopulateInfo(CameraEntry &_entry,
+              double _baseline, const std::string &_frameId);
+
+  /// \brief Pack the images of all cameras left to right into the side by
+  /// side message.
+  public: void PackSideBySide();
+
+  /// \brief node to create publisher
+  public: transport::Node node;
+
+  /// \brief Publisher of side by side images
+  public: transport::Node::Publisher sideBySidePub;
+
+  /// \brief true if Load() has been called and was successful
+  public: bool initialized = false;
+
+  /// \brief Cameras, in SDF order.
+  public: std::vector<CameraEntry> cameras;
+
+  /// \brief Image messages, one per camera. Kept between updates so their
+  /// data buffers are reused.
+  public: std::vector<msgs::Image> imageMsgs;
+
+  /// \brief True to pack the images into one side by side image.
+  public: bool sideBySide = false;
+
+  /// \brief Side by side image message.
+  public: msgs::Image sideBySideMsg;
+
+  /// \brief Event that is used to trigger callbacks when a new set of
+  /// images is generated
+  public: common::EventT<
+          void(const std::vector<msgs::Image> &)> imagesEvent;
+
+  /// \brief Connection to the Manager's scene change event.
+  public: common::ConnectionPtr sceneChangeConnection;
+
+  /// \brief Just a mutex for thread safety
+  public: std::mutex mutex;
+};
+
+using namespace gz;
+using namespace sensors;
+
+/// \brief Get the message pixel format of a rendered image.
+/// \param[in] _format Rendering pixel format.
+/// \return Message pixel format, unknown if not supported.
+static msgs::PixelFormatType msgsPixelFormat(rendering::PixelFormat _format)
+{
+  switch (_format)
+  {
+    case rendering::PF_R8G8B8:
+      return msgs::PixelFormatType::RGB_INT8;
+    case rendering::PF_L8:
+      return msgs::PixelFormatType::L_INT8;
+    case rendering::PF_L16:
+      return msgs::PixelFormatType::L_INT16;
+    default:
+      return msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT;
+  }
+}
+
+//////////////////////////////////////////////////
+MultiCameraSensor::MultiCameraSensor()
+  : dataPtr(new MultiCameraSensorPrivate())
+{
+}
+
+//////////////////////////////////////////////////
+MultiCameraSensor::~MultiCameraSensor()
+{
+}
+
+//////////////////////////////////////////////////
+bool MultiCameraSensor::Init()
+{
+  return this->Sensor::Init();
+}
+
+//////////////////////////////////////////////////
+bool MultiCameraSensor::Load(sdf::ElementPtr _sdf)
+{
+  sdf::Sensor sdfSensor;
+  sdfSensor.Load(_sdf);
+  return this->Load(sdfSensor);
+}
+
+//////////////////////////////////////////////////
+bool MultiCameraSensor::Load(const sdf::Sensor &_sdf)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  if (!Sensor::Load(_sdf))
+  {
+    return false;
+  }
+
+  // Check if this is the right type
+  if (_sdf.Type() != sdf::SensorType::MULTICAMERA)
+  {
+    ignerr << "Attempting to a load a Multi Camera sensor, but received "
+      << "a " << _sdf.TypeStr() << std::endl;
+  }
+
+  // The sensor DOM holds a single camera, so the cameras are loaded from
+  // the <camera> elements directly
+  sdf::ElementPtr sensorElem = _sdf.Element();
+  if (!sensorElem || !sensorElem->HasElement("camera"))
+  {
+    ignerr << "Attempting to a load a Multi Camera sensor, but received "
+      << "no <camera> elements." << std::endl;
+    return false;
+  }
+
+  this->dataPtr->cameras.clear();
+  std::set<std::string> names;
+  for (sdf::ElementPtr cameraElem = sensorElem->GetElement("camera");
+      cameraElem; cameraElem = cameraElem->GetNextElement("camera"))
+  {
+    MultiCameraSensorPrivate::CameraEntry entry;
+    sdf::Errors errors = entry.sdf.Load(cameraElem);
+    if (!errors.empty())
+    {
+      for (const auto &error : errors)
+        ignerr << error.Message() << std::endl;
+      return false;
+    }
+
+    if (!names.insert(entry.sdf.Name()).second)
+    {
+      ignerr << "Camera names of Multi Camera sensor [" << this->Name()
+        << "] must be unique, found [" << entry.sdf.Name() << "] twice."
+        << std::endl;
+      return false;
+    }
+
+    entry.pose = entry.sdf.RawPose();
+    this->dataPtr->cameras.push_back(std::move(entry));
+  }
+
+  if (this->Topic().empty())
+    this->SetTopic("/multicamera");
+
+  for (auto &entry : this->dataPtr->cameras)
+  {
+    std::string cameraTopic = this->Topic() + "/" + entry.sdf.Name();
+
+    entry.imagePub = this->dataPtr->node.Advertise<msgs::Image>(
+        cameraTopic + "/image");
+    if (!entry.imagePub)
+    {
+      ignerr << "Unable to create publisher on topic["
+        << cameraTopic + "/image" << "].\n";
+      return false;
+    }
+
+    entry.infoPub = this->dataPtr->node.Advertise<msgs::CameraInfo>(
+        cameraTopic + "/camera_info");
+    if (!entry.infoPub)
+    {
+      ignerr << "Unable to create publisher on topic["
+        << cameraTopic + "/camera_info" << "].\n";
+      return false;
+    }
+
+    igndbg << "Images of camera [" << entry.sdf.Name() << "] for ["
+           << this->Name() << "] advertised on [" << cameraTopic << "/image]"
+           << std::endl;
+  }
+
+  this->dataPtr->sideBySide = sensorElem->HasElement("ignition:side_by_side")
+      && sensorElem->Get<bool>("ignition:side_by_side");
+  if (this->dataPtr->sideBySide)
+  {
+    this->dataPtr->sideBySidePub =
+        this->dataPtr->node.Advertise<msgs::Image>(
+            this->Topic() + "/side_by_side");
+    if (!this->dataPtr->sideBySidePub)
+    {
+      ignerr << "Unable to create publisher on topic["
+        << this->Topic() + "/side_by_side" << "].\n";
+      return false;
+    }
+
+    igndbg << "Side by side images for [" << this->Name()
+           << "] advertised on [" << this->Topic() << "/side_by_side]"
+           << std::endl;
+  }
+
+  if (this->Scene())
+  {
+    if (!this->CreateCameras())
+      return false;
+  }
+
+  this->dataPtr->sceneChangeConnection =
+      RenderingEvents::ConnectSceneChangeCallback(
+      std::bind(&MultiCameraSensor::SetScene, this, std::placeholders::_1));
+
+  this->dataPtr->initialized = true;
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool MultiCameraSensor::CreateCameras()
+{
+  auto &cameras = this->dataPtr->cameras;
+  this->dataPtr->imageMsgs.resize(cameras.size());
+
+  for (std::size_t i = 0u; i < cameras.size(); ++i)
+  {
+    MultiCameraSensorPrivate::CameraEntry &entry = cameras[i];
+    const sdf::Camera &cameraSdf = entry.sdf;
+
+    unsigned int width = cameraSdf.ImageWidth();
+    unsigned int height = cameraSdf.ImageHeight();
+
+    entry.camera = this->Scene()->CreateCamera(
+        this->Name() + "::" + cameraSdf.Name());
+    entry.camera->SetImageWidth(width);
+    entry.camera->SetImageHeight(height);
+    entry.camera->SetNearClipPlane(cameraSdf.NearClip());
+    entry.camera->SetFarClipPlane(cameraSdf.FarClip());
+    entry.camera->SetVisibilityMask(cameraSdf.VisibilityMask());
+
+    // All cameras are rendered by the same Render() call, after a single
+    // scene update
+    this->AddSensor(entry.camera);
+
+    const sdf::Noise &noiseSdf = cameraSdf.ImageNoise();
+    if (noiseSdf.Type() == sdf::NoiseType::GAUSSIAN)
+    {
+      entry.noise = ImageNoiseFactory::NewNoiseModel(noiseSdf, "multicamera");
+      std::dynamic_pointer_cast<ImageGaussianNoiseModel>(
+          entry.noise)->SetCamera(entry.camera);
+    }
+    else if (noiseSdf.Type() != sdf::NoiseType::NONE)
+    {
+      ignwarn << "The multi camera sensor only supports Gaussian noise. "
+       << "The supplied noise type[" << static_cast<int>(noiseSdf.Type())
+       << "] is not supported." << std::endl;
+    }
+
+    // \todo(nkoeng) these parameters via sdf
+    entry.camera->SetAntiAliasing(2);
+
+    math::Angle angle = cameraSdf.HorizontalFov();
+    if (angle < 0.01 || angle > IGN_PI*2)
+    {
+      ignerr << "Invalid horizontal field of view [" << angle << "]\n";
+      return false;
+    }
+    entry.camera->SetAspectRatio(static_cast<double>(width)/height);
+    entry.camera->SetHFOV(angle);
+
+    if (cameraSdf.HasLensIntrinsics() || cameraSdf.HasLensProjection())
+    {
+      ignwarn << "Custom lens intrinsics and projection are not supported "
+              << "by the multi camera sensor, camera [" << cameraSdf.Name()
+              << "] uses the projection of its field of view." << std::endl;
+    }
+    if (cameraSdf.Element() && cameraSdf.Element()->HasElement("distortion"))
+    {
+      ignwarn << "Distortion is not supported by the multi camera sensor, "
+              << "camera [" << cameraSdf.Name() << "] renders undistorted "
+              << "images." << std::endl;
+    }
+
+    sdf::PixelFormatType pixelFormat = cameraSdf.PixelFormat();
+    switch (pixelFormat)
+    {
+      case sdf::PixelFormatType::RGB_INT8:
+        entry.camera->SetImageFormat(rendering::PF_R8G8B8);
+        break;
+      case sdf::PixelFormatType::L_INT8:
+        entry.camera->SetImageFormat(rendering::PF_L8);
+        break;
+      case sdf::PixelFormatType::L_INT16:
+        entry.camera->SetImageFormat(rendering::PF_L16);
+        break;
+      default:
+        ignerr << "Unsupported pixel format ["
+          << static_cast<int>(pixelFormat) << "]\n";
+        break;
+    }
+
+    entry.image = entry.camera->CreateImage();
+
+    this->Scene()->RootVisual()->AddChild(entry.camera);
+
+    // Note: while Gazebo interprets the camera frame to be looking towards
+    // +X, other tools, such as ROS, may interpret this frame as looking
+    // towards +Z. To make this configurable the user has the option to set
+    // an optical frame per camera.
+    std::string frameId = cameraSdf.OpticalFrameId().empty() ?
+        this->FrameId() : cameraSdf.OpticalFrameId();
+
+    // The image x axis points towards -Y of the sensor frame
+    double baseline = cameras[0].pose.Pos().Y() - entry.pose.Pos().Y();
+    MultiCameraSensorPrivate::PopulateInfo(entry, baseline, frameId);
+
+    // The parts of the image messages that stay the same between updates
+    msgs::Image &msg = this->dataPtr->imageMsgs[i];
+    msg.Clear();
+    msg.set_width(width);
+    msg.set_height(height);
+    msg.set_step(width * rendering::PixelUtil::BytesPerPixel(
+        entry.camera->ImageFormat()));
+    msg.set_pixel_format_type(msgsPixelFormat(entry.camera->ImageFormat()));
+    auto frame = msg.mutable_header()->add_data();
+    frame->set_key("frame_id");
+    frame->add_value(frameId);
+  }
+
+  // The packed image is as wide as all images together
+  const msgs::Image &first = this->dataPtr->imageMsgs[0];
+  unsigned int packedWidth = 0u;
+  unsigned int packedStep = 0u;
+  if (this->dataPtr->sideBySide)
+  {
+    for (const auto &msg : this->dataPtr->imageMsgs)
+    {
+      if (msg.height() != first.height() ||
+          msg.pixel_format_type() != first.pixel_format_type())
+      {
+        ignerr << "Side by side images of [" << this->Name() << "] require "
+               << "all cameras to have the same height and pixel format, "
+               << "side by side images are disabled." << std::endl;
+        this->dataPtr->sideBySide = false;
+        break;
+      }
+      packedWidth += msg.width();
+      packedStep += msg.step();
+    }
+  }
+
+  if (this->dataPtr->sideBySide)
+  {
+    msgs::Image &packed = this->dataPtr->sideBySideMsg;
+    packed.Clear();
+    packed.set_width(packedWidth);
+    packed.set_height(first.height());
+    packed.set_step(packedStep);
+    packed.set_pixel_format_type(first.pixel_format_type());
+    auto frame = packed.mutable_header()->add_data();
+    frame->set_key("frame_id");
+    frame->add_value(this->FrameId());
+    auto names = packed.mutable_header()->add_data();
+    names->set_key("cameras");
+    for (const auto &entry : cameras)
+      names->add_value(entry.sdf.Name());
+  }
+
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MultiCameraSensorPrivate::PopulateInfo(
+    MultiCameraSensorPrivate::CameraEntry &_entry,
+    double _baseline, const std::string &_frameId)
+{
+  const sdf::Camera &cameraSdf = _entry.sdf;
+  msgs::CameraInfo &info = _entry.infoMsg;
+  info.Clear();
+
+  auto intrinsicMatrix = rendering::projectionToCameraIntrinsic(
+      _entry.camera->ProjectionMatrix(),
+      _entry.camera->ImageWidth(),
+      _entry.camera->ImageHeight());
+  double fx = intrinsicMatrix(0, 0);
+  double fy = intrinsicMatrix(1, 1);
+  double cx = intrinsicMatrix(0, 2);
+  double cy = intrinsicMatrix(1, 2);
+
+  // Images are rendered undistorted, so the SDF distortion coefficients
+  // would not describe them
+  msgs::CameraInfo::Distortion *distortion = info.mutable_distortion();
+  distortion->set_model(msgs::CameraInfo::Distortion::PLUMB_BOB);
+  for (int i = 0; i < 5; ++i)
+    distortion->add_k(0.0);
+
+  msgs::CameraInfo::Intrinsics *intrinsics = info.mutable_intrinsics();
+  for (double k : {fx, 0.0, cx, 0.0, fy, cy, 0.0, 0.0, 1.0})
+    intrinsics->add_k(k);
+
+  // The baseline to the first camera goes into the projection, as for
+  // stereo cameras set up with CameraSensor::SetBaseline
+  msgs::CameraInfo::Projection *proj = info.mutable_projection();
+  for (double p : {fx, 0.0, cx, -fx * _baseline, 0.0, fy, cy, 0.0,
+      0.0, 0.0, 1.0, 0.0})
+  {
+    proj->add_p(p);
+  }
+
+  // Set the rectification matrix to identity
+  for (double r : {1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0})
+    info.add_rectification_matrix(r);
+
+  auto infoFrame = info.mutable_header()->add_data();
+  infoFrame->set_key("frame_id");
+  infoFrame->add_value(_frameId);
+
+  info.set_width(cameraSdf.ImageWidth());
+  info.set_height(cameraSdf.ImageHeight());
+}
+
+/////////////////////////////////////////////////
+void MultiCameraSensor::SetScene(rendering::ScenePtr _scene)
+{
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+  // APIs make it possible for the scene pointer to change
+  if (this->Scene() != _scene)
+  {
+    // TODO(anyone) Remove cameras from current scene
+    for (auto &entry : this->dataPtr->cameras)
+      entry.camera = nullptr;
+    RenderingSensor::SetScene(_scene);
+
+    if (this->dataPtr->initialized)
+      this->CreateCameras();
+  }
+}
+
+//////////////////////////////////////////////////
+void MultiCameraSensorPrivate::PackSideBySide()
+{
+  IGN_PROFILE("MultiCameraSensor::Update Pack side by side");
+  std::string *packed = this->sideBySideMsg.mutable_data();
+  const std::size_t packedStep = this->sideBySideMsg.step();
+  packed->resize(packedStep * this->sideBySideMsg.height());
+  char *dst = &(*packed)[0];
+
+  // Copy row by row, each camera filling its slice of the packed row
+  std::size_t offset = 0u;
+  for (const auto &msg : this->imageMsgs)
+  {
+    const char *src = msg.data().data();
+    const std::size_t step = msg.step();
+    for (std::size_t row = 0u; row < msg.height(); ++row)
+      std::memcpy(dst + row * packedStep + offset, src + row * step, step);
+    offset += step;
+  }
+}
+
+//////////////////////////////////////////////////
+bool MultiCameraSensor::Update(
+    const std::chrono::steady_clock::duration &_now)
+{
+  IGN_PROFILE("MultiCameraSensor::Update");
+  if (!this->dataPtr->initialized)
+  {
+    ignerr << "Not initialized, update ignored.\n";
+    return false;
+  }
+
+  auto &cameras = this->dataPtr->cameras;
+  if (cameras.empty() || !cameras[0].camera)
+  {
+    ignerr << "Cameras don't exist.\n";
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+
+  // move the cameras to the current pose
+  for (auto &entry : cameras)
+    entry.camera->SetLocalPose(this->Pose() * entry.pose);
+
+  // publish the camera info messages
+  for (auto &entry : cameras)
+  {
+    if (entry.infoPub.HasConnections())
+    {
+      *entry.infoMsg.mutable_header()->mutable_stamp() = msgs::Convert(_now);
+      entry.infoPub.Publish(entry.infoMsg);
+    }
+  }
+
+  // Side by side images and callbacks need every camera, separate topics
+  // only the cameras with subscribers
+  bool allCameras = this->dataPtr->imagesEvent.ConnectionCount() > 0u ||
+      (this->dataPtr->sideBySide &&
+       this->dataPtr->sideBySidePub.HasConnections());
+  bool anyCamera = allCameras;
+  for (auto &entry : cameras)
+  {
+    entry.copied = allCameras || entry.imagePub.HasConnections();
+    anyCamera = anyCamera || entry.copied;
+  }
+
+  // render only if necessary
+  if (!anyCamera)
+    return true;
+
+  // generate sensor data. The scene is updated once and all cameras are
+  // rendered back to back, so the images show the same instant.
+  this->Render();
+
+  for (std::size_t i = 0u; i < cameras.size(); ++i)
+  {
+    MultiCameraSensorPrivate::CameraEntry &entry = cameras[i];
+    if (!entry.copied)
+      continue;
+
+    {
+      IGN_PROFILE("MultiCameraSensor::Update Copy image");
+      entry.camera->Copy(entry.image);
+    }
+
+    // Assigning keeps the capacity of the message buffer from the last
+    // update
+    msgs::Image &msg = this->dataPtr->imageMsgs[i];
+    msg.mutable_data()->assign(entry.image.Data<char>(),
+        entry.camera->ImageMemorySize());
+    *msg.mutable_header()->mutable_stamp() = msgs::Convert(_now);
+
+    if (entry.imagePub.HasConnections())
+    {
+      this->AddSequence(msg.mutable_header(), entry.sdf.Name());
+      IGN_PROFILE("MultiCameraSensor::Update Publish");
+      entry.imagePub.Publish(msg);
+    }
+  }
+
+  if (this->dataPtr->sideBySide &&
+      this->dataPtr->sideBySidePub.HasConnections())
+  {
+    this->dataPtr->PackSideBySide();
+    *this->dataPtr->sideBySideMsg.mutable_header()->mutable_stamp() =
+        msgs::Convert(_now);
+    this->AddSequence(this->dataPtr->sideBySideMsg.mutable_header(),
+        "sideBySide");
+    IGN_PROFILE("MultiCameraSensor::Update Publish side by side");
+    this->dataPtr->sideBySidePub.Publish(this->dataPtr->sideBySideMsg);
+  }
+
+  // Trigger callbacks.
+  if (this->dataPtr->imagesEvent.ConnectionCount() > 0u)
+  {
+    try
+    {
+      this->dataPtr->imagesEvent(this->dataPtr->imageMsgs);
+    }
+    catch(...)
+    {
+      ignerr << "Exception thrown in an image callback.\n";
+    }
+  }
+
+  return true;
+}
+
+/////////////////////////////////////////////////
+common::ConnectionPtr MultiCameraSensor::ConnectImagesCallback(
+    std::function<void(const std::vector<msgs::Image> &)> _callback)
+{
+  return this->dataPtr->imagesEvent.Connect(_callback);
+}
+
+//////////////////////////////////////////////////
+std::size_t MultiCameraSensor::CameraCount() const
+{
+  return this->dataPtr->cameras.size();
+}
+
+//////////////////////////////////////////////////
+std::string MultiCameraSensor::CameraName(std::size_t _index) const
+{
+  if (_index >= this->dataPtr->cameras.size())
+    return std::string();
+  return this->dataPtr->cameras[_index].sdf.Name();
+}
+
+//////////////////////////////////////////////////
+rendering::CameraPtr MultiCameraSensor::RenderingCamera(
+    std::size_t _index) const
+{
+  if (_index >= this->dataPtr->cameras.size())
+    return nullptr;
+  return this->dataPtr->cameras[_index].camera;
+}
+
+//////////////////////////////////////////////////
+unsigned int MultiCameraSensor::ImageWidth(std::size_t _index) const
+{
+  if (_index >= this->dataPtr->cameras.size())
+    return 0u;
+  return this->dataPtr->cameras[_index].sdf.ImageWidth();
+}
+
+//////////////////////////////////////////////////
+unsigned int MultiCameraSensor::ImageHeight(std::size_t _index) const
+{
+  if (_index >= this->dataPtr->cameras.size())
+    return 0u;
+  return this->dataPtr->cameras[_index].sdf.ImageHeight();
+}
+
+//////////////////////////////////////////////////
+bool MultiCameraSensor::SideBySide() const
+{
+  return this->dataPtr->sideBySide;
+}
+
+//////////////////////////////////////////////////
+bool MultiCameraSensor::HasConnections() const
+{
+  if (this->dataPtr->imagesEvent.ConnectionCount() > 0u ||
+      (this->dataPtr->sideBySidePub &&
+       this->dataPtr->sideBySidePub.HasConnections()))
+  {
+    return true;
+  }
+  for (const auto &entry : this->dataPtr->cameras)
+  {
+    if ((entry.imagePub && entry.imagePub.HasConnections()) ||
+        (entry.infoPub && entry.infoPub.HasConnections()))
+    {
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+
+#include "ParallelRows.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+ParallelRows &ParallelRows::Instance()
+{
+  // Intentionally leaked, joining threads during static destruction is not
+  // safe on all platforms.
+  static ParallelRows *rows = new ParallelRows();
+  return *rows;
+}
+
+//////////////////////////////////////////////////
+ParallelRows::ParallelRows(unsigned int _threadCount)
+{
+  unsigned int threadCount = _threadCount;
+  if (threadCount == 0u)
+  {
+    // Sensors run alongside physics and rendering, a few threads are
+    // enough to keep image post processing off the critical path
+    threadCount =
+        std::min(8u, std::max(1u, std::thread::hardware_concurrency()));
+  }
+
+  for (unsigned int i = 1u; i < threadCount; ++i)
+    this->workers.emplace_back(&ParallelRows::Loop, this);
+}
+
+//////////////////////////////////////////////////
+ParallelRows::~ParallelRows()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->stop = true;
+  }
+  this->jobAvailable.notify_all();
+  for (auto &worker : this->workers)
+    worker.join();
+}
+
+//////////////////////////////////////////////////
+unsigned int ParallelRows::ThreadCount() const
+{
+  return static_cast<unsigned int>(this->workers.size()) + 1u;
+}
+
+//////////////////////////////////////////////////
+void ParallelRows::Run(unsigned int _rows, const Work &_work,
+    unsigned int _minRows)
+{
+  if (_rows == 0u)
+    return;
+
+  const unsigned int minRows = std::max(1u, _minRows);
+  bool idle = false;
+  if (this->workers.empty() || _rows < 2u * minRows ||
+      !this->running.compare_exchange_strong(idle, true))
+  {
+    _work(0u, _rows);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    // A few chunks per thread balance rows that cost more than others
+    const unsigned int chunks = this->ThreadCount() * 4u;
+    this->chunk = std::max(minRows, (_rows + chunks - 1u) / chunks);
+    this->rows = _rows;
+    this->work = &_work;
+    this->next = 0u;
+    ++this->generation;
+  }
+  this->jobAvailable.notify_all();
+
+  this->Drain();
+
+  // Every chunk is taken, wait for the workers still processing theirs.
+  // Workers that wake up after this see no job.
+  std::unique_lock<std::mutex> lock(this->mutex);
+  this->jobDone.wait(lock, [this] { return this->busy == 0u; });
+  this->work = nullptr;
+  this->running = false;
+}
+
+//////////////////////////////////////////////////
+void ParallelRows::Drain()
+{
+  while (true)
+  {
+    const unsigned int begin = this->next.fetch_add(this->chunk);
+    if (begin >= this->rows)
+      return;
+    (*this->work)(begin, std::min(this->rows, begin + this->chunk));
+  }
+}
+
+//////////////////////////////////////////////////
+void ParallelRows::Loop()
+{
+  std::uint64_t seen = 0u;
+  std::unique_lock<std::mutex> lock(this->mutex);
+  while (true)
+  {
+    this->jobAvailable.wait(lock, [this, &seen]
+        {
+          return this->stop ||
+              (this->work != nullptr && this->generation != seen);
+        });
+    if (this->stop)
+      return;
+
+    seen = this->generation;
+    ++this->busy;
+    lock.unlock();
+    this->Drain();
+    lock.lock();
+    if (--this->busy == 0u)
+      this->jobDone.notify_all();
+  }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_PARALLELROWS_HH_
+#define GZ_SENSORS_PARALLELROWS_HH_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define ParallelRows_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define ParallelRows_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ParallelRows_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Splits per pixel work on the rows of an image between worker
+    /// threads. The calling thread takes chunks of rows too, and Run()
+    /// returns once every row is done.
+    ///
+    /// One image is processed at a time. A Run() call made while another
+    /// one is in progress, for example by a sensor updating on another
+    /// thread, processes its rows on the calling thread instead of waiting.
+    class ParallelRows_EXPORTS_API ParallelRows
+    {
+      /// \brief Work on a range of rows.
+      /// \param[in] _begin First row.
+      /// \param[in] _end One past the last row.
+      public: using Work =
+          std::function<void(unsigned int _begin, unsigned int _end)>;
+
+      /// \brief Get the workers shared by all sensors.
+      /// \return The workers.
+      public: static ParallelRows &Instance();
+
+      /// \brief Constructor.
+      /// \param[in] _threadCount Number of threads including the calling
+      /// thread. Zero picks a number based on the hardware concurrency.
+      public: explicit ParallelRows(unsigned int _threadCount = 0u);
+
+      /// \brief Destructor. Stops the workers.
+      public: ~ParallelRows();
+
+      /// \brief Get the number of threads that take part in Run().
+      /// \return Number of threads including the calling thread.
+      public: unsigned int ThreadCount() const;
+
+      /// \brief Process rows in parallel.
+      /// \param[in] _rows Number of rows.
+      /// \param[in] _work Work called on disjoint, non empty ranges covering
+      /// all rows.
+      /// \param[in] _minRows Smallest range handed to a thread. Images with
+      /// fewer than twice as many rows are processed on the calling thread.
+      public: void Run(unsigned int _rows, const Work &_work,
+          unsigned int _minRows = 16u);
+
+      /// \brief Worker thread loop.
+      private: void Loop();
+
+      /// \brief Take chunks of the current job until none is left.
+      private: void Drain();
+
+      /// \brief Copying would share the worker threads.
+      public: ParallelRows(const ParallelRows &) = delete;
+
+      /// \brief Copying would share the worker threads.
+      public: ParallelRows &operator=(const ParallelRows &) = delete;
+
+      /// \brief Worker threads.
+      private: std::vector<std::thread> workers;
+
+      /// \brief True while a Run() call hands rows to the workers.
+      private: std::atomic<bool> running{false};
+
+      /// \brief Protects the job and the worker counters.
+      private: std::mutex mutex;
+
+      /// \brief Signals a new job or shutdown to the workers.
+      private: std::condition_variable jobAvailable;
+
+      /// \brief Signals that no worker is busy anymore.
+      private: std::condition_variable jobDone;
+
+      /// \brief Work of the current job, null between jobs.
+      private: const Work *work = nullptr;
+
+      /// \brief Number of rows of the current job.
+      private: unsigned int rows = 0u;
+
+      /// \brief Rows per chunk of the current job.
+      private: unsigned int chunk = 1u;
+
+      /// \brief First row of the next chunk to take.
+      private: std::atomic<unsigned int> next{0u};
+
+      /// \brief Incremented for every job, so that each worker joins a job
+      /// at most once.
+      private: std::uint64_t generation = 0u;
+
+      /// \brief Number of workers taking chunks of the current job.
+      private: unsigned int busy = 0u;
+
+      /// \brief True when the workers should exit.
+      private: bool stop = false;
+    };
+    }
+  }
+}
+
+#endif
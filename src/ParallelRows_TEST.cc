@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "ParallelRows.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(ParallelRows_TEST, EveryRowOnce)
+{
+  ParallelRows rows(4u);
+  EXPECT_EQ(4u, rows.ThreadCount());
+
+  for (unsigned int count : {0u, 1u, 31u, 32u, 1000u})
+  {
+    std::vector<std::atomic<int>> visits(count);
+    for (auto &v : visits)
+      v = 0;
+    rows.Run(count, [&](unsigned int _begin, unsigned int _end)
+        {
+          EXPECT_LT(_begin, _end);
+          for (unsigned int row = _begin; row < _end; ++row)
+            visits[row]++;
+        });
+    for (unsigned int row = 0; row < count; ++row)
+      EXPECT_EQ(1, visits[row]) << count << " " << row;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(ParallelRows_TEST, SingleThread)
+{
+  ParallelRows rows(1u);
+  EXPECT_EQ(1u, rows.ThreadCount());
+
+  // Everything runs in one call on the calling thread
+  unsigned int calls = 0u;
+  rows.Run(1000u, [&](unsigned int _begin, unsigned int _end)
+      {
+        EXPECT_EQ(0u, _begin);
+        EXPECT_EQ(1000u, _end);
+        ++calls;
+      });
+  EXPECT_EQ(1u, calls);
+}
+
+//////////////////////////////////////////////////
+TEST(ParallelRows_TEST, Nested)
+{
+  // A Run() call made while another one is in progress runs inline
+  ParallelRows rows(4u);
+  std::atomic<unsigned int> total{0u};
+  rows.Run(64u, [&](unsigned int _begin, unsigned int _end)
+      {
+        for (unsigned int row = _begin; row < _end; ++row)
+        {
+          rows.Run(64u, [&](unsigned int _b, unsigned int _e)
+              {
+                total += _e - _b;
+              });
+        }
+      });
+  EXPECT_EQ(64u * 64u, total);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
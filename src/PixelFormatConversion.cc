@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "PixelFormatConversion.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Format names, in PixelFormatConversion::Format order.
+  const char *const kFormatNames[] =
+  {
+    "NONE", "BGR8", "RGBA8", "YUYV", "NV12", "BAYER_RGGB8", "BAYER_BGGR8"
+  };
+
+  // The loops below work on one row at a time with fixed size pixel
+  // groups and no branches in the inner loop, so that the compiler can
+  // vectorize them.
+
+  /// \brief BT.601 limited range luma.
+  inline unsigned char lumaY(int _r, int _g, int _b)
+  {
+    return static_cast<unsigned char>(
+        ((66 * _r + 129 * _g + 25 * _b + 128) >> 8) + 16);
+  }
+
+  /// \brief BT.601 limited range blue difference chroma.
+  inline unsigned char chromaU(int _r, int _g, int _b)
+  {
+    return static_cast<unsigned char>(
+        ((-38 * _r - 74 * _g + 112 * _b + 128) >> 8) + 128);
+  }
+
+  /// \brief BT.601 limited range red difference chroma.
+  inline unsigned char chromaV(int _r, int _g, int _b)
+  {
+    return static_cast<unsigned char>(
+        ((112 * _r - 94 * _g - 18 * _b + 128) >> 8) + 128);
+  }
+
+  /// \brief RGB8 to BGR8.
+  void convertBGR8(const unsigned char *_rgb, std::size_t _pixels,
+      unsigned char *_dst)
+  {
+    for (std::size_t i = 0; i < _pixels; ++i)
+    {
+      _dst[i * 3] = _rgb[i * 3 + 2];
+      _dst[i * 3 + 1] = _rgb[i * 3 + 1];
+      _dst[i * 3 + 2] = _rgb[i * 3];
+    }
+  }
+
+  /// \brief RGB8 to RGBA8.
+  void convertRGBA8(const unsigned char *_rgb, std::size_t _pixels,
+      unsigned char *_dst)
+  {
+    for (std::size_t i = 0; i < _pixels; ++i)
+    {
+      _dst[i * 4] = _rgb[i * 3];
+      _dst[i * 4 + 1] = _rgb[i * 3 + 1];
+      _dst[i * 4 + 2] = _rgb[i * 3 + 2];
+      _dst[i * 4 + 3] = 255u;
+    }
+  }
+
+  /// \brief RGB8 to YUYV.
+  void convertYUYV(const unsigned char *_rgb, unsigned int _width,
+      unsigned int _height, unsigned char *_dst)
+  {
+    const unsigned int pairs = _width / 2u;
+    const unsigned int step = ((_width + 1u) / 2u) * 4u;
+    for (unsigned int y = 0; y < _height; ++y)
+    {
+      const unsigned char *src = _rgb + y * _width * 3u;
+      unsigned char *dst = _dst + y * step;
+      for (unsigned int i = 0; i < pairs; ++i)
+      {
+        int r0 = src[i * 6];
+        int g0 = src[i * 6 + 1];
+        int b0 = src[i * 6 + 2];
+        int r1 = src[i * 6 + 3];
+        int g1 = src[i * 6 + 4];
+        int b1 = src[i * 6 + 5];
+        int r = (r0 + r1 + 1) >> 1;
+        int g = (g0 + g1 + 1) >> 1;
+        int b = (b0 + b1 + 1) >> 1;
+        dst[i * 4] = lumaY(r0, g0, b0);
+        dst[i * 4 + 1] = chromaU(r, g, b);
+        dst[i * 4 + 2] = lumaY(r1, g1, b1);
+        dst[i * 4 + 3] = chromaV(r, g, b);
+      }
+
+      // Odd width, the last pixel is paired with itself
+      if (_width & 1u)
+      {
+        const unsigned char *p = src + (_width - 1u) * 3u;
+        unsigned char *d = dst + pairs * 4u;
+        d[0] = lumaY(p[0], p[1], p[2]);
+        d[1] = chromaU(p[0], p[1], p[2]);
+        d[2] = d[0];
+        d[3] = chromaV(p[0], p[1], p[2]);
+      }
+    }
+  }
+
+  /// \brief RGB8 to NV12.
+  void convertNV12(const unsigned char *_rgb, unsigned int _width,
+      unsigned int _height, unsigned char *_dst)
+  {
+    const std::size_t pixels = static_cast<std::size_t>(_width) * _height;
+    for (std::size_t i = 0; i < pixels; ++i)
+      _dst[i] = lumaY(_rgb[i * 3], _rgb[i * 3 + 1], _rgb[i * 3 + 2]);
+
+    const unsigned int chromaWidth = (_width + 1u) / 2u;
+    const unsigned int chromaHeight = (_height + 1u) / 2u;
+    unsigned char *uv = _dst + pixels;
+    for (unsigned int cy = 0; cy < chromaHeight; ++cy)
+    {
+      // Odd height, the last row is paired with itself
+      const unsigned int y0 = cy * 2u;
+      const unsigned int y1 = y0 + 1u < _height ? y0 + 1u : y0;
+      const unsigned char *row0 = _rgb + y0 * _width * 3u;
+      const unsigned char *row1 = _rgb + y1 * _width * 3u;
+      unsigned char *dst = uv + cy * chromaWidth * 2u;
+      for (unsigned int cx = 0; cx < chromaWidth; ++cx)
+      {
+        const unsigned int x0 = cx * 2u * 3u;
+        const unsigned int x1 = cx * 2u + 1u < _width ? x0 + 3u : x0;
+        int r = (row0[x0] + row0[x1] + row1[x0] + row1[x1] + 2) >> 2;
+        int g = (row0[x0 + 1] + row0[x1 + 1] + row1[x0 + 1] + row1[x1 + 1] +
+            2) >> 2;
+        int b = (row0[x0 + 2] + row0[x1 + 2] + row1[x0 + 2] + row1[x1 + 2] +
+            2) >> 2;
+        dst[cx * 2] = chromaU(r, g, b);
+        dst[cx * 2 + 1] = chromaV(r, g, b);
+      }
+    }
+  }
+
+  /// \brief RGB8 to a Bayer mosaic. _evenRow and _oddRow are the channel
+  /// indices sampled at even and odd columns of even rows, and likewise for
+  /// odd rows.
+  void convertBayer(const unsigned char *_rgb, unsigned int _width,
+      unsigned int _height, const unsigned int _evenRow[2],
+      const unsigned int _oddRow[2], unsigned char *_dst)
+  {
+    for (unsigned int y = 0; y < _height; ++y)
+    {
+      const unsigned int *channels = (y & 1u) ? _oddRow : _evenRow;
+      const unsigned int c0 = channels[0];
+      const unsigned int c1 = channels[1];
+      const unsigned char *src = _rgb + y * _width * 3u;
+      unsigned char *dst = _dst + y * _width;
+      const unsigned int pairs = _width / 2u;
+      for (unsigned int i = 0; i < pairs; ++i)
+      {
+        dst[i * 2] = src[i * 6 + c0];
+        dst[i * 2 + 1] = src[i * 6 + 3 + c1];
+      }
+      if (_width & 1u)
+        dst[_width - 1u] = src[(_width - 1u) * 3u + c0];
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool PixelFormatConversion::SetFormat(const std::string &_name)
+{
+  for (unsigned int i = 0; i < sizeof(kFormatNames) / sizeof(kFormatNames[0]);
+       ++i)
+  {
+    if (_name == kFormatNames[i])
+    {
+      this->format = static_cast<Format>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void PixelFormatConversion::SetFormat(Format _format)
+{
+  this->format = _format;
+}
+
+//////////////////////////////////////////////////
+PixelFormatConversion::Format PixelFormatConversion::OutputFormat() const
+{
+  return this->format;
+}
+
+//////////////////////////////////////////////////
+std::string PixelFormatConversion::Name() const
+{
+  return kFormatNames[static_cast<unsigned int>(this->format)];
+}
+
+//////////////////////////////////////////////////
+msgs::PixelFormatType PixelFormatConversion::MsgsFormat() const
+{
+  switch (this->format)
+  {
+    case Format::NONE:
+      return msgs::PixelFormatType::RGB_INT8;
+    case Format::BGR8:
+      return msgs::PixelFormatType::BGR_INT8;
+    case Format::RGBA8:
+      return msgs::PixelFormatType::RGBA_INT8;
+    case Format::BAYER_RGGB8:
+      return msgs::PixelFormatType::BAYER_RGGB8;
+    case Format::BAYER_BGGR8:
+      return msgs::PixelFormatType::BAYER_BGGR8;
+    default:
+      return msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT;
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t PixelFormatConversion::OutputSize(unsigned int _width,
+    unsigned int _height) const
+{
+  const std::size_t pixels = static_cast<std::size_t>(_width) * _height;
+  switch (this->format)
+  {
+    case Format::NV12:
+      return pixels + static_cast<std::size_t>((_width + 1u) / 2u) *
+          ((_height + 1u) / 2u) * 2u;
+    default:
+      return static_cast<std::size_t>(this->Step(_width)) * _height;
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int PixelFormatConversion::Step(unsigned int _width) const
+{
+  switch (this->format)
+  {
+    case Format::RGBA8:
+      return _width * 4u;
+    case Format::YUYV:
+      return ((_width + 1u) / 2u) * 4u;
+    case Format::NV12:
+    case Format::BAYER_RGGB8:
+    case Format::BAYER_BGGR8:
+      return _width;
+    default:
+      return _width * 3u;
+  }
+}
+
+//////////////////////////////////////////////////
+bool PixelFormatConversion::Convert(const unsigned char *_rgb,
+    unsigned int _width, unsigned int _height, unsigned char *_dst) const
+{
+  const std::size_t pixels = static_cast<std::size_t>(_width) * _height;
+  switch (this->format)
+  {
+    case Format::BGR8:
+      convertBGR8(_rgb, pixels, _dst);
+      return true;
+    case Format::RGBA8:
+      convertRGBA8(_rgb, pixels, _dst);
+      return true;
+    case Format::YUYV:
+      convertYUYV(_rgb, _width, _height, _dst);
+      return true;
+    case Format::NV12:
+      convertNV12(_rgb, _width, _height, _dst);
+      return true;
+    case Format::BAYER_RGGB8:
+    {
+      const unsigned int evenRow[2] = {0u, 1u};
+      const unsigned int oddRow[2] = {1u, 2u};
+      convertBayer(_rgb, _width, _height, evenRow, oddRow, _dst);
+      return true;
+    }
+    case Format::BAYER_BGGR8:
+    {
+      const unsigned int evenRow[2] = {2u, 1u};
+      const unsigned int oddRow[2] = {1u, 0u};
+      convertBayer(_rgb, _width, _height, evenRow, oddRow, _dst);
+      return true;
+    }
+    default:
+      return false;
+  }
+}
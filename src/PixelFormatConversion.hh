@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_PIXELFORMATCONVERSION_HH_
+#define GZ_SENSORS_PIXELFORMATCONVERSION_HH_
+
+#include <cstddef>
+#include <string>
+
+#if defined(_MSC_VER)
+  #pragma warning(push)
+  #pragma warning(disable: 4005)
+  #pragma warning(disable: 4251)
+#endif
+#include <gz/msgs/image.pb.h>
+#if defined(_MSC_VER)
+  #pragma warning(pop)
+#endif
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define PixelFormatConversion_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define PixelFormatConversion_EXPORTS_API __declspec(dllexport)
+#  else
+#    define PixelFormatConversion_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Converts rendered RGB8 images to the pixel format a camera
+    /// publishes, so that consumers expecting a hardware format do not
+    /// each have to convert every frame. The CameraSensor class uses this.
+    ///
+    /// YUV formats use BT.601 limited range coefficients. YUYV is packed
+    /// 4:2:2 with the chroma of each horizontal pixel pair averaged. NV12 is
+    /// a full resolution Y plane followed by an interleaved UV plane with the
+    /// chroma of each 2x2 block averaged. Odd image sizes repeat the last
+    /// column or row when averaging.
+    class PixelFormatConversion_EXPORTS_API PixelFormatConversion
+    {
+      /// \brief Output pixel formats.
+      public: enum class Format
+      {
+        /// \brief No conversion, the rendered image is published.
+        NONE,
+
+        /// \brief 8 bit blue, green, red.
+        BGR8,
+
+        /// \brief 8 bit red, green, blue, with opaque alpha.
+        RGBA8,
+
+        /// \brief Packed YUV 4:2:2, Y0 U Y1 V.
+        YUYV,
+
+        /// \brief Planar YUV 4:2:0, Y plane then interleaved UV plane.
+        NV12,
+
+        /// \brief Bayer mosaic with an RGGB pattern.
+        BAYER_RGGB8,
+
+        /// \brief Bayer mosaic with a BGGR pattern.
+        BAYER_BGGR8
+      };
+
+      /// \brief Set the output format from its name: "BGR8", "RGBA8",
+      /// "YUYV", "NV12", "BAYER_RGGB8", "BAYER_BGGR8" or "NONE".
+      /// \param[in] _name Format name.
+      /// \return False if the name is unknown, in which case the format is
+      /// left unchanged.
+      public: bool SetFormat(const std::string &_name);
+
+      /// \brief Set the output format.
+      /// \param[in] _format Output format.
+      public: void SetFormat(Format _format);
+
+      /// \brief Get the output format.
+      /// \return Output format.
+      public: Format OutputFormat() const;
+
+      /// \brief Get the output format name, as accepted by SetFormat().
+      /// \return Format name.
+      public: std::string Name() const;
+
+      /// \brief Get the message pixel format of the output. Formats that
+      /// msgs::PixelFormatType can not express return UNKNOWN_PIXEL_FORMAT,
+      /// and consumers should look at Name() instead.
+      /// \return Message pixel format.
+      public: msgs::PixelFormatType MsgsFormat() const;
+
+      /// \brief Get the size of a converted image.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \return Size in bytes.
+      public: std::size_t OutputSize(unsigned int _width,
+          unsigned int _height) const;
+
+      /// \brief Get the row step of a converted image. For NV12 this is the
+      /// step of both planes.
+      /// \param[in] _width Image width in pixels.
+      /// \return Step in bytes.
+      public: unsigned int Step(unsigned int _width) const;
+
+      /// \brief Convert an RGB8 image.
+      /// \param[in] _rgb RGB8 image data with a step of 3 * _width.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \param[out] _dst Destination with room for OutputSize() bytes.
+      /// \return False if the format is NONE.
+      public: bool Convert(const unsigned char *_rgb, unsigned int _width,
+          unsigned int _height, unsigned char *_dst) const;
+
+      /// \brief Output format.
+      private: Format format = Format::NONE;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,158 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "PixelFormatConversion.hh"
+
+using namespace gz;
+using namespace sensors;
+
+/// \brief 3x2 RGB test image, each pixel a distinct color.
+static const std::vector<unsigned char> kImage =
+{
+  255, 0, 0,    0, 255, 0,    0, 0, 255,
+  255, 255, 255,  0, 0, 0,  10, 20, 30
+};
+
+//////////////////////////////////////////////////
+TEST(PixelFormatConversion_TEST, Names)
+{
+  PixelFormatConversion conversion;
+  EXPECT_EQ(PixelFormatConversion::Format::NONE, conversion.OutputFormat());
+  EXPECT_FALSE(conversion.Convert(kImage.data(), 3u, 2u, nullptr));
+
+  for (const std::string name :
+      {"BGR8", "RGBA8", "YUYV", "NV12", "BAYER_RGGB8", "BAYER_BGGR8", "NONE"})
+  {
+    EXPECT_TRUE(conversion.SetFormat(name));
+    EXPECT_EQ(name, conversion.Name());
+  }
+
+  conversion.SetFormat(PixelFormatConversion::Format::YUYV);
+  EXPECT_FALSE(conversion.SetFormat("YUV9"));
+  EXPECT_EQ(PixelFormatConversion::Format::YUYV, conversion.OutputFormat());
+  EXPECT_EQ(msgs::PixelFormatType::UNKNOWN_PIXEL_FORMAT,
+      conversion.MsgsFormat());
+}
+
+//////////////////////////////////////////////////
+TEST(PixelFormatConversion_TEST, BGR8RGBA8)
+{
+  PixelFormatConversion conversion;
+  conversion.SetFormat(PixelFormatConversion::Format::BGR8);
+  EXPECT_EQ(msgs::PixelFormatType::BGR_INT8, conversion.MsgsFormat());
+  ASSERT_EQ(18u, conversion.OutputSize(3u, 2u));
+  EXPECT_EQ(9u, conversion.Step(3u));
+  std::vector<unsigned char> bgr(18u);
+  EXPECT_TRUE(conversion.Convert(kImage.data(), 3u, 2u, bgr.data()));
+  for (unsigned int i = 0; i < 6u; ++i)
+  {
+    EXPECT_EQ(kImage[i * 3], bgr[i * 3 + 2]);
+    EXPECT_EQ(kImage[i * 3 + 1], bgr[i * 3 + 1]);
+    EXPECT_EQ(kImage[i * 3 + 2], bgr[i * 3]);
+  }
+
+  conversion.SetFormat(PixelFormatConversion::Format::RGBA8);
+  EXPECT_EQ(msgs::PixelFormatType::RGBA_INT8, conversion.MsgsFormat());
+  ASSERT_EQ(24u, conversion.OutputSize(3u, 2u));
+  std::vector<unsigned char> rgba(24u);
+  EXPECT_TRUE(conversion.Convert(kImage.data(), 3u, 2u, rgba.data()));
+  for (unsigned int i = 0; i < 6u; ++i)
+  {
+    EXPECT_EQ(kImage[i * 3], rgba[i * 4]);
+    EXPECT_EQ(kImage[i * 3 + 2], rgba[i * 4 + 2]);
+    EXPECT_EQ(255u, rgba[i * 4 + 3]);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(PixelFormatConversion_TEST, YUV)
+{
+  PixelFormatConversion conversion;
+
+  // Odd width, the last column pairs with itself
+  conversion.SetFormat(PixelFormatConversion::Format::YUYV);
+  EXPECT_EQ(8u, conversion.Step(3u));
+  ASSERT_EQ(16u, conversion.OutputSize(3u, 2u));
+  std::vector<unsigned char> yuyv(16u);
+  EXPECT_TRUE(conversion.Convert(kImage.data(), 3u, 2u, yuyv.data()));
+
+  // Limited range white and black
+  EXPECT_EQ(235u, yuyv[8]);
+  EXPECT_EQ(16u, yuyv[10]);
+  // Red then green luma, blue is paired with itself
+  EXPECT_EQ(82u, yuyv[0]);
+  EXPECT_EQ(144u, yuyv[2]);
+  EXPECT_EQ(yuyv[4], yuyv[6]);
+  // Grey has neutral chroma
+  EXPECT_NEAR(128, yuyv[9], 1);
+  EXPECT_NEAR(128, yuyv[11], 1);
+
+  // NV12 has a full Y plane then a 2x1 UV plane for a 3x2 image
+  conversion.SetFormat(PixelFormatConversion::Format::NV12);
+  EXPECT_EQ(3u, conversion.Step(3u));
+  ASSERT_EQ(6u + 4u, conversion.OutputSize(3u, 2u));
+  std::vector<unsigned char> nv12(10u);
+  EXPECT_TRUE(conversion.Convert(kImage.data(), 3u, 2u, nv12.data()));
+  EXPECT_EQ(82u, nv12[0]);
+  EXPECT_EQ(144u, nv12[1]);
+  EXPECT_EQ(235u, nv12[3]);
+  EXPECT_EQ(16u, nv12[4]);
+  EXPECT_EQ(yuyv[0], nv12[0]);
+}
+
+//////////////////////////////////////////////////
+TEST(PixelFormatConversion_TEST, Bayer)
+{
+  PixelFormatConversion conversion;
+  std::vector<unsigned char> bayer(6u);
+
+  conversion.SetFormat(PixelFormatConversion::Format::BAYER_RGGB8);
+  EXPECT_EQ(msgs::PixelFormatType::BAYER_RGGB8, conversion.MsgsFormat());
+  ASSERT_EQ(6u, conversion.OutputSize(3u, 2u));
+  EXPECT_TRUE(conversion.Convert(kImage.data(), 3u, 2u, bayer.data()));
+  // R G R
+  // G B G
+  EXPECT_EQ(255u, bayer[0]);
+  EXPECT_EQ(255u, bayer[1]);
+  EXPECT_EQ(0u, bayer[2]);
+  EXPECT_EQ(255u, bayer[3]);
+  EXPECT_EQ(0u, bayer[4]);
+  EXPECT_EQ(20u, bayer[5]);
+
+  conversion.SetFormat(PixelFormatConversion::Format::BAYER_BGGR8);
+  EXPECT_EQ(msgs::PixelFormatType::BAYER_BGGR8, conversion.MsgsFormat());
+  EXPECT_TRUE(conversion.Convert(kImage.data(), 3u, 2u, bayer.data()));
+  // B G B
+  // G R G
+  EXPECT_EQ(0u, bayer[0]);
+  EXPECT_EQ(255u, bayer[1]);
+  EXPECT_EQ(255u, bayer[2]);
+  EXPECT_EQ(255u, bayer[3]);
+  EXPECT_EQ(0u, bayer[4]);
+  EXPECT_EQ(20u, bayer[5]);
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,8 @@
 
 #include "PointCloudUtil.hh"
 
+#include <cmath>
+#include <limits>
 #include <string>
 
 using namespace gz;
@@ -160,11 +162,11 @@ void PointCloudUtil::FillMsg(msgs::PointCloudPacked &_msg,
   // Iterate over scan and populate point cloud
   for (uint32_t j = 0; j < height; ++j)
   {
-    int pcStep = j*width*4;
+    int pcStep = j*width*kPointStride;
     int imgStep = j*width*3;
     for (uint32_t i = 0; i < width; ++i)
     {
-      int pcIndex = pcStep + i*4;
+      int pcIndex = pcStep + i*kPointStride;
       float x = _pointCloudData[pcIndex];
       float y = _pointCloudData[pcIndex + 1];
       float z = _pointCloudData[pcIndex + 2];
@@ -220,6 +222,105 @@ void PointCloudUtil::FillMsg(msgs::PointCloudPacked &_msg,
   }
 }
 
+//////////////////////////////////////////////////
+void PointCloudUtil::FillMsg(msgs::PointCloudPacked &_msg,
+    const float *_pointCloudData, const float *_depthData,
+    float _depthNearClip, float _depthFarClip,
+    unsigned char *_imageData) const
+{
+  const float inf = std::numeric_limits<float>::infinity();
+
+  uint32_t width = _msg.width();
+  uint32_t height = _msg.height();
+
+  std::string *msgBuffer = _msg.mutable_data();
+  msgBuffer->resize(_msg.row_step() * _msg.height());
+  char *msgBufferIndex = msgBuffer->data();
+
+  // Look up the field layout once rather than for every point
+  const uint32_t pointStep = _msg.point_step();
+  const uint32_t xOffset = _msg.field(0).offset();
+  const uint32_t yOffset = _msg.field(1).offset();
+  const uint32_t zOffset = _msg.field(2).offset();
+  const uint32_t rgbOffset = _msg.field(3).offset();
+  const bool bigEndian = _msg.is_bigendian();
+
+  // Iterate over scan and populate point cloud
+  for (uint32_t j = 0; j < height; ++j)
+  {
+    int depthStep = j*width;
+    for (uint32_t i = 0; i < width; ++i)
+    {
+      int depthIndex = depthStep + i;
+      int pcIndex = depthIndex * kPointStride;
+
+      // Clip test written as selects rather than branches so that it
+      // compiles down to compare and blend instructions. A point is
+      // invalidated if its clipped depth is infinite, which also covers
+      // depth values the depth camera already reported as infinite.
+      float depth = _depthData[depthIndex];
+      depth = depth > _depthFarClip ? inf : depth;
+      depth = depth < _depthNearClip ? -inf : depth;
+      const bool clipped = std::isinf(depth);
+
+      float x = clipped ? depth : _pointCloudData[pcIndex];
+      float y = clipped ? depth : _pointCloudData[pcIndex + 1];
+      float z = clipped ? depth : _pointCloudData[pcIndex + 2];
+      float rgba = _pointCloudData[pcIndex + 3];
+
+      *reinterpret_cast<float*>(msgBufferIndex + xOffset) = x;
+      *reinterpret_cast<float*>(msgBufferIndex + yOffset) = y;
+      *reinterpret_cast<float*>(msgBufferIndex + zOffset) = z;
+
+      uint8_t r = 0u;
+      uint8_t g = 0u;
+      uint8_t b = 0u;
+      uint8_t a = 255u;
+      this->DecodeRGBAFromFloat(rgba, r, g, b, a);
+
+      // Put image color data for each point, check endianess first.
+      if (bigEndian)
+      {
+        *(msgBufferIndex + rgbOffset + 0) = r;
+        *(msgBufferIndex + rgbOffset + 1) = g;
+        *(msgBufferIndex + rgbOffset + 2) = b;
+      }
+      else
+      {
+        *(msgBufferIndex + rgbOffset + 0) = b;
+        *(msgBufferIndex + rgbOffset + 1) = g;
+        *(msgBufferIndex + rgbOffset + 2) = r;
+      }
+
+      // Add any padding
+      msgBufferIndex += pointStep;
+
+      // Fill image buffer
+      if (_imageData)
+      {
+        int imgIndex = depthIndex * 3;
+        _imageData[imgIndex + 0] = static_cast<unsigned char>(r);
+        _imageData[imgIndex + 1] = static_cast<unsigned char>(g);
+        _imageData[imgIndex + 2] = static_cast<unsigned char>(b);
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+void PointCloudUtil::ClipDepth(float *_dst, const float *_depthData,
+    unsigned int _count, float _depthNearClip, float _depthFarClip) const
+{
+  const float inf = std::numeric_limits<float>::infinity();
+
+  // Branch free so that the loop can be auto-vectorized
+  for (unsigned int i = 0; i < _count; ++i)
+  {
+    float depth = _depthData[i];
+    depth = depth > _depthFarClip ? inf : depth;
+    _dst[i] = depth < _depthNearClip ? -inf : depth;
+  }
+}
 
 //////////////////////////////////////////////////
 void PointCloudUtil::RGBFromPointCloud(unsigned char *_imageData,
@@ -229,11 +330,11 @@ void PointCloudUtil::RGBFromPointCloud(unsigned char *_imageData,
   // Iterate over scan and populate image data
   for (uint32_t j = 0; j < _height; ++j)
   {
-    int pcStep = j*_width*4;
+    int pcStep = j*_width*kPointStride;
     int imgStep = j*_width*3;
     for (uint32_t i = 0; i < _width; ++i)
     {
-      int pcIndex = pcStep + i*4;
+      int pcIndex = pcStep + i*kPointStride;
       float rgba = _pointCloudData[pcIndex + 3];
       uint8_t r = 0u;
       uint8_t g = 0u;
@@ -256,11 +357,11 @@ void PointCloudUtil::XYZFromPointCloud(float *_xyzData,
   // Iterate over scan and populate image data
   for (uint32_t j = 0; j < _height; ++j)
   {
-    int pcStep = j*_width*4;
+    int pcStep = j*_width*kPointStride;
     int imgStep = j*_width*3;
     for (uint32_t i = 0; i < _width; ++i)
     {
-      int pcIndex = pcStep + i*4;
+      int pcIndex = pcStep + i*kPointStride;
       int imgIndex = imgStep + i * 3;
       _xyzData[imgIndex] = _pointCloudData[pcIndex];
       _xyzData[imgIndex + 1] = _pointCloudData[pcIndex + 1];
@@ -54,6 +54,10 @@ namespace ignition
     /// class use this.
     class PointCloudUtil_EXPORTS_API PointCloudUtil
     {
+      /// \brief Number of floats per point in point cloud data: x, y, z
+      /// and the packed RGBA color.
+      public: static constexpr unsigned int kPointStride = 4u;
+
       /// \brief Fill a msgs::PointCloudPacked.
       /// \param[in,out] _msg Point cloud message to fill. This message
       /// should be initialized. See example usage in either
@@ -90,6 +94,36 @@ namespace ignition
           const float *_pointCloudData, bool _writeToBuffers = false,
           unsigned char *_imageData = 0, float *_xyzData = 0) const;
 
+      /// \brief Fill a msgs::PointCloudPacked while applying depth clipping
+      /// in the same pass. A point whose depth is greater than
+      /// _depthFarClip gets all of its xyz values set to +inf, and a point
+      /// whose depth is less than _depthNearClip gets them set to -inf.
+      /// Points whose depth is already infinite are treated the same way.
+      /// \param[in,out] _msg Point cloud message to fill. This message
+      /// should be initialized. See example usage in RgbdCameraSensor.
+      /// \param[in] _pointCloudData Point cloud XYZ RGB data.
+      /// \param[in] _depthData Depth image data used for the clip test.
+      /// \param[in] _depthNearClip Near clip distance. Use -inf to disable.
+      /// \param[in] _depthFarClip Far clip distance. Use +inf to disable.
+      /// \param[out] _imageData If not null, it is filled with RGB data
+      /// extracted from _pointCloudData.
+      public: void FillMsg(msgs::PointCloudPacked &_msg,
+          const float *_pointCloudData, const float *_depthData,
+          float _depthNearClip, float _depthFarClip,
+          unsigned char *_imageData = nullptr) const;
+
+      /// \brief Copy depth data while applying depth clipping. Values
+      /// greater than _depthFarClip are set to +inf and values less than
+      /// _depthNearClip are set to -inf.
+      /// \param[out] _dst Destination buffer with room for _count floats.
+      /// \param[in] _depthData Depth image data.
+      /// \param[in] _count Number of depth samples.
+      /// \param[in] _depthNearClip Near clip distance. Use -inf to disable.
+      /// \param[in] _depthFarClip Far clip distance. Use +inf to disable.
+      public: void ClipDepth(float *_dst, const float *_depthData,
+          unsigned int _count, float _depthNearClip,
+          float _depthFarClip) const;
+
       /// \brief Extract RGB data from point cloud data
       /// \param[out] _imageData RGB Image buffer to be filled.
       /// \param[in] _pointCloudData Point cloud XYZ data.
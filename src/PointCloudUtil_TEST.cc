@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include <gz/msgs/Utility.hh>
+
+#include "PointCloudUtil.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  const float kInf = std::numeric_limits<float>::infinity();
+  const float kNaN = std::numeric_limits<float>::quiet_NaN();
+
+  /// \brief Depth samples: below near, in range, beyond far, NaN and
+  /// infinite either way.
+  const std::vector<float> kDepths = {0.2f, 1.0f, 20.0f, kNaN, kInf, -kInf};
+
+  /// \brief Check a value, NaN being equal to NaN.
+  void expectValue(float _expected, float _actual, std::size_t _index)
+  {
+    if (std::isnan(_expected))
+      EXPECT_TRUE(std::isnan(_actual)) << _index;
+    else
+      EXPECT_FLOAT_EQ(_expected, _actual) << _index;
+  }
+
+  /// \brief Pack RGBA bytes into a float, as rendering does.
+  float packRgba(std::uint32_t _rgba)
+  {
+    float value;
+    std::memcpy(&value, &_rgba, sizeof(value));
+    return value;
+  }
+
+  /// \brief Read a float field of a point in a message.
+  float readField(const msgs::PointCloudPacked &_msg, std::size_t _point,
+      int _field)
+  {
+    float value;
+    std::memcpy(&value, _msg.data().data() + _point * _msg.point_step() +
+        _msg.field(_field).offset(), sizeof(value));
+    return value;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(PointCloudUtil_TEST, ClipDepth)
+{
+  PointCloudUtil util;
+  std::vector<float> clipped(kDepths.size());
+  util.ClipDepth(clipped.data(), kDepths.data(),
+      static_cast<unsigned int>(kDepths.size()), 0.5f, 10.0f);
+  const std::vector<float> expected = {-kInf, 1.0f, kInf, kNaN, kInf, -kInf};
+  for (std::size_t i = 0; i < expected.size(); ++i)
+    expectValue(expected[i], clipped[i], i);
+
+  // Clipping disabled
+  util.ClipDepth(clipped.data(), kDepths.data(),
+      static_cast<unsigned int>(kDepths.size()), -kInf, kInf);
+  for (std::size_t i = 0; i < kDepths.size(); ++i)
+    expectValue(kDepths[i], clipped[i], i);
+}
+
+//////////////////////////////////////////////////
+TEST(PointCloudUtil_TEST, FillMsgClip)
+{
+  const unsigned int width = static_cast<unsigned int>(kDepths.size());
+  msgs::PointCloudPacked msg;
+  msgs::InitPointCloudPacked(msg, "frame", true,
+      {{"xyz", msgs::PointCloudPacked::Field::FLOAT32},
+       {"rgb", msgs::PointCloudPacked::Field::FLOAT32}});
+  msg.set_width(width);
+  msg.set_height(1u);
+  msg.set_row_step(msg.point_step() * width);
+
+  // Points are at the depth along x, with distinct y and z
+  std::vector<float> pointCloud;
+  for (unsigned int i = 0; i < width; ++i)
+  {
+    pointCloud.push_back(kDepths[i]);
+    pointCloud.push_back(i + 0.25f);
+    pointCloud.push_back(i + 0.5f);
+    pointCloud.push_back(packRgba(0x10203040u + i));
+  }
+
+  PointCloudUtil util;
+  std::vector<unsigned char> image(width * 3u);
+  util.FillMsg(msg, pointCloud.data(), kDepths.data(), 0.5f, 10.0f,
+      image.data());
+  ASSERT_EQ(msg.row_step(), msg.data().size());
+
+  // Clipped points have all of x, y and z set to the clipped depth. NaN
+  // depths fail both clip tests and keep the point as rendered.
+  const std::vector<float> clip = {-kInf, 0.0f, kInf, 0.0f, kInf, -kInf};
+  for (unsigned int i = 0; i < width; ++i)
+  {
+    const bool clipped = std::isinf(clip[i]);
+    expectValue(clipped ? clip[i] : pointCloud[i * 4u],
+        readField(msg, i, 0), i);
+    expectValue(clipped ? clip[i] : pointCloud[i * 4u + 1u],
+        readField(msg, i, 1), i);
+    expectValue(clipped ? clip[i] : pointCloud[i * 4u + 2u],
+        readField(msg, i, 2), i);
+
+    // Colors are kept either way
+    EXPECT_EQ(0x10u, image[i * 3u]) << i;
+    EXPECT_EQ(0x20u, image[i * 3u + 1u]) << i;
+    EXPECT_EQ(0x30u, image[i * 3u + 2u]) << i;
+  }
+
+  // Without clip distances only infinite depths are invalidated
+  util.FillMsg(msg, pointCloud.data(), kDepths.data(), -kInf, kInf,
+      nullptr);
+  for (unsigned int i = 0; i < width; ++i)
+  {
+    const bool infinite = std::isinf(kDepths[i]);
+    expectValue(infinite ? kDepths[i] : pointCloud[i * 4u + 1u],
+        readField(msg, i, 1), i);
+    expectValue(pointCloud[i * 4u], readField(msg, i, 0), i);
+  }
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
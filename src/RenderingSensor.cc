@@ -15,6 +15,8 @@
  *
 */
 
+#include <unordered_set>
+
 #include <gz/common/Profiler.hh>
 
 #include <gz/rendering/Camera.hh>
@@ -33,6 +35,9 @@ class gz::sensors::RenderingSensorPrivate
   /// \brief Pointer to the internal rendering sensors used for generating
   /// sensor data
   public: std::vector<rendering::SensorPtr::weak_type> sensors;
+
+  /// \brief Sensors skipped by Render()
+  public: std::unordered_set<const rendering::Sensor *> disabled;
 };
 
 using namespace gz;
@@ -76,6 +81,16 @@ void RenderingSensor::AddSensor(rendering::SensorPtr _sensor)
   this->dataPtr->sensors.push_back(_sensor);
 }
 
+/////////////////////////////////////////////////
+void RenderingSensor::SetSensorEnabled(rendering::SensorPtr _sensor,
+    bool _enabled)
+{
+  if (_enabled)
+    this->dataPtr->disabled.erase(_sensor.get());
+  else
+    this->dataPtr->disabled.insert(_sensor.get());
+}
+
 /////////////////////////////////////////////////
 void RenderingSensor::SetManualSceneUpdate(bool _manual)
 {
@@ -101,7 +116,7 @@ void RenderingSensor::Render()
   for (auto rs : this->dataPtr->sensors)
   {
     auto s = rs.lock();
-    if (!s)
+    if (!s || this->dataPtr->disabled.count(s.get()))
       continue;
     rendering::CameraPtr rc =
         std::dynamic_pointer_cast<rendering::Camera>(s);
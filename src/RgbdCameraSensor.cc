@@ -44,6 +44,7 @@
 #include "gz/sensors/SensorFactory.hh"
 
 #include "PointCloudUtil.hh"
+#include "TripleBuffer.hh"
 
 /// \brief Private data for RgbdCameraSensor
 class gz::sensors::RgbdCameraSensorPrivate
@@ -88,11 +89,11 @@ class gz::sensors::RgbdCameraSensorPrivate
   /// \brief Rendering camera
   public: gz::rendering::DepthCameraPtr depthCamera;
 
-  /// \brief Depth data buffer.
-  public: float *depthBuffer = nullptr;
+  /// \brief Depth frames handed over from the depth camera callback.
+  public: TripleBuffer<float> depthFrames;
 
-  /// \brief Point cloud data buffer.
-  public: float *pointCloudBuffer = nullptr;
+  /// \brief Point cloud frames handed over from the depth camera callback.
+  public: TripleBuffer<float> pointCloudFrames;
 
   /// \brief True if a depth far clipping value has been set.
   public: bool hasDepthFarClip = false;
@@ -156,10 +157,6 @@ RgbdCameraSensor::~RgbdCameraSensor()
 {
   this->dataPtr->depthConnection.reset();
   this->dataPtr->pointCloudConnection.reset();
-  if (this->dataPtr->depthBuffer)
-    delete [] this->dataPtr->depthBuffer;
-  if (this->dataPtr->pointCloudBuffer)
-    delete [] this->dataPtr->pointCloudBuffer;
 }
 
 //////////////////////////////////////////////////
@@ -246,6 +243,7 @@ bool RgbdCameraSensor::Load(const sdf::Sensor &_sdf)
 
   if (!this->AdvertiseInfo(this->Topic() + "/camera_info"))
     return false;
+  this->LoadInfoRate(_sdf.CameraSensor());
 
   // Initialize the point message.
   // \todo(anyone) The true value in the following function call forces
@@ -420,15 +418,8 @@ void RgbdCameraSensorPrivate::OnNewDepthFrame(const float *_scan,
                     unsigned int /*_channels*/,
                     const std::string &/*_format*/)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-
-  unsigned int depthSamples = _width * _height;
-  unsigned int depthBufferSize = depthSamples * sizeof(float);
-
-  if (!this->depthBuffer)
-    this->depthBuffer = new float[depthSamples];
-
-  memcpy(this->depthBuffer, _scan, depthBufferSize);
+  // No lock needed, the frame is written into a slot Update never reads
+  this->depthFrames.Write(_scan, _width * _height);
 }
 
 /////////////////////////////////////////////////
@@ -437,17 +428,12 @@ void RgbdCameraSensorPrivate::OnNewRgbPointCloud(const float *_scan,
                     unsigned int _channels,
                     const std::string &/*_format*/)
 {
-  std::lock_guard<std::mutex> lock(this->mutex);
-
-  unsigned int pointCloudSamples = _width * _height;
-  unsigned int pointCloudBufferSize = pointCloudSamples * _channels *
-      sizeof(float);
   this->channels = _channels;
 
-  if (!this->pointCloudBuffer)
-    this->pointCloudBuffer = new float[pointCloudSamples * _channels];
-
-  memcpy(this->pointCloudBuffer, _scan, pointCloudBufferSize);
+  // No lock needed, the frame is written into a slot Update never reads.
+  // Frames with another stride than PointCloudUtil::kPointStride fail the
+  // size check in Update.
+  this->pointCloudFrames.Write(_scan, _width * _height * _channels);
 }
 
 //////////////////////////////////////////////////
@@ -483,11 +469,38 @@ bool RgbdCameraSensor::Update(const std::chrono::steady_clock::duration &_now)
   unsigned int height = this->dataPtr->depthCamera->ImageHeight();
   unsigned int depthSamples = height * width;
 
+  // The following is a work around since ign-rendering's depth camera
+  // does not support 2 different clipping distances. An assumption is made
+  // that the depth clipping distances are within bounds of the rgb clipping
+  // distances, if not, the rgb clipping values will take priority.
+  // The clip test is applied while filling the outgoing messages so that
+  // the depth and point cloud buffers are not rewritten.
+  bool clipDepth =
+      this->dataPtr->hasDepthNearClip || this->dataPtr->hasDepthFarClip;
+  float depthNearClip = this->dataPtr->hasDepthNearClip ?
+      static_cast<float>(this->dataPtr->depthNearClip) : -math::INF_F;
+  float depthFarClip = this->dataPtr->hasDepthFarClip ?
+      static_cast<float>(this->dataPtr->depthFarClip) : math::INF_F;
+
   // generate sensor data
   this->Render();
 
+  // Take the latest frames. They stay valid until the next Acquire, so they
+  // are published without holding the mutex or copying them first.
+  this->dataPtr->depthFrames.Acquire();
+  this->dataPtr->pointCloudFrames.Acquire();
+
+  const float *depthBuffer = nullptr;
+  if (this->dataPtr->depthFrames.FrontSize() == depthSamples)
+    depthBuffer = this->dataPtr->depthFrames.Front();
+
+  const float *pointCloudBuffer = nullptr;
+  if (this->dataPtr->pointCloudFrames.FrontSize() ==
+      depthSamples * PointCloudUtil::kPointStride)
+    pointCloudBuffer = this->dataPtr->pointCloudFrames.Front();
+
   // create and publish the depthmessage
-  if (this->HasDepthConnections())
+  if (this->HasDepthConnections() && depthBuffer)
   {
     msgs::Image msg;
     msg.set_width(width);
@@ -500,31 +513,23 @@ bool RgbdCameraSensor::Update(const std::chrono::steady_clock::duration &_now)
     frame->set_key("frame_id");
     frame->add_value(this->dataPtr->opticalFrameId);
 
-    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
-
-    // The following code is a work around since ign-rendering's depth camera
-    // does not support 2 different clipping distances. An assumption is made
-    // that the depth clipping distances are within bounds of the rgb clipping
-    // distances, if not, the rgb clipping values will take priority.
-    if (this->dataPtr->hasDepthNearClip || this->dataPtr->hasDepthFarClip)
+    if (clipDepth)
     {
-      for (unsigned int i = 0; i < depthSamples; i++)
-      {
-        if (this->dataPtr->hasDepthFarClip &&
-            (this->dataPtr->depthBuffer[i] > this->dataPtr->depthFarClip))
-        {
-          this->dataPtr->depthBuffer[i] = math::INF_D;
-        }
-        if (this->dataPtr->hasDepthNearClip &&
-            (this->dataPtr->depthBuffer[i] < this->dataPtr->depthNearClip))
-        {
-          this->dataPtr->depthBuffer[i] = -math::INF_D;
-        }
-      }
+      // clip directly into the message buffer
+      std::string *msgData = msg.mutable_data();
+      msgData->resize(rendering::PixelUtil::MemorySize(
+          rendering::PF_FLOAT32_R, width, height));
+      this->dataPtr->pointsUtil.ClipDepth(
+          reinterpret_cast<float *>(msgData->data()),
+          depthBuffer, depthSamples,
+          depthNearClip, depthFarClip);
+    }
+    else
+    {
+      msg.set_data(depthBuffer,
+          rendering::PixelUtil::MemorySize(rendering::PF_FLOAT32_R,
+          width, height));
     }
-    msg.set_data(this->dataPtr->depthBuffer,
-        rendering::PixelUtil::MemorySize(rendering::PF_FLOAT32_R,
-        width, height));
 
     // publish
     {
@@ -534,7 +539,7 @@ bool RgbdCameraSensor::Update(const std::chrono::steady_clock::duration &_now)
     }
   }
 
-  if (this->dataPtr->pointCloudBuffer)
+  if (pointCloudBuffer)
   {
     bool filledImgData = false;
     if (this->dataPtr->image.Width() != width
@@ -552,29 +557,22 @@ bool RgbdCameraSensor::Update(const std::chrono::steady_clock::duration &_now)
         msgs::Convert(_now);
       this->dataPtr->pointMsg.set_is_dense(true);
 
-      if ((this->dataPtr->hasDepthNearClip || this->dataPtr->hasDepthFarClip)
-          && this->dataPtr->depthBuffer)
-      {
-        for (unsigned int i = 0; i < depthSamples; i++)
-        {
-          float depthValue = this->dataPtr->depthBuffer[i];
-          if (std::isinf(depthValue))
-          {
-            unsigned int index = i * this->dataPtr->channels;
-
-            this->dataPtr->pointCloudBuffer[index] = depthValue;
-            this->dataPtr->pointCloudBuffer[index + 1] = depthValue;
-            this->dataPtr->pointCloudBuffer[index + 2] = depthValue;
-          }
-        }
-      }
-
       {
         IGN_PROFILE("RgbdCameraSensor::Update Fill Point Cloud");
         // fill point cloud msg and image data
-        this->dataPtr->pointsUtil.FillMsg(this->dataPtr->pointMsg,
-            this->dataPtr->pointCloudBuffer, true,
-            this->dataPtr->image.Data<unsigned char>());
+        if (clipDepth && depthBuffer)
+        {
+          this->dataPtr->pointsUtil.FillMsg(this->dataPtr->pointMsg,
+              pointCloudBuffer, depthBuffer,
+              depthNearClip, depthFarClip,
+              this->dataPtr->image.Data<unsigned char>());
+        }
+        else
+        {
+          this->dataPtr->pointsUtil.FillMsg(this->dataPtr->pointMsg,
+              pointCloudBuffer, true,
+              this->dataPtr->image.Data<unsigned char>());
+        }
         filledImgData = true;
       }
 
@@ -595,8 +593,7 @@ bool RgbdCameraSensor::Update(const std::chrono::steady_clock::duration &_now)
         // extract image data from point cloud data
         this->dataPtr->pointsUtil.RGBFromPointCloud(
             this->dataPtr->image.Data<unsigned char>(),
-            this->dataPtr->pointCloudBuffer,
-            width, height);
+            pointCloudBuffer, width, height);
       }
 
       unsigned char *data = this->dataPtr->image.Data<unsigned char>();
@@ -17,11 +17,14 @@
 
 #include <memory>
 #include <mutex>
+#include <string>
+#include <vector>
 
 #include <ignition/common/Console.hh>
 #include <ignition/common/Image.hh>
 #include <ignition/common/Profiler.hh>
 #include <ignition/common/Util.hh>
+#include <ignition/math/Vector2.hh>
 #include <ignition/msgs.hh>
 #include <ignition/rendering/SegmentationCamera.hh>
 #include <ignition/transport/Node.hh>
@@ -31,17 +34,53 @@
 #include "ignition/sensors/SegmentationCameraSensor.hh"
 #include "ignition/sensors/SensorFactory.hh"
 
+#include "FrameBufferPool.hh"
+#include "ImageSaver.hh"
+#include "LabelMapConversion.hh"
+
 using namespace ignition;
 using namespace sensors;
 
 class ignition::sensors::SegmentationCameraSensorPrivate
 {
   /// \brief Save a sample for the dataset (image & colored map & labels map)
-  /// \return True if the image was saved successfully. False can mean
+  /// \return True if the sample was queued for saving. False can mean
   /// that the image save path does not exist and creation
-  /// of the path was not possible.
+  /// of the path was not possible, or that the sample was dropped.
   public: bool SaveSample();
 
+  /// \brief Set the size, format and header of an image message. The
+  /// header is rebuilt so that it holds a single frame id.
+  /// \param[in] _msg Message.
+  /// \param[in] _width Image width.
+  /// \param[in] _height Image height.
+  /// \param[in] _format Pixel format.
+  /// \param[in] _bytesPerPixel Bytes per pixel.
+  /// \param[in] _now Time stamp.
+  /// \param[in] _frameId Frame id.
+  public: void FillHeader(msgs::Image &_msg, unsigned int _width,
+      unsigned int _height, msgs::PixelFormatType _format,
+      unsigned int _bytesPerPixel,
+      const std::chrono::steady_clock::duration &_now,
+      const std::string &_frameId);
+
+  /// \brief Fill the boxes message from the measurements. Boxes are in
+  /// pixels and their corners are the first and last pixel covered. The
+  /// header of each box holds the "instance" count, the "pixel_count" and
+  /// the "centroid" column and row.
+  /// \param[in] _now Time stamp.
+  /// \param[in] _frameId Frame id.
+  public: void FillBoxes(const std::chrono::steady_clock::duration &_now,
+      const std::string &_frameId);
+
+  /// \brief Set a header with a time stamp and a single frame id.
+  /// \param[in] _header Header.
+  /// \param[in] _now Time stamp.
+  /// \param[in] _frameId Frame id.
+  public: static void FillHeader(msgs::Header &_header,
+      const std::chrono::steady_clock::duration &_now,
+      const std::string &_frameId);
+
   /// \brief SDF Sensor DOM Object
   public: sdf::Sensor sdfSensor;
 
@@ -66,23 +105,61 @@ class ignition::sensors::SegmentationCameraSensorPrivate
   /// \brief Publisher to publish segmentation labels image
   public: transport::Node::Publisher labelsMapPublisher;
 
-  /// \brief Segmentation colored image message
+  /// \brief Segmentation colored image message. New frames are copied
+  /// straight into its data.
   public: msgs::Image coloredMapMsg;
 
-  /// \brief Segmentation labels image message
+  /// \brief Segmentation labels image message. RGB8 labels are converted
+  /// straight into its data.
   public: msgs::Image labelsMapMsg;
 
+  /// \brief Publisher of run length encoded instances, only advertised
+  /// when enabled.
+  public: transport::Node::Publisher instancesPublisher;
+
+  /// \brief Run length encoded instances message.
+  public: msgs::Int32_V instancesMsg;
+
+  /// \brief Publisher of the boxes measured on the labels map, only
+  /// advertised when enabled.
+  public: transport::Node::Publisher boxesPublisher;
+
+  /// \brief Boxes message.
+  public: msgs::AnnotatedAxisAligned2DBox_V boxesMsg;
+
+  /// \brief Measurements of the labels or instances, kept between frames.
+  public: std::vector<LabelMapConversion::Instance> measurements;
+
+  /// \brief Conversion of the labels map to its published format and to
+  /// run length encoded instances.
+  public: LabelMapConversion labelConversion;
+
+  /// \brief RGB8 labels map of the current frame, when it is not the
+  /// labels message data.
+  public: FrameBuffer segmentationLabelsBuffer;
+
+  /// \brief Run length encoded instances, kept between frames.
+  public: std::vector<std::int32_t> instanceRuns;
+
+  /// \brief True if the colored map of the frame being rendered is needed,
+  /// otherwise new frames are not copied.
+  public: bool needColoredMap = true;
+
+  /// \brief Size in bytes of the last frame received, zero before the
+  /// first one.
+  public: std::size_t frameSize = 0u;
+
   /// \brief Topic suffix to publish the segmentation colored map
   public: const std::string topicColoredMapSuffix = "/colored_map";
 
   /// \brief Topic suffix to publish the segmentation labels map
   public: const std::string topicLabelsMapSuffix = "/labels_map";
 
-  /// \brief Buffer contains the segmentation colored map data
-  public: uint8_t *segmentationColoredBuffer {nullptr};
+  /// \brief Topic suffix to publish run length encoded instances
+  public: const std::string topicInstancesSuffix = "/instances";
 
-  /// \brief Buffer contains the segmentation labels map data
-  public: uint8_t *segmentationLabelsBuffer {nullptr};
+  /// \brief Topic suffix to publish the measured boxes
+  public: const std::string topicBoxesSuffix = "/boxes";
 
   /// \brief Buffer contains the image data to be saved
   public: unsigned char *saveImageBuffer {nullptr};
@@ -121,6 +198,9 @@ class ignition::sensors::SegmentationCameraSensorPrivate
   /// \brief Counter used to set the image filename
   public: std::uint64_t saveCounter = 0;
 
+  /// \brief Save policy and file format
+  public: ImageSaver::Options saveOptions;
+
   /// \brief Event that is used to trigger callbacks when a new image
   /// is generated
   public: ignition::common::EventT<
@@ -136,17 +216,9 @@ SegmentationCameraSensor::SegmentationCameraSensor()
 /////////////////////////////////////////////////
 SegmentationCameraSensor::~SegmentationCameraSensor()
 {
-  if (this->dataPtr->segmentationColoredBuffer)
-  {
-    delete [] this->dataPtr->segmentationColoredBuffer;
-    this->dataPtr->segmentationColoredBuffer = nullptr;
-  }
-
-  if (this->dataPtr->segmentationLabelsBuffer)
-  {
-    delete [] this->dataPtr->segmentationLabelsBuffer;
-    this->dataPtr->segmentationLabelsBuffer = nullptr;
-  }
+  // Make sure the last samples are on disk before the sensor goes away
+  if (this->dataPtr->saveSamples)
+    ImageSaver::Instance().Finish(this->dataPtr->saveOptions);
 }
 
 /////////////////////////////////////////////////
@@ -221,9 +293,65 @@ bool SegmentationCameraSensor::Load(const sdf::Sensor &_sdf)
     << "] advertised on [" << this->Topic()
     << this->dataPtr->topicLabelsMapSuffix << "]\n";
 
+  // The labels map may be published with one or two bytes per pixel
+  sdf::ElementPtr cameraElem = _sdf.CameraSensor()->Element();
+  if (cameraElem && cameraElem->HasElement("ignition:labels_format"))
+  {
+    std::string format =
+        cameraElem->Get<std::string>("ignition:labels_format");
+    if (!this->dataPtr->labelConversion.SetFormat(format))
+    {
+      ignerr << "Unsupported labels map format [" << format << "]. "
+             << "Supported formats are R8G8B8, L8 and L16." << std::endl;
+    }
+  }
+
+  // Run length encoded instances are optional
+  if (cameraElem && cameraElem->HasElement("ignition:labels_instances") &&
+      cameraElem->Get<bool>("ignition:labels_instances"))
+  {
+    this->dataPtr->instancesPublisher =
+        this->dataPtr->node.Advertise<ignition::msgs::Int32_V>(
+            this->Topic() + this->dataPtr->topicInstancesSuffix);
+
+    if (!this->dataPtr->instancesPublisher)
+    {
+      ignerr << "Unable to create publisher on topic ["
+        << this->Topic() << this->dataPtr->topicInstancesSuffix << "].\n";
+      return false;
+    }
+
+    igndbg << "Segmentation instances for [" << this->Name()
+      << "] advertised on [" << this->Topic()
+      << this->dataPtr->topicInstancesSuffix << "]\n";
+  }
+
+  // Boxes, pixel counts and centroids measured on the labels map are
+  // optional too
+  if (cameraElem && cameraElem->HasElement("ignition:labels_boxes") &&
+      cameraElem->Get<bool>("ignition:labels_boxes"))
+  {
+    this->dataPtr->boxesPublisher =
+        this->dataPtr->node.Advertise<
+        ignition::msgs::AnnotatedAxisAligned2DBox_V>(
+            this->Topic() + this->dataPtr->topicBoxesSuffix);
+
+    if (!this->dataPtr->boxesPublisher)
+    {
+      ignerr << "Unable to create publisher on topic ["
+        << this->Topic() << this->dataPtr->topicBoxesSuffix << "].\n";
+      return false;
+    }
+
+    igndbg << "Segmentation boxes for [" << this->Name()
+      << "] advertised on [" << this->Topic()
+      << this->dataPtr->topicBoxesSuffix << "]\n";
+  }
+
   // TODO(anyone) Access the info topic from the parent class
   if (!this->AdvertiseInfo(this->Topic() + "/camera_info"))
     return false;
+  this->LoadInfoRate(_sdf.CameraSensor());
 
   if (this->Scene())
   {
@@ -300,6 +428,8 @@ bool SegmentationCameraSensor::CreateCamera()
     this->dataPtr->savePath = sdfCamera->SaveFramesPath();
     this->dataPtr->saveImagePrefix = this->Name() + "_";
     this->dataPtr->saveSamples = true;
+    this->dataPtr->saveOptions = ImageSaver::OptionsFromSdf(*sdfCamera,
+        this->Name());
 
     // Folders paths
     this->dataPtr->saveImageFolder =
@@ -311,15 +441,8 @@ bool SegmentationCameraSensor::CreateCamera()
 
     // Set the save counter to be equal number of images in the folder + 1
     // to continue adding to the images in the folder (multi scene datasets)
-    if (ignition::common::isDirectory(this->dataPtr->saveImageFolder))
-    {
-      common::DirIter endIter;
-      for (common::DirIter dirIter(this->dataPtr->saveImageFolder);
-        dirIter != endIter; ++dirIter)
-      {
-        this->dataPtr->saveCounter++;
-      }
-    }
+    this->dataPtr->saveCounter = ImageSaver::SavedCount(
+        this->dataPtr->saveImageFolder, this->dataPtr->saveOptions);
   }
 
   if (!this->dataPtr->camera)
@@ -337,6 +460,8 @@ bool SegmentationCameraSensor::CreateCamera()
 
   // Segmentation properties
   this->dataPtr->camera->SetSegmentationType(this->dataPtr->type);
+  this->dataPtr->labelConversion.SetPanoptic(
+      this->dataPtr->type == rendering::SegmentationType::ST_PANOPTIC);
   // Must be true to generate the colored map first then convert it
   this->dataPtr->camera->EnableColoredMap(true);
 
@@ -409,19 +534,18 @@ void SegmentationCameraSensor::OnNewSegmentationFrame(const uint8_t * _data,
 {
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  unsigned int bufferSize = _width * _height * _channles;
-
-  if (!this->dataPtr->segmentationColoredBuffer)
-    this->dataPtr->segmentationColoredBuffer = new uint8_t[bufferSize];
+  std::size_t bufferSize = static_cast<std::size_t>(_width) * _height *
+      _channles;
+  this->dataPtr->frameSize = bufferSize;
 
-  if (!this->dataPtr->segmentationLabelsBuffer)
-    this->dataPtr->segmentationLabelsBuffer = new uint8_t[bufferSize];
+  // The labels map is converted in Update() from the camera's own copy of
+  // the frame, and only when needed
+  if (!this->dataPtr->needColoredMap)
+    return;
 
-  memcpy(this->dataPtr->segmentationColoredBuffer, _data, bufferSize);
-
-  // Convert the colored map to labels map
-  this->dataPtr->camera->LabelMapFromColoredBuffer(
-    this->dataPtr->segmentationLabelsBuffer);
+  std::string *data = this->dataPtr->coloredMapMsg.mutable_data();
+  data->resize(bufferSize);
+  memcpy(&(*data)[0], _data, bufferSize);
 }
 
 //////////////////////////////////////////////////
@@ -447,9 +571,15 @@ bool SegmentationCameraSensor::Update(
     this->PublishInfo(_now);
   }
 
+  const bool instancesConnections = this->dataPtr->instancesPublisher &&
+      this->dataPtr->instancesPublisher.HasConnections();
+  const bool boxesConnections = this->dataPtr->boxesPublisher &&
+      this->dataPtr->boxesPublisher.HasConnections();
+
   // don't render if there are no subscribers nor saving
   if (!this->dataPtr->coloredMapPublisher.HasConnections() &&
     !this->dataPtr->labelsMapPublisher.HasConnections() &&
+    !instancesConnections && !boxesConnections &&
     !this->dataPtr->saveSamples)
   {
     return false;
@@ -463,6 +593,21 @@ bool SegmentationCameraSensor::Update(
       this->dataPtr->camera->WorldPose());
   }
 
+  // Each map is only produced when something consumes it
+  const bool coloredConnections =
+      this->dataPtr->coloredMapPublisher.HasConnections() ||
+      this->dataPtr->imageEvent.ConnectionCount() > 0u;
+  const bool labelsConnections =
+      this->dataPtr->labelsMapPublisher.HasConnections();
+  const bool needLabelsMap = labelsConnections || this->dataPtr->saveSamples;
+  const bool needLabels = needLabelsMap || instancesConnections ||
+      boxesConnections;
+  {
+    std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
+    this->dataPtr->needColoredMap =
+        coloredConnections || this->dataPtr->saveSamples;
+  }
+
   // Actual render
   this->Render();
 
@@ -473,47 +618,95 @@ bool SegmentationCameraSensor::Update(
     this->dataPtr->saveImageBuffer = this->dataPtr->image.Data<unsigned char>();
   }
 
-  if (!this->dataPtr->segmentationColoredBuffer ||
-    !this->dataPtr->segmentationLabelsBuffer)
-    return false;
-
   auto width = this->dataPtr->camera->ImageWidth();
   auto height = this->dataPtr->camera->ImageHeight();
-
-  // create colored map message
-  this->dataPtr->coloredMapMsg.set_width(width);
-  this->dataPtr->coloredMapMsg.set_height(height);
-  // format
-  this->dataPtr->coloredMapMsg.set_step(
-    width * rendering::PixelUtil::BytesPerPixel(rendering::PF_R8G8B8));
-  this->dataPtr->coloredMapMsg.set_pixel_format_type(
-    msgs::PixelFormatType::RGB_INT8);
-  // time stamp
-  auto stamp = this->dataPtr->coloredMapMsg.mutable_header()->mutable_stamp();
-  *stamp = msgs::Convert(_now);
-  auto frame = this->dataPtr->coloredMapMsg.mutable_header()->add_data();
-  frame->set_key("frame_id");
-  frame->add_value(this->FrameId());
-
-  this->dataPtr->labelsMapMsg.CopyFrom(this->dataPtr->coloredMapMsg);
+  auto bufferSize = rendering::PixelUtil::MemorySize(rendering::PF_R8G8B8,
+    width, height);
 
   // Protect the data being modified by the segmentation buffers
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
-  // segmentation colored map data
-  this->dataPtr->coloredMapMsg.set_data(
-    this->dataPtr->segmentationColoredBuffer,
-    rendering::PixelUtil::MemorySize(rendering::PF_R8G8B8,
-    width, height));
+  // The frame may be missing or have the previous size if the resolution
+  // just changed
+  if (this->dataPtr->frameSize != bufferSize ||
+      (this->dataPtr->needColoredMap &&
+      this->dataPtr->coloredMapMsg.data().size() != bufferSize))
+    return false;
 
-  // segmentation labels map data
-  this->dataPtr->labelsMapMsg.set_data(this->dataPtr->segmentationLabelsBuffer,
-      rendering::PixelUtil::MemorySize(rendering::PF_R8G8B8,
-      width, height));
+  if (this->dataPtr->needColoredMap)
+  {
+    this->dataPtr->FillHeader(this->dataPtr->coloredMapMsg, width, height,
+        msgs::PixelFormatType::RGB_INT8, 3u, _now, this->FrameId());
+  }
+
+  // Convert the colored map to labels map. RGB8 labels go straight into
+  // the message, compact formats are converted from a scratch buffer.
+  if (needLabels)
+  {
+    LabelMapConversion &conversion = this->dataPtr->labelConversion;
+    const bool rgbLabels =
+        conversion.OutputFormat() == LabelMapConversion::Format::R8G8B8;
+    std::string *data = this->dataPtr->labelsMapMsg.mutable_data();
+    uint8_t *labels = nullptr;
+    if (rgbLabels && needLabelsMap)
+    {
+      data->resize(bufferSize);
+      labels = reinterpret_cast<uint8_t *>(&(*data)[0]);
+    }
+    else
+    {
+      this->dataPtr->segmentationLabelsBuffer.Resize(bufferSize);
+      labels = this->dataPtr->segmentationLabelsBuffer.Data<uint8_t>();
+    }
+    this->dataPtr->camera->LabelMapFromColoredBuffer(labels);
+
+    if (needLabelsMap)
+    {
+      const std::size_t samples = static_cast<std::size_t>(width) * height;
+      msgs::PixelFormatType format = msgs::PixelFormatType::RGB_INT8;
+      if (!rgbLabels)
+      {
+        data->resize(samples * conversion.BytesPerPixel());
+        conversion.Convert(labels, samples,
+            reinterpret_cast<unsigned char *>(&(*data)[0]));
+        format = conversion.BytesPerPixel() == 1u ?
+            msgs::PixelFormatType::L_INT8 : msgs::PixelFormatType::L_INT16;
+      }
+      this->dataPtr->FillHeader(this->dataPtr->labelsMapMsg, width, height,
+          format, conversion.BytesPerPixel(), _now, this->FrameId());
+    }
+
+    if (instancesConnections)
+    {
+      msgs::Int32_V &instancesMsg = this->dataPtr->instancesMsg;
+      this->dataPtr->FillHeader(*instancesMsg.mutable_header(), _now,
+          this->FrameId());
+      conversion.EncodeInstances(labels, width, height,
+          this->dataPtr->camera->BackgroundLabel(),
+          this->dataPtr->instanceRuns);
+      instancesMsg.mutable_data()->Assign(
+          this->dataPtr->instanceRuns.begin(),
+          this->dataPtr->instanceRuns.end());
+    }
+
+    if (boxesConnections)
+    {
+      conversion.Measure(labels, width, height,
+          this->dataPtr->camera->BackgroundLabel(),
+          this->dataPtr->measurements);
+      this->dataPtr->FillBoxes(_now, this->FrameId());
+    }
+  }
 
   // Publish
-  this->dataPtr->coloredMapPublisher.Publish(this->dataPtr->coloredMapMsg);
-  this->dataPtr->labelsMapPublisher.Publish(this->dataPtr->labelsMapMsg);
+  if (this->dataPtr->coloredMapPublisher.HasConnections())
+    this->dataPtr->coloredMapPublisher.Publish(this->dataPtr->coloredMapMsg);
+  if (labelsConnections)
+    this->dataPtr->labelsMapPublisher.Publish(this->dataPtr->labelsMapMsg);
+  if (instancesConnections)
+    this->dataPtr->instancesPublisher.Publish(this->dataPtr->instancesMsg);
+  if (boxesConnections)
+    this->dataPtr->boxesPublisher.Publish(this->dataPtr->boxesMsg);
 
   // Trigger callbacks.
   if (this->dataPtr->imageEvent.ConnectionCount() > 0u)
@@ -565,37 +758,90 @@ bool SegmentationCameraSensor::HasConnections() const
       this->dataPtr->coloredMapPublisher.HasConnections()) ||
       (this->dataPtr->labelsMapPublisher &&
       this->dataPtr->labelsMapPublisher.HasConnections()) ||
+      (this->dataPtr->instancesPublisher &&
+      this->dataPtr->instancesPublisher.HasConnections()) ||
+      (this->dataPtr->boxesPublisher &&
+      this->dataPtr->boxesPublisher.HasConnections()) ||
       this->dataPtr->imageEvent.ConnectionCount() > 0u ||
       this->HasInfoConnections();
 }
 
 //////////////////////////////////////////////////
-bool SegmentationCameraSensorPrivate::SaveSample()
+void SegmentationCameraSensorPrivate::FillHeader(msgs::Image &_msg,
+    unsigned int _width, unsigned int _height, msgs::PixelFormatType _format,
+    unsigned int _bytesPerPixel,
+    const std::chrono::steady_clock::duration &_now,
+    const std::string &_frameId)
 {
-  // Attempt to create the directories if they don't exist
-  if (!ignition::common::isDirectory(this->savePath))
-  {
-    if (!ignition::common::createDirectories(this->savePath))
-      return false;
-  }
-  if (!ignition::common::isDirectory(this->saveImageFolder))
-  {
-    if (!ignition::common::createDirectories(this->saveImageFolder))
-      return false;
-  }
-  if (!ignition::common::isDirectory(this->saveColoredMapsFolder))
+  _msg.set_width(_width);
+  _msg.set_height(_height);
+  _msg.set_step(_width * _bytesPerPixel);
+  _msg.set_pixel_format_type(_format);
+  FillHeader(*_msg.mutable_header(), _now, _frameId);
+}
+
+//////////////////////////////////////////////////
+void SegmentationCameraSensorPrivate::FillHeader(msgs::Header &_header,
+    const std::chrono::steady_clock::duration &_now,
+    const std::string &_frameId)
+{
+  _header.Clear();
+  *_header.mutable_stamp() = msgs::Convert(_now);
+  auto frame = _header.add_data();
+  frame->set_key("frame_id");
+  frame->add_value(_frameId);
+}
+
+//////////////////////////////////////////////////
+void SegmentationCameraSensorPrivate::FillBoxes(
+    const std::chrono::steady_clock::duration &_now,
+    const std::string &_frameId)
+{
+  this->boxesMsg.Clear();
+  FillHeader(*this->boxesMsg.mutable_header(), _now, _frameId);
+  for (const auto &measurement : this->measurements)
   {
-    if (!ignition::common::createDirectories(this->saveColoredMapsFolder))
-      return false;
+    auto annotatedBox = this->boxesMsg.add_annotated_box();
+    annotatedBox->set_label(static_cast<uint32_t>(measurement.label));
+
+    auto box = annotatedBox->mutable_box();
+    msgs::Set(box->mutable_min_corner(),
+        math::Vector2d(measurement.minU, measurement.minV));
+    msgs::Set(box->mutable_max_corner(),
+        math::Vector2d(measurement.maxU, measurement.maxV));
+
+    auto header = box->mutable_header();
+    auto instance = header->add_data();
+    instance->set_key("instance");
+    instance->add_value(std::to_string(measurement.instance));
+    auto pixels = header->add_data();
+    pixels->set_key("pixel_count");
+    pixels->add_value(std::to_string(measurement.pixels));
+    auto centroid = header->add_data();
+    centroid->set_key("centroid");
+    centroid->add_value(std::to_string(measurement.centroidU));
+    centroid->add_value(std::to_string(measurement.centroidV));
   }
-  if (!ignition::common::isDirectory(this->saveLabelsMapsFolder))
+}
+
+//////////////////////////////////////////////////
+bool SegmentationCameraSensorPrivate::SaveSample()
+{
+  // Attempt to create the directories if they don't exist, the saver only
+  // touches the filesystem the first time. A container only needs the
+  // directory it is in, which the saver creates.
+  ImageSaver &saver = ImageSaver::Instance();
+  if (this->saveOptions.container.empty() &&
+      (!saver.EnsureDirectory(this->saveImageFolder) ||
+      !saver.EnsureDirectory(this->saveColoredMapsFolder) ||
+      !saver.EnsureDirectory(this->saveLabelsMapsFolder)))
   {
-    if (!ignition::common::createDirectories(this->saveLabelsMapsFolder))
-      return false;
+    return false;
   }
 
   auto width = this->camera->ImageWidth();
   auto height = this->camera->ImageHeight();
+  std::size_t size = static_cast<std::size_t>(width) * height * 3u;
 
   // Save the images in format of 0000001, 0000002 .. etc
   // Useful in sorting them in python
@@ -603,34 +849,33 @@ bool SegmentationCameraSensorPrivate::SaveSample()
   ss << std::setw(7) << std::setfill('0') << this->saveCounter;
   std::string saveCounterString = ss.str();
 
-  std::string coloredName = "colored_" + saveCounterString + ".png";
-  std::string labelsName = "labels_" + saveCounterString + ".png";
-  std::string rgbImageName = "image_" + saveCounterString + ".png";
-
-  // Save rgb image
-  ignition::common::Image rgbImage;
-  rgbImage.SetFromData(this->saveImageBuffer,
-    width, height, ignition::common::Image::RGB_INT8);
-
-  rgbImage.SavePNG(
-      ignition::common::joinPaths(this->saveImageFolder, rgbImageName));
-
-  // Save colored map
-  ignition::common::Image localColoredImage;
-  localColoredImage.SetFromData(this->segmentationColoredBuffer,
-    width, height, ignition::common::Image::RGB_INT8);
-
-  localColoredImage.SavePNG(
-      ignition::common::joinPaths(this->saveColoredMapsFolder, coloredName));
-
-  // Save labels map
-  ignition::common::Image localLabelsImage;
-  localLabelsImage.SetFromData(this->segmentationLabelsBuffer,
-    width, height, ignition::common::Image::RGB_INT8);
-
-  localLabelsImage.SavePNG(
-      ignition::common::joinPaths(this->saveLabelsMapsFolder, labelsName));
+  std::string coloredName = "colored_" + saveCounterString;
+  std::string labelsName = "labels_" + saveCounterString;
+  std::string rgbImageName = "image_" + saveCounterString;
+
+  // Queue the rgb image, colored map and labels map. The saver copies the
+  // buffers, which are overwritten by the next frame.
+  bool result = saver.Save(this->saveImageFolder, rgbImageName,
+      this->saveImageBuffer, size, width, height,
+      ignition::common::Image::RGB_INT8, this->saveOptions);
+
+  result = saver.Save(this->saveColoredMapsFolder, coloredName,
+      reinterpret_cast<const unsigned char *>(
+      this->coloredMapMsg.data().data()), size, width,
+      height, ignition::common::Image::RGB_INT8, this->saveOptions) && result;
+
+  // Labels maps are saved in the format they are published in
+  auto labelsFormat = ignition::common::Image::RGB_INT8;
+  if (this->labelConversion.OutputFormat() == LabelMapConversion::Format::L8)
+    labelsFormat = ignition::common::Image::L_INT8;
+  else if (this->labelConversion.OutputFormat() ==
+      LabelMapConversion::Format::L16)
+    labelsFormat = ignition::common::Image::L_INT16;
+  result = saver.Save(this->saveLabelsMapsFolder, labelsName,
+      reinterpret_cast<const unsigned char *>(
+      this->labelsMapMsg.data().data()), this->labelsMapMsg.data().size(),
+      width, height, labelsFormat, this->saveOptions) && result;
 
   ++this->saveCounter;
-  return true;
+  return result;
 }
@@ -0,0 +1,709 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "ignition/sensors/SharedMemoryImage.hh"
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <signal.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <utility>
+
+#include <ignition/common/Console.hh>
+
+using namespace ignition;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Value of SegmentHeader::magic once a segment is initialized.
+  const std::uint32_t kSegmentMagic = 0x49474e53u;
+
+  /// \brief Version of the segment layout.
+  const std::uint32_t kSegmentVersion = 2u;
+
+  /// \brief Alignment of the segment header, slot headers and frame data.
+  const std::size_t kSegmentAlignment = 64u;
+
+  /// \brief Header at the start of a segment.
+  struct SegmentHeader
+  {
+    /// \brief kSegmentMagic, written last when the segment is created.
+    std::atomic<std::uint32_t> magic;
+
+    /// \brief Layout version.
+    std::uint32_t version;
+
+    /// \brief Number of slots.
+    std::uint32_t slotCount;
+
+    /// \brief Process id of the writer that created the segment.
+    std::uint32_t owner;
+
+    /// \brief Maximum frame size in bytes.
+    std::uint64_t slotSize;
+
+    /// \brief Identifies this segment among the segments created with the
+    /// same name, such as by a restarted writer.
+    std::uint64_t generation;
+  };
+
+  /// \brief Header at the start of each slot.
+  struct SlotHeader
+  {
+    /// \brief Twice the sequence number of the frame in the slot. Odd while
+    /// the writer is updating the slot.
+    std::atomic<std::uint64_t> sequence;
+
+    /// \brief Size of the frame in bytes.
+    std::uint64_t size;
+  };
+
+  static_assert(sizeof(SegmentHeader) <= kSegmentAlignment,
+      "Segment header does not fit its reserved space");
+  static_assert(sizeof(SlotHeader) <= kSegmentAlignment,
+      "Slot header does not fit its reserved space");
+
+  /// \brief Round a size up to kSegmentAlignment.
+  std::size_t alignSize(std::size_t _size)
+  {
+    return (_size + kSegmentAlignment - 1u) & ~(kSegmentAlignment - 1u);
+  }
+
+  /// \brief Distance between the start of two consecutive slots.
+  std::size_t slotStride(std::size_t _slotSize)
+  {
+    return kSegmentAlignment + alignSize(_slotSize);
+  }
+
+  /// \brief Total size of a segment.
+  std::size_t segmentSize(unsigned int _slotCount, std::size_t _slotSize)
+  {
+    return kSegmentAlignment + _slotCount * slotStride(_slotSize);
+  }
+
+  /// \brief Get a slot header in a mapped segment.
+  SlotHeader *slotHeader(unsigned char *_base, std::size_t _slotSize,
+      unsigned int _slot)
+  {
+    return reinterpret_cast<SlotHeader *>(
+        _base + kSegmentAlignment + _slot * slotStride(_slotSize));
+  }
+
+  /// \brief Add the leading '/' POSIX requires in segment names.
+  std::string segmentName(const std::string &_name)
+  {
+    if (!_name.empty() && _name[0] == '/')
+      return _name;
+    return "/" + _name;
+  }
+
+#ifndef _WIN32
+  /// \brief Make a generation number that differs between the segments
+  /// created by all writers, in this process or another one.
+  std::uint64_t newGeneration()
+  {
+    static std::atomic<std::uint64_t> counter{0u};
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    return (static_cast<std::uint64_t>(now) ^
+        (static_cast<std::uint64_t>(getpid()) << 40u)) + ++counter;
+  }
+
+  /// \brief Remove an existing segment if it was left behind by a writer
+  /// process that is no longer running. Segments of running writers, and
+  /// segments that are not image rings, are left alone.
+  /// \param[in] _name Segment name, with the leading '/'.
+  /// \return True if the segment was removed.
+  bool removeAbandoned(const std::string &_name)
+  {
+    int fd = shm_open(_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+      return errno == ENOENT;
+
+    struct stat st;
+    std::uint32_t owner = 0u;
+    if (fstat(fd, &st) == 0 &&
+        static_cast<std::size_t>(st.st_size) >= kSegmentAlignment)
+    {
+      void *base = mmap(nullptr, kSegmentAlignment, PROT_READ, MAP_SHARED,
+          fd, 0);
+      if (base != MAP_FAILED)
+      {
+        auto header = static_cast<const SegmentHeader *>(base);
+        if (header->magic.load(std::memory_order_acquire) == kSegmentMagic)
+          owner = header->owner;
+        munmap(base, kSegmentAlignment);
+      }
+    }
+    close(fd);
+
+    if (owner == 0u)
+    {
+      ignerr << "Shared memory segment [" << _name << "] exists and was not "
+             << "created by an image writer." << std::endl;
+      return false;
+    }
+    if (kill(static_cast<pid_t>(owner), 0) == 0 || errno != ESRCH)
+    {
+      ignerr << "Shared memory segment [" << _name << "] is in use by "
+             << "process [" << owner << "]." << std::endl;
+      return false;
+    }
+
+    igndbg << "Removing shared memory segment [" << _name << "] left by "
+           << "process [" << owner << "]." << std::endl;
+    return shm_unlink(_name.c_str()) == 0 || errno == ENOENT;
+  }
+#endif
+
+  /// \brief Find a header value in a descriptor message.
+  /// \return Pointer to the value or nullptr if the key is missing.
+  const std::string *headerValue(const msgs::Image &_msg,
+      const std::string &_key)
+  {
+    for (const auto &data : _msg.header().data())
+    {
+      if (data.key() == _key && data.value_size() > 0)
+        return &data.value(0);
+    }
+    return nullptr;
+  }
+
+  /// \brief Set a header value in a descriptor message, replacing the
+  /// existing value if there is one.
+  void setHeaderValue(msgs::Image &_msg, const std::string &_key,
+      const std::string &_value)
+  {
+    auto header = _msg.mutable_header();
+    for (auto &data : *header->mutable_data())
+    {
+      if (data.key() == _key)
+      {
+        data.clear_value();
+        data.add_value(_value);
+        return;
+      }
+    }
+    auto data = header->add_data();
+    data->set_key(_key);
+    data->add_value(_value);
+  }
+}
+
+/// \brief Private data for SharedMemoryImageWriter
+class ignition::sensors::SharedMemoryImageWriter::Implementation
+{
+  /// \brief Segment name.
+  public: std::string name;
+
+  /// \brief Start of the mapped segment.
+  public: unsigned char *base = nullptr;
+
+  /// \brief Size of the mapped segment in bytes.
+  public: std::size_t mappedSize = 0u;
+
+  /// \brief Number of slots.
+  public: unsigned int slotCount = 0u;
+
+  /// \brief Maximum frame size in bytes.
+  public: std::size_t slotSize = 0u;
+
+  /// \brief Sequence number of the last frame written.
+  public: std::uint64_t sequence = 0u;
+
+  /// \brief Generation of the segment.
+  public: std::uint64_t generation = 0u;
+
+  /// \brief Device of the segment, to tell it from a segment created
+  /// under the same name by someone else.
+  public: std::uint64_t device = 0u;
+
+  /// \brief Inode of the segment.
+  public: std::uint64_t inode = 0u;
+};
+
+/// \brief Private data for SharedMemoryImageReader
+class ignition::sensors::SharedMemoryImageReader::Implementation
+{
+  /// \brief Copy a frame out of the mapped segment.
+  /// \param[in] _slot Slot index.
+  /// \param[in] _sequence Sequence number of the frame.
+  /// \param[in] _size Frame size.
+  /// \param[out] _data Destination, at least _size bytes.
+  /// \return True if the frame was copied without being overwritten.
+  public: bool Copy(unsigned int _slot, std::uint64_t _sequence,
+              std::size_t _size, void *_data) const;
+
+  /// \brief Map the segment named in a descriptor unless the same
+  /// generation of it is already mapped and large enough for the frame.
+  /// \param[in] _name Segment name.
+  /// \param[in] _generation Segment generation.
+  /// \param[in] _size Frame size.
+  /// \return True if the segment is mapped.
+  public: bool Ensure(const std::string &_name, std::uint64_t _generation,
+              std::size_t _size);
+
+  /// \brief Parse the shared memory entries of a descriptor.
+  /// \return False if an entry is missing or malformed.
+  public: static bool Parse(const msgs::Image &_descriptor,
+              std::string &_name, std::uint64_t &_generation,
+              unsigned int &_slot, std::uint64_t &_sequence,
+              std::size_t &_size);
+
+  /// \brief Segment name.
+  public: std::string name;
+
+  /// \brief Start of the mapped segment.
+  public: unsigned char *base = nullptr;
+
+  /// \brief Size of the mapped segment in bytes.
+  public: std::size_t mappedSize = 0u;
+
+  /// \brief Number of slots.
+  public: unsigned int slotCount = 0u;
+
+  /// \brief Maximum frame size in bytes.
+  public: std::size_t slotSize = 0u;
+
+  /// \brief Generation of the mapped segment.
+  public: std::uint64_t generation = 0u;
+};
+
+//////////////////////////////////////////////////
+SharedMemoryImageWriter::SharedMemoryImageWriter()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+SharedMemoryImageWriter::~SharedMemoryImageWriter()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageWriter::Open(const std::string &_name,
+    unsigned int _slotCount, std::size_t _slotSize)
+{
+  this->Close();
+
+  if (_slotCount == 0u || _slotSize == 0u)
+  {
+    ignerr << "Shared memory segment [" << _name << "] needs at least one "
+           << "slot of non zero size." << std::endl;
+    return false;
+  }
+
+#ifdef _WIN32
+  ignerr << "Shared memory image transport is not supported on Windows."
+         << std::endl;
+  return false;
+#else
+  std::string name = segmentName(_name);
+  std::size_t size = segmentSize(_slotCount, _slotSize);
+
+  // A segment left behind by a writer that crashed is replaced, one that
+  // belongs to a running writer is not
+  int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  if (fd < 0 && errno == EEXIST)
+  {
+    if (!removeAbandoned(name))
+      return false;
+    fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+  }
+  if (fd < 0)
+  {
+    ignerr << "Unable to create shared memory segment [" << name << "]: "
+           << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0)
+  {
+    ignerr << "Unable to stat shared memory segment [" << name << "]: "
+           << std::strerror(errno) << std::endl;
+    close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  if (ftruncate(fd, static_cast<off_t>(size)) != 0)
+  {
+    ignerr << "Unable to resize shared memory segment [" << name << "] to ["
+           << size << "] bytes: " << std::strerror(errno) << std::endl;
+    close(fd);
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  void *base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+  {
+    ignerr << "Unable to map shared memory segment [" << name << "]: "
+           << std::strerror(errno) << std::endl;
+    shm_unlink(name.c_str());
+    return false;
+  }
+
+  this->dataPtr->name = name;
+  this->dataPtr->base = static_cast<unsigned char *>(base);
+  this->dataPtr->mappedSize = size;
+  this->dataPtr->slotCount = _slotCount;
+  this->dataPtr->slotSize = _slotSize;
+  this->dataPtr->sequence = 0u;
+  this->dataPtr->generation = newGeneration();
+  this->dataPtr->device = static_cast<std::uint64_t>(st.st_dev);
+  this->dataPtr->inode = static_cast<std::uint64_t>(st.st_ino);
+
+  // ftruncate zero fills the segment, so all slots start at sequence 0.
+  // Publish the header last so readers never see a partial one.
+  auto header = new (this->dataPtr->base) SegmentHeader;
+  header->version = kSegmentVersion;
+  header->slotCount = _slotCount;
+  header->owner = static_cast<std::uint32_t>(getpid());
+  header->slotSize = _slotSize;
+  header->generation = this->dataPtr->generation;
+  header->magic.store(kSegmentMagic, std::memory_order_release);
+
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+void SharedMemoryImageWriter::Close()
+{
+#ifndef _WIN32
+  if (this->dataPtr->base)
+  {
+    munmap(this->dataPtr->base, this->dataPtr->mappedSize);
+
+    // Only remove the name if it still refers to the segment created here
+    int fd = shm_open(this->dataPtr->name.c_str(), O_RDONLY, 0);
+    if (fd >= 0)
+    {
+      struct stat st;
+      bool own = fstat(fd, &st) == 0 &&
+          static_cast<std::uint64_t>(st.st_dev) == this->dataPtr->device &&
+          static_cast<std::uint64_t>(st.st_ino) == this->dataPtr->inode;
+      close(fd);
+      if (own)
+        shm_unlink(this->dataPtr->name.c_str());
+    }
+  }
+#endif
+  this->dataPtr->name.clear();
+  this->dataPtr->base = nullptr;
+  this->dataPtr->mappedSize = 0u;
+  this->dataPtr->slotCount = 0u;
+  this->dataPtr->slotSize = 0u;
+  this->dataPtr->generation = 0u;
+  this->dataPtr->device = 0u;
+  this->dataPtr->inode = 0u;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageWriter::IsOpen() const
+{
+  return this->dataPtr->base != nullptr;
+}
+
+//////////////////////////////////////////////////
+const std::string &SharedMemoryImageWriter::Name() const
+{
+  return this->dataPtr->name;
+}
+
+//////////////////////////////////////////////////
+unsigned int SharedMemoryImageWriter::SlotCount() const
+{
+  return this->dataPtr->slotCount;
+}
+
+//////////////////////////////////////////////////
+std::size_t SharedMemoryImageWriter::SlotSize() const
+{
+  return this->dataPtr->slotSize;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageWriter::Write(const void *_data, std::size_t _size,
+    msgs::Image &_descriptor)
+{
+  if (!this->dataPtr->base)
+    return false;
+
+  if (_size > this->dataPtr->slotSize)
+  {
+    ignerr << "Frame of [" << _size << "] bytes does not fit in the ["
+           << this->dataPtr->slotSize << "] byte slots of shared memory "
+           << "segment [" << this->dataPtr->name << "]." << std::endl;
+    return false;
+  }
+
+  std::uint64_t sequence = ++this->dataPtr->sequence;
+  unsigned int slot =
+      static_cast<unsigned int>((sequence - 1u) % this->dataPtr->slotCount);
+  SlotHeader *header =
+      slotHeader(this->dataPtr->base, this->dataPtr->slotSize, slot);
+
+  // Sequence lock: an odd value tells readers the slot is being written
+  header->sequence.store(sequence * 2u - 1u, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  header->size = _size;
+  std::memcpy(reinterpret_cast<unsigned char *>(header) + kSegmentAlignment,
+      _data, _size);
+  header->sequence.store(sequence * 2u, std::memory_order_release);
+
+  _descriptor.clear_data();
+  setHeaderValue(_descriptor, kSharedMemoryNameKey, this->dataPtr->name);
+  setHeaderValue(_descriptor, kSharedMemoryGenerationKey,
+      std::to_string(this->dataPtr->generation));
+  setHeaderValue(_descriptor, kSharedMemorySlotKey, std::to_string(slot));
+  setHeaderValue(_descriptor, kSharedMemorySequenceKey,
+      std::to_string(sequence));
+  setHeaderValue(_descriptor, kSharedMemorySizeKey, std::to_string(_size));
+  return true;
+}
+
+//////////////////////////////////////////////////
+SharedMemoryImageReader::SharedMemoryImageReader()
+  : dataPtr(utils::MakeUniqueImpl<Implementation>())
+{
+}
+
+//////////////////////////////////////////////////
+SharedMemoryImageReader::~SharedMemoryImageReader()
+{
+  this->Close();
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageReader::IsDescriptor(const msgs::Image &_msg)
+{
+  return headerValue(_msg, kSharedMemoryNameKey) != nullptr;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageReader::Open(const std::string &_name)
+{
+  this->Close();
+
+#ifdef _WIN32
+  ignerr << "Shared memory image transport is not supported on Windows."
+         << std::endl;
+  return false;
+#else
+  std::string name = segmentName(_name);
+  int fd = shm_open(name.c_str(), O_RDONLY, 0);
+  if (fd < 0)
+  {
+    ignerr << "Unable to open shared memory segment [" << name << "]: "
+           << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) != 0 ||
+      static_cast<std::size_t>(st.st_size) < kSegmentAlignment)
+  {
+    ignerr << "Shared memory segment [" << name << "] is not initialized."
+           << std::endl;
+    close(fd);
+    return false;
+  }
+
+  std::size_t size = static_cast<std::size_t>(st.st_size);
+  void *base = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (base == MAP_FAILED)
+  {
+    ignerr << "Unable to map shared memory segment [" << name << "]: "
+           << std::strerror(errno) << std::endl;
+    return false;
+  }
+
+  auto header = static_cast<const SegmentHeader *>(base);
+  if (header->magic.load(std::memory_order_acquire) != kSegmentMagic ||
+      header->version != kSegmentVersion ||
+      segmentSize(header->slotCount, header->slotSize) > size)
+  {
+    ignerr << "Shared memory segment [" << name << "] is not an image ring."
+           << std::endl;
+    munmap(base, size);
+    return false;
+  }
+
+  this->dataPtr->name = name;
+  this->dataPtr->base = static_cast<unsigned char *>(base);
+  this->dataPtr->mappedSize = size;
+  this->dataPtr->slotCount = header->slotCount;
+  this->dataPtr->slotSize = header->slotSize;
+  this->dataPtr->generation = header->generation;
+  return true;
+#endif
+}
+
+//////////////////////////////////////////////////
+void SharedMemoryImageReader::Close()
+{
+#ifndef _WIN32
+  if (this->dataPtr->base)
+    munmap(this->dataPtr->base, this->dataPtr->mappedSize);
+#endif
+  this->dataPtr->name.clear();
+  this->dataPtr->base = nullptr;
+  this->dataPtr->mappedSize = 0u;
+  this->dataPtr->slotCount = 0u;
+  this->dataPtr->slotSize = 0u;
+  this->dataPtr->generation = 0u;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageReader::Read(const msgs::Image &_descriptor,
+    msgs::Image &_image)
+{
+  std::string name;
+  std::uint64_t generation;
+  unsigned int slot;
+  std::uint64_t sequence;
+  std::size_t size;
+  if (!Implementation::Parse(_descriptor, name, generation, slot, sequence,
+          size) ||
+      !this->dataPtr->Ensure(name, generation, size))
+  {
+    return false;
+  }
+
+  _image.CopyFrom(_descriptor);
+  std::string *data = _image.mutable_data();
+  data->resize(size);
+  if (!this->dataPtr->Copy(slot, sequence, size, &(*data)[0]))
+  {
+    _image.clear_data();
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::size_t SharedMemoryImageReader::Read(const msgs::Image &_descriptor,
+    void *_data, std::size_t _size)
+{
+  std::string name;
+  std::uint64_t generation;
+  unsigned int slot;
+  std::uint64_t sequence;
+  std::size_t size;
+  if (!Implementation::Parse(_descriptor, name, generation, slot, sequence,
+          size) ||
+      size > _size || !this->dataPtr->Ensure(name, generation, size))
+  {
+    return 0u;
+  }
+
+  return this->dataPtr->Copy(slot, sequence, size, _data) ? size : 0u;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageReader::Implementation::Parse(
+    const msgs::Image &_descriptor, std::string &_name,
+    std::uint64_t &_generation, unsigned int &_slot,
+    std::uint64_t &_sequence, std::size_t &_size)
+{
+  const std::string *name = headerValue(_descriptor, kSharedMemoryNameKey);
+  const std::string *generation =
+      headerValue(_descriptor, kSharedMemoryGenerationKey);
+  const std::string *slot = headerValue(_descriptor, kSharedMemorySlotKey);
+  const std::string *sequence =
+      headerValue(_descriptor, kSharedMemorySequenceKey);
+  const std::string *size = headerValue(_descriptor, kSharedMemorySizeKey);
+  if (!name || !generation || !slot || !sequence || !size)
+    return false;
+
+  try
+  {
+    _name = *name;
+    _generation = std::stoull(*generation);
+    _slot = static_cast<unsigned int>(std::stoul(*slot));
+    _sequence = std::stoull(*sequence);
+    _size = static_cast<std::size_t>(std::stoull(*size));
+  }
+  catch (const std::exception &)
+  {
+    ignerr << "Malformed shared memory image descriptor." << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageReader::Implementation::Ensure(const std::string &_name,
+    std::uint64_t _generation, std::size_t _size)
+{
+  // The writer recreates the segment when frames outgrow the slots, and a
+  // restarted writer creates a new one under the same name, so a frame from
+  // another generation means the mapping is stale
+  if (this->base && this->name == segmentName(_name) &&
+      this->generation == _generation && _size <= this->slotSize)
+  {
+    return true;
+  }
+
+  SharedMemoryImageReader reader;
+  if (!reader.Open(_name))
+    return false;
+
+  std::swap(*this, *reader.dataPtr);
+  return this->generation == _generation && _size <= this->slotSize;
+}
+
+//////////////////////////////////////////////////
+bool SharedMemoryImageReader::Implementation::Copy(unsigned int _slot,
+    std::uint64_t _sequence, std::size_t _size, void *_data) const
+{
+  if (!this->base || _slot >= this->slotCount || _size > this->slotSize)
+    return false;
+
+  const SlotHeader *header = slotHeader(this->base, this->slotSize, _slot);
+  const std::uint64_t expected = _sequence * 2u;
+  if (header->sequence.load(std::memory_order_acquire) != expected ||
+      header->size != _size)
+  {
+    return false;
+  }
+
+  std::memcpy(_data,
+      reinterpret_cast<const unsigned char *>(header) + kSegmentAlignment,
+      _size);
+
+  // If the writer started on this slot during the copy the frame is torn
+  std::atomic_thread_fence(std::memory_order_acquire);
+  return header->sequence.load(std::memory_order_relaxed) == expected;
+}
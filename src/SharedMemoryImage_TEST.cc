@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#ifndef _WIN32
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <ignition/utils/ExtraTestMacros.hh>
+
+#include "ignition/sensors/SharedMemoryImage.hh"
+
+using namespace ignition;
+using namespace sensors;
+
+/// \brief Segment name used by a test.
+static std::string segmentName(const std::string &_suffix)
+{
+  return "/ign_sensors_SharedMemoryImage_TEST_" + _suffix;
+}
+
+/// \brief Fill a frame with a pattern that depends on _seed.
+static std::vector<unsigned char> makeFrame(std::size_t _size,
+    unsigned char _seed)
+{
+  std::vector<unsigned char> frame(_size);
+  for (std::size_t i = 0; i < _size; ++i)
+    frame[i] = static_cast<unsigned char>(i * 7u + _seed);
+  return frame;
+}
+
+//////////////////////////////////////////////////
+TEST(SharedMemoryImage_TEST,
+     IGN_UTILS_TEST_DISABLED_ON_WIN32(WriteRead))
+{
+  SharedMemoryImageWriter writer;
+  EXPECT_FALSE(writer.IsOpen());
+  ASSERT_TRUE(writer.Open(segmentName("write_read"), 2u, 64u * 48u * 3u));
+  EXPECT_TRUE(writer.IsOpen());
+  EXPECT_EQ(2u, writer.SlotCount());
+  EXPECT_EQ(64u * 48u * 3u, writer.SlotSize());
+
+  msgs::Image descriptor;
+  descriptor.set_width(64u);
+  descriptor.set_height(48u);
+  descriptor.set_step(64u * 3u);
+  descriptor.set_data("stale");
+
+  std::vector<unsigned char> frame = makeFrame(64u * 48u * 3u, 1u);
+  ASSERT_TRUE(writer.Write(frame.data(), frame.size(), descriptor));
+  EXPECT_TRUE(descriptor.data().empty());
+  EXPECT_TRUE(SharedMemoryImageReader::IsDescriptor(descriptor));
+
+  SharedMemoryImageReader reader;
+  msgs::Image image;
+  ASSERT_TRUE(reader.Read(descriptor, image));
+  EXPECT_EQ(64u, image.width());
+  EXPECT_EQ(48u, image.height());
+  EXPECT_EQ(64u * 3u, image.step());
+  ASSERT_EQ(frame.size(), image.data().size());
+  EXPECT_EQ(0, std::memcmp(frame.data(), image.data().data(), frame.size()));
+
+  // Read into a caller owned buffer
+  std::vector<unsigned char> out(frame.size());
+  EXPECT_EQ(frame.size(), reader.Read(descriptor, out.data(), out.size()));
+  EXPECT_EQ(frame, out);
+  EXPECT_EQ(0u, reader.Read(descriptor, out.data(), out.size() - 1u));
+
+  // Frames larger than a slot are refused
+  std::vector<unsigned char> large(writer.SlotSize() + 1u);
+  msgs::Image largeDescriptor;
+  EXPECT_FALSE(writer.Write(large.data(), large.size(), largeDescriptor));
+
+  // Not a descriptor
+  msgs::Image plain;
+  EXPECT_FALSE(SharedMemoryImageReader::IsDescriptor(plain));
+  EXPECT_FALSE(reader.Read(plain, image));
+}
+
+//////////////////////////////////////////////////
+TEST(SharedMemoryImage_TEST,
+     IGN_UTILS_TEST_DISABLED_ON_WIN32(Overwritten))
+{
+  SharedMemoryImageWriter writer;
+  ASSERT_TRUE(writer.Open(segmentName("overwritten"), 2u, 128u));
+
+  std::vector<msgs::Image> descriptors(3u);
+  for (unsigned int i = 0u; i < descriptors.size(); ++i)
+  {
+    std::vector<unsigned char> frame =
+        makeFrame(128u, static_cast<unsigned char>(i));
+    ASSERT_TRUE(writer.Write(frame.data(), frame.size(), descriptors[i]));
+  }
+
+  // The first frame's slot was reused by the third frame
+  SharedMemoryImageReader reader;
+  msgs::Image image;
+  EXPECT_FALSE(reader.Read(descriptors[0], image));
+  EXPECT_TRUE(reader.Read(descriptors[1], image));
+  EXPECT_EQ(makeFrame(128u, 1u),
+      std::vector<unsigned char>(image.data().begin(), image.data().end()));
+  EXPECT_TRUE(reader.Read(descriptors[2], image));
+  EXPECT_EQ(makeFrame(128u, 2u),
+      std::vector<unsigned char>(image.data().begin(), image.data().end()));
+}
+
+//////////////////////////////////////////////////
+TEST(SharedMemoryImage_TEST,
+     IGN_UTILS_TEST_DISABLED_ON_WIN32(Reopen))
+{
+  const std::string name = segmentName("reopen");
+  SharedMemoryImageWriter writer;
+  ASSERT_TRUE(writer.Open(name, 2u, 16u));
+
+  msgs::Image descriptor;
+  std::vector<unsigned char> small = makeFrame(16u, 3u);
+  ASSERT_TRUE(writer.Write(small.data(), small.size(), descriptor));
+
+  SharedMemoryImageReader reader;
+  EXPECT_TRUE(reader.Open(name));
+  msgs::Image image;
+  EXPECT_TRUE(reader.Read(descriptor, image));
+
+  // The writer grows the segment, the reader follows the larger frame size
+  ASSERT_TRUE(writer.Open(name, 2u, 1024u));
+  std::vector<unsigned char> large = makeFrame(1024u, 4u);
+  ASSERT_TRUE(writer.Write(large.data(), large.size(), descriptor));
+  ASSERT_TRUE(reader.Read(descriptor, image));
+  EXPECT_EQ(large,
+      std::vector<unsigned char>(image.data().begin(), image.data().end()));
+
+  writer.Close();
+  EXPECT_FALSE(writer.IsOpen());
+  SharedMemoryImageReader other;
+  EXPECT_FALSE(other.Open(name));
+}
+
+//////////////////////////////////////////////////
+TEST(SharedMemoryImage_TEST,
+     IGN_UTILS_TEST_DISABLED_ON_WIN32(Restart))
+{
+  const std::string name = segmentName("restart");
+  SharedMemoryImageReader reader;
+  msgs::Image descriptor;
+  msgs::Image image;
+  {
+    SharedMemoryImageWriter writer;
+    ASSERT_TRUE(writer.Open(name, 2u, 16u));
+    std::vector<unsigned char> frame = makeFrame(16u, 5u);
+    ASSERT_TRUE(writer.Write(frame.data(), frame.size(), descriptor));
+    ASSERT_TRUE(reader.Read(descriptor, image));
+  }
+
+  // A new writer with the same name and size restarts the sequence, the
+  // reader maps the new segment instead of reading the old one
+  SharedMemoryImageWriter writer;
+  ASSERT_TRUE(writer.Open(name, 2u, 16u));
+  std::vector<unsigned char> frame = makeFrame(16u, 6u);
+  ASSERT_TRUE(writer.Write(frame.data(), frame.size(), descriptor));
+  ASSERT_TRUE(reader.Read(descriptor, image));
+  EXPECT_EQ(frame,
+      std::vector<unsigned char>(image.data().begin(), image.data().end()));
+}
+
+//////////////////////////////////////////////////
+TEST(SharedMemoryImage_TEST,
+     IGN_UTILS_TEST_DISABLED_ON_WIN32(InUse))
+{
+  const std::string name = segmentName("in_use");
+  SharedMemoryImageWriter writer;
+  ASSERT_TRUE(writer.Open(name, 2u, 16u));
+
+  // The segment of a running writer is neither replaced nor removed
+  {
+    SharedMemoryImageWriter other;
+    EXPECT_FALSE(other.Open(name, 2u, 16u));
+  }
+
+  msgs::Image descriptor;
+  std::vector<unsigned char> frame = makeFrame(16u, 7u);
+  ASSERT_TRUE(writer.Write(frame.data(), frame.size(), descriptor));
+  SharedMemoryImageReader reader;
+  msgs::Image image;
+  EXPECT_TRUE(reader.Read(descriptor, image));
+}
+
+#ifndef _WIN32
+//////////////////////////////////////////////////
+TEST(SharedMemoryImage_TEST, Abandoned)
+{
+  // A writer process that exits without closing leaves its segment behind
+  const std::string name = segmentName("abandoned");
+  pid_t pid = fork();
+  ASSERT_GE(pid, 0);
+  if (pid == 0)
+  {
+    SharedMemoryImageWriter writer;
+    _exit(writer.Open(name, 2u, 16u) ? 0 : 1);
+  }
+  int status = 0;
+  ASSERT_EQ(pid, waitpid(pid, &status, 0));
+  ASSERT_TRUE(WIFEXITED(status));
+  ASSERT_EQ(0, WEXITSTATUS(status));
+
+  SharedMemoryImageReader reader;
+  EXPECT_TRUE(reader.Open(name));
+
+  SharedMemoryImageWriter writer;
+  EXPECT_TRUE(writer.Open(name, 2u, 16u));
+}
+#endif
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
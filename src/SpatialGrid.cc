@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpatialGrid.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Bits per axis of a cell key.
+  const unsigned int kBits = 21u;
+
+  /// \brief Bias making cell coordinates non negative.
+  const std::int64_t kBias = std::int64_t{1} << (kBits - 1u);
+
+  /// \brief Mask of one axis of a cell key.
+  const std::uint64_t kMask = (std::uint64_t{1} << kBits) - 1u;
+}
+
+//////////////////////////////////////////////////
+void SpatialGrid::SetCellSize(double _size)
+{
+  if (!(_size > 0.0) || !std::isfinite(_size))
+    return;
+  this->cellSize = _size;
+  this->Clear();
+}
+
+//////////////////////////////////////////////////
+double SpatialGrid::CellSize() const
+{
+  return this->cellSize;
+}
+
+//////////////////////////////////////////////////
+void SpatialGrid::Clear()
+{
+  this->cells.clear();
+}
+
+//////////////////////////////////////////////////
+void SpatialGrid::Insert(std::uint32_t _index,
+    const math::Vector3d &_position)
+{
+  this->cells[this->PositionKey(_position)].push_back(_index);
+}
+
+//////////////////////////////////////////////////
+void SpatialGrid::Move(std::uint32_t _index, const math::Vector3d &_from,
+    const math::Vector3d &_to)
+{
+  const Key from = this->PositionKey(_from);
+  const Key to = this->PositionKey(_to);
+  if (from == to)
+    return;
+
+  auto cell = this->cells.find(from);
+  if (cell != this->cells.end())
+  {
+    auto &indices = cell->second;
+    auto it = std::find(indices.begin(), indices.end(), _index);
+    if (it != indices.end())
+    {
+      *it = indices.back();
+      indices.pop_back();
+    }
+    if (indices.empty())
+      this->cells.erase(cell);
+  }
+  this->cells[to].push_back(_index);
+}
+
+//////////////////////////////////////////////////
+void SpatialGrid::Query(const math::Vector3d &_min,
+    const math::Vector3d &_max, std::vector<std::uint32_t> &_indices) const
+{
+  _indices.clear();
+  const std::int64_t minX = this->Coordinate(_min.X());
+  const std::int64_t minY = this->Coordinate(_min.Y());
+  const std::int64_t minZ = this->Coordinate(_min.Z());
+  const std::int64_t maxX = this->Coordinate(_max.X());
+  const std::int64_t maxY = this->Coordinate(_max.Y());
+  const std::int64_t maxZ = this->Coordinate(_max.Z());
+  if (minX > maxX || minY > maxY || minZ > maxZ)
+    return;
+
+  // A box spanning more cells than are occupied, such as the box of a far
+  // reaching frustum, is cheaper to test against the occupied cells
+  const double spanned = static_cast<double>(maxX - minX + 1) *
+      static_cast<double>(maxY - minY + 1) *
+      static_cast<double>(maxZ - minZ + 1);
+  if (spanned > static_cast<double>(this->cells.size()))
+  {
+    for (const auto &cell : this->cells)
+    {
+      const std::int64_t x =
+          static_cast<std::int64_t>(cell.first & kMask) - kBias;
+      const std::int64_t y =
+          static_cast<std::int64_t>((cell.first >> kBits) & kMask) - kBias;
+      const std::int64_t z =
+          static_cast<std::int64_t>(cell.first >> (2u * kBits)) - kBias;
+      if (x >= minX && x <= maxX && y >= minY && y <= maxY &&
+          z >= minZ && z <= maxZ)
+      {
+        _indices.insert(_indices.end(), cell.second.begin(),
+            cell.second.end());
+      }
+    }
+    return;
+  }
+
+  for (std::int64_t z = minZ; z <= maxZ; ++z)
+  {
+    for (std::int64_t y = minY; y <= maxY; ++y)
+    {
+      for (std::int64_t x = minX; x <= maxX; ++x)
+      {
+        auto cell = this->cells.find(CellKey(x, y, z));
+        if (cell != this->cells.end())
+        {
+          _indices.insert(_indices.end(), cell->second.begin(),
+              cell->second.end());
+        }
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+std::size_t SpatialGrid::CellCount() const
+{
+  return this->cells.size();
+}
+
+//////////////////////////////////////////////////
+std::int64_t SpatialGrid::Coordinate(double _value) const
+{
+  // Positions beyond the grid, and NaN, share the border cells
+  const double cell = std::floor(_value / this->cellSize);
+  if (!(cell > static_cast<double>(-kBias)))
+    return -kBias;
+  if (cell > static_cast<double>(kBias - 1))
+    return kBias - 1;
+  return static_cast<std::int64_t>(cell);
+}
+
+//////////////////////////////////////////////////
+SpatialGrid::Key SpatialGrid::CellKey(std::int64_t _x, std::int64_t _y,
+    std::int64_t _z)
+{
+  return static_cast<Key>(_x + kBias) |
+      (static_cast<Key>(_y + kBias) << kBits) |
+      (static_cast<Key>(_z + kBias) << (2u * kBits));
+}
+
+//////////////////////////////////////////////////
+SpatialGrid::Key SpatialGrid::PositionKey(
+    const math::Vector3d &_position) const
+{
+  return CellKey(this->Coordinate(_position.X()),
+      this->Coordinate(_position.Y()), this->Coordinate(_position.Z()));
+}
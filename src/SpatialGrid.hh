@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_SPATIALGRID_HH_
+#define GZ_SENSORS_SPATIALGRID_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <gz/math/Vector3.hh>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define SpatialGrid_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define SpatialGrid_EXPORTS_API __declspec(dllexport)
+#  else
+#    define SpatialGrid_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief A uniform grid of points, identified by index, for finding the
+    /// points within a box without testing all of them. The
+    /// LogicalCameraSensor class uses this to cull models outside its
+    /// frustum.
+    ///
+    /// Only occupied cells are stored, in a hash map, so the grid has no
+    /// bounds. Points are moved between cells as they move, which leaves
+    /// the other cells untouched.
+    class SpatialGrid_EXPORTS_API SpatialGrid
+    {
+      /// \brief Set the size of the cells, which removes all points.
+      /// \param[in] _size Cell edge length, in meters. Values that are not
+      /// positive and finite are ignored.
+      public: void SetCellSize(double _size);
+
+      /// \brief Get the size of the cells.
+      /// \return Cell edge length, in meters.
+      public: double CellSize() const;
+
+      /// \brief Remove all points.
+      public: void Clear();
+
+      /// \brief Add a point.
+      /// \param[in] _index Point index, unique within the grid.
+      /// \param[in] _position Point position.
+      public: void Insert(std::uint32_t _index,
+          const math::Vector3d &_position);
+
+      /// \brief Move a point.
+      /// \param[in] _index Point index.
+      /// \param[in] _from Position the point was inserted or last moved at.
+      /// \param[in] _to New position.
+      public: void Move(std::uint32_t _index, const math::Vector3d &_from,
+          const math::Vector3d &_to);
+
+      /// \brief Get the points in the cells overlapping a box. This is a
+      /// superset of the points within the box, the caller tests them.
+      /// \param[in] _min Box minimum corner.
+      /// \param[in] _max Box maximum corner.
+      /// \param[out] _indices Point indices, in no particular order.
+      public: void Query(const math::Vector3d &_min,
+          const math::Vector3d &_max,
+          std::vector<std::uint32_t> &_indices) const;
+
+      /// \brief Get the number of occupied cells.
+      /// \return Number of cells.
+      public: std::size_t CellCount() const;
+
+      /// \brief Cell coordinates packed in one key, 21 bits per axis.
+      private: using Key = std::uint64_t;
+
+      /// \brief Get the cell coordinate of a position along one axis.
+      /// \param[in] _value Position along the axis.
+      /// \return Cell coordinate, clamped to 21 bits.
+      private: std::int64_t Coordinate(double _value) const;
+
+      /// \brief Get the key of a cell.
+      /// \param[in] _x Cell coordinate along x.
+      /// \param[in] _y Cell coordinate along y.
+      /// \param[in] _z Cell coordinate along z.
+      /// \return Key.
+      private: static Key CellKey(std::int64_t _x, std::int64_t _y,
+          std::int64_t _z);
+
+      /// \brief Get the key of the cell holding a position.
+      /// \param[in] _position Position.
+      /// \return Key.
+      private: Key PositionKey(const math::Vector3d &_position) const;
+
+      /// \brief Cell edge length.
+      private: double cellSize = 1.0;
+
+      /// \brief Point indices of each occupied cell.
+      private: std::unordered_map<Key, std::vector<std::uint32_t>> cells;
+    };
+    }
+  }
+}
+
+#endif
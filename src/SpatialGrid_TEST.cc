@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "SpatialGrid.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Check that a query returns every point within a box, once.
+  void expectWithin(const SpatialGrid &_grid,
+      const std::vector<math::Vector3d> &_points,
+      const math::Vector3d &_min, const math::Vector3d &_max)
+  {
+    std::vector<std::uint32_t> indices;
+    _grid.Query(_min, _max, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_TRUE(std::adjacent_find(indices.begin(), indices.end()) ==
+        indices.end());
+    for (std::uint32_t i = 0; i < _points.size(); ++i)
+    {
+      const math::Vector3d &p = _points[i];
+      if (p.X() >= _min.X() && p.Y() >= _min.Y() && p.Z() >= _min.Z() &&
+          p.X() <= _max.X() && p.Y() <= _max.Y() && p.Z() <= _max.Z())
+      {
+        EXPECT_TRUE(std::binary_search(indices.begin(), indices.end(), i))
+            << i;
+      }
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SpatialGrid_TEST, InsertQuery)
+{
+  SpatialGrid grid;
+  grid.SetCellSize(2.0);
+  EXPECT_DOUBLE_EQ(2.0, grid.CellSize());
+  grid.SetCellSize(-1.0);
+  EXPECT_DOUBLE_EQ(2.0, grid.CellSize());
+
+  grid.Insert(0u, {0.5, 0.5, 0.5});
+  grid.Insert(1u, {1.5, 1.0, 0.0});
+  grid.Insert(2u, {-0.5, 0.5, 0.5});
+  grid.Insert(3u, {100.0, 0.0, 0.0});
+  EXPECT_EQ(3u, grid.CellCount());
+
+  // Points of the same cell come together, the far one is not returned
+  std::vector<std::uint32_t> indices;
+  grid.Query({0.1, 0.1, 0.1}, {0.2, 0.2, 0.2}, indices);
+  std::sort(indices.begin(), indices.end());
+  EXPECT_EQ(std::vector<std::uint32_t>({0u, 1u}), indices);
+
+  grid.Query({-1.0, 0.0, 0.0}, {1.0, 1.0, 1.0}, indices);
+  EXPECT_EQ(3u, indices.size());
+
+  // An empty box returns nothing
+  grid.Query({1.0, 1.0, 1.0}, {-1.0, -1.0, -1.0}, indices);
+  EXPECT_TRUE(indices.empty());
+
+  grid.Clear();
+  EXPECT_EQ(0u, grid.CellCount());
+  grid.Query({-1e9, -1e9, -1e9}, {1e9, 1e9, 1e9}, indices);
+  EXPECT_TRUE(indices.empty());
+}
+
+//////////////////////////////////////////////////
+TEST(SpatialGrid_TEST, MoveMatchesBruteForce)
+{
+  SpatialGrid grid;
+  grid.SetCellSize(5.0);
+
+  // Points on a lattice, some of them outside the grid's range
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 500; ++i)
+  {
+    points.emplace_back((i * 37 % 101) - 50.0, (i * 53 % 89) - 44.0,
+        (i % 7) * 0.5);
+  }
+  points.push_back({1e12, -1e12, 0.0});
+  for (std::uint32_t i = 0; i < points.size(); ++i)
+    grid.Insert(i, points[i]);
+
+  const math::Vector3d boxes[][2] =
+  {
+    {{-10.0, -10.0, 0.0}, {10.0, 10.0, 1.0}},
+    {{-50.0, -44.0, 0.0}, {-45.0, -40.0, 3.0}},
+    {{0.0, 0.0, -1.0}, {0.0, 0.0, 1.0}},
+    {{-1e13, -1e13, -1e13}, {1e13, 1e13, 1e13}}
+  };
+  for (const auto &box : boxes)
+    expectWithin(grid, points, box[0], box[1]);
+
+  // Move every point, across cells for most of them
+  for (std::uint32_t i = 0; i < points.size(); ++i)
+  {
+    const math::Vector3d to = points[i] + math::Vector3d(
+        (i % 5) * 3.0, -(i % 3) * 4.0, 0.25);
+    grid.Move(i, points[i], to);
+    points[i] = to;
+  }
+  for (const auto &box : boxes)
+    expectWithin(grid, points, box[0], box[1]);
+
+  std::vector<std::uint32_t> indices;
+  grid.Query({-1e13, -1e13, -1e13}, {1e13, 1e13, 1e13}, indices);
+  EXPECT_EQ(points.size(), indices.size());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
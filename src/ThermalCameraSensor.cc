@@ -21,12 +21,14 @@
   #pragma warning(disable: 4251)
 #endif
 #include <gz/msgs/image.pb.h>
+#include <gz/msgs/param.pb.h>
 #if defined(_MSC_VER)
   #pragma warning(pop)
 #endif
 
 #include <algorithm>
 #include <mutex>
+#include <sstream>
 
 #include <gz/common/Console.hh>
 #include <gz/common/Image.hh>
@@ -43,6 +45,11 @@
 #include "gz/sensors/RenderingEvents.hh"
 #include "gz/sensors/SensorFactory.hh"
 
+#include "FrameBufferPool.hh"
+#include "ImageSaver.hh"
+#include "ThermalImageConversion.hh"
+#include "ThermalStatistics.hh"
+
 /// \brief Private data for ThermalCameraSensor
 class gz::sensors::ThermalCameraSensorPrivate
 {
@@ -51,20 +58,26 @@ class gz::sensors::ThermalCameraSensorPrivate
   /// \param[in] _width width of image in pixels
   /// \param[in] _height height of image in pixels
   /// \param[in] _format The format the data is in
-  /// \return True if the image was saved successfully. False can mean
+  /// \return True if the image was queued for saving. False can mean
   /// that the path provided to the constructor does exist and creation
-  /// of the path was not possible.
+  /// of the path was not possible, or that the frame was dropped.
   /// \sa ImageSaver
   public: bool SaveImage(const uint16_t *_data, unsigned int _width,
     unsigned int _height, gz::common::Image::PixelFormatType _format);
 
-  /// \brief Helper function to convert temperature data to thermal image
-  /// \param[in] _data temperature data
-  /// \param[out] _imageBuffer resulting thermal image data
-  /// \param[in] _width width of image
-  /// \param[in] _height height of image
-  public: bool ConvertTemperatureToImage(const uint16_t *_data,
-    unsigned char *_imageBuffer, unsigned int _width, unsigned int _height);
+  /// \brief Convert the temperature window to the units of the linear
+  /// resolution and pass it to the conversion.
+  public: void UpdateWindow();
+
+  /// \brief Compute the statistics of a thermal image and publish them.
+  /// \param[in] _data Thermal image.
+  /// \param[in] _width Image width in pixels.
+  /// \param[in] _height Image height in pixels.
+  /// \param[in] _now Time stamp of the image.
+  /// \param[in] _frameId Frame id of the image.
+  public: void PublishStatistics(const uint16_t *_data, unsigned int _width,
+      unsigned int _height, const std::chrono::steady_clock::duration &_now,
+      const std::string &_frameId);
 
   /// \brief node to create publisher
   public: transport::Node node;
@@ -75,18 +88,12 @@ class gz::sensors::ThermalCameraSensorPrivate
   /// \brief Rendering camera
   public: gz::rendering::ThermalCameraPtr thermalCamera;
 
-  /// \brief Thermal data buffer.
-  public: uint16_t *thermalBuffer = nullptr;
+  /// \brief Thermal data buffer, resized to follow the image size.
+  public: FrameBuffer thermalBuffer;
 
   /// \brief Thermal data buffer 8 bit.
-  public: unsigned char *thermalBuffer8Bit = nullptr;
+  public: FrameBuffer thermalBuffer8Bit;
 
-  /// \brief Thermal data buffer used when saving image.
-  public: unsigned char *imgThermalBuffer = nullptr;
-
-  /// \brief Thermal data buffer used when saving image.
-  public: math::Vector2i imgThermalBufferSize =
-      math::Vector2i::Zero;
 
   /// \brief Pointer to an image to be published
   public: gz::rendering::Image image;
@@ -120,6 +127,9 @@ class gz::sensors::ThermalCameraSensorPrivate
   /// \brief counter used to set the image filename
   public: std::uint64_t saveImageCounter = 0;
 
+  /// \brief Save policy and file format
+  public: ImageSaver::Options saveOptions;
+
   /// \brief SDF Sensor DOM object.
   public: sdf::Sensor sdfSensor;
 
@@ -129,6 +139,25 @@ class gz::sensors::ThermalCameraSensorPrivate
   /// \brief publisher to publish thermal image
   public: transport::Node::Publisher thermalPub;
 
+  /// \brief Publisher of false color images, only advertised when a
+  /// palette is configured.
+  public: transport::Node::Publisher palettePub;
+
+  /// \brief False color image message.
+  public: msgs::Image paletteMsg;
+
+  /// \brief False color image buffer, resized to follow the image size.
+  public: FrameBuffer paletteBuffer;
+
+  /// \brief Publisher of image statistics, only advertised when enabled.
+  public: transport::Node::Publisher statisticsPub;
+
+  /// \brief Image statistics message.
+  public: msgs::Param statisticsMsg;
+
+  /// \brief Computes the image statistics.
+  public: ThermalStatistics statistics;
+
   /// \brief Ambient temperature of the environment
   public: float ambient = 0.0;
 
@@ -143,6 +172,16 @@ class gz::sensors::ThermalCameraSensorPrivate
 
   /// \brief Linear resolution. Defaults to 10mK
   public: float resolution = 0.01f;
+
+  /// \brief Conversion of thermal images to 8 bits, for 8 bit cameras and
+  /// for viewing.
+  public: ThermalImageConversion conversion;
+
+  /// \brief Temperature mapped to black by the window mapping, in kelvin.
+  public: double windowLow = 253.15;
+
+  /// \brief Temperature mapped to white by the window mapping, in kelvin.
+  public: double windowHigh = 373.15;
 };
 
 using namespace gz;
@@ -158,14 +197,10 @@ ThermalCameraSensor::ThermalCameraSensor()
 ThermalCameraSensor::~ThermalCameraSensor()
 {
   this->dataPtr->thermalConnection.reset();
-  if (this->dataPtr->thermalBuffer)
-    delete [] this->dataPtr->thermalBuffer;
 
-  if (this->dataPtr->thermalBuffer8Bit)
-    delete[] this->dataPtr->thermalBuffer8Bit;
-
-  if (this->dataPtr->imgThermalBuffer)
-    delete[] this->dataPtr->imgThermalBuffer;
+  // Make sure the last frames are on disk before the sensor goes away
+  if (this->dataPtr->saveImage)
+    ImageSaver::Instance().Finish(this->dataPtr->saveOptions);
 }
 
 //////////////////////////////////////////////////
@@ -225,6 +260,91 @@ bool ThermalCameraSensor::Load(const sdf::Sensor &_sdf)
 
   if (!this->AdvertiseInfo())
     return false;
+  this->LoadInfoRate(_sdf.CameraSensor());
+
+  // False color images are optional, they are published on a sub topic
+  // when a palette is configured
+  sdf::ElementPtr cameraElem = _sdf.CameraSensor()->Element();
+  if (cameraElem && cameraElem->HasElement("ignition:thermal_palette"))
+  {
+    std::string palette =
+        cameraElem->Get<std::string>("ignition:thermal_palette");
+    if (!this->dataPtr->conversion.SetPalette(palette))
+    {
+      ignerr << "Unsupported thermal palette [" << palette << "]. "
+             << "Supported palettes are white_hot, black_hot, ironbow and "
+             << "rainbow." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->palettePub =
+          this->dataPtr->node.Advertise<msgs::Image>(
+              this->Topic() + "/palette");
+      if (!this->dataPtr->palettePub)
+      {
+        ignerr << "Unable to create publisher on topic["
+          << this->Topic() + "/palette" << "].\n";
+        return false;
+      }
+
+      igndbg << "False color images for [" << this->Name()
+             << "] advertised on [" << this->Topic() << "/palette]"
+             << std::endl;
+    }
+  }
+
+  // Statistics are optional too: the temperature range, the hottest
+  // pixels and, with a grid given as "columns rows", the hottest
+  // temperature of each cell
+  if (cameraElem && cameraElem->HasElement("ignition:thermal_statistics") &&
+      cameraElem->Get<bool>("ignition:thermal_statistics"))
+  {
+    if (cameraElem->HasElement("ignition:thermal_hotspots"))
+    {
+      int hotspots = cameraElem->Get<int>("ignition:thermal_hotspots");
+      if (hotspots < 0)
+      {
+        ignerr << "<ignition:thermal_hotspots> must not be negative."
+               << std::endl;
+      }
+      else
+      {
+        this->dataPtr->statistics.SetHotspotCount(
+            static_cast<unsigned int>(hotspots));
+      }
+    }
+    if (cameraElem->HasElement("ignition:thermal_grid"))
+    {
+      std::istringstream grid(
+          cameraElem->Get<std::string>("ignition:thermal_grid"));
+      int columns = 0;
+      int rows = 0;
+      if (!(grid >> columns >> rows) || columns <= 0 || rows <= 0)
+      {
+        ignerr << "<ignition:thermal_grid> must hold a positive number of "
+               << "columns and rows." << std::endl;
+      }
+      else
+      {
+        this->dataPtr->statistics.SetGrid(static_cast<unsigned int>(columns),
+            static_cast<unsigned int>(rows));
+      }
+    }
+
+    this->dataPtr->statisticsPub =
+        this->dataPtr->node.Advertise<msgs::Param>(
+            this->Topic() + "/statistics");
+    if (!this->dataPtr->statisticsPub)
+    {
+      ignerr << "Unable to create publisher on topic["
+        << this->Topic() + "/statistics" << "].\n";
+      return false;
+    }
+
+    igndbg << "Thermal statistics for [" << this->Name()
+           << "] advertised on [" << this->Topic() << "/statistics]"
+           << std::endl;
+  }
 
   if (this->Scene())
   {
@@ -340,6 +460,39 @@ bool ThermalCameraSensor::CreateCamera()
   // This->dataPtr->distortion.reset(new Distortion());
   // This->dataPtr->distortion->Load(this->sdf->GetElement("distortion"));
 
+  // How temperatures are stretched over 8 bits for viewing. The window is
+  // given in kelvin as "low high".
+  sdf::ElementPtr cameraElem = cameraSdf->Element();
+  if (cameraElem && cameraElem->HasElement("ignition:thermal_mapping"))
+  {
+    std::string mapping =
+        cameraElem->Get<std::string>("ignition:thermal_mapping");
+    if (!this->dataPtr->conversion.SetMapping(mapping))
+    {
+      ignerr << "Unsupported thermal mapping [" << mapping << "]. "
+             << "Supported mappings are linear, window and histogram."
+             << std::endl;
+    }
+  }
+  if (cameraElem && cameraElem->HasElement("ignition:thermal_window"))
+  {
+    std::istringstream window(
+        cameraElem->Get<std::string>("ignition:thermal_window"));
+    double low = 0.0;
+    double high = 0.0;
+    if (!(window >> low >> high) || !(high > low) || low < 0.0)
+    {
+      ignerr << "<ignition:thermal_window> must hold a low and a high "
+             << "temperature in kelvin, with low < high." << std::endl;
+    }
+    else
+    {
+      this->dataPtr->windowLow = low;
+      this->dataPtr->windowHigh = high;
+    }
+  }
+  this->dataPtr->UpdateWindow();
+
   this->Scene()->RootVisual()->AddChild(this->dataPtr->thermalCamera);
 
   // Create the directory to store frames
@@ -348,6 +501,8 @@ bool ThermalCameraSensor::CreateCamera()
     this->dataPtr->saveImagePath = cameraSdf->SaveFramesPath();
     this->dataPtr->saveImagePrefix = this->Name() + "_";
     this->dataPtr->saveImage = true;
+    this->dataPtr->saveOptions = ImageSaver::OptionsFromSdf(*cameraSdf,
+        this->Name());
   }
 
   this->dataPtr->thermalConnection =
@@ -370,10 +525,9 @@ void ThermalCameraSensor::OnNewThermalFrame(const uint16_t *_scan,
   unsigned int samples = _width * _height;
   unsigned int thermalBufferSize = samples * sizeof(uint16_t);
 
-  if (!this->dataPtr->thermalBuffer)
-    this->dataPtr->thermalBuffer = new uint16_t[samples];
-
-  memcpy(this->dataPtr->thermalBuffer, _scan, thermalBufferSize);
+  this->dataPtr->thermalBuffer.Resize(thermalBufferSize);
+  memcpy(this->dataPtr->thermalBuffer.Data<uint16_t>(), _scan,
+      thermalBufferSize);
 }
 
 /////////////////////////////////////////////////
@@ -429,16 +583,18 @@ bool ThermalCameraSensor::Update(
   }
 
   // don't render if there are no subscribers
+  const bool paletteConnections = this->dataPtr->palettePub &&
+      this->dataPtr->palettePub.HasConnections();
+  const bool statisticsConnections = this->dataPtr->statisticsPub &&
+      this->dataPtr->statisticsPub.HasConnections();
   if (!this->dataPtr->thermalPub.HasConnections() &&
-      this->dataPtr->imageEvent.ConnectionCount() == 0u)
+      this->dataPtr->imageEvent.ConnectionCount() == 0u &&
+      !paletteConnections && !statisticsConnections)
     return false;
 
   // generate sensor data - this triggers image callback
   this->Render();
 
-  if (!this->dataPtr->thermalBuffer)
-    return false;
-
   unsigned int width = this->dataPtr->thermalCamera->ImageWidth();
   unsigned int height = this->dataPtr->thermalCamera->ImageHeight();
 
@@ -468,25 +624,28 @@ bool ThermalCameraSensor::Update(
 
   std::lock_guard<std::mutex> lock(this->dataPtr->mutex);
 
+  // the last frame may be missing or have a stale size if the resolution
+  // just changed
+  if (this->dataPtr->thermalBuffer.Size() != width * height * sizeof(uint16_t))
+    return false;
+  const uint16_t *thermalBuffer = this->dataPtr->thermalBuffer.Data<uint16_t>();
+
   // \todo(anyone) once ign-rendering supports an image event with unsigned char
   // data type, we can remove this check that copies uint16_t data to char array
   if (this->dataPtr->thermalCamera->ImageFormat() == rendering::PF_L8)
   {
     unsigned int len = width * height;
-    if (!this->dataPtr->thermalBuffer8Bit)
-      this->dataPtr->thermalBuffer8Bit = new unsigned char[len];
-    for (unsigned int i = 0; i < len; ++i)
-    {
-      this->dataPtr->thermalBuffer8Bit[i] =
-          static_cast<uint8_t>(this->dataPtr->thermalBuffer[i]);
-    }
-    this->dataPtr->thermalMsg.set_data(this->dataPtr->thermalBuffer8Bit,
+    this->dataPtr->thermalBuffer8Bit.Resize(len);
+    unsigned char *thermalBuffer8Bit =
+        this->dataPtr->thermalBuffer8Bit.Data<unsigned char>();
+    ThermalImageConversion::Narrow(thermalBuffer, len, thermalBuffer8Bit);
+    this->dataPtr->thermalMsg.set_data(thermalBuffer8Bit,
         rendering::PixelUtil::MemorySize(renderingFormat,
         width, height));
   }
   else
   {
-    this->dataPtr->thermalMsg.set_data(this->dataPtr->thermalBuffer,
+    this->dataPtr->thermalMsg.set_data(thermalBuffer,
         rendering::PixelUtil::MemorySize(renderingFormat,
         width, height));
   }
@@ -504,10 +663,41 @@ bool ThermalCameraSensor::Update(
     ignerr << "Exception thrown in an image callback.\n";
   }
 
+  // False color image, only computed for subscribers
+  if (paletteConnections)
+  {
+    const unsigned int samples = width * height;
+    this->dataPtr->paletteBuffer.Resize(samples * 3u);
+    unsigned char *paletteBuffer =
+        this->dataPtr->paletteBuffer.Data<unsigned char>();
+    this->dataPtr->conversion.ToPalette(thermalBuffer, samples,
+        paletteBuffer);
+
+    msgs::Image &paletteMsg = this->dataPtr->paletteMsg;
+    paletteMsg.set_width(width);
+    paletteMsg.set_height(height);
+    paletteMsg.set_step(width * 3u);
+    paletteMsg.set_pixel_format_type(msgs::PixelFormatType::RGB_INT8);
+    paletteMsg.mutable_header()->Clear();
+    *paletteMsg.mutable_header()->mutable_stamp() = msgs::Convert(_now);
+    auto paletteFrame = paletteMsg.mutable_header()->add_data();
+    paletteFrame->set_key("frame_id");
+    paletteFrame->add_value(this->FrameId());
+    paletteMsg.set_data(paletteBuffer, samples * 3u);
+    this->dataPtr->palettePub.Publish(paletteMsg);
+  }
+
+  // Statistics, only computed for subscribers
+  if (statisticsConnections)
+  {
+    this->dataPtr->PublishStatistics(thermalBuffer, width, height, _now,
+        this->FrameId());
+  }
+
   // Save image
   if (this->dataPtr->saveImage)
   {
-    this->dataPtr->SaveImage(this->dataPtr->thermalBuffer, width, height,
+    this->dataPtr->SaveImage(thermalBuffer, width, height,
         commonFormat);
   }
 
@@ -580,39 +770,89 @@ void ThermalCameraSensor::SetLinearResolution(float _resolution)
     this->dataPtr->thermalCamera->SetLinearResolution(
         this->dataPtr->resolution);
   }
+  this->dataPtr->UpdateWindow();
 }
 
 //////////////////////////////////////////////////
-bool ThermalCameraSensorPrivate::ConvertTemperatureToImage(
-    const uint16_t *_data,
-    unsigned char *_imageBuffer,
-    unsigned int _width, unsigned int _height)
+void ThermalCameraSensorPrivate::UpdateWindow()
+{
+  if (this->resolution <= 0.0f)
+    return;
+
+  auto toValue = [this](double _kelvin)
+  {
+    return static_cast<std::uint16_t>(
+        std::min(65535.0, std::max(0.0, _kelvin / this->resolution)));
+  };
+  this->conversion.SetWindow(toValue(this->windowLow),
+      toValue(this->windowHigh));
+}
+
+//////////////////////////////////////////////////
+void ThermalCameraSensorPrivate::PublishStatistics(const uint16_t *_data,
+    unsigned int _width, unsigned int _height,
+    const std::chrono::steady_clock::duration &_now,
+    const std::string &_frameId)
 {
-  // get min and max of temperature values
-  const auto [min, max] = // NOLINT
-      std::minmax_element(&_data[0], &_data[_height * _width]);
+  if (!this->statistics.Compute(_data, _width, _height))
+    return;
 
-  // convert temperature to grayscale image
-  double range = static_cast<double>(max - min);
-  if (math::equal(range, 0.0))
-    range = 1.0;
-  for (unsigned int i = 0; i < _height; ++i)
+  const double resolution = this->resolution;
+  auto setInt = [](msgs::Param &_param, const std::string &_key, int _value)
   {
-    for (unsigned int j = 0; j < _width; ++j)
+    msgs::Any &any = (*_param.mutable_params())[_key];
+    any.set_type(msgs::Any::INT32);
+    any.set_int_value(_value);
+  };
+  auto setKelvin = [resolution](msgs::Param &_param, const std::string &_key,
+      double _value)
+  {
+    msgs::Any &any = (*_param.mutable_params())[_key];
+    any.set_type(msgs::Any::DOUBLE);
+    any.set_double_value(_value * resolution);
+  };
+
+  // Temperatures are in kelvin. Each hotspot is a child with its pixel
+  // coordinates, hottest first, and cell maxima are "cell_<row>_<column>"
+  msgs::Param &msg = this->statisticsMsg;
+  msg.Clear();
+  *msg.mutable_header()->mutable_stamp() = msgs::Convert(_now);
+  auto frame = msg.mutable_header()->add_data();
+  frame->set_key("frame_id");
+  frame->add_value(_frameId);
+
+  setInt(msg, "width", static_cast<int>(_width));
+  setInt(msg, "height", static_cast<int>(_height));
+  setKelvin(msg, "min", this->statistics.Min());
+  setKelvin(msg, "max", this->statistics.Max());
+  setKelvin(msg, "mean", this->statistics.Mean());
+
+  for (const auto &spot : this->statistics.Hotspots())
+  {
+    msgs::Param *child = msg.add_children();
+    setInt(*child, "u", static_cast<int>(spot.u));
+    setInt(*child, "v", static_cast<int>(spot.v));
+    setKelvin(*child, "temperature", spot.value);
+  }
+
+  const unsigned int columns = this->statistics.GridColumns();
+  const unsigned int rows = this->statistics.GridRows();
+  if (columns > 0u && rows > 0u)
+  {
+    setInt(msg, "grid_columns", static_cast<int>(columns));
+    setInt(msg, "grid_rows", static_cast<int>(rows));
+    const auto &grid = this->statistics.Grid();
+    for (unsigned int r = 0; r < rows; ++r)
     {
-      uint16_t temp = _data[i*_width + j];
-      double t = static_cast<double>(temp-*min) / range;
-      int r = static_cast<int>(255*t);
-      int g = r;
-      int b = r;
-      int index = i*_width*3 + j*3;
-      _imageBuffer[index] = r;
-      _imageBuffer[index+1] = g;
-      _imageBuffer[index+2] = b;
+      for (unsigned int c = 0; c < columns; ++c)
+      {
+        setKelvin(msg, "cell_" + std::to_string(r) + "_" + std::to_string(c),
+            grid[r * columns + c]);
+      }
     }
   }
 
-  return true;
+  this->statisticsPub.Publish(msg);
 }
 
 //////////////////////////////////////////////////
@@ -620,40 +860,34 @@ bool ThermalCameraSensorPrivate::SaveImage(const uint16_t *_data,
     unsigned int _width, unsigned int _height,
     common::Image::PixelFormatType /*_format*/)
 {
-  // Attempt to create the directory if it doesn't exist
-  if (!common::isDirectory(this->saveImagePath))
-  {
-    if (!common::createDirectories(this->saveImagePath))
-      return false;
-  }
-
   if (_width == 0 || _height == 0)
     return false;
 
-  common::Image localImage;
+  ImageSaver &saver = ImageSaver::Instance();
+
+  std::string filename = this->saveImagePrefix +
+                         std::to_string(this->saveImageCounter);
+  ++this->saveImageCounter;
 
-  if (static_cast<int>(_width) != this->imgThermalBufferSize.X() ||
-      static_cast<int>(_height) != this->imgThermalBufferSize.Y())
+  // Raw dumps keep the temperatures, PNG and QOI get an 8 bit image
+  if (this->saveOptions.format == ImageSaver::FileFormat::RAW ||
+      this->saveOptions.format == ImageSaver::FileFormat::LZ4)
   {
-    delete [] this->imgThermalBuffer;
-    unsigned int bufferSize = _width * _height * 3;
-    this->imgThermalBuffer = new unsigned char[bufferSize];
-    this->imgThermalBufferSize = math::Vector2i(_width, _height);
+    return saver.Save(this->saveImagePath, filename,
+        reinterpret_cast<const unsigned char *>(_data),
+        _width * _height * sizeof(uint16_t), _width, _height,
+        common::Image::L_INT16, this->saveOptions);
   }
 
-  this->ConvertTemperatureToImage(_data, this->imgThermalBuffer,
-      _width, _height);
-
-  std::string filename = this->saveImagePrefix +
-                         std::to_string(this->saveImageCounter) + ".png";
-  ++this->saveImageCounter;
+  // Convert straight into the buffer handed to the saver
+  FrameBuffer imgThermalBuffer = saver.Buffer(_width * _height * 3u);
 
-  localImage.SetFromData(this->imgThermalBuffer, _width, _height,
-      common::Image::RGB_INT8);
-  localImage.SavePNG(
-      common::joinPaths(this->saveImagePath, filename));
+  this->conversion.ToRgb(_data, _width * _height,
+      imgThermalBuffer.Data<unsigned char>());
 
-  return true;
+  return saver.Save(this->saveImagePath, filename,
+      std::move(imgThermalBuffer), _width, _height, common::Image::RGB_INT8,
+      this->saveOptions);
 }
 
 //////////////////////////////////////////////////
@@ -661,6 +895,10 @@ bool ThermalCameraSensor::HasConnections() const
 {
   return (this->dataPtr->thermalPub &&
       this->dataPtr->thermalPub.HasConnections()) ||
+      (this->dataPtr->palettePub &&
+      this->dataPtr->palettePub.HasConnections()) ||
+      (this->dataPtr->statisticsPub &&
+      this->dataPtr->statisticsPub.HasConnections()) ||
       this->dataPtr->imageEvent.ConnectionCount() > 0u ||
       this->HasInfoConnections();
 }
@@ -0,0 +1,421 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#if defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+  #define GZ_SENSORS_THERMAL_SSE2
+#endif
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "ThermalImageConversion.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  /// \brief Mapping names, in ThermalImageConversion::Mapping order.
+  const char *const kMappingNames[] = {"linear", "window", "histogram"};
+
+  /// \brief Palette names, in ThermalImageConversion::Palette order.
+  const char *const kPaletteNames[] =
+      {"white_hot", "black_hot", "ironbow", "rainbow"};
+
+  /// \brief A palette color at a position between 0 and 1.
+  struct ColorStop
+  {
+    /// \brief Position.
+    double position;
+
+    /// \brief Red, green and blue.
+    double rgb[3];
+  };
+
+  /// \brief Ironbow control points.
+  const ColorStop kIronbow[] =
+  {
+    {0.0, {0, 0, 0}},
+    {0.15, {32, 0, 140}},
+    {0.35, {145, 0, 160}},
+    {0.55, {230, 70, 40}},
+    {0.75, {250, 160, 0}},
+    {0.9, {255, 220, 60}},
+    {1.0, {255, 255, 255}}
+  };
+
+  /// \brief Rainbow control points.
+  const ColorStop kRainbow[] =
+  {
+    {0.0, {0, 0, 255}},
+    {0.25, {0, 255, 255}},
+    {0.5, {0, 255, 0}},
+    {0.75, {255, 255, 0}},
+    {1.0, {255, 0, 0}}
+  };
+
+  /// \brief Interpolate control points.
+  /// \param[in] _stops Control points, the first at 0 and the last at 1.
+  /// \param[in] _count Number of control points.
+  /// \param[in] _t Position between 0 and 1.
+  /// \param[out] _rgb Color.
+  void interpolate(const ColorStop *_stops, std::size_t _count, double _t,
+      unsigned char *_rgb)
+  {
+    std::size_t i = 1u;
+    while (i + 1u < _count && _stops[i].position < _t)
+      ++i;
+    const ColorStop &a = _stops[i - 1u];
+    const ColorStop &b = _stops[i];
+    const double s = (_t - a.position) / (b.position - a.position);
+    for (unsigned int c = 0; c < 3u; ++c)
+    {
+      _rgb[c] = static_cast<unsigned char>(
+          std::lround(a.rgb[c] + s * (b.rgb[c] - a.rgb[c])));
+    }
+  }
+
+  /// \brief Look up colors. Each color is copied as a 4 byte word that
+  /// overlaps the next pixel, which the next copy overwrites, so that the
+  /// loop is a plain gather.
+  /// \param[in] _index Table indices.
+  /// \param[in] _count Number of pixels, at least one.
+  /// \param[in] _table Colors, 4 bytes per entry.
+  /// \param[out] _dst RGB8 pixels.
+  template <typename T>
+  void gatherRgb(const T *_index, std::size_t _count,
+      const unsigned char *_table, unsigned char *_dst)
+  {
+    const std::size_t last = _count - 1u;
+    for (std::size_t i = 0; i < last; ++i)
+      std::memcpy(_dst + i * 3u, _table + _index[i] * 4u, 4u);
+    std::memcpy(_dst + last * 3u, _table + _index[last] * 4u, 3u);
+  }
+
+  /// \brief Map values linearly from [_low, _low + _range] to [0, 255],
+  /// clamping values outside. The scale is in 16.16 fixed point and the
+  /// loop has no branches, so that the compiler vectorizes it.
+  /// \param[in] _src Values.
+  /// \param[in] _count Number of values.
+  /// \param[in] _low Value mapped to 0.
+  /// \param[in] _range Values mapped to 0 through 255, at least 1.
+  /// \param[out] _dst Intensities, each written to _Channels bytes.
+  template <unsigned int _Channels>
+  void mapLinear(const std::uint16_t *_src, std::size_t _count,
+      std::int32_t _low, std::int32_t _range, unsigned char *_dst)
+  {
+    const std::uint32_t range = static_cast<std::uint32_t>(_range);
+    const std::uint32_t scale = ((255u << 16) + range / 2u) / range;
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      std::int32_t d = static_cast<std::int32_t>(_src[i]) - _low;
+      d = d < 0 ? 0 : d;
+      d = d > _range ? _range : d;
+      const unsigned char value = static_cast<unsigned char>(
+          (static_cast<std::uint32_t>(d) * scale + 0x8000u) >> 16);
+      for (unsigned int c = 0; c < _Channels; ++c)
+        _dst[i * _Channels + c] = value;
+    }
+  }
+
+  /// \brief Map values through a lookup table indexed from _low.
+  /// \param[in] _src Values, all in the table range.
+  /// \param[in] _count Number of values.
+  /// \param[in] _low Value of the first table entry.
+  /// \param[in] _lookup Lookup table.
+  /// \param[out] _dst Intensities, each written to _Channels bytes.
+  template <unsigned int _Channels>
+  void mapLookup(const std::uint16_t *_src, std::size_t _count,
+      std::uint16_t _low, const unsigned char *_lookup, unsigned char *_dst)
+  {
+    for (std::size_t i = 0; i < _count; ++i)
+    {
+      const unsigned char value = _lookup[_src[i] - _low];
+      for (unsigned int c = 0; c < _Channels; ++c)
+        _dst[i * _Channels + c] = value;
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool ThermalImageConversion::SetMapping(const std::string &_name)
+{
+  for (unsigned int i = 0; i < 3u; ++i)
+  {
+    if (_name == kMappingNames[i])
+    {
+      this->mapping = static_cast<Mapping>(i);
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::SetMapping(Mapping _mapping)
+{
+  this->mapping = _mapping;
+}
+
+//////////////////////////////////////////////////
+ThermalImageConversion::Mapping ThermalImageConversion::MappingType() const
+{
+  return this->mapping;
+}
+
+//////////////////////////////////////////////////
+bool ThermalImageConversion::SetPalette(const std::string &_name)
+{
+  for (unsigned int i = 0; i < 4u; ++i)
+  {
+    if (_name == kPaletteNames[i])
+    {
+      this->SetPalette(static_cast<Palette>(i));
+      return true;
+    }
+  }
+  return false;
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::SetPalette(Palette _palette)
+{
+  this->palette = _palette;
+  this->BuildPalette();
+}
+
+//////////////////////////////////////////////////
+ThermalImageConversion::Palette ThermalImageConversion::PaletteType() const
+{
+  return this->palette;
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::BuildPalette()
+{
+  this->paletteTable.assign(256u * 4u, 0u);
+  for (unsigned int i = 0; i < 256u; ++i)
+  {
+    unsigned char *rgb = this->paletteTable.data() + i * 4u;
+    const double t = i / 255.0;
+    switch (this->palette)
+    {
+      case Palette::BLACK_HOT:
+        rgb[0] = rgb[1] = rgb[2] = static_cast<unsigned char>(255u - i);
+        break;
+      case Palette::IRONBOW:
+        interpolate(kIronbow, sizeof(kIronbow) / sizeof(kIronbow[0]), t,
+            rgb);
+        break;
+      case Palette::RAINBOW:
+        interpolate(kRainbow, sizeof(kRainbow) / sizeof(kRainbow[0]), t,
+            rgb);
+        break;
+      case Palette::WHITE_HOT:
+      default:
+        rgb[0] = rgb[1] = rgb[2] = static_cast<unsigned char>(i);
+        break;
+    }
+  }
+  this->windowTable.clear();
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::SetWindow(std::uint16_t _low,
+    std::uint16_t _high)
+{
+  this->windowLow = std::min<std::uint16_t>(_low, 65534u);
+  this->windowHigh = std::max<std::uint16_t>(_high, this->windowLow + 1u);
+  this->windowTable.clear();
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::Narrow(const std::uint16_t *_src,
+    std::size_t _count, unsigned char *_dst)
+{
+  std::size_t i = 0;
+#ifdef GZ_SENSORS_THERMAL_SSE2
+  // min(x, 255) is x - saturate(x - 255), then pack 16 values at a time
+  const __m128i max8 = _mm_set1_epi16(255);
+  for (; i + 16u <= _count; i += 16u)
+  {
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + i));
+    __m128i b =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + i + 8u));
+    a = _mm_subs_epu16(a, _mm_subs_epu16(a, max8));
+    b = _mm_subs_epu16(b, _mm_subs_epu16(b, max8));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(_dst + i),
+        _mm_packus_epi16(a, b));
+  }
+#endif
+  for (; i < _count; ++i)
+    _dst[i] = static_cast<unsigned char>(_src[i] > 255u ? 255u : _src[i]);
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::MinMax(const std::uint16_t *_src,
+    std::size_t _count, std::uint16_t &_min, std::uint16_t &_max)
+{
+  std::uint16_t low = 65535u;
+  std::uint16_t high = 0u;
+  std::size_t i = 0;
+#ifdef GZ_SENSORS_THERMAL_SSE2
+  if (_count >= 8u)
+  {
+    // SSE2 only compares signed 16 bit values, flip the sign bit so that
+    // their order matches the unsigned values
+    const __m128i bias = _mm_set1_epi16(static_cast<short>(0x8000));
+    __m128i vmin = _mm_set1_epi16(0x7FFF);
+    __m128i vmax = _mm_set1_epi16(static_cast<short>(0x8000));
+    for (; i + 8u <= _count; i += 8u)
+    {
+      const __m128i v = _mm_xor_si128(bias,
+          _mm_loadu_si128(reinterpret_cast<const __m128i *>(_src + i)));
+      vmin = _mm_min_epi16(vmin, v);
+      vmax = _mm_max_epi16(vmax, v);
+    }
+    alignas(16) std::uint16_t mins[8];
+    alignas(16) std::uint16_t maxs[8];
+    _mm_store_si128(reinterpret_cast<__m128i *>(mins),
+        _mm_xor_si128(vmin, bias));
+    _mm_store_si128(reinterpret_cast<__m128i *>(maxs),
+        _mm_xor_si128(vmax, bias));
+    for (unsigned int j = 0; j < 8u; ++j)
+    {
+      low = std::min(low, mins[j]);
+      high = std::max(high, maxs[j]);
+    }
+  }
+#endif
+  for (; i < _count; ++i)
+  {
+    low = std::min(low, _src[i]);
+    high = std::max(high, _src[i]);
+  }
+  _min = low;
+  _max = high;
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::ToGray(const std::uint16_t *_src,
+    std::size_t _count, unsigned char *_dst)
+{
+  this->Map(_src, _count, 1u, _dst);
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::ToRgb(const std::uint16_t *_src,
+    std::size_t _count, unsigned char *_dst)
+{
+  this->Map(_src, _count, 3u, _dst);
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::ToPalette(const std::uint16_t *_src,
+    std::size_t _count, unsigned char *_dst)
+{
+  if (_count == 0u)
+    return;
+
+  if (this->paletteTable.empty())
+    this->BuildPalette();
+
+  if (this->mapping == Mapping::WINDOW)
+  {
+    // The window does not depend on the image, so every value has a fixed
+    // color and pixels are colored in a single lookup
+    if (this->windowTable.empty())
+    {
+      std::vector<std::uint16_t> values(65536u);
+      for (std::size_t v = 0; v < values.size(); ++v)
+        values[v] = static_cast<std::uint16_t>(v);
+      std::vector<unsigned char> gray(values.size());
+      mapLinear<1u>(values.data(), values.size(), this->windowLow,
+          this->windowHigh - this->windowLow, gray.data());
+      this->windowTable.resize(values.size() * 4u);
+      for (std::size_t v = 0; v < values.size(); ++v)
+      {
+        std::memcpy(this->windowTable.data() + v * 4u,
+            this->paletteTable.data() + gray[v] * 4u, 4u);
+      }
+    }
+    gatherRgb(_src, _count, this->windowTable.data(), _dst);
+    return;
+  }
+
+  this->intensities.resize(_count);
+  this->Map(_src, _count, 1u, this->intensities.data());
+  gatherRgb(this->intensities.data(), _count, this->paletteTable.data(),
+      _dst);
+}
+
+//////////////////////////////////////////////////
+void ThermalImageConversion::Map(const std::uint16_t *_src,
+    std::size_t _count, unsigned int _channels, unsigned char *_dst)
+{
+  if (_count == 0u)
+    return;
+
+  if (this->mapping == Mapping::WINDOW)
+  {
+    const std::int32_t range = this->windowHigh - this->windowLow;
+    if (_channels == 1u)
+      mapLinear<1u>(_src, _count, this->windowLow, range, _dst);
+    else
+      mapLinear<3u>(_src, _count, this->windowLow, range, _dst);
+    return;
+  }
+
+  std::uint16_t low = 0u;
+  std::uint16_t high = 0u;
+  MinMax(_src, _count, low, high);
+
+  if (this->mapping == Mapping::LINEAR || low == high)
+  {
+    const std::int32_t range = std::max(1, high - low);
+    if (_channels == 1u)
+      mapLinear<1u>(_src, _count, low, range, _dst);
+    else
+      mapLinear<3u>(_src, _count, low, range, _dst);
+    return;
+  }
+
+  // Histogram equalization over the range of values in the image. The
+  // coldest value maps to 0 and the hottest to 255.
+  const std::size_t bins = static_cast<std::size_t>(high - low) + 1u;
+  this->histogram.assign(bins, 0u);
+  for (std::size_t i = 0; i < _count; ++i)
+    ++this->histogram[_src[i] - low];
+
+  this->lookup.resize(bins);
+  const std::uint64_t first = this->histogram[0];
+  const std::uint64_t denominator = _count - first;
+  std::uint64_t cumulative = 0u;
+  for (std::size_t b = 0; b < bins; ++b)
+  {
+    cumulative += this->histogram[b];
+    this->lookup[b] = static_cast<unsigned char>(
+        ((cumulative - first) * 255u + denominator / 2u) / denominator);
+  }
+
+  if (_channels == 1u)
+    mapLookup<1u>(_src, _count, low, this->lookup.data(), _dst);
+  else
+    mapLookup<3u>(_src, _count, low, this->lookup.data(), _dst);
+}
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_THERMALIMAGECONVERSION_HH_
+#define GZ_SENSORS_THERMALIMAGECONVERSION_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define ThermalImageConversion_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define ThermalImageConversion_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ThermalImageConversion_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Converts thermal images, which hold temperatures in units of
+    /// the linear resolution, to 8 bit images. The ThermalCameraSensor
+    /// class uses this to publish 8 bit cameras and to render images for
+    /// viewing.
+    ///
+    /// Narrow() keeps the temperature values and saturates them, which is
+    /// what 8 bit cameras publish. The mappings stretch temperatures over
+    /// the 8 bit range for viewing, and palettes color the result. The
+    /// kernels use SSE2 where available and are otherwise written so that
+    /// the compiler vectorizes them.
+    class ThermalImageConversion_EXPORTS_API ThermalImageConversion
+    {
+      /// \brief How temperatures map to 8 bit intensities.
+      public: enum class Mapping
+      {
+        /// \brief The coldest pixel of each image is black, the hottest is
+        /// white.
+        LINEAR,
+
+        /// \brief A fixed window of temperatures, set with SetWindow(),
+        /// maps to black through white. Temperatures outside are clamped.
+        WINDOW,
+
+        /// \brief Histogram equalization, which spreads the temperatures
+        /// of each image evenly over the intensities.
+        HISTOGRAM
+      };
+
+      /// \brief False color palettes.
+      public: enum class Palette
+      {
+        /// \brief Grey, hot is white.
+        WHITE_HOT,
+
+        /// \brief Grey, hot is black.
+        BLACK_HOT,
+
+        /// \brief Black through blue, purple, orange and yellow to white.
+        IRONBOW,
+
+        /// \brief Blue through cyan, green and yellow to red.
+        RAINBOW
+      };
+
+      /// \brief Set the mapping from its name: "linear", "window" or
+      /// "histogram".
+      /// \param[in] _name Mapping name.
+      /// \return False if the name is unknown, in which case the mapping is
+      /// left unchanged.
+      public: bool SetMapping(const std::string &_name);
+
+      /// \brief Set the mapping.
+      /// \param[in] _mapping Mapping.
+      public: void SetMapping(Mapping _mapping);
+
+      /// \brief Get the mapping.
+      /// \return Mapping.
+      public: Mapping MappingType() const;
+
+      /// \brief Set the palette from its name: "white_hot", "black_hot",
+      /// "ironbow" or "rainbow". The palette lookup table is built here.
+      /// \param[in] _name Palette name.
+      /// \return False if the name is unknown, in which case the palette is
+      /// left unchanged.
+      public: bool SetPalette(const std::string &_name);
+
+      /// \brief Set the palette. The palette lookup table is built here.
+      /// \param[in] _palette Palette.
+      public: void SetPalette(Palette _palette);
+
+      /// \brief Get the palette.
+      /// \return Palette.
+      public: Palette PaletteType() const;
+
+      /// \brief Set the window used by Mapping::WINDOW.
+      /// \param[in] _low Value mapped to black.
+      /// \param[in] _high Value mapped to white, at least _low + 1.
+      public: void SetWindow(std::uint16_t _low, std::uint16_t _high);
+
+      /// \brief Narrow values to 8 bits, saturating values above 255.
+      /// \param[in] _src Source values.
+      /// \param[in] _count Number of values.
+      /// \param[out] _dst Destination with room for _count values.
+      public: static void Narrow(const std::uint16_t *_src,
+          std::size_t _count, unsigned char *_dst);
+
+      /// \brief Find the smallest and largest value in one pass.
+      /// \param[in] _src Values.
+      /// \param[in] _count Number of values, at least one.
+      /// \param[out] _min Smallest value.
+      /// \param[out] _max Largest value.
+      public: static void MinMax(const std::uint16_t *_src,
+          std::size_t _count, std::uint16_t &_min, std::uint16_t &_max);
+
+      /// \brief Map an image to 8 bit intensities.
+      /// \param[in] _src Thermal image.
+      /// \param[in] _count Number of pixels.
+      /// \param[out] _dst Destination with room for _count bytes.
+      public: void ToGray(const std::uint16_t *_src, std::size_t _count,
+          unsigned char *_dst);
+
+      /// \brief Map an image to a grey RGB8 image.
+      /// \param[in] _src Thermal image.
+      /// \param[in] _count Number of pixels.
+      /// \param[out] _dst Destination with room for 3 * _count bytes.
+      public: void ToRgb(const std::uint16_t *_src, std::size_t _count,
+          unsigned char *_dst);
+
+      /// \brief Map an image to a false color RGB8 image with the palette.
+      /// With Mapping::WINDOW every value is looked up directly in a table
+      /// of 65536 colors, otherwise intensities are looked up in a table of
+      /// 256 colors.
+      /// \param[in] _src Thermal image.
+      /// \param[in] _count Number of pixels.
+      /// \param[out] _dst Destination with room for 3 * _count bytes.
+      public: void ToPalette(const std::uint16_t *_src, std::size_t _count,
+          unsigned char *_dst);
+
+      /// \brief Build the palette tables.
+      private: void BuildPalette();
+
+      /// \brief Map an image with a number of output channels.
+      /// \param[in] _src Thermal image.
+      /// \param[in] _count Number of pixels.
+      /// \param[in] _channels Output channels, 1 or 3.
+      /// \param[out] _dst Destination.
+      private: void Map(const std::uint16_t *_src, std::size_t _count,
+          unsigned int _channels, unsigned char *_dst);
+
+      /// \brief Mapping.
+      private: Mapping mapping = Mapping::LINEAR;
+
+      /// \brief Value mapped to black by Mapping::WINDOW.
+      private: std::uint16_t windowLow = 0u;
+
+      /// \brief Value mapped to white by Mapping::WINDOW.
+      private: std::uint16_t windowHigh = 65535u;
+
+      /// \brief Palette.
+      private: Palette palette = Palette::WHITE_HOT;
+
+      /// \brief Color of each intensity, 4 bytes per entry with the fourth
+      /// unused so that entries are loaded as words.
+      private: std::vector<unsigned char> paletteTable;
+
+      /// \brief Color of each value through the window, 4 bytes per entry,
+      /// built on first use after the palette or window changes.
+      private: std::vector<unsigned char> windowTable;
+
+      /// \brief Intensities of the last image colored without the window.
+      private: std::vector<unsigned char> intensities;
+
+      /// \brief Histogram and lookup table scratch space of
+      /// Mapping::HISTOGRAM, kept between images.
+      private: std::vector<std::uint32_t> histogram;
+
+      /// \brief Intensity of each value of the histogram range.
+      private: std::vector<unsigned char> lookup;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ThermalImageConversion.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(ThermalImageConversion_TEST, Narrow)
+{
+  // Long enough for the vector loop and a tail
+  std::vector<std::uint16_t> values(37u);
+  for (std::size_t i = 0; i < values.size(); ++i)
+    values[i] = static_cast<std::uint16_t>(i * 17u);
+  values[5] = 65535u;
+  values[36] = 256u;
+
+  std::vector<unsigned char> out(values.size());
+  ThermalImageConversion::Narrow(values.data(), values.size(), out.data());
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    EXPECT_EQ(std::min<unsigned int>(values[i], 255u),
+        static_cast<unsigned int>(out[i])) << i;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(ThermalImageConversion_TEST, MinMax)
+{
+  std::vector<std::uint16_t> values(29u, 30000u);
+  values[3] = 29000u;
+  values[27] = 65535u;
+
+  std::uint16_t low = 0u;
+  std::uint16_t high = 0u;
+  ThermalImageConversion::MinMax(values.data(), values.size(), low, high);
+  EXPECT_EQ(29000u, low);
+  EXPECT_EQ(65535u, high);
+
+  // Values at both ends of the range, found by the vector loop
+  values[27] = 30000u;
+  values[8] = 0u;
+  values[9] = 40000u;
+  ThermalImageConversion::MinMax(values.data(), values.size(), low, high);
+  EXPECT_EQ(0u, low);
+  EXPECT_EQ(40000u, high);
+
+  ThermalImageConversion::MinMax(values.data() + 1, 2u, low, high);
+  EXPECT_EQ(30000u, low);
+  EXPECT_EQ(30000u, high);
+}
+
+//////////////////////////////////////////////////
+TEST(ThermalImageConversion_TEST, Linear)
+{
+  ThermalImageConversion conversion;
+  EXPECT_EQ(ThermalImageConversion::Mapping::LINEAR, conversion.MappingType());
+
+  const std::vector<std::uint16_t> values = {1000u, 1100u, 1050u, 1200u};
+  std::vector<unsigned char> gray(values.size());
+  conversion.ToGray(values.data(), values.size(), gray.data());
+  EXPECT_EQ(0u, gray[0]);
+  EXPECT_NEAR(128, gray[1], 1);
+  EXPECT_NEAR(64, gray[2], 1);
+  EXPECT_EQ(255u, gray[3]);
+
+  std::vector<unsigned char> rgb(values.size() * 3u);
+  conversion.ToRgb(values.data(), values.size(), rgb.data());
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    EXPECT_EQ(gray[i], rgb[i * 3u]);
+    EXPECT_EQ(gray[i], rgb[i * 3u + 1u]);
+    EXPECT_EQ(gray[i], rgb[i * 3u + 2u]);
+  }
+
+  // A uniform image is black
+  const std::vector<std::uint16_t> uniform(5u, 3000u);
+  std::vector<unsigned char> uniformGray(uniform.size(), 1u);
+  conversion.ToGray(uniform.data(), uniform.size(), uniformGray.data());
+  for (unsigned char value : uniformGray)
+    EXPECT_EQ(0u, value);
+}
+
+//////////////////////////////////////////////////
+TEST(ThermalImageConversion_TEST, Window)
+{
+  ThermalImageConversion conversion;
+  EXPECT_FALSE(conversion.SetMapping("ironbow"));
+  EXPECT_TRUE(conversion.SetMapping("window"));
+  EXPECT_EQ(ThermalImageConversion::Mapping::WINDOW, conversion.MappingType());
+  conversion.SetWindow(1000u, 2000u);
+
+  // Outside the window is clamped
+  const std::vector<std::uint16_t> values = {500u, 1000u, 1500u, 2000u,
+      60000u};
+  std::vector<unsigned char> gray(values.size());
+  conversion.ToGray(values.data(), values.size(), gray.data());
+  EXPECT_EQ(0u, gray[0]);
+  EXPECT_EQ(0u, gray[1]);
+  EXPECT_NEAR(128, gray[2], 1);
+  EXPECT_EQ(255u, gray[3]);
+  EXPECT_EQ(255u, gray[4]);
+
+  // An empty window is widened to one value
+  conversion.SetWindow(1500u, 1500u);
+  conversion.ToGray(values.data(), values.size(), gray.data());
+  EXPECT_EQ(0u, gray[2]);
+  EXPECT_EQ(255u, gray[3]);
+}
+
+//////////////////////////////////////////////////
+TEST(ThermalImageConversion_TEST, Histogram)
+{
+  ThermalImageConversion conversion;
+  EXPECT_TRUE(conversion.SetMapping("histogram"));
+  EXPECT_EQ(ThermalImageConversion::Mapping::HISTOGRAM,
+      conversion.MappingType());
+
+  // Mostly cold background with a few very hot pixels. Linear mapping
+  // would make the background black, equalization spreads the cold values.
+  std::vector<std::uint16_t> values;
+  for (std::uint16_t v = 0; v < 100u; ++v)
+    values.push_back(static_cast<std::uint16_t>(29000u + v));
+  values.push_back(40000u);
+
+  std::vector<unsigned char> gray(values.size());
+  conversion.ToGray(values.data(), values.size(), gray.data());
+  EXPECT_EQ(0u, gray.front());
+  EXPECT_EQ(255u, gray.back());
+  EXPECT_GT(gray[50], 100u);
+  EXPECT_LT(gray[50], 160u);
+  for (std::size_t i = 1; i < values.size(); ++i)
+    EXPECT_LE(gray[i - 1], gray[i]);
+}
+
+//////////////////////////////////////////////////
+TEST(ThermalImageConversion_TEST, Palette)
+{
+  ThermalImageConversion conversion;
+  EXPECT_EQ(ThermalImageConversion::Palette::WHITE_HOT,
+      conversion.PaletteType());
+  EXPECT_FALSE(conversion.SetPalette("jet"));
+
+  const std::vector<std::uint16_t> values = {1000u, 1100u, 1200u};
+  std::vector<unsigned char> rgb(values.size() * 3u);
+  std::vector<unsigned char> expected(values.size() * 3u);
+
+  // White hot matches the grey image
+  conversion.ToPalette(values.data(), values.size(), rgb.data());
+  conversion.ToRgb(values.data(), values.size(), expected.data());
+  EXPECT_EQ(expected, rgb);
+
+  EXPECT_TRUE(conversion.SetPalette("black_hot"));
+  conversion.ToPalette(values.data(), values.size(), rgb.data());
+  EXPECT_EQ(255u, rgb[0]);
+  EXPECT_EQ(0u, rgb[6]);
+
+  // Ironbow goes from black to white, rainbow from blue to red
+  EXPECT_TRUE(conversion.SetPalette("ironbow"));
+  EXPECT_EQ(ThermalImageConversion::Palette::IRONBOW,
+      conversion.PaletteType());
+  conversion.ToPalette(values.data(), values.size(), rgb.data());
+  EXPECT_EQ(std::vector<unsigned char>({0u, 0u, 0u}),
+      std::vector<unsigned char>(rgb.begin(), rgb.begin() + 3));
+  EXPECT_EQ(std::vector<unsigned char>({255u, 255u, 255u}),
+      std::vector<unsigned char>(rgb.begin() + 6, rgb.end()));
+  EXPECT_GT(rgb[3], rgb[4]);
+
+  EXPECT_TRUE(conversion.SetPalette("rainbow"));
+  conversion.ToPalette(values.data(), values.size(), rgb.data());
+  EXPECT_EQ(std::vector<unsigned char>({0u, 0u, 255u}),
+      std::vector<unsigned char>(rgb.begin(), rgb.begin() + 3));
+  EXPECT_EQ(0u, rgb[3]);
+  EXPECT_EQ(255u, rgb[4]);
+  EXPECT_LE(rgb[5], 4u);
+  EXPECT_EQ(std::vector<unsigned char>({255u, 0u, 0u}),
+      std::vector<unsigned char>(rgb.begin() + 6, rgb.end()));
+
+  // Through the window every value has a fixed color, also after the
+  // window changes
+  EXPECT_TRUE(conversion.SetMapping("window"));
+  conversion.SetWindow(1000u, 1100u);
+  conversion.ToPalette(values.data(), values.size(), rgb.data());
+  EXPECT_EQ(std::vector<unsigned char>({0u, 0u, 255u}),
+      std::vector<unsigned char>(rgb.begin(), rgb.begin() + 3));
+  EXPECT_EQ(std::vector<unsigned char>({255u, 0u, 0u}),
+      std::vector<unsigned char>(rgb.begin() + 3, rgb.begin() + 6));
+  EXPECT_EQ(std::vector<unsigned char>({255u, 0u, 0u}),
+      std::vector<unsigned char>(rgb.begin() + 6, rgb.end()));
+
+  conversion.SetWindow(1000u, 1200u);
+  conversion.ToPalette(values.data(), values.size(), rgb.data());
+  EXPECT_EQ(0u, rgb[3]);
+  EXPECT_EQ(255u, rgb[4]);
+  EXPECT_LE(rgb[5], 4u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+#include "ParallelRows.hh"
+#include "ThermalStatistics.hh"
+
+using namespace gz;
+using namespace sensors;
+
+namespace
+{
+  using Hotspot = ThermalStatistics::Hotspot;
+
+  /// \brief Order hotspots, hottest first and then in image order.
+  /// \param[in] _a First hotspot.
+  /// \param[in] _b Second hotspot.
+  /// \return True if _a comes before _b.
+  bool hotter(const Hotspot &_a, const Hotspot &_b)
+  {
+    if (_a.value != _b.value)
+      return _a.value > _b.value;
+    if (_a.v != _b.v)
+      return _a.v < _b.v;
+    return _a.u < _b.u;
+  }
+
+  /// \brief Offer a pixel to a heap of hotspots. The heap front is the
+  /// coolest hotspot, which is replaced once the heap is full.
+  /// \param[in,out] _heap Heap.
+  /// \param[in] _count Heap capacity.
+  /// \param[in] _spot Candidate.
+  void offer(std::vector<Hotspot> &_heap, unsigned int _count,
+      const Hotspot &_spot)
+  {
+    if (_heap.size() < _count)
+    {
+      _heap.push_back(_spot);
+      std::push_heap(_heap.begin(), _heap.end(), hotter);
+    }
+    else if (hotter(_spot, _heap.front()))
+    {
+      std::pop_heap(_heap.begin(), _heap.end(), hotter);
+      _heap.back() = _spot;
+      std::push_heap(_heap.begin(), _heap.end(), hotter);
+    }
+  }
+
+  /// \brief Partial statistics of a chunk of rows.
+  struct Partial
+  {
+    /// \brief Smallest value.
+    std::uint16_t min = 65535u;
+
+    /// \brief Largest value.
+    std::uint16_t max = 0u;
+
+    /// \brief Sum of the values.
+    std::uint64_t sum = 0u;
+
+    /// \brief Hotspots, as a heap.
+    std::vector<Hotspot> heap;
+
+    /// \brief Cell maxima.
+    std::vector<std::uint16_t> grid;
+  };
+}
+
+//////////////////////////////////////////////////
+void ThermalStatistics::SetHotspotCount(unsigned int _count)
+{
+  this->hotspotCount = _count;
+}
+
+//////////////////////////////////////////////////
+unsigned int ThermalStatistics::HotspotCount() const
+{
+  return this->hotspotCount;
+}
+
+//////////////////////////////////////////////////
+void ThermalStatistics::SetGrid(unsigned int _columns, unsigned int _rows)
+{
+  this->requestedColumns = _rows > 0u ? _columns : 0u;
+  this->requestedRows = _columns > 0u ? _rows : 0u;
+}
+
+//////////////////////////////////////////////////
+bool ThermalStatistics::Compute(const std::uint16_t *_data,
+    unsigned int _width, unsigned int _height)
+{
+  if (!_data || _width == 0u || _height == 0u)
+    return false;
+
+  // Without a grid every row is one span, otherwise one span per cell
+  this->gridColumns = std::min(this->requestedColumns, _width);
+  this->gridRows = std::min(this->requestedRows, _height);
+  const unsigned int spans = std::max(this->gridColumns, 1u);
+  this->cellBounds.resize(spans + 1u);
+  for (unsigned int c = 0; c <= spans; ++c)
+  {
+    this->cellBounds[c] = static_cast<unsigned int>(
+        static_cast<std::uint64_t>(c) * _width / spans);
+  }
+
+  Partial total;
+  total.grid.assign(
+      static_cast<std::size_t>(this->gridColumns) * this->gridRows, 0u);
+  std::mutex mutex;
+  const unsigned int count = this->hotspotCount;
+  const unsigned int *bounds = this->cellBounds.data();
+  const unsigned int columns = this->gridColumns;
+  const unsigned int rows = this->gridRows;
+
+  ParallelRows::Instance().Run(_height,
+      [&](unsigned int _begin, unsigned int _end)
+      {
+        Partial part;
+        part.heap.reserve(count);
+        part.grid.assign(total.grid.size(), 0u);
+        for (unsigned int v = _begin; v < _end; ++v)
+        {
+          const std::uint16_t *row =
+              _data + static_cast<std::size_t>(v) * _width;
+          std::uint16_t *cells = rows > 0u ? part.grid.data() +
+              static_cast<std::size_t>(v) * rows / _height *
+              columns : nullptr;
+          std::uint16_t rowMax = 0u;
+          for (unsigned int c = 0; c < spans; ++c)
+          {
+            // Plain loops over the span, which the compiler vectorizes
+            std::uint16_t spanMin = 65535u;
+            std::uint16_t spanMax = 0u;
+            std::uint64_t spanSum = 0u;
+            for (unsigned int u = bounds[c]; u < bounds[c + 1u]; ++u)
+            {
+              spanMin = std::min(spanMin, row[u]);
+              spanMax = std::max(spanMax, row[u]);
+              spanSum += row[u];
+            }
+            part.min = std::min(part.min, spanMin);
+            rowMax = std::max(rowMax, spanMax);
+            part.sum += spanSum;
+            if (cells)
+              cells[c] = std::max(cells[c], spanMax);
+          }
+          part.max = std::max(part.max, rowMax);
+
+          // Rows are visited in order, so a pixel only displaces a full
+          // heap when it is strictly hotter than its coolest entry
+          if (count == 0u || (part.heap.size() == count &&
+              rowMax <= part.heap.front().value))
+          {
+            continue;
+          }
+          for (unsigned int u = 0; u < _width; ++u)
+          {
+            if (part.heap.size() < count ||
+                row[u] > part.heap.front().value)
+            {
+              offer(part.heap, count, Hotspot{u, v, row[u]});
+            }
+          }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        total.min = std::min(total.min, part.min);
+        total.max = std::max(total.max, part.max);
+        total.sum += part.sum;
+        for (const Hotspot &spot : part.heap)
+          offer(total.heap, count, spot);
+        for (std::size_t i = 0; i < total.grid.size(); ++i)
+          total.grid[i] = std::max(total.grid[i], part.grid[i]);
+      });
+
+  this->min = total.min;
+  this->max = total.max;
+  this->mean = static_cast<double>(total.sum) /
+      (static_cast<double>(_width) * _height);
+  std::sort(total.heap.begin(), total.heap.end(), hotter);
+  this->hotspots = std::move(total.heap);
+  this->grid = std::move(total.grid);
+  return true;
+}
+
+//////////////////////////////////////////////////
+std::uint16_t ThermalStatistics::Min() const
+{
+  return this->min;
+}
+
+//////////////////////////////////////////////////
+std::uint16_t ThermalStatistics::Max() const
+{
+  return this->max;
+}
+
+//////////////////////////////////////////////////
+double ThermalStatistics::Mean() const
+{
+  return this->mean;
+}
+
+//////////////////////////////////////////////////
+const std::vector<ThermalStatistics::Hotspot> &
+    ThermalStatistics::Hotspots() const
+{
+  return this->hotspots;
+}
+
+//////////////////////////////////////////////////
+const std::vector<std::uint16_t> &ThermalStatistics::Grid() const
+{
+  return this->grid;
+}
+
+//////////////////////////////////////////////////
+unsigned int ThermalStatistics::GridColumns() const
+{
+  return this->gridColumns;
+}
+
+//////////////////////////////////////////////////
+unsigned int ThermalStatistics::GridRows() const
+{
+  return this->gridRows;
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_THERMALSTATISTICS_HH_
+#define GZ_SENSORS_THERMALSTATISTICS_HH_
+
+#include <cstdint>
+#include <vector>
+
+#include "gz/sensors/config.hh"
+#include "gz/sensors/Export.hh"
+
+#ifndef _WIN32
+#  define ThermalStatistics_EXPORTS_API
+#else
+#  if (defined(DepthPoints_EXPORTS))
+#    define ThermalStatistics_EXPORTS_API __declspec(dllexport)
+#  else
+#    define ThermalStatistics_EXPORTS_API __declspec(dllimport)
+#  endif
+#endif
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Statistics of a thermal image: the smallest, largest and mean
+    /// value, the hottest pixels and optionally the largest value of each
+    /// cell of a coarse grid. The ThermalCameraSensor class publishes them
+    /// so that consumers do not need the full image.
+    ///
+    /// Everything is computed in one pass over the image, with rows
+    /// processed in parallel and the partial results of each chunk of rows
+    /// merged at the end. Values are in the units of the image, usually
+    /// the linear resolution of the camera.
+    class ThermalStatistics_EXPORTS_API ThermalStatistics
+    {
+      /// \brief One of the hottest pixels.
+      public: struct Hotspot
+      {
+        /// \brief Column.
+        unsigned int u = 0u;
+
+        /// \brief Row.
+        unsigned int v = 0u;
+
+        /// \brief Value.
+        std::uint16_t value = 0u;
+      };
+
+      /// \brief Set the number of hottest pixels to find. Defaults to 5.
+      /// \param[in] _count Number of hotspots, zero to skip them.
+      public: void SetHotspotCount(unsigned int _count);
+
+      /// \brief Get the number of hottest pixels to find.
+      /// \return Number of hotspots.
+      public: unsigned int HotspotCount() const;
+
+      /// \brief Set the size of the grid of cell maxima. Cells split the
+      /// image evenly, and the grid is clamped to one pixel per cell.
+      /// \param[in] _columns Number of columns, zero for no grid.
+      /// \param[in] _rows Number of rows, zero for no grid.
+      public: void SetGrid(unsigned int _columns, unsigned int _rows);
+
+      /// \brief Compute the statistics of an image.
+      /// \param[in] _data Image, one value per pixel.
+      /// \param[in] _width Image width in pixels.
+      /// \param[in] _height Image height in pixels.
+      /// \return False if the image is empty.
+      public: bool Compute(const std::uint16_t *_data, unsigned int _width,
+          unsigned int _height);
+
+      /// \brief Get the smallest value of the last image.
+      /// \return Smallest value.
+      public: std::uint16_t Min() const;
+
+      /// \brief Get the largest value of the last image.
+      /// \return Largest value.
+      public: std::uint16_t Max() const;
+
+      /// \brief Get the mean value of the last image.
+      /// \return Mean value.
+      public: double Mean() const;
+
+      /// \brief Get the hottest pixels of the last image, hottest first.
+      /// Pixels of equal value are in image order.
+      /// \return Up to HotspotCount() hotspots.
+      public: const std::vector<Hotspot> &Hotspots() const;
+
+      /// \brief Get the largest value of each cell of the last image, row
+      /// major.
+      /// \return GridColumns() * GridRows() values, empty without a grid.
+      public: const std::vector<std::uint16_t> &Grid() const;
+
+      /// \brief Get the number of grid columns of the last image.
+      /// \return Number of columns.
+      public: unsigned int GridColumns() const;
+
+      /// \brief Get the number of grid rows of the last image.
+      /// \return Number of rows.
+      public: unsigned int GridRows() const;
+
+      /// \brief Number of hotspots to find.
+      private: unsigned int hotspotCount = 5u;
+
+      /// \brief Requested grid columns.
+      private: unsigned int requestedColumns = 0u;
+
+      /// \brief Requested grid rows.
+      private: unsigned int requestedRows = 0u;
+
+      /// \brief Grid columns of the last image.
+      private: unsigned int gridColumns = 0u;
+
+      /// \brief Grid rows of the last image.
+      private: unsigned int gridRows = 0u;
+
+      /// \brief Smallest value.
+      private: std::uint16_t min = 0u;
+
+      /// \brief Largest value.
+      private: std::uint16_t max = 0u;
+
+      /// \brief Mean value.
+      private: double mean = 0.0;
+
+      /// \brief Hottest pixels.
+      private: std::vector<Hotspot> hotspots;
+
+      /// \brief Cell maxima.
+      private: std::vector<std::uint16_t> grid;
+
+      /// \brief First image column of each grid column, plus the width.
+      private: std::vector<unsigned int> cellBounds;
+    };
+    }
+  }
+}
+
+#endif
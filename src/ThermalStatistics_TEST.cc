@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "ThermalStatistics.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(ThermalStatistics_TEST, Global)
+{
+  const unsigned int width = 37u;
+  const unsigned int height = 23u;
+  std::vector<std::uint16_t> image(width * height);
+  double sum = 0.0;
+  for (std::size_t i = 0; i < image.size(); ++i)
+  {
+    image[i] = static_cast<std::uint16_t>(29000u + (i * 7919u) % 1000u);
+    sum += image[i];
+  }
+
+  ThermalStatistics stats;
+  EXPECT_FALSE(stats.Compute(image.data(), 0u, height));
+  ASSERT_TRUE(stats.Compute(image.data(), width, height));
+  EXPECT_EQ(*std::min_element(image.begin(), image.end()), stats.Min());
+  EXPECT_EQ(*std::max_element(image.begin(), image.end()), stats.Max());
+  EXPECT_NEAR(sum / image.size(), stats.Mean(), 1e-6);
+  EXPECT_TRUE(stats.Grid().empty());
+  EXPECT_EQ(0u, stats.GridColumns());
+}
+
+//////////////////////////////////////////////////
+TEST(ThermalStatistics_TEST, Hotspots)
+{
+  // Hotspots spread over many rows so that several chunks contribute,
+  // including ties that must come out in image order
+  const unsigned int width = 64u;
+  const unsigned int height = 200u;
+  std::vector<std::uint16_t> image(width * height, 30000u);
+  image[5 * width + 3] = 40000u;
+  image[150 * width + 60] = 45000u;
+  image[199 * width + 63] = 41000u;
+  image[80 * width + 10] = 41000u;
+  image[20 * width + 30] = 35000u;
+  image[190 * width + 1] = 35000u;
+
+  ThermalStatistics stats;
+  stats.SetHotspotCount(5u);
+  ASSERT_TRUE(stats.Compute(image.data(), width, height));
+  const auto &spots = stats.Hotspots();
+  ASSERT_EQ(5u, spots.size());
+  EXPECT_EQ(45000u, spots[0].value);
+  EXPECT_EQ(60u, spots[0].u);
+  EXPECT_EQ(150u, spots[0].v);
+  EXPECT_EQ(41000u, spots[1].value);
+  EXPECT_EQ(80u, spots[1].v);
+  EXPECT_EQ(41000u, spots[2].value);
+  EXPECT_EQ(199u, spots[2].v);
+  EXPECT_EQ(40000u, spots[3].value);
+  EXPECT_EQ(35000u, spots[4].value);
+  EXPECT_EQ(20u, spots[4].v);
+
+  // A uniform image gives the first pixels
+  std::vector<std::uint16_t> flat(width * height, 100u);
+  stats.SetHotspotCount(3u);
+  ASSERT_TRUE(stats.Compute(flat.data(), width, height));
+  ASSERT_EQ(3u, stats.Hotspots().size());
+  for (unsigned int i = 0; i < 3u; ++i)
+  {
+    EXPECT_EQ(i, stats.Hotspots()[i].u);
+    EXPECT_EQ(0u, stats.Hotspots()[i].v);
+  }
+
+  stats.SetHotspotCount(0u);
+  ASSERT_TRUE(stats.Compute(flat.data(), width, height));
+  EXPECT_TRUE(stats.Hotspots().empty());
+}
+
+//////////////////////////////////////////////////
+TEST(ThermalStatistics_TEST, Grid)
+{
+  const unsigned int width = 10u;
+  const unsigned int height = 6u;
+  std::vector<std::uint16_t> image(width * height);
+  for (unsigned int v = 0; v < height; ++v)
+  {
+    for (unsigned int u = 0; u < width; ++u)
+      image[v * width + u] = static_cast<std::uint16_t>(v * 100u + u);
+  }
+
+  ThermalStatistics stats;
+  stats.SetGrid(3u, 2u);
+  ASSERT_TRUE(stats.Compute(image.data(), width, height));
+  EXPECT_EQ(3u, stats.GridColumns());
+  EXPECT_EQ(2u, stats.GridRows());
+  ASSERT_EQ(6u, stats.Grid().size());
+
+  // Columns split at 3 and 6, rows at 3
+  const std::uint16_t expected[] = {202u, 205u, 209u, 502u, 505u, 509u};
+  for (unsigned int i = 0; i < 6u; ++i)
+    EXPECT_EQ(expected[i], stats.Grid()[i]) << i;
+
+  // The grid is clamped to one pixel per cell
+  stats.SetGrid(20u, 20u);
+  ASSERT_TRUE(stats.Compute(image.data(), width, height));
+  EXPECT_EQ(width, stats.GridColumns());
+  EXPECT_EQ(height, stats.GridRows());
+  EXPECT_EQ(image, stats.Grid());
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_TRIGGERQUEUE_HH_
+#define GZ_SENSORS_TRIGGERQUEUE_HH_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "gz/sensors/config.hh"
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Lock free bounded queue of trigger times, filled by trigger
+    /// topic callbacks and drained by a triggered sensor's Update function.
+    ///
+    /// Each slot carries a sequence number that tells producers and the
+    /// consumer whose turn it is to use it, so pushing and popping only
+    /// ever touch the slot at the head or tail and never wait for a lock
+    /// held by rendering. Any number of producer threads is supported, but
+    /// only one consumer. A trigger that arrives while the queue is full is
+    /// dropped and counted.
+    class TriggerQueue
+    {
+      /// \brief Time type of a trigger.
+      public: using Duration = std::chrono::steady_clock::duration;
+
+      /// \brief Default number of triggers the queue holds.
+      public: static constexpr std::size_t kDefaultCapacity = 16u;
+
+      /// \brief Constructor
+      /// \param[in] _capacity Number of triggers the queue holds, rounded up
+      /// to a power of two of at least two.
+      public: explicit TriggerQueue(std::size_t _capacity = kDefaultCapacity)
+      {
+        this->Reset(_capacity);
+      }
+
+      /// \brief Change the capacity and empty the queue. Not thread safe,
+      /// call before triggers arrive.
+      /// \param[in] _capacity Number of triggers the queue holds, rounded up
+      /// to a power of two of at least two.
+      public: void Reset(std::size_t _capacity)
+      {
+        // A single slot could not tell a full queue from an empty one
+        std::size_t capacity = 2u;
+        while (capacity < _capacity)
+          capacity <<= 1u;
+        this->mask = capacity - 1u;
+        this->slots.reset(new Slot[capacity]);
+        for (std::size_t i = 0u; i < capacity; ++i)
+          this->slots[i].sequence.store(i, std::memory_order_relaxed);
+        this->head.store(0u, std::memory_order_relaxed);
+        this->tail = 0u;
+        this->dropped.store(0u, std::memory_order_relaxed);
+      }
+
+      /// \brief Get the number of triggers the queue holds.
+      /// \return Capacity.
+      public: std::size_t Capacity() const
+      {
+        return this->mask + 1u;
+      }
+
+      /// \brief Queue a trigger.
+      /// \param[in] _time Time of the trigger.
+      /// \return False if the queue was full and the trigger was dropped.
+      public: bool Push(const Duration &_time)
+      {
+        std::size_t position = this->head.load(std::memory_order_relaxed);
+        while (true)
+        {
+          Slot &slot = this->slots[position & this->mask];
+          std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+          auto diff = static_cast<std::ptrdiff_t>(sequence - position);
+          if (diff == 0)
+          {
+            // The slot is free, claim it
+            if (this->head.compare_exchange_weak(position, position + 1u,
+                std::memory_order_relaxed))
+            {
+              slot.time = _time;
+              slot.sequence.store(position + 1u, std::memory_order_release);
+              return true;
+            }
+          }
+          else if (diff < 0)
+          {
+            // The consumer has not taken the trigger a lap ago yet
+            this->dropped.fetch_add(1u, std::memory_order_relaxed);
+            return false;
+          }
+          else
+          {
+            position = this->head.load(std::memory_order_relaxed);
+          }
+        }
+      }
+
+      /// \brief Take the oldest trigger off the queue.
+      /// \param[out] _time Time of the trigger.
+      /// \return False if the queue is empty.
+      public: bool Pop(Duration &_time)
+      {
+        Slot &slot = this->slots[this->tail & this->mask];
+        std::size_t sequence = slot.sequence.load(std::memory_order_acquire);
+        if (sequence != this->tail + 1u)
+          return false;
+        _time = slot.time;
+        slot.sequence.store(this->tail + this->mask + 1u,
+            std::memory_order_release);
+        ++this->tail;
+        return true;
+      }
+
+      /// \brief Check whether a trigger is waiting. Only meaningful on the
+      /// consumer thread.
+      /// \return True if the queue is empty.
+      public: bool Empty() const
+      {
+        return this->slots[this->tail & this->mask].sequence.load(
+            std::memory_order_acquire) != this->tail + 1u;
+      }
+
+      /// \brief Get the number of triggers dropped because the queue was
+      /// full.
+      /// \return Number of dropped triggers.
+      public: std::uint64_t DroppedCount() const
+      {
+        return this->dropped.load(std::memory_order_relaxed);
+      }
+
+      /// \brief Storage for one trigger.
+      private: struct Slot
+      {
+        /// \brief Position the slot is next written at plus one once it
+        /// holds a trigger, or the position it is next written at when
+        /// free.
+        std::atomic<std::size_t> sequence{0u};
+
+        /// \brief Time of the trigger.
+        Duration time{0};
+      };
+
+      /// \brief Trigger storage.
+      private: std::unique_ptr<Slot[]> slots;
+
+      /// \brief Capacity minus one.
+      private: std::size_t mask = 0u;
+
+      /// \brief Position the next trigger is pushed at.
+      private: std::atomic<std::size_t> head{0u};
+
+      /// \brief Position the next trigger is popped from, consumer only.
+      private: std::size_t tail = 0u;
+
+      /// \brief Number of dropped triggers.
+      private: std::atomic<std::uint64_t> dropped{0u};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "TriggerQueue.hh"
+
+using namespace gz;
+using namespace sensors;
+
+using namespace std::chrono_literals;
+
+//////////////////////////////////////////////////
+TEST(TriggerQueue_TEST, PushPop)
+{
+  TriggerQueue queue(3u);
+  EXPECT_EQ(4u, queue.Capacity());
+  EXPECT_TRUE(queue.Empty());
+
+  TriggerQueue::Duration time;
+  EXPECT_FALSE(queue.Pop(time));
+
+  // Triggers come out in order with their times
+  EXPECT_TRUE(queue.Push(1ms));
+  EXPECT_TRUE(queue.Push(2ms));
+  EXPECT_FALSE(queue.Empty());
+  EXPECT_TRUE(queue.Pop(time));
+  EXPECT_EQ(TriggerQueue::Duration(1ms), time);
+
+  // Fill up, wrapping around the end of the storage
+  EXPECT_TRUE(queue.Push(3ms));
+  EXPECT_TRUE(queue.Push(4ms));
+  EXPECT_TRUE(queue.Push(5ms));
+  EXPECT_FALSE(queue.Push(6ms));
+  EXPECT_FALSE(queue.Push(7ms));
+  EXPECT_EQ(2u, queue.DroppedCount());
+
+  for (auto expected : {2ms, 3ms, 4ms, 5ms})
+  {
+    EXPECT_TRUE(queue.Pop(time));
+    EXPECT_EQ(TriggerQueue::Duration(expected), time);
+  }
+  EXPECT_FALSE(queue.Pop(time));
+  EXPECT_TRUE(queue.Empty());
+
+  // Room again
+  EXPECT_TRUE(queue.Push(8ms));
+  EXPECT_EQ(2u, queue.DroppedCount());
+
+  queue.Reset(1u);
+  EXPECT_EQ(2u, queue.Capacity());
+  EXPECT_TRUE(queue.Empty());
+  EXPECT_EQ(0u, queue.DroppedCount());
+  EXPECT_TRUE(queue.Push(9ms));
+  EXPECT_TRUE(queue.Push(10ms));
+  EXPECT_FALSE(queue.Push(11ms));
+  EXPECT_TRUE(queue.Pop(time));
+  EXPECT_EQ(TriggerQueue::Duration(9ms), time);
+}
+
+//////////////////////////////////////////////////
+TEST(TriggerQueue_TEST, Concurrent)
+{
+  // Several trigger callbacks racing a sensor update loop. Every trigger is
+  // either popped or counted as dropped, and each producer's triggers stay
+  // in order.
+  const int producers = 4;
+  const int triggersPerProducer = 20000;
+  TriggerQueue queue(8u);
+
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p)
+  {
+    threads.emplace_back([&queue, p]
+    {
+      for (int i = 1; i <= triggersPerProducer; ++i)
+      {
+        queue.Push(TriggerQueue::Duration(
+            static_cast<TriggerQueue::Duration::rep>(i) * producers + p));
+      }
+    });
+  }
+
+  std::vector<TriggerQueue::Duration::rep> last(producers, 0);
+  std::uint64_t popped = 0u;
+  bool ordered = true;
+  auto drain = [&]
+  {
+    TriggerQueue::Duration time;
+    while (queue.Pop(time))
+    {
+      auto p = time.count() % producers;
+      ordered = ordered && time.count() > last[p];
+      last[p] = time.count();
+      ++popped;
+    }
+  };
+
+  bool running = true;
+  while (running)
+  {
+    drain();
+    running = popped + queue.DroppedCount() <
+        static_cast<std::uint64_t>(producers) * triggersPerProducer;
+  }
+  for (auto &thread : threads)
+    thread.join();
+  drain();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(static_cast<std::uint64_t>(producers) * triggersPerProducer,
+      popped + queue.DroppedCount());
+  EXPECT_GT(popped, 0u);
+}
+
+/////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
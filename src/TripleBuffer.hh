@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GZ_SENSORS_TRIPLEBUFFER_HH_
+#define GZ_SENSORS_TRIPLEBUFFER_HH_
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+
+#include "gz/sensors/config.hh"
+#include "FrameBufferPool.hh"
+
+namespace ignition
+{
+  namespace sensors
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_SENSORS_VERSION_NAMESPACE {
+    //
+    /// \brief Lock free triple buffer used to hand frames from a rendering
+    /// callback (the producer) to a sensor's Update function (the consumer).
+    ///
+    /// The producer always writes into a back slot the consumer never
+    /// reads, then publishes it by atomically swapping it with the middle
+    /// slot. The consumer swaps the middle slot into its front slot only
+    /// when a newer frame has been published, so the front frame stays
+    /// valid and unchanged until the next call to Acquire(). Neither side
+    /// copies under a lock and neither side ever waits for the other.
+    ///
+    /// Only one producer thread and one consumer thread are supported.
+    /// Slot memory comes from the FrameBufferPool and follows the frame
+    /// size, so frames may change size between writes.
+    template <typename T>
+    class TripleBuffer
+    {
+      static_assert(std::is_trivially_copyable<T>::value,
+          "TripleBuffer elements are stored in raw pooled memory");
+
+      /// \brief Get the back slot, resized to hold _count elements.
+      /// \param[in] _count Number of elements the frame holds.
+      /// \return Pointer to the writable back slot.
+      public: T *BeginWrite(std::size_t _count)
+      {
+        Slot &slot = this->slots[this->back];
+        slot.buffer.Resize(_count * sizeof(T));
+        slot.count = _count;
+        return slot.buffer.template Data<T>();
+      }
+
+      /// \brief Publish the back slot written since BeginWrite().
+      public: void EndWrite()
+      {
+        this->back = this->state.exchange(this->back | kFresh) & kIndexMask;
+      }
+
+      /// \brief Copy a frame into the back slot and publish it.
+      /// \param[in] _data Frame data.
+      /// \param[in] _count Number of elements in _data.
+      public: void Write(const T *_data, std::size_t _count)
+      {
+        std::copy(_data, _data + _count, this->BeginWrite(_count));
+        this->EndWrite();
+      }
+
+      /// \brief Make the most recently published frame the front frame.
+      /// \return True if a new frame was published since the last call.
+      public: bool Acquire()
+      {
+        if (!(this->state.load() & kFresh))
+          return false;
+        this->front = this->state.exchange(this->front) & kIndexMask;
+        return true;
+      }
+
+      /// \brief Get the front frame.
+      /// \return Pointer to the front frame or nullptr if no frame has been
+      /// acquired yet.
+      public: T *Front()
+      {
+        return this->slots[this->front].buffer.template Data<T>();
+      }
+
+      /// \brief Get the number of elements in the front frame.
+      /// \return Number of elements.
+      public: std::size_t FrontSize() const
+      {
+        return this->slots[this->front].count;
+      }
+
+      /// \brief Bit set in the shared state when the middle slot holds a
+      /// frame the consumer has not acquired yet.
+      private: static constexpr unsigned int kFresh = 0x4u;
+
+      /// \brief Mask to extract a slot index from the shared state.
+      private: static constexpr unsigned int kIndexMask = 0x3u;
+
+      /// \brief Storage for one frame.
+      private: struct Slot
+      {
+        /// \brief Frame memory.
+        FrameBuffer buffer;
+
+        /// \brief Number of elements in the frame.
+        std::size_t count = 0u;
+      };
+
+      /// \brief Frame storage.
+      private: std::array<Slot, 3> slots;
+
+      /// \brief Slot owned by the producer.
+      private: unsigned int back = 0u;
+
+      /// \brief Slot owned by the consumer.
+      private: unsigned int front = 1u;
+
+      /// \brief Index of the middle slot plus the kFresh flag.
+      private: std::atomic<unsigned int> state{2u};
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "TripleBuffer.hh"
+
+using namespace gz;
+using namespace sensors;
+
+//////////////////////////////////////////////////
+TEST(TripleBuffer_TEST, Empty)
+{
+  TripleBuffer<float> buffer;
+  EXPECT_FALSE(buffer.Acquire());
+  EXPECT_EQ(nullptr, buffer.Front());
+  EXPECT_EQ(0u, buffer.FrontSize());
+}
+
+//////////////////////////////////////////////////
+TEST(TripleBuffer_TEST, WriteAcquire)
+{
+  TripleBuffer<float> buffer;
+
+  std::vector<float> frame0 = {1.0f, 2.0f, 3.0f};
+  buffer.Write(frame0.data(), frame0.size());
+
+  EXPECT_TRUE(buffer.Acquire());
+  ASSERT_EQ(3u, buffer.FrontSize());
+  ASSERT_NE(nullptr, buffer.Front());
+  EXPECT_FLOAT_EQ(1.0f, buffer.Front()[0]);
+  EXPECT_FLOAT_EQ(3.0f, buffer.Front()[2]);
+
+  // Nothing new, front frame is unchanged
+  EXPECT_FALSE(buffer.Acquire());
+  EXPECT_FLOAT_EQ(1.0f, buffer.Front()[0]);
+
+  // Writing does not touch the front frame until it is acquired
+  std::vector<float> frame1 = {4.0f, 5.0f};
+  buffer.Write(frame1.data(), frame1.size());
+  EXPECT_EQ(3u, buffer.FrontSize());
+  EXPECT_FLOAT_EQ(1.0f, buffer.Front()[0]);
+
+  // Only the latest of several frames is acquired
+  std::vector<float> frame2 = {6.0f, 7.0f, 8.0f, 9.0f};
+  buffer.Write(frame2.data(), frame2.size());
+  EXPECT_TRUE(buffer.Acquire());
+  ASSERT_EQ(4u, buffer.FrontSize());
+  EXPECT_FLOAT_EQ(6.0f, buffer.Front()[0]);
+  EXPECT_FLOAT_EQ(9.0f, buffer.Front()[3]);
+}
+
+//////////////////////////////////////////////////
+TEST(TripleBuffer_TEST, ProducerConsumer)
+{
+  TripleBuffer<unsigned int> buffer;
+  const unsigned int frameCount = 10000u;
+  const unsigned int frameSize = 64u;
+
+  // Each frame is filled with its index. A torn frame would contain mixed
+  // values and frames must be seen in increasing order.
+  std::thread producer([&]()
+  {
+    for (unsigned int i = 1u; i <= frameCount; ++i)
+    {
+      unsigned int *data = buffer.BeginWrite(frameSize);
+      for (unsigned int j = 0u; j < frameSize; ++j)
+        data[j] = i;
+      buffer.EndWrite();
+    }
+  });
+
+  // Failures stop reading rather than return, so the producer is joined
+  unsigned int last = 0u;
+  bool valid = true;
+  while (valid && last < frameCount)
+  {
+    if (!buffer.Acquire())
+      continue;
+    const unsigned int *data = buffer.Front();
+    valid = buffer.FrontSize() == frameSize && data[0] > last;
+    for (unsigned int j = 1u; valid && j < frameSize; ++j)
+      valid = data[0] == data[j];
+    EXPECT_TRUE(valid) << "Frame " << data[0] << " after frame " << last;
+    last = data[0];
+  }
+  producer.join();
+}
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
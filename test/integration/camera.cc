@@ -94,6 +94,12 @@ class CameraSensorTest: public testing::Test,
 
   // Create camera sensors and verify camera projection
   public: void CameraProjection(const std::string &_renderEngine);
+
+  // Crop and bin camera images and verify the camera info matches
+  public: void ImageRegion(const std::string &_renderEngine);
+
+  // Publish camera info on changes and at a low rate
+  public: void InfoRate(const std::string &_renderEngine);
 };
 
 void CameraSensorTest::ImagesWithBuiltinSDF(const std::string &_renderEngine)
@@ -968,6 +974,236 @@ TEST_P(CameraSensorTest, LInt16ImagesWithBuiltinSDF)
   ImageFormatLInt16(GetParam());
 }
 
+//////////////////////////////////////////////////
+void CameraSensorTest::ImageRegion(const std::string &_renderEngine)
+{
+  std::string path = ignition::common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "sdf", "camera_sensor_builtin.sdf");
+  sdf::SDFPtr doc(new sdf::SDF());
+  sdf::init(doc);
+  ASSERT_TRUE(sdf::readFile(path, doc));
+  ASSERT_NE(nullptr, doc->Root());
+  ASSERT_TRUE(doc->Root()->HasElement("model"));
+  auto modelPtr = doc->Root()->GetElement("model");
+  ASSERT_TRUE(modelPtr->HasElement("link"));
+  auto linkPtr = modelPtr->GetElement("link");
+  ASSERT_TRUE(linkPtr->HasElement("sensor"));
+  auto sensorPtr = linkPtr->GetElement("sensor");
+
+  // Setup ign-rendering with an empty scene
+  auto *engine = ignition::rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ignition::rendering::ScenePtr scene = engine->CreateScene("scene");
+
+  ignition::sensors::Manager mgr;
+
+  ignition::sensors::CameraSensor *sensor =
+      mgr.CreateSensor<ignition::sensors::CameraSensor>(sensorPtr);
+  ASSERT_NE(sensor, nullptr);
+  sensor->SetScene(scene);
+  EXPECT_EQ(256u, sensor->PublishedImageWidth());
+  EXPECT_EQ(257u, sensor->PublishedImageHeight());
+
+  // Unsupported binning leaves the whole image
+  EXPECT_FALSE(sensor->SetImageRegion(0u, 0u, 0u, 0u, 3u));
+  EXPECT_EQ(256u, sensor->PublishedImageWidth());
+
+  // A 128 wide region down to the last row, binned 2x2
+  EXPECT_TRUE(sensor->SetImageRegion(16u, 1u, 128u, 0u, 2u));
+  EXPECT_EQ(256u, sensor->ImageWidth());
+  EXPECT_EQ(64u, sensor->PublishedImageWidth());
+  EXPECT_EQ(128u, sensor->PublishedImageHeight());
+
+  std::string topic = "/test/integration/CameraPlugin_imagesWithBuiltinSDF";
+  WaitForMessageTestHelper<ignition::msgs::Image> helper(topic);
+  WaitForMessageTestHelper<ignition::msgs::CameraInfo> infoHelper(
+      sensor->InfoTopic());
+
+  mgr.RunOnce(std::chrono::steady_clock::duration::zero());
+  EXPECT_TRUE(helper.WaitForMessage()) << helper;
+  EXPECT_TRUE(infoHelper.WaitForMessage()) << infoHelper;
+
+  ignition::msgs::Image image = helper.Message();
+  EXPECT_EQ(64u, image.width());
+  EXPECT_EQ(128u, image.height());
+  EXPECT_EQ(64u * 3u, image.step());
+  EXPECT_EQ(64u * 128u * 3u, image.data().size());
+
+  // Intrinsics and projection describe the published image
+  ignition::msgs::CameraInfo info = infoHelper.Message();
+  EXPECT_EQ(64u, info.width());
+  EXPECT_EQ(128u, info.height());
+  ASSERT_EQ(9, info.intrinsics().k_size());
+  EXPECT_DOUBLE_EQ(140.0, info.intrinsics().k(0));
+  EXPECT_DOUBLE_EQ((162.0 - 16.0 + 0.5) / 2.0 - 0.5, info.intrinsics().k(2));
+  EXPECT_DOUBLE_EQ(140.5, info.intrinsics().k(4));
+  EXPECT_DOUBLE_EQ((124.0 - 1.0 + 0.5) / 2.0 - 0.5, info.intrinsics().k(5));
+  ASSERT_EQ(12, info.projection().p_size());
+  EXPECT_DOUBLE_EQ(141.0, info.projection().p(0));
+  EXPECT_DOUBLE_EQ(0.5, info.projection().p(3));
+
+  // Clean up
+  engine->DestroyScene(scene);
+  ignition::rendering::unloadEngine(engine->Name());
+}
+
+//////////////////////////////////////////////////
+TEST_P(CameraSensorTest, ImageRegion)
+{
+  ImageRegion(GetParam());
+}
+
+//////////////////////////////////////////////////
+void CameraSensorTest::InfoRate(const std::string &_renderEngine)
+{
+  std::string path = ignition::common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "sdf", "camera_sensor_builtin.sdf");
+  sdf::SDFPtr doc(new sdf::SDF());
+  sdf::init(doc);
+  ASSERT_TRUE(sdf::readFile(path, doc));
+  ASSERT_NE(nullptr, doc->Root());
+  ASSERT_TRUE(doc->Root()->HasElement("model"));
+  auto modelPtr = doc->Root()->GetElement("model");
+  ASSERT_TRUE(modelPtr->HasElement("link"));
+  auto linkPtr = modelPtr->GetElement("link");
+  ASSERT_TRUE(linkPtr->HasElement("sensor"));
+  auto sensorPtr = linkPtr->GetElement("sensor");
+
+  // Setup ign-rendering with an empty scene
+  auto *engine = ignition::rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ignition::rendering::ScenePtr scene = engine->CreateScene("scene");
+
+  ignition::sensors::Manager mgr;
+
+  ignition::sensors::CameraSensor *sensor =
+      mgr.CreateSensor<ignition::sensors::CameraSensor>(sensorPtr);
+  ASSERT_NE(sensor, nullptr);
+  sensor->SetScene(scene);
+  EXPECT_GT(0.0, sensor->InfoRate());
+
+  // Rates that would leave late subscribers without camera info are raised
+  sensor->SetInfoRate(0.0);
+  EXPECT_DOUBLE_EQ(0.1, sensor->InfoRate());
+
+  std::mutex mutex;
+  unsigned int infoCounter = 0u;
+  ignition::msgs::CameraInfo info;
+  std::function<void(const ignition::msgs::CameraInfo &)> infoCallback =
+      [&](const ignition::msgs::CameraInfo &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        info = _msg;
+        infoCounter++;
+      };
+  ignition::transport::Node node;
+  node.Subscribe(sensor->InfoTopic(), infoCallback);
+
+  auto waitForInfo = [&](const unsigned int &_counter, unsigned int _count)
+  {
+    for (int sleep = 0; sleep < 10; ++sleep)
+    {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (_counter >= _count)
+          return;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+  };
+
+  // The first update publishes to the new subscriber, later updates do not
+  for (int sec = 1; sec <= 3; ++sec)
+    sensor->Update(std::chrono::seconds(sec));
+  waitForInfo(infoCounter, 2u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(1u, infoCounter);
+    EXPECT_EQ(1, info.header().stamp().sec());
+    ASSERT_EQ(12, info.projection().p_size());
+    EXPECT_DOUBLE_EQ(0.0, info.projection().p(3));
+    ASSERT_LT(0, info.header().data_size());
+    EXPECT_EQ("frame_id", info.header().data(0).key());
+  }
+
+  // A change is published on the next update
+  sensor->SetBaseline(0.1);
+  sensor->Update(std::chrono::seconds(4));
+  waitForInfo(infoCounter, 2u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(2u, infoCounter);
+    EXPECT_EQ(4, info.header().stamp().sec());
+    EXPECT_NEAR(-info.projection().p(0) * 0.1, info.projection().p(3), 1e-6);
+  }
+
+  // A subscriber that joins while another is connected gets the message
+  // when it is republished, ten seconds after the last one at 0.1 Hz
+  unsigned int lateCounter = 0u;
+  ignition::msgs::CameraInfo lateInfo;
+  std::function<void(const ignition::msgs::CameraInfo &)> lateCallback =
+      [&](const ignition::msgs::CameraInfo &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        lateInfo = _msg;
+        lateCounter++;
+      };
+  ignition::transport::Node lateNode;
+  lateNode.Subscribe(sensor->InfoTopic(), lateCallback);
+  for (int sec = 5; sec <= 13; ++sec)
+    sensor->Update(std::chrono::seconds(sec));
+  waitForInfo(lateCounter, 1u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(0u, lateCounter);
+    EXPECT_EQ(2u, infoCounter);
+  }
+  sensor->Update(std::chrono::seconds(14));
+  waitForInfo(lateCounter, 1u);
+  waitForInfo(infoCounter, 3u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(1u, lateCounter);
+    EXPECT_EQ(14, lateInfo.header().stamp().sec());
+    EXPECT_NEAR(-lateInfo.projection().p(0) * 0.1,
+        lateInfo.projection().p(3), 1e-6);
+    EXPECT_EQ(3u, infoCounter);
+  }
+
+  // At 0.5 Hz the unchanged message is republished every two seconds
+  sensor->SetInfoRate(0.5);
+  for (int sec = 15; sec <= 17; ++sec)
+    sensor->Update(std::chrono::seconds(sec));
+  waitForInfo(infoCounter, 5u);
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(4u, infoCounter);
+    EXPECT_EQ(16, info.header().stamp().sec());
+  }
+
+  // Clean up
+  engine->DestroyScene(scene);
+  ignition::rendering::unloadEngine(engine->Name());
+}
+
+//////////////////////////////////////////////////
+TEST_P(CameraSensorTest, InfoRate)
+{
+  InfoRate(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(CameraSensor, CameraSensorTest,
     RENDER_ENGINE_VALUES, ignition::rendering::PrintToStringParam());
 
@@ -17,6 +17,10 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <mutex>
+#include <vector>
+
 #ifdef _WIN32
 #pragma warning(push)
 #pragma warning(disable: 4005)
@@ -149,6 +153,9 @@ class DepthCameraSensorTest: public testing::Test,
 {
   // Create a Camera sensor from a SDF and gets a image message
   public: void ImagesWithBuiltinSDF(const std::string &_renderEngine);
+
+  // Create a Camera sensor with lens distortion and check its frames
+  public: void DistortedWithBuiltinSDF(const std::string &_renderEngine);
 };
 
 void DepthCameraSensorTest::ImagesWithBuiltinSDF(
@@ -502,12 +509,123 @@ void DepthCameraSensorTest::ImagesWithBuiltinSDF(
   gz::rendering::unloadEngine(engine->Name());
 }
 
+void DepthCameraSensorTest::DistortedWithBuiltinSDF(
+    const std::string &_renderEngine)
+{
+  std::string path = gz::common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "sdf", "depth_camera_distortion_sensor_builtin.sdf");
+  sdf::SDFPtr doc(new sdf::SDF());
+  sdf::init(doc);
+  ASSERT_TRUE(sdf::readFile(path, doc));
+  ASSERT_NE(nullptr, doc->Root());
+  auto sensorPtr = doc->Root()->GetElement("model")->GetElement("link")->
+      GetElement("sensor");
+  ASSERT_NE(nullptr, sensorPtr);
+
+  // If ogre is not the engine, don't run the test
+  if ((_renderEngine.compare("ogre") != 0) &&
+      (_renderEngine.compare("ogre2") != 0))
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' doesn't support depth cameras" << std::endl;
+    return;
+  }
+
+  auto *engine = gz::rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  // A box filling the undistorted view
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  gz::rendering::VisualPtr root = scene->RootVisual();
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(1.0, 0.0, 0.0);
+  box->SetLocalScale(1.0, 10.0, 10.0);
+  root->AddChild(box);
+
+  gz::sensors::Manager mgr;
+  gz::sensors::DepthCameraSensor *depthSensor =
+      mgr.CreateSensor<gz::sensors::DepthCameraSensor>(sensorPtr);
+  ASSERT_NE(depthSensor, nullptr);
+  depthSensor->SetScene(scene);
+  const unsigned int width = depthSensor->ImageWidth();
+  const unsigned int height = depthSensor->ImageHeight();
+
+  std::string topic =
+    "/test/integration/DepthCameraPlugin_distortedWithBuiltinSDF/image";
+  gz::transport::Node node;
+  std::mutex mutex;
+  std::vector<float> depth;
+  node.Subscribe<gz::msgs::Image>(topic,
+      [&](const gz::msgs::Image &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        depth.resize(_msg.width() * _msg.height());
+        memcpy(depth.data(), _msg.data().c_str(),
+            depth.size() * sizeof(float));
+      });
+
+  bool pointsDense = true;
+  unsigned int pointsCounter = 0u;
+  node.Subscribe<gz::msgs::PointCloudPacked>(topic + "/points",
+      [&](const gz::msgs::PointCloudPacked &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        pointsDense = _msg.is_dense();
+        ++pointsCounter;
+      });
+
+  for (int sleep = 0; sleep < 300; ++sleep)
+  {
+    mgr.RunOnce(std::chrono::steady_clock::duration::zero(), true);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!depth.empty() && pointsCounter > 0u)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  ASSERT_EQ(width * height, depth.size());
+  EXPECT_GT(pointsCounter, 0u);
+  EXPECT_FALSE(pointsDense);
+
+  // The center sees the box. Barrel distortion samples the corners from
+  // outside the rendered view, which have no depth.
+  const float expectedDepth = 0.5f;
+  EXPECT_NEAR(expectedDepth, depth[height / 2u * width + width / 2u],
+      DEPTH_TOL);
+  EXPECT_TRUE(std::isnan(depth[0]));
+  EXPECT_TRUE(std::isnan(depth[width * height - 1u]));
+
+  // Depth is never blended, valid pixels all see the box face
+  for (float d : depth)
+  {
+    if (!std::isnan(d))
+      EXPECT_NEAR(expectedDepth, d, 0.1);
+  }
+
+  box.reset();
+  mgr.Remove(depthSensor->Id());
+  engine->DestroyScene(scene);
+  gz::rendering::unloadEngine(engine->Name());
+}
+
 //////////////////////////////////////////////////
 TEST_P(DepthCameraSensorTest, ImagesWithBuiltinSDF)
 {
   ImagesWithBuiltinSDF(GetParam());
 }
 
+//////////////////////////////////////////////////
+TEST_P(DepthCameraSensorTest, DistortedWithBuiltinSDF)
+{
+  DistortedWithBuiltinSDF(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(DepthCameraSensor, DepthCameraSensorTest,
     RENDER_ENGINE_VALUES, gz::rendering::PrintToStringParam());
 
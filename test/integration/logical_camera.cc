@@ -22,9 +22,11 @@
 #include <gz/common/Console.hh>
 
 #include <gz/sensors/LogicalCameraSensor.hh>
+#include <gz/sensors/ModelPoseSnapshot.hh>
 #include <gz/sensors/SensorFactory.hh>
 #include <gz/sensors/Export.hh>
 
+#include <gz/math/Frustum.hh>
 #include <gz/math/Helpers.hh>
 #ifdef _WIN32
 #pragma warning(push)
@@ -244,6 +246,144 @@ TEST_F(LogicalCameraSensorTest, DetectBox)
   EXPECT_TRUE(helper.WaitForMessage()) << helper;
 }
 
+/////////////////////////////////////////////////
+TEST_F(LogicalCameraSensorTest, DetectManyModels)
+{
+  const std::string name = "TestLogicalCamera";
+  const std::string topic = "/ignition/sensors/test/logical_camera_many";
+  const double near = 0.55;
+  const double far = 5;
+  const double horzFov = 1.04719755;
+  const double aspectRatio = 1.778;
+
+  gz::math::Pose3d sensorPose(gz::math::Vector3d(0.5, -1.0, 0.5),
+      gz::math::Quaterniond(0, 0.1, 0.4));
+  sdf::ElementPtr logicalCameraSdf = LogicalCameraToSdf(name, sensorPose,
+        30, topic, near, far, horzFov, aspectRatio, true, false);
+
+  gz::sensors::SensorFactory sf;
+  auto sensor = sf.CreateSensor<gz::sensors::LogicalCameraSensor>(
+      logicalCameraSdf);
+  ASSERT_NE(nullptr, sensor);
+
+  gz::math::Frustum frustum(near, far, gz::math::Angle(horzFov),
+      aspectRatio, sensorPose);
+
+  // Models scattered around the camera, the detected ones must be exactly
+  // those in the frustum, in name order
+  auto check = [&](const std::map<std::string, gz::math::Pose3d> &_models)
+  {
+    std::vector<std::string> expected;
+    for (const auto &it : _models)
+    {
+      if (frustum.Contains(it.second.Pos()))
+        expected.push_back(it.first);
+    }
+    EXPECT_FALSE(expected.empty());
+
+    sensor->Update(std::chrono::steady_clock::duration::zero());
+    auto img = sensor->Image();
+    ASSERT_EQ(expected.size(), static_cast<std::size_t>(img.model().size()));
+    for (std::size_t i = 0; i < expected.size(); ++i)
+      EXPECT_EQ(expected[i], img.model(static_cast<int>(i)).name());
+  };
+
+  std::map<std::string, gz::math::Pose3d> models;
+  for (int i = 0; i < 2000; ++i)
+  {
+    models["model_" + std::to_string(i)] = gz::math::Pose3d(
+        (i * 37 % 241) * 0.1 - 12.0, (i * 53 % 199) * 0.1 - 10.0,
+        (i % 11) * 0.2 - 0.5, 0, 0, 0);
+  }
+  auto copy = models;
+  sensor->SetModelPoses(std::move(copy));
+  check(models);
+
+  // The same models, moved
+  for (auto &it : models)
+    it.second.Pos() += gz::math::Vector3d(1.3, -0.7, 0.1);
+  copy = models;
+  sensor->SetModelPoses(std::move(copy));
+  check(models);
+
+  // Models added and removed
+  models.erase("model_7");
+  models.erase("model_1234");
+  models["added"] = gz::math::Pose3d(3.0, -0.5, 0.6, 0, 0, 0);
+  copy = models;
+  sensor->SetModelPoses(std::move(copy));
+  check(models);
+}
+
+/////////////////////////////////////////////////
+TEST_F(LogicalCameraSensorTest, SharedSnapshot)
+{
+  const double near = 0.55;
+  const double far = 5;
+  const double horzFov = 1.04719755;
+  const double aspectRatio = 1.778;
+
+  std::map<std::string, gz::math::Pose3d> models;
+  for (int i = 0; i < 2000; ++i)
+  {
+    models["model_" + std::to_string(i)] = gz::math::Pose3d(
+        (i * 37 % 241) * 0.1 - 12.0, (i * 53 % 199) * 0.1 - 10.0,
+        (i % 11) * 0.2 - 0.5, 0, 0, 0.1 * i);
+  }
+  auto snapshot =
+      std::make_shared<const gz::sensors::ModelPoseSnapshot>(models);
+  EXPECT_EQ(models.size(), snapshot->Count());
+
+  // Cameras looking in different directions share the snapshot
+  gz::sensors::SensorFactory sf;
+  std::vector<std::unique_ptr<gz::sensors::LogicalCameraSensor>> cameras;
+  std::vector<gz::sensors::LogicalCameraSensor *> sensors;
+  std::vector<gz::math::Pose3d> poses;
+  for (int i = 0; i < 8; ++i)
+  {
+    gz::math::Pose3d pose(gz::math::Vector3d(i - 4.0, 0.5 * i - 2.0, 0.5),
+        gz::math::Quaterniond(0, 0.05 * i, 0.8 * i));
+    auto sdf = LogicalCameraToSdf("camera_" + std::to_string(i), pose, 30,
+        "/ignition/sensors/test/logical_camera_" + std::to_string(i), near,
+        far, horzFov, aspectRatio, true, false);
+    cameras.push_back(
+        sf.CreateSensor<gz::sensors::LogicalCameraSensor>(sdf));
+    ASSERT_NE(nullptr, cameras.back());
+    sensors.push_back(cameras.back().get());
+    poses.push_back(pose);
+  }
+
+  gz::sensors::LogicalCameraSensor::UpdateAll(sensors, snapshot,
+      std::chrono::steady_clock::duration::zero());
+
+  for (std::size_t c = 0; c < sensors.size(); ++c)
+  {
+    gz::math::Frustum frustum(near, far, gz::math::Angle(horzFov),
+        aspectRatio, poses[c]);
+    std::vector<std::string> expected;
+    for (const auto &it : models)
+    {
+      if (frustum.Contains(it.second.Pos()))
+        expected.push_back(it.first);
+    }
+
+    auto img = sensors[c]->Image();
+    ASSERT_EQ(expected.size(), static_cast<std::size_t>(img.model().size()));
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      EXPECT_EQ(expected[i], img.model(static_cast<int>(i)).name());
+      EXPECT_EQ(models[expected[i]] - poses[c],
+          gz::msgs::Convert(img.model(static_cast<int>(i)).pose()));
+    }
+  }
+
+  // Setting poses again replaces the snapshot
+  std::map<std::string, gz::math::Pose3d> none;
+  sensors[0]->SetModelPoses(std::move(none));
+  sensors[0]->Update(std::chrono::steady_clock::duration::zero());
+  EXPECT_EQ(0, sensors[0]->Image().model().size());
+}
+
 /////////////////////////////////////////////////
 TEST_F(LogicalCameraSensorTest, Topic)
 {
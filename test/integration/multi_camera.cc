@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable: 4005)
+#pragma warning(disable: 4251)
+#endif
+#include <gz/msgs/camera_info.pb.h>
+#include <ignition/msgs.hh>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#include <gz/common/Filesystem.hh>
+#include <gz/common/Event.hh>
+#include <gz/sensors/Manager.hh>
+#include <gz/sensors/MultiCameraSensor.hh>
+
+// TODO(louise) Remove these pragmas once ign-rendering is disabling the
+// warnings
+#ifdef _WIN32
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+#include <gz/rendering/Material.hh>
+#include <gz/rendering/RenderEngine.hh>
+#include <gz/rendering/RenderingIface.hh>
+#include <gz/rendering/Scene.hh>
+#include <gz/rendering/Visual.hh>
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "TransportTestTools.hh"
+
+using namespace gz;
+
+std::mutex g_mutex;
+std::vector<msgs::Image> g_images;
+unsigned int g_setCounter = 0;
+
+void OnImages(const std::vector<msgs::Image> &_images)
+{
+  std::lock_guard<std::mutex> lock(g_mutex);
+  g_images = _images;
+  g_setCounter++;
+}
+
+class MultiCameraSensorTest: public testing::Test,
+  public testing::WithParamInterface<const char *>
+{
+  // Create a Multi Camera sensor from a SDF and gets image messages
+  public: void ImagesWithBuiltinSDF(const std::string &_renderEngine);
+};
+
+void MultiCameraSensorTest::ImagesWithBuiltinSDF(
+    const std::string &_renderEngine)
+{
+  std::string path = common::joinPaths(PROJECT_SOURCE_PATH, "test", "sdf",
+      "multi_camera_sensor_builtin.sdf");
+  sdf::SDFPtr doc(new sdf::SDF());
+  sdf::init(doc);
+  ASSERT_TRUE(sdf::readFile(path, doc));
+  ASSERT_NE(nullptr, doc->Root());
+  ASSERT_TRUE(doc->Root()->HasElement("model"));
+  auto modelPtr = doc->Root()->GetElement("model");
+  ASSERT_TRUE(modelPtr->HasElement("link"));
+  auto linkPtr = modelPtr->GetElement("link");
+  ASSERT_TRUE(linkPtr->HasElement("sensor"));
+  auto sensorPtr = linkPtr->GetElement("sensor");
+
+  // Setup ign-rendering with an empty scene
+  auto *engine = rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  rendering::ScenePtr scene = engine->CreateScene("scene");
+
+  // Create a box in front of the cameras
+  rendering::VisualPtr root = scene->RootVisual();
+  rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetOrigin(0.0, 0.0, 0.0);
+  box->SetLocalPosition(2.0, 0.0, 0.0);
+  box->SetLocalRotation(0, 0, 0);
+  box->SetLocalScale(1, 1, 1);
+  rendering::MaterialPtr blue = scene->CreateMaterial();
+  blue->SetAmbient(0.0, 0.0, 1.0);
+  blue->SetDiffuse(0.0, 0.0, 1.0);
+  blue->SetSpecular(0.0, 0.0, 1.0);
+  box->SetMaterial(blue);
+  root->AddChild(box);
+
+  sensors::Manager mgr;
+
+  auto *sensor = mgr.CreateSensor<sensors::MultiCameraSensor>(sensorPtr);
+  ASSERT_NE(sensor, nullptr);
+  EXPECT_FALSE(sensor->HasConnections());
+  sensor->SetScene(scene);
+
+  ASSERT_EQ(2u, sensor->CameraCount());
+  EXPECT_EQ("left", sensor->CameraName(0u));
+  EXPECT_EQ("right", sensor->CameraName(1u));
+  EXPECT_TRUE(sensor->CameraName(2u).empty());
+  ASSERT_NE(nullptr, sensor->RenderingCamera(0u));
+  ASSERT_NE(nullptr, sensor->RenderingCamera(1u));
+  EXPECT_EQ(nullptr, sensor->RenderingCamera(2u));
+  EXPECT_EQ(320u, sensor->ImageWidth(0u));
+  EXPECT_EQ(160u, sensor->ImageWidth(1u));
+  EXPECT_EQ(240u, sensor->ImageHeight(1u));
+  EXPECT_TRUE(sensor->SideBySide());
+
+  std::string topic =
+      "/test/integration/MultiCameraPlugin_imagesWithBuiltinSDF";
+  WaitForMessageTestHelper<msgs::Image> leftHelper(topic + "/left/image");
+  WaitForMessageTestHelper<msgs::Image> rightHelper(topic + "/right/image");
+  WaitForMessageTestHelper<msgs::Image> packedHelper(topic + "/side_by_side");
+  WaitForMessageTestHelper<msgs::CameraInfo> infoHelper(
+      topic + "/right/camera_info");
+  EXPECT_TRUE(sensor->HasConnections());
+
+  auto connection = sensor->ConnectImagesCallback(&OnImages);
+
+  mgr.RunOnce(std::chrono::seconds(1));
+
+  EXPECT_TRUE(leftHelper.WaitForMessage()) << leftHelper;
+  EXPECT_TRUE(rightHelper.WaitForMessage()) << rightHelper;
+  EXPECT_TRUE(packedHelper.WaitForMessage()) << packedHelper;
+  EXPECT_TRUE(infoHelper.WaitForMessage()) << infoHelper;
+
+  // All images of a set have the same stamp
+  msgs::Image left = leftHelper.Message();
+  msgs::Image right = rightHelper.Message();
+  msgs::Image packed = packedHelper.Message();
+  EXPECT_EQ(1, left.header().stamp().sec());
+  EXPECT_EQ(1, right.header().stamp().sec());
+  EXPECT_EQ(1, packed.header().stamp().sec());
+  EXPECT_EQ(320u, left.width());
+  EXPECT_EQ(160u, right.width());
+
+  // The side by side image holds the left image, then the right image
+  ASSERT_EQ(480u, packed.width());
+  ASSERT_EQ(240u, packed.height());
+  ASSERT_EQ(480u * 3u, packed.step());
+  ASSERT_EQ(packed.step() * packed.height(), packed.data().size());
+  for (unsigned int row = 0u; row < packed.height(); ++row)
+  {
+    EXPECT_EQ(left.data().substr(row * left.step(), left.step()),
+        packed.data().substr(row * packed.step(), left.step()));
+    EXPECT_EQ(right.data().substr(row * right.step(), right.step()),
+        packed.data().substr(row * packed.step() + left.step(),
+        right.step()));
+  }
+
+  // The right camera carries the baseline to the left camera
+  msgs::CameraInfo info = infoHelper.Message();
+  ASSERT_EQ(12, info.projection().p_size());
+  EXPECT_NEAR(-info.projection().p(0) * 0.1, info.projection().p(3), 1e-6);
+  EXPECT_EQ(160u, info.width());
+
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    EXPECT_EQ(1u, g_setCounter);
+    ASSERT_EQ(2u, g_images.size());
+    EXPECT_EQ(1, g_images[0].header().stamp().sec());
+    EXPECT_EQ(1, g_images[1].header().stamp().sec());
+    EXPECT_EQ(left.data(), g_images[0].data());
+    EXPECT_EQ(right.data(), g_images[1].data());
+  }
+
+  // Clean up rendering ptrs
+  box.reset();
+  blue.reset();
+
+  // Clean up
+  connection.reset();
+  mgr.Remove(sensor->Id());
+  engine->DestroyScene(scene);
+  rendering::unloadEngine(engine->Name());
+}
+
+//////////////////////////////////////////////////
+TEST_P(MultiCameraSensorTest, ImagesWithBuiltinSDF)
+{
+  ImagesWithBuiltinSDF(GetParam());
+}
+
+INSTANTIATE_TEST_CASE_P(MultiCameraSensor, MultiCameraSensorTest,
+    RENDER_ENGINE_VALUES, rendering::PrintToStringParam());
+
+//////////////////////////////////////////////////
+int main(int argc, char **argv)
+{
+  common::Console::SetVerbosity(4);
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <mutex>
+
 #include <ignition/common/Filesystem.hh>
 #include <ignition/sensors/Manager.hh>
 #include <ignition/sensors/SegmentationCameraSensor.hh>
@@ -169,6 +171,10 @@ class SegmentationCameraSensorTest: public testing::Test,
 {
   // Create a Segmentation Camera sensor from a SDF and gets a image message
   public: void ImagesWithBuiltinSDF(const std::string &_renderEngine);
+
+  // Create a Segmentation Camera sensor with an L8 labels map, run length
+  // encoded instances and measured boxes
+  public: void CompactLabelsWithBuiltinSDF(const std::string &_renderEngine);
 };
 
 /////////////////////////////////////////////////
@@ -367,6 +373,168 @@ TEST_P(SegmentationCameraSensorTest, ImagesWithBuiltinSDF)
   ImagesWithBuiltinSDF(GetParam());
 }
 
+/////////////////////////////////////////////////
+void SegmentationCameraSensorTest::CompactLabelsWithBuiltinSDF(
+  const std::string &_renderEngine)
+{
+  std::string path = ignition::common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "sdf", "segmentation_camera_sensor_compact_builtin.sdf");
+  sdf::SDFPtr doc(new sdf::SDF());
+  sdf::init(doc);
+  ASSERT_TRUE(sdf::readFile(path, doc));
+  ASSERT_NE(nullptr, doc->Root());
+  auto sensorPtr = doc->Root()->GetElement("model")->GetElement("link")->
+      GetElement("sensor");
+  ASSERT_NE(nullptr, sensorPtr);
+
+  // If ogre2 is not the engine, don't run the test
+  if (_renderEngine.compare("ogre2") != 0)
+  {
+    igndbg << "Engine '" << _renderEngine
+      << "' doesn't support segmentation cameras" << std::endl;
+    return;
+  }
+  auto *engine = ignition::rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  ignition::rendering::ScenePtr scene = engine->CreateScene("scene");
+  ASSERT_NE(nullptr, scene);
+  BuildScene(scene);
+
+  ignition::sensors::Manager mgr;
+  sdf::Sensor sdfSensor;
+  sdfSensor.Load(sensorPtr);
+  ignition::sensors::SegmentationCameraSensor *sensor =
+    mgr.CreateSensor<ignition::sensors::SegmentationCameraSensor>(sdfSensor);
+  ASSERT_NE(sensor, nullptr);
+  EXPECT_FALSE(sensor->HasConnections());
+  sensor->SetScene(scene);
+
+  auto camera = sensor->SegmentationCamera();
+  ASSERT_NE(camera, nullptr);
+  camera->SetLocalPosition(0.0, 0.0, 0.0);
+  camera->SetLocalRotation(0.0, 0.0, 0.0);
+  const uint32_t backgroundLabel = 23;
+  camera->SetBackgroundLabel(backgroundLabel);
+
+  std::string topic =
+    "/test/integration/SegmentationCameraPlugin_compactLabelsWithBuiltinSDF";
+  ignition::transport::Node node;
+  std::mutex mutex;
+  msgs::Image labelsMsg;
+  msgs::Int32_V instancesMsg;
+  msgs::AnnotatedAxisAligned2DBox_V boxesMsg;
+  node.Subscribe<msgs::Image>(topic + "/labels_map",
+      [&](const msgs::Image &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        labelsMsg = _msg;
+      });
+  node.Subscribe<msgs::Int32_V>(topic + "/instances",
+      [&](const msgs::Int32_V &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        instancesMsg = _msg;
+      });
+  node.Subscribe<msgs::AnnotatedAxisAligned2DBox_V>(topic + "/boxes",
+      [&](const msgs::AnnotatedAxisAligned2DBox_V &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        boxesMsg = _msg;
+      });
+  EXPECT_TRUE(sensor->HasConnections());
+
+  for (int sleep = 0; sleep < 300; ++sleep)
+  {
+    mgr.RunOnce(std::chrono::steady_clock::duration::zero(), true);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (labelsMsg.width() > 0u && instancesMsg.data_size() > 0 &&
+        boxesMsg.annotated_box_size() > 0)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const unsigned int width = sensor->ImageWidth();
+  const unsigned int height = sensor->ImageHeight();
+
+  // One byte per pixel
+  ASSERT_EQ(width, labelsMsg.width());
+  ASSERT_EQ(height, labelsMsg.height());
+  EXPECT_EQ(width, labelsMsg.step());
+  EXPECT_EQ(msgs::PixelFormatType::L_INT8, labelsMsg.pixel_format_type());
+  ASSERT_EQ(width * height, labelsMsg.data().size());
+  const auto *labels =
+      reinterpret_cast<const uint8_t *>(labelsMsg.data().data());
+  EXPECT_EQ(leftBoxLabel, labels[height / 2u * width + width / 4u]);
+  EXPECT_EQ(middleBoxLabel, labels[height / 2u * width + width / 2u]);
+  EXPECT_EQ(backgroundLabel, labels[0]);
+
+  // Instances of the two visible labels, the background is skipped
+  ASSERT_GE(instancesMsg.data_size(), 3);
+  EXPECT_EQ(static_cast<int>(width), instancesMsg.data(0));
+  EXPECT_EQ(static_cast<int>(height), instancesMsg.data(1));
+  EXPECT_EQ(2, instancesMsg.data(2));
+  int index = 3;
+  int pixels = 0;
+  for (int i = 0; i < instancesMsg.data(2); ++i)
+  {
+    ASSERT_LT(index + 2, instancesMsg.data_size());
+    EXPECT_NE(static_cast<int>(backgroundLabel), instancesMsg.data(index));
+    EXPECT_NE(static_cast<int>(hiddenLabel), instancesMsg.data(index));
+    const int runs = instancesMsg.data(index + 2);
+    index += 3;
+    for (int r = 0; r < runs; ++r, index += 2)
+      pixels += instancesMsg.data(index + 1);
+  }
+  EXPECT_EQ(instancesMsg.data_size(), index);
+  EXPECT_GT(pixels, 0);
+  EXPECT_LT(pixels, static_cast<int>(width * height));
+
+  // One box per label: the outer boxes share theirs and span the view, the
+  // middle box is centered
+  ASSERT_EQ(2, boxesMsg.annotated_box_size());
+  int boxPixels = 0;
+  for (const auto &annotated : boxesMsg.annotated_box())
+  {
+    const auto &box = annotated.box();
+    ASSERT_EQ(3, box.header().data_size());
+    EXPECT_EQ("pixel_count", box.header().data(1).key());
+    boxPixels += std::stoi(box.header().data(1).value(0));
+    const double centroidU = std::stod(box.header().data(2).value(0));
+    EXPECT_LE(box.min_corner().x(), centroidU);
+    EXPECT_GE(box.max_corner().x(), centroidU);
+    if (annotated.label() == middleBoxLabel)
+    {
+      EXPECT_LT(box.min_corner().x(), width / 2.0);
+      EXPECT_GT(box.max_corner().x(), width / 2.0);
+      EXPECT_NEAR(width / 2.0, centroidU, 2.0);
+    }
+    else
+    {
+      EXPECT_EQ(leftBoxLabel, annotated.label());
+      EXPECT_LT(box.min_corner().x(), width / 4.0);
+      EXPECT_GT(box.max_corner().x(), width * 3.0 / 4.0);
+    }
+  }
+  EXPECT_EQ(pixels, boxPixels);
+
+  camera.reset();
+  mgr.Remove(sensor->Id());
+  engine->DestroyScene(scene);
+  ignition::rendering::unloadEngine(engine->Name());
+}
+
+//////////////////////////////////////////////////
+TEST_P(SegmentationCameraSensorTest, CompactLabelsWithBuiltinSDF)
+{
+  CompactLabelsWithBuiltinSDF(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(SegmentationCameraSensor, SegmentationCameraSensorTest,
     RENDER_ENGINE_VALUES, ignition::rendering::PrintToStringParam());
 
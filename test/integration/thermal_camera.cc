@@ -17,6 +17,8 @@
 
 #include <gtest/gtest.h>
 
+#include <mutex>
+
 #ifdef _WIN32
 #pragma warning(push)
 #pragma warning(disable: 4005)
@@ -102,6 +104,12 @@ class ThermalCameraSensorTest: public testing::Test,
 
   // Create a thermal camera sensor from a SDF with 8 bit image format
   public: void Images8BitWithBuiltinSDF(const std::string &_renderEngine);
+
+  // Create a thermal camera sensor with a false color palette
+  public: void PaletteWithBuiltinSDF(const std::string &_renderEngine);
+
+  // Create a thermal camera sensor that publishes image statistics
+  public: void StatisticsWithBuiltinSDF(const std::string &_renderEngine);
 };
 
 void ThermalCameraSensorTest::ImagesWithBuiltinSDF(
@@ -625,6 +633,224 @@ TEST_P(ThermalCameraSensorTest, Images8BitWithBuiltinSDF)
   Images8BitWithBuiltinSDF(GetParam());
 }
 
+void ThermalCameraSensorTest::PaletteWithBuiltinSDF(
+    const std::string &_renderEngine)
+{
+  std::string path = gz::common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "sdf", "thermal_camera_sensor_palette_builtin.sdf");
+  sdf::SDFPtr doc(new sdf::SDF());
+  sdf::init(doc);
+  ASSERT_TRUE(sdf::readFile(path, doc));
+  ASSERT_NE(nullptr, doc->Root());
+  auto sensorPtr = doc->Root()->GetElement("model")->GetElement("link")->
+      GetElement("sensor");
+  ASSERT_NE(nullptr, sensorPtr);
+
+  // If ogre is not the engine, don't run the test
+  if ((_renderEngine.compare("ogre") != 0) &&
+      (_renderEngine.compare("ogre2") != 0))
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' doesn't support thermal cameras" << std::endl;
+    return;
+  }
+
+  auto *engine = gz::rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  // A hot box in the middle of the view
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  gz::rendering::VisualPtr root = scene->RootVisual();
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(3.0, 0.0, 0.0);
+  box->SetUserData("temperature", 310.0f);
+  root->AddChild(box);
+
+  gz::sensors::Manager mgr;
+  gz::sensors::ThermalCameraSensor *thermalSensor =
+      mgr.CreateSensor<gz::sensors::ThermalCameraSensor>(sensorPtr);
+  ASSERT_NE(thermalSensor, nullptr);
+  thermalSensor->SetAmbientTemperature(296.0f);
+  thermalSensor->SetLinearResolution(0.01f);
+  thermalSensor->SetScene(scene);
+  EXPECT_FALSE(thermalSensor->HasConnections());
+
+  // Subscribing to the palette topic alone is enough to render
+  std::string topic =
+    "/test/integration/ThermalCameraPlugin_paletteWithBuiltinSDF/image";
+  gz::transport::Node node;
+  std::mutex mutex;
+  gz::msgs::Image paletteMsg;
+  node.Subscribe<gz::msgs::Image>(topic + "/palette",
+      [&](const gz::msgs::Image &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        paletteMsg = _msg;
+      });
+  EXPECT_TRUE(thermalSensor->HasConnections());
+
+  for (int sleep = 0; sleep < 300; ++sleep)
+  {
+    mgr.RunOnce(std::chrono::steady_clock::duration::zero(), true);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (paletteMsg.width() > 0u)
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const unsigned int width = thermalSensor->ImageWidth();
+  const unsigned int height = thermalSensor->ImageHeight();
+  ASSERT_EQ(width, paletteMsg.width());
+  ASSERT_EQ(height, paletteMsg.height());
+  EXPECT_EQ(width * 3u, paletteMsg.step());
+  EXPECT_EQ(gz::msgs::PixelFormatType::RGB_INT8,
+      paletteMsg.pixel_format_type());
+  ASSERT_EQ(width * height * 3u, paletteMsg.data().size());
+
+  // The box is the hottest, white in ironbow, the background is darker
+  const unsigned char *rgb =
+      reinterpret_cast<const unsigned char *>(paletteMsg.data().data());
+  const unsigned int mid = ((height / 2u) * width + width / 2u) * 3u;
+  EXPECT_EQ(255u, rgb[mid]);
+  EXPECT_EQ(255u, rgb[mid + 1u]);
+  EXPECT_EQ(255u, rgb[mid + 2u]);
+  const unsigned int left = (height / 2u) * width * 3u;
+  EXPECT_LT(rgb[left + 1u], 255u);
+
+  box.reset();
+  mgr.Remove(thermalSensor->Id());
+  engine->DestroyScene(scene);
+  gz::rendering::unloadEngine(engine->Name());
+}
+
+//////////////////////////////////////////////////
+TEST_P(ThermalCameraSensorTest, PaletteWithBuiltinSDF)
+{
+  PaletteWithBuiltinSDF(GetParam());
+}
+
+void ThermalCameraSensorTest::StatisticsWithBuiltinSDF(
+    const std::string &_renderEngine)
+{
+  std::string path = gz::common::joinPaths(PROJECT_SOURCE_PATH, "test",
+      "sdf", "thermal_camera_sensor_statistics_builtin.sdf");
+  sdf::SDFPtr doc(new sdf::SDF());
+  sdf::init(doc);
+  ASSERT_TRUE(sdf::readFile(path, doc));
+  ASSERT_NE(nullptr, doc->Root());
+  auto sensorPtr = doc->Root()->GetElement("model")->GetElement("link")->
+      GetElement("sensor");
+  ASSERT_NE(nullptr, sensorPtr);
+
+  // If ogre is not the engine, don't run the test
+  if ((_renderEngine.compare("ogre") != 0) &&
+      (_renderEngine.compare("ogre2") != 0))
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' doesn't support thermal cameras" << std::endl;
+    return;
+  }
+
+  auto *engine = gz::rendering::engine(_renderEngine);
+  if (!engine)
+  {
+    igndbg << "Engine '" << _renderEngine
+              << "' is not supported" << std::endl;
+    return;
+  }
+
+  // A hot box in the middle of the view
+  gz::rendering::ScenePtr scene = engine->CreateScene("scene");
+  gz::rendering::VisualPtr root = scene->RootVisual();
+  gz::rendering::VisualPtr box = scene->CreateVisual();
+  box->AddGeometry(scene->CreateBox());
+  box->SetLocalPosition(3.0, 0.0, 0.0);
+  box->SetUserData("temperature", 310.0f);
+  root->AddChild(box);
+
+  gz::sensors::Manager mgr;
+  gz::sensors::ThermalCameraSensor *thermalSensor =
+      mgr.CreateSensor<gz::sensors::ThermalCameraSensor>(sensorPtr);
+  ASSERT_NE(thermalSensor, nullptr);
+  thermalSensor->SetAmbientTemperature(296.0f);
+  thermalSensor->SetLinearResolution(0.01f);
+  thermalSensor->SetScene(scene);
+  EXPECT_FALSE(thermalSensor->HasConnections());
+
+  // Subscribing to the statistics topic alone is enough to render
+  std::string topic =
+    "/test/integration/ThermalCameraPlugin_statisticsWithBuiltinSDF/image";
+  gz::transport::Node node;
+  std::mutex mutex;
+  gz::msgs::Param statsMsg;
+  node.Subscribe<gz::msgs::Param>(topic + "/statistics",
+      [&](const gz::msgs::Param &_msg)
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        statsMsg = _msg;
+      });
+  EXPECT_TRUE(thermalSensor->HasConnections());
+
+  for (int sleep = 0; sleep < 300; ++sleep)
+  {
+    mgr.RunOnce(std::chrono::steady_clock::duration::zero(), true);
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!statsMsg.params().empty())
+      break;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex);
+  const auto &params = statsMsg.params();
+  ASSERT_EQ(1u, params.count("max"));
+  EXPECT_EQ(static_cast<int>(thermalSensor->ImageWidth()),
+      params.at("width").int_value());
+  EXPECT_EQ(static_cast<int>(thermalSensor->ImageHeight()),
+      params.at("height").int_value());
+
+  // The box is the hottest, the background is at the ambient temperature
+  EXPECT_NEAR(310.0, params.at("max").double_value(), 1.0);
+  EXPECT_NEAR(296.0, params.at("min").double_value(), 1.0);
+  EXPECT_LT(params.at("min").double_value(),
+      params.at("mean").double_value());
+  EXPECT_LT(params.at("mean").double_value(),
+      params.at("max").double_value());
+
+  // Hotspots on the box, hottest first
+  ASSERT_EQ(3, statsMsg.children_size());
+  const unsigned int width = thermalSensor->ImageWidth();
+  for (const auto &spot : statsMsg.children())
+  {
+    EXPECT_NEAR(params.at("max").double_value(),
+        spot.params().at("temperature").double_value(), 1.0);
+    EXPECT_NEAR(width / 2.0, spot.params().at("u").int_value(),
+        width / 4.0);
+  }
+
+  // The centre cells see the box, the corner sees the background
+  EXPECT_EQ(4, params.at("grid_columns").int_value());
+  EXPECT_EQ(4, params.at("grid_rows").int_value());
+  EXPECT_NEAR(params.at("max").double_value(),
+      params.at("cell_1_1").double_value(), 1.0);
+  EXPECT_NEAR(296.0, params.at("cell_0_0").double_value(), 1.0);
+
+  box.reset();
+  mgr.Remove(thermalSensor->Id());
+  engine->DestroyScene(scene);
+  gz::rendering::unloadEngine(engine->Name());
+}
+
+//////////////////////////////////////////////////
+TEST_P(ThermalCameraSensorTest, StatisticsWithBuiltinSDF)
+{
+  StatisticsWithBuiltinSDF(GetParam());
+}
+
 INSTANTIATE_TEST_CASE_P(ThermalCameraSensor, ThermalCameraSensorTest,
     RENDER_ENGINE_VALUES, gz::rendering::PrintToStringParam());
 
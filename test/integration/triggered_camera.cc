@@ -17,6 +17,11 @@
 
 #include <gtest/gtest.h>
 
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
 #include <ignition/common/Console.hh>
 #include <ignition/common/Filesystem.hh>
 #include <ignition/sensors/CameraSensor.hh>
@@ -135,6 +140,34 @@ void TriggeredCameraTest::ImagesWithBuiltinSDF(const std::string &_renderEngine)
     EXPECT_TRUE(helper.WaitForMessage(3s)) << helper;
   }
 
+  // triggers between updates are queued, one frame each, stamped with the
+  // trigger time
+  {
+    std::mutex mutex;
+    std::vector<std::chrono::steady_clock::duration> stamps;
+    auto connection = sensor->ConnectImageCallback(
+        [&](const ignition::msgs::Image &_image)
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          stamps.push_back(ignition::msgs::Convert(_image.header().stamp()));
+        });
+
+    for (int i = 1; i <= 3; ++i)
+    {
+      msg.mutable_header()->mutable_stamp()->set_sec(i);
+      pub.Publish(msg);
+    }
+    std::this_thread::sleep_for(500ms);
+    mgr.RunOnce(5s, true);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ASSERT_EQ(3u, stamps.size());
+    EXPECT_EQ(std::chrono::steady_clock::duration(1s), stamps[0]);
+    EXPECT_EQ(std::chrono::steady_clock::duration(2s), stamps[1]);
+    EXPECT_EQ(std::chrono::steady_clock::duration(3s), stamps[2]);
+    EXPECT_EQ(0u, sensor->DroppedTriggerCount());
+  }
+
   // test removing sensor
   // first make sure the sensor objects do exist
   auto sensorId = sensor->Id();
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "BoxDatasetWriter.hh"
+
+using namespace ignition;
+using namespace sensors;
+
+using Box = BoxDatasetWriter::Box;
+using Type = BoxDatasetWriter::Type;
+
+/// \brief Boxes per frame, a busy scene.
+static const unsigned int kBoxCount = 50u;
+
+/// \brief Frames formatted or written per method.
+static const unsigned int kFrameCount = 2000u;
+
+/// \brief Build the CSV text of a frame of 3D boxes the way the bounding
+/// box camera did, with a temporary string per value.
+/// \param[in] _boxes Boxes.
+/// \return CSV text.
+static std::string toStringCsv(const std::vector<Box> &_boxes)
+{
+  std::string file = "label,x,y,z,w,h,l,roll,pitch,yaw\n";
+  for (const auto &box : _boxes)
+  {
+    std::string sep = ",";
+    std::string boxString = std::to_string(box.label);
+    for (unsigned int v = 0u; v < 9u; ++v)
+      boxString = boxString + sep + std::to_string(box.values[v]);
+    file += boxString + '\n';
+  }
+  return file;
+}
+
+/// \brief Get the rate of a method.
+/// \param[in] _start Start time.
+/// \return Boxes per second.
+static double boxesPerSecond(std::chrono::steady_clock::time_point _start)
+{
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - _start;
+  return kFrameCount * kBoxCount / elapsed.count();
+}
+
+//////////////////////////////////////////////////
+TEST(BoxDatasetWriter, BoxesPerSecond)
+{
+  std::vector<Box> boxes(kBoxCount);
+  for (unsigned int i = 0u; i < kBoxCount; ++i)
+  {
+    boxes[i].label = i % 7u;
+    for (unsigned int v = 0u; v < 9u; ++v)
+      boxes[i].values[v] = (i + 1.0) * (v - 4.0) / 3.0;
+  }
+
+  // Keeps the formatted text alive, so that no method is optimized away
+  std::size_t bytes = 0u;
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int f = 0u; f < kFrameCount; ++f)
+    bytes += toStringCsv(boxes).size();
+  double toStringRate = boxesPerSecond(start);
+
+  start = std::chrono::steady_clock::now();
+  std::string text;
+  for (unsigned int f = 0u; f < kFrameCount; ++f)
+  {
+    text.clear();
+    BoxDatasetWriter::AppendCsvHeader(Type::BOX3D, false, text);
+    BoxDatasetWriter::AppendCsv(Type::BOX3D, boxes.data(), boxes.size(), -1,
+        text);
+    bytes += text.size();
+  }
+  double appendRate = boxesPerSecond(start);
+
+  const std::string path = std::string(PROJECT_BUILD_PATH) +
+      "/box_dataset_writer.ignb";
+  const std::string csvPath = std::string(PROJECT_BUILD_PATH) +
+      "/box_dataset_writer.csv";
+  std::remove(path.c_str());
+  BoxDatasetWriter writer;
+  ASSERT_TRUE(writer.Open(path, Type::BOX3D));
+  start = std::chrono::steady_clock::now();
+  for (unsigned int f = 0u; f < kFrameCount; ++f)
+    EXPECT_TRUE(writer.Append(f, boxes.data(), boxes.size()));
+  writer.Close();
+  double binaryRate = boxesPerSecond(start);
+
+  start = std::chrono::steady_clock::now();
+  EXPECT_TRUE(BoxDatasetWriter::ExportCsv(path, csvPath));
+  double exportRate = boxesPerSecond(start);
+
+  std::cout << kBoxCount << " 3D boxes per frame, " << kFrameCount
+            << " frames (" << bytes << " bytes of CSV)\n"
+            << "  std::to_string CSV: " << toStringRate << " boxes/s\n"
+            << "  AppendCsv:          " << appendRate << " boxes/s\n"
+            << "  binary file:        " << binaryRate << " boxes/s\n"
+            << "  CSV export:         " << exportRate << " boxes/s\n"
+            << std::flush;
+  EXPECT_GT(appendRate, 0.0);
+  EXPECT_GT(binaryRate, 0.0);
+
+  std::remove(path.c_str());
+  std::remove(csvPath.c_str());
+}
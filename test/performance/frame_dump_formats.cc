@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <ignition/common/Filesystem.hh>
+
+#include "test_config.h"  // NOLINT(build/include)
+#include "ImageSaver.hh"
+
+using namespace ignition;
+using namespace sensors;
+
+/// \brief VGA frames, the common dataset generation resolution.
+static const unsigned int kWidth = 640u;
+static const unsigned int kHeight = 480u;
+
+/// \brief Frames written per format.
+static const unsigned int kFrameCount = 100u;
+
+/// \brief Save kFrameCount frames through a single worker, so that formats
+/// are compared by encoding and writing cost alone.
+/// \param[in] _dir Output directory.
+/// \param[in] _data Frame data.
+/// \param[in] _size Size of _data in bytes.
+/// \param[in] _pixelFormat Pixel format of _data.
+/// \param[in] _fileFormat File format.
+/// \return Frames written per second.
+static double framesPerSecond(const std::string &_dir,
+    const unsigned char *_data, std::size_t _size,
+    common::Image::PixelFormatType _pixelFormat,
+    ImageSaver::FileFormat _fileFormat)
+{
+  ImageSaver saver(1u, kFrameCount);
+  ImageSaver::Options options;
+  options.format = _fileFormat;
+
+  auto start = std::chrono::steady_clock::now();
+  for (unsigned int i = 0u; i < kFrameCount; ++i)
+  {
+    saver.Save(_dir, std::to_string(i), _data, _size, kWidth, kHeight,
+        _pixelFormat, options);
+  }
+  saver.Flush();
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return kFrameCount / elapsed.count();
+}
+
+//////////////////////////////////////////////////
+TEST(FrameDumpFormats, FramesPerSecond)
+{
+  std::string dir = common::joinPaths(PROJECT_BUILD_PATH, "test",
+      "frame_dump_formats");
+  common::removeAll(dir);
+
+  // A smooth image with some texture compresses like a rendered scene
+  std::vector<unsigned char> rgb(kWidth * kHeight * 3u);
+  std::vector<float> depth(kWidth * kHeight);
+  for (unsigned int y = 0u; y < kHeight; ++y)
+  {
+    for (unsigned int x = 0u; x < kWidth; ++x)
+    {
+      std::size_t i = y * kWidth + x;
+      rgb[i * 3u] = static_cast<unsigned char>(x / 3u);
+      rgb[i * 3u + 1u] = static_cast<unsigned char>(y / 2u);
+      rgb[i * 3u + 2u] = static_cast<unsigned char>(((x / 16u) ^ (y / 16u)) &
+          1u ? 200u : 40u);
+      depth[i] = 1.0f + 4.0f * y / kHeight +
+          0.1f * std::sin(x * 0.05f);
+    }
+  }
+  const unsigned char *depthData =
+      reinterpret_cast<const unsigned char *>(depth.data());
+
+  const ImageSaver::FileFormat formats[] =
+  {
+    ImageSaver::FileFormat::PNG,
+    ImageSaver::FileFormat::RAW,
+    ImageSaver::FileFormat::QOI,
+    ImageSaver::FileFormat::LZ4
+  };
+
+  std::cout << kWidth << "x" << kHeight << ", " << kFrameCount
+            << " frames per format, one worker\n";
+  for (auto format : formats)
+  {
+    double rgbRate = framesPerSecond(dir, rgb.data(), rgb.size(),
+        common::Image::RGB_INT8, format);
+    std::cout << "  RGB8    " << ImageSaver::Extension(format) << ": "
+              << rgbRate << " frames/s\n";
+    EXPECT_GT(rgbRate, 0.0);
+  }
+
+  // Float depth, PNG and QOI can not store it and fall back to raw
+  for (auto format : {ImageSaver::FileFormat::RAW,
+      ImageSaver::FileFormat::LZ4})
+  {
+    double depthRate = framesPerSecond(dir, depthData,
+        depth.size() * sizeof(float), common::Image::R_FLOAT32, format);
+    std::cout << "  FLOAT32 " << ImageSaver::Extension(format) << ": "
+              << depthRate << " frames/s\n";
+    EXPECT_GT(depthRate, 0.0);
+  }
+  std::cout << std::flush;
+
+  common::removeAll(dir);
+}